@@ -38,6 +38,7 @@
 #include "fsl_stdlib.h"
 #include "fsl_gen.h"
 #include "classifier.h"
+#include "classifier_kcr.h"
 
 #define AIOP_APP_NAME		"CLASSIFIER"
 
@@ -50,7 +51,7 @@
 #define PRESENTATION_LENGTH 64
 
 /* IPV4: SrcIP(4), DstIP(4), Protocol(1), SrcPort(2), DstPort(2) */
-#define TABLE_KEY_LEN		13
+#define TABLE_KEY_LEN		CLASSIFIER_5TUPLE_KCR_KEY_SIZE
 #define TABLE_COMMIT_RULES	10
 #define TABLE_MAX_RULES		20
 #define CONN_TABLE_SIZE		3
@@ -395,60 +396,16 @@ static void app_fill_kg_profile(struct dpkg_profile_cfg *kg_cfg)
 
 static int app_create_exact_match_table(void)
 {
-	struct kcr_builder	kb __attribute__((aligned(16)));
 	struct table_rule	rule __attribute__((aligned(16)));
-	struct kcr_builder_fec_mask	mask;
 	struct table_create_params	tbl_params;
 	uint16_t			l_table_id;
 	uint8_t				l_key_id;
 	uint64_t			tmp_rule_id = 0;
 	int				ret;
 
-	/* Create key composition rule */
-	memset(&kb, 0, sizeof(struct kcr_builder));
-	keygen_kcr_builder_init(&kb);
-	/* IP_SRC */
-	ret = keygen_kcr_builder_add_protocol_specific_field(
-			KEYGEN_KCR_IPSRC_1_FECID, NULL, &kb);
-	if (ret) {
-		pr_err("Failed to add IP_SRC to key rule: ret = %d\n", ret);
-		return ret;
-	}
-	/* IP_DST:  mask least significant 5 bits of IP DST */
-	memset(&mask, 0, sizeof(struct kcr_builder_fec_mask));
-	mask.num_of_masks = 1;
-	mask.single_mask[0].mask = 0xE0;
-	mask.single_mask[0].mask_offset = 3;
-	ret = keygen_kcr_builder_add_protocol_specific_field(
-			KEYGEN_KCR_IPDST_1_FECID, &mask, &kb);
-	if (ret) {
-		pr_err("Failed to add IP_DST to key rule: ret = %d\n", ret);
-		return ret;
-	}
-	/* PTYPE */
-	ret = keygen_kcr_builder_add_protocol_specific_field(
-			KEYGEN_KCR_PTYPE_1_FECID, NULL, &kb);
-	if (ret) {
-		pr_err("Failed to add PTYPE to key rule: ret = %d\n", ret);
-		return ret;
-	}
-	/* SRC_PORT */
-	ret = keygen_kcr_builder_add_protocol_specific_field(
-			KEYGEN_KCR_L4PSRC_FECID, NULL, &kb);
-	if (ret) {
-		pr_err("Failed to add SRC_PORT to key rule: ret = %d\n", ret);
-		return ret;
-	}
-	/* DST_PORT */
-	ret = keygen_kcr_builder_add_protocol_specific_field(
-			KEYGEN_KCR_L4PDST_FECID, NULL, &kb);
-	if (ret) {
-		pr_err("Failed to add DST_PORT to key rule: ret = %d\n", ret);
-		return ret;
-	}
-	/* Generate key */
-	ret = keygen_kcr_create(
-			KEYGEN_ACCEL_ID_CTLU, (uint8_t *)&kb.kcr, &l_key_id);
+	/* Generate key from the precompiled rule (classifier.kcr) */
+	ret = keygen_kcr_create(KEYGEN_ACCEL_ID_CTLU,
+				(uint8_t *)classifier_5tuple_kcr.kcr, &l_key_id);
 	if (ret) {
 		pr_err("Failed to create exact match key composition rule : ret = %d\n",
 			ret);
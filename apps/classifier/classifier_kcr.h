@@ -0,0 +1,61 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Generated by misc/tools/kcr_compiler/kcr_compiler.py from classifier.kcr.
+ * Do not edit.
+ */
+
+#ifndef __CLASSIFIER_KCR_H_
+#define __CLASSIFIER_KCR_H_
+
+#include "fsl_keygen.h"
+
+/* classifier_5tuple_kcr: 5 FECs, KCR 8 bytes
+ *   IPSRC_1                  4 (IPv6 16)
+ *   IPDST_1                  4 (IPv6 16)
+ *   PTYPE_1                  1
+ *   L4PSRC                   2
+ *   L4PDST                   2
+ */
+#define CLASSIFIER_5TUPLE_KCR_KEY_SIZE		13
+#define CLASSIFIER_5TUPLE_KCR_KEY_SIZE_IPV6	37
+#define CLASSIFIER_5TUPLE_KCR_ENTRIES_PER_RULE	2
+static const struct kcr_builder classifier_5tuple_kcr __attribute__((aligned(16))) = {
+	{
+		0x05, 0x24, 0x27, 0x03, 0xe0, 0x28, 0x3e, 0x40,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	},
+	8
+};
+
+#endif /* __CLASSIFIER_KCR_H_ */
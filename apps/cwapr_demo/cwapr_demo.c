@@ -46,6 +46,26 @@
 #include "fsl_evmng.h"
 #include "apps.h"
 #include "fsl_ste.h"
+#include "fsl_prof.h"
+
+/* Uncomment to look up the reassembly contexts in a software hash table
+ * instead of a CTLU table (CWAPR_MODE_SW_TABLE) */
+/* #define CWAPR_DEMO_SW_TABLE */
+/* Number of bins of the software hash table */
+#define CWAPR_DEMO_SW_TABLE_BINS	256
+
+/* Uncomment to benchmark the reassembly: the frames aren't printed and the
+ * statistics and the profiling regions (cwapr_lookup, cwapr_delete) are
+ * printed every CWAPR_DEMO_BENCHMARK_FRAMES reassembled frames.
+ * ENABLE_PROF_REGIONS must be defined in build_flags.h */
+/* #define CWAPR_DEMO_BENCHMARK */
+#define CWAPR_DEMO_BENCHMARK_FRAMES	10000
+
+#ifdef CWAPR_DEMO_BENCHMARK
+#define demo_print(...)
+#else
+#define demo_print(...)		fsl_print(__VA_ARGS__)
+#endif
 
 int app_early_init(void);
 int app_init(void);
@@ -61,6 +81,9 @@ uint64_t stats_mem_base_addr;
 __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 {
 	uint64_t tunnel_id = 0;
+#ifdef CWAPR_DEMO_BENCHMARK
+	uint32_t reass_frm_cntr;
+#endif
 	int reassemble_status;
 	int err;
 
@@ -76,13 +99,13 @@ __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 				PRC_GET_SEGMENT_ADDRESS());
 
 		if (capwap_hdr->bits_flags & NET_HDR_FLD_CAPWAP_F)
-			fsl_print("CWAPR_DEMO:: Received CAPWAP fragment with length %d\n",
+			demo_print("CWAPR_DEMO:: Received CAPWAP fragment with length %d\n",
 					LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 		else
-			fsl_print("CWAPR_DEMO:: Received CAPWAP frame with length %d\n",
+			demo_print("CWAPR_DEMO:: Received CAPWAP frame with length %d\n",
 					LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 	} else {
-		fsl_print("CWAPR_DEMO:: Received non-CAPWAP frame -> DROP frame\n");
+		demo_print("CWAPR_DEMO:: Received non-CAPWAP frame -> DROP frame\n");
 		fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
 		fdma_terminate_task();
 	}
@@ -92,13 +115,22 @@ __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 	   (reassemble_status == CWAPR_REASSEMBLY_REGULAR)) {
 
 		if (reassemble_status == CWAPR_REASSEMBLY_SUCCESS) {
-			fsl_print
+			demo_print
 			("CWAPR_DEMO:: Send reassembled CAPWAP frame with length %d\n"
 				, LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 
+#ifdef CWAPR_DEMO_BENCHMARK
+			cwapr_get_reass_frm_cntr(cwapr_instance_handle,
+						 &reass_frm_cntr);
+			if (!(reass_frm_cntr % CWAPR_DEMO_BENCHMARK_FRAMES)) {
+				print_cwapr_statistics(cwapr_instance_handle);
+				prof_regions_print();
+			}
+#else
 			print_cwapr_statistics(cwapr_instance_handle);
+#endif
 		} else
-			fsl_print
+			demo_print
 			("CWAPR_DEMO:: Send CAPWAP frame with length %d\n"
 				, LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 
@@ -207,6 +239,16 @@ int app_init(void)
 	cwapr_params.cb_timeout_arg = 0;
 	cwapr_params.flags = CWAPR_MODE_TABLE_LOCATION_PEB |
 			CWAPR_MODE_EXTENDED_STATS_EN;
+#ifdef CWAPR_MODE_SW_TABLE
+	/* Not available on LS2085A */
+	cwapr_params.sw_table_bins = 0;
+#endif
+#ifdef CWAPR_DEMO_SW_TABLE
+	cwapr_params.flags |= CWAPR_MODE_SW_TABLE;
+	cwapr_params.sw_table_bins = CWAPR_DEMO_SW_TABLE_BINS;
+	fsl_print("CWAPR_DEMO:: Software table with %d bins\n",
+		  CWAPR_DEMO_SW_TABLE_BINS);
+#endif
 	fsl_get_mem(0x21*64, mem_pid, 64, &tmi_mem_base_addr);
 	tman_create_tmi(tmi_mem_base_addr, 0x20, &cwapr_params.tmi_id);
 
@@ -37,6 +37,7 @@
 #include "gso_demo.h"
 #include "fsl_malloc.h"
 #include "fsl_tman.h"
+#include "fsl_fd_batch.h"
 
 #define AIOP_APP_NAME		"GSO_demo"
 
@@ -104,6 +105,8 @@ static __HOT_CODE ENTRY_POINT void app_gso_demo(void)
 #else
 	uint32_t total_length = (LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 	tcp_gso_ctx_t tcp_gso_ctx;
+	struct fdma_queueing_destination_params qd_params;
+	struct fd_batch batch;
 	int status;
 
 	sl_prolog();
@@ -112,12 +115,16 @@ static __HOT_CODE ENTRY_POINT void app_gso_demo(void)
 	tcp_gso_context_init(0, tcp_mss, tcp_gso_ctx);
 	fsl_print("GSO_demo: tcp_gso_context_init done, TCP_MSS = %d\n",
 		  tcp_mss);
+	dpni_send_prepare(task_get_receive_niid(), &qd_params);
+	/* The task ends with the enqueue of the last segment */
+	fd_batch_init(&batch, FD_BATCH_TERMINATE);
 	do {
 		status = tcp_gso_generate_seg(tcp_gso_ctx);
 		if (status == TCP_GSO_GEN_SEG_STATUS_SYN_RST_SET)
 			return;
-		err = dpni_drv_send(task_get_receive_niid(),
-				    DPNI_DRV_SEND_MODE_NONE);
+		err = fd_batch_send_default_frame(&batch, &qd_params,
+				(status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS) ?
+				FD_BATCH_NO_FLAGS : FD_BATCH_LAST);
 		if (err) {
 			if (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS)
 				tcp_gso_discard_frame_remainder(tcp_gso_ctx);
@@ -323,6 +330,8 @@ void ipr_timout_cb(ipr_timeout_arg_t arg, uint32_t flags)
 void reassemble_segment(ipr_instance_handle_t ipr_instance_val_1,
 			tcp_gso_ctx_t tcp_gso_ctx)
 {
+	struct fdma_queueing_destination_params qd_params;
+	struct fd_batch batch;
 	int	reassemble_status;
 	int	status;
 	int	err = 0;
@@ -331,24 +340,21 @@ void reassemble_segment(ipr_instance_handle_t ipr_instance_val_1,
 	if (reassemble_status == IPR_REASSEMBLY_SUCCESS) {
 		fsl_print("ipr_demo: Core %d reassembled IPv4 frame\n",
 			  core_get_id());
+		dpni_send_prepare(task_get_receive_niid(), &qd_params);
+		/* More fragments may follow, the task is not terminated */
+		fd_batch_init(&batch, FD_BATCH_NO_FLAGS);
 		do {
 			status = tcp_gso_generate_seg(tcp_gso_ctx);
 			if (status == TCP_GSO_GEN_SEG_STATUS_SYN_RST_SET)
 				return;
-			err = dpni_drv_send(task_get_receive_niid(),
-					    DPNI_DRV_SEND_MODE_NONE);
-			if (err == -ENOMEM) {
-				pr_err("%d : dpni_drv_send()\n", err);
-				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
-				break;
-			} else if (err) {
-				pr_err("%d : dpni_drv_send()\n", err);
-				ARCH_FDMA_DISCARD_FD();
-				break;
-			}
-			if ((status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS) &&
-			    (err != 0)) {
-				tcp_gso_discard_frame_remainder(tcp_gso_ctx);
+			err = fd_batch_send_default_frame(&batch, &qd_params,
+							  FD_BATCH_NO_FLAGS);
+			if (err) {
+				pr_err("%d : fd_batch_send_default_frame()\n",
+				       err);
+				if (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS)
+					tcp_gso_discard_frame_remainder(
+								tcp_gso_ctx);
 				break;
 			}
 		} while (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS);
@@ -42,6 +42,7 @@
 
 #include "fsl_ip.h"
 #include "fsl_osm.h"
+#include "fsl_fd_batch.h"
 #include "apps.h"
 
 int app_init(void);
@@ -73,6 +74,8 @@ static __HOT_CODE ENTRY_POINT void app_proc_pkt_seg_offset_ipheader(void)
 	uint16_t mtu;
 	int ipf_status;
 	int local_test_error = 0;
+	struct fdma_queueing_destination_params qd_params;
+	struct fd_batch batch;
 
 #ifdef LS2085A_REV1
 	/* If the segment offset is not set to 0, re-present the frame using
@@ -103,17 +106,18 @@ static __HOT_CODE ENTRY_POINT void app_proc_pkt_seg_offset_ipheader(void)
 	ipf_context_init(0, mtu, ipf_context_addr);
 	fsl_print("ipf_demo: ipf_context_init done, MTU = %d\n", mtu);
 
+	dpni_send_prepare(task_get_receive_niid(), &qd_params);
+	/* The task ends with the enqueue of the last fragment */
+	fd_batch_init(&batch, FD_BATCH_TERMINATE);
 	do {
 		ipf_status = ipf_generate_frag(ipf_context_addr);
-		err = dpni_drv_send(task_get_receive_niid(),
-				    DPNI_DRV_SEND_MODE_NONE);
+		err = fd_batch_send_default_frame(&batch, &qd_params,
+				(ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS) ?
+				FD_BATCH_NO_FLAGS : FD_BATCH_LAST);
 		if (err) {
-			fsl_print("ERROR = %d: dpni_drv_send()\n", err);
+			fsl_print("ERROR = %d: fd_batch_send_default_frame()\n",
+				  err);
 			local_test_error |= err;
-			if (err == -ENOMEM)
-				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
-			else /* (err == -EBUSY) */
-				ARCH_FDMA_DISCARD_FD();
 			if (ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS)
 				ipf_discard_frame_remainder(ipf_context_addr);
 			break;
@@ -140,6 +144,8 @@ __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 	int local_test_error = 0;
 	uint32_t fd_length;
 	uint16_t offset;
+	struct fdma_queueing_destination_params qd_params;
+	struct fd_batch batch;
 
 #ifdef SEGMENT_OFFSET_NOT_0_TEST
 	/* If the segment offset is not set to 0, re-present the frame using
@@ -178,6 +184,10 @@ __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 	ipf_context_init(0, mtu, ipf_context_addr);
 	fsl_print("ipf_demo: ipf_context_init done, MTU = %d\n", mtu);
 
+	dpni_send_prepare(task_get_receive_niid(), &qd_params);
+	/* The last fragment is checked after its enqueue, the task is not
+	 * terminated by the batch */
+	fd_batch_init(&batch, FD_BATCH_NO_FLAGS);
 	do {
 		ipf_status = ipf_generate_frag(ipf_context_addr);
 
@@ -227,18 +237,12 @@ __HOT_CODE ENTRY_POINT static void app_process_packet(void)
 				local_test_error |= 1;
 			}
 		}
-		err = dpni_drv_send(task_get_receive_niid(), DPNI_DRV_SEND_MODE_NONE);
+		err = fd_batch_send_default_frame(&batch, &qd_params,
+						  FD_BATCH_NO_FLAGS);
 		if (err){
-			fsl_print("ERROR = %d: dpni_drv_send()\n",err);
+			fsl_print("ERROR = %d: fd_batch_send_default_frame()\n",
+				  err);
 			local_test_error |= err;
-			if(err == -ENOMEM)
-			{
-				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
-			}
-			else /* (err == -EBUSY) */
-				ARCH_FDMA_DISCARD_FD();
-
-
 			if (ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS)
 				ipf_discard_frame_remainder(ipf_context_addr);
 			break;
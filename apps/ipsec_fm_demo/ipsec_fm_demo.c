@@ -47,6 +47,7 @@ static void ipsec_print_frame(void);
 static void ipsec_print_stats(ipsec_handle_t desc_handle, int sa,
 			      uint8_t is_encap);
 static void ipsec_print_sp(uint16_t ni_spid);
+static void ipsec_print_sd_tmpl_stats(uint32_t num_sa, uint64_t install_time);
 static void user_lifetime_callback(uint64_t opaque1, uint8_t opaque2);
 static void epid_setup(void);
 
@@ -901,6 +902,7 @@ static int ipsec_app_init(uint16_t ni_id)
 	ipsec_handle_t ws_desc_handle_outbound = 0;
 	ipsec_handle_t ws_desc_handle_inbound = 0;
 	int sa_index;
+	uint64_t sa_install_start, sa_install_end;
 #if (LIFETIME_TIMERS_ENABLE == 1 || IPSEC_STATS_PRINT == 1)
 	uint64_t tmi_buffer_handle, tmi_timer_addr;
 #endif
@@ -1168,6 +1170,7 @@ static int ipsec_app_init(uint16_t ni_id)
 	cdma_write(auth_key_addr, &auth_key, (uint16_t)auth_keylen);
 
 	/* Create all SAs */
+	tman_get_timestamp(&sa_install_start);
 	for (sa_index = 0; sa_index < TEST_NUM_OF_SA; sa_index++) {
 		/* Outbound (encryption) parameters */
 		if (outer_header_ip_version == 4) {
@@ -1361,6 +1364,9 @@ static int ipsec_app_init(uint16_t ni_id)
 		fsl_print("IPsec Demo: IPsec Initialization completed\n");
 	else
 		return err;
+	tman_get_timestamp(&sa_install_end);
+	ipsec_print_sd_tmpl_stats(2 * TEST_NUM_OF_SA,
+				  sa_install_end - sa_install_start);
 #if (IPSEC_STATS_PRINT == 1)
 	/* Create statistics print periodic timer */
 	err = tman_create_timer(tmi_id,
@@ -1379,6 +1385,31 @@ static int ipsec_app_init(uint16_t ni_id)
 	return 0;
 }
 
+/* Print the SA install rate (including the console prints of the SA loop)
+ * and the shared descriptor generation rates, with and without template */
+/******************************************************************************/
+static void ipsec_print_sd_tmpl_stats(uint32_t num_sa, uint64_t install_time)
+{
+	struct ipsec_sd_tmpl_stats stats;
+	uint32_t hit_avg = 0, miss_avg = 0;
+
+	ipsec_get_sd_tmpl_stats(&stats);
+	if (stats.hits)
+		hit_avg = (uint32_t)(stats.hit_time / stats.hits);
+	if (stats.misses)
+		miss_avg = (uint32_t)(stats.miss_time / stats.misses);
+
+	fsl_print("IPsec Demo: %d SAs installed in %d us\n", num_sa,
+		  (uint32_t)install_time);
+	fsl_print("\t SD templates : hits = %d (%d us/SA), misses = %d (%d us/SA)\n",
+		  stats.hits, hit_avg, stats.misses, miss_avg);
+	fsl_print("\t SD templates : created = %d, uncached = %d\n",
+		  stats.inserts, stats.uncached);
+	if (hit_avg && miss_avg)
+		fsl_print("\t SD generation : %d SAs/s from templates, %d SAs/s by the RTA\n",
+			  1000000 / hit_avg, 1000000 / miss_avg);
+}
+
 /* Print the frame in a Wireshark-like format */
 /******************************************************************************/
 static void ipsec_print_frame(void)
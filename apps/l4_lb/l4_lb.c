@@ -0,0 +1,1307 @@
+/*
+ * Copyright 2014-2015 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_types.h"
+#include "fsl_stdio.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_ip.h"
+#include "fsl_nat.h"
+#include "fsl_l2.h"
+#include "fsl_parser.h"
+#include "fsl_fdma.h"
+#include "fsl_net.h"
+#include "fsl_dbg.h"
+#include "fsl_evmng.h"
+#include "fsl_spinlock.h"
+#include "fsl_malloc.h"
+#include "fsl_slab.h"
+#include "fsl_tman.h"
+#include "fsl_table.h"
+#include "fsl_keygen.h"
+#include "fsl_cdma.h"
+#include "fsl_ste.h"
+#include "fsl_rcu.h"
+#include "fsl_cmdif_server.h"
+#include "fsl_mc_sys.h"
+#include "fsl_mc_cmd.h"
+#include "l4_lb.h"
+
+#define AIOP_APP_NAME		"L4_LB"
+
+/* L4 fields */
+#define NH_FLD_L4_PORT_SRC	(1)
+#define NH_FLD_L4_PORT_DST	(NH_FLD_L4_PORT_SRC << 1)
+
+/*
+ * The application rewrites the Ethernet, IP and L4 headers (up to an IPv6
+ * header and a TCP header without options, behind a VLAN tag).
+ */
+#define PRESENTATION_LENGTH	128
+
+#define LB_IP_PROTO_IPIP	4
+#define LB_IP_PROTO_TCP		6
+#define LB_IP_PROTO_UDP		17
+#define LB_IP_PROTO_IPV6	41
+#define LB_TUNNEL_TTL		64
+
+/*
+ * Maglev lookup table of a service: LB_MAGLEV_SIZE (prime) one byte entries,
+ * the backend slot of each entry. Each table takes LB_TABLE_STRIDE bytes of
+ * DDR.
+ */
+#define LB_MAGLEV_SIZE		4093
+#define LB_TABLE_STRIDE		4096
+#define LB_NO_BACKEND		0xFF
+/* The tables are compared in chunks of LB_CHUNK_SIZE bytes, the modified
+ * blocks of LB_BLOCK_SIZE bytes are written */
+#define LB_CHUNK_SIZE		128
+#define LB_BLOCK_SIZE		16
+/* FNV-1a hash of a backend address and port, two seeds for the offset and
+ * the skip of the backend in the table (see misc/tools/maglev_bench) */
+#define LB_FNV_PRIME		0x01000193
+#define LB_HASH_SEED_OFFSET	0x811C9DC5
+#define LB_HASH_SEED_SKIP	0x050C5D1F
+
+/*
+ * Connection table: one rule per direction (two for LB_MODE_NAT), plus the
+ * clock rule. The rule timestamps are refreshed by the lookups.
+ */
+#define LB_MAX_RULES		(2 * LB_MAX_CONNS + 1)
+/* Key of the clock rule: no frame has this IP version */
+#define LB_CLOCK_KEY		0xFF
+#define LB_DEF_IDLE_TIMEOUT	60	/* seconds */
+#define LB_USEC_PER_SEC		1000000
+/* The aging timer checks LB_AGING_BATCH rules every LB_AGING_PERIOD (10 ms
+ * units): the whole table in about 16 seconds */
+#define LB_AGING_PERIOD		100
+#define LB_AGING_BATCH		2048
+#define LB_LAST_RULE_ID		0xFFFFFFFFFFFFFFFFULL
+
+/* Result of a connection rule (data0) */
+#define LB_CONN_REPLY		0x01	/* Reply of a LB_MODE_NAT backend */
+#define LB_CONN_DATA(_vip, _slot, _gen, _flags) \
+	(((uint64_t)(_flags) << 24) | ((uint64_t)(_gen) << 16) | \
+	 ((uint64_t)(_vip) << 8) | (uint64_t)(_slot))
+#define LB_CONN_SLOT(_data)	((uint8_t)(_data))
+#define LB_CONN_VIP(_data)	((uint8_t)((_data) >> 8))
+#define LB_CONN_GEN(_data)	((uint8_t)((_data) >> 16))
+#define LB_CONN_FLAGS(_data)	((uint8_t)((_data) >> 24))
+
+#define LB_BACKEND_BIT(_slot)	(1U << (_slot))
+
+/* The number of created timers should be 3 timers larger than actually
+ * needed and larger than 4. The memory region used to hold the timers must be
+ * of at least 64 * (num_of_timers + 1) bytes, and 64 bytes aligned. */
+#define LB_NUM_TIMERS		5
+#define LB_TMI_SIZE		(64 * (LB_NUM_TIMERS + 1))
+#define COMMITTED_BUFFERS	1
+#define MAXIMUM_BUFFERS		1
+#define BUFFERS_ALIGNMENT	64
+
+#define LB_CMD_READ(_param, _offset, _width, _type, _arg) \
+	_arg = (_type)mc_dec(cmd_data->params[_param], _offset, _width);
+
+#define LB_RSP_PREP(_param, _offset, _width, _type, _arg) \
+	cmd_data->params[_param] |= mc_enc(_offset, _width, _arg);
+
+/* Key of the connection table, the 5-tuple of a direction */
+struct lb_conn_key {
+	uint32_t	src_addr[4];
+	uint32_t	dst_addr[4];
+	uint16_t	src_port;
+	uint16_t	dst_port;
+	uint8_t		protocol;
+	uint8_t		ip_version;
+	uint8_t		reserved[2];
+};
+
+struct lb_vip_cfg {
+	uint32_t	addr[4];
+	uint32_t	tunnel_src;
+	uint32_t	idle_timeout;
+	uint16_t	port;
+	uint16_t	ni;
+	uint8_t		gw_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t		protocol;
+	uint8_t		ip_version;
+	uint8_t		mode;
+};
+
+struct lb_backend_cfg {
+	uint32_t	addr[4];
+	uint16_t	port;
+	uint16_t	ni;
+	uint8_t		dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t		ip_version;
+	uint8_t		reserved;
+};
+
+/* Backend record (DDR, 64 bytes). The configuration is written before the
+ * backend is enabled and is not modified until it is deleted. */
+struct lb_backend {
+	/* STE counters */
+	uint64_t		frames;
+	uint64_t		bytes;
+	uint64_t		conns;
+	uint8_t			src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t			reserved[2];
+	struct lb_backend_cfg	cfg;
+	uint8_t			reserved1[4];
+};
+
+/* Counters updated by the frame tasks */
+struct lb_vip_counters {
+	int64_t		frames;
+	int64_t		new_conns;
+	int64_t		reselects;
+	int64_t		no_conn;
+	int64_t		no_backend;
+	int64_t		tx_errors;
+	int64_t		replies;
+};
+
+/* Statistics reported by LB_CMD_GET_STATS */
+struct lb_stats {
+	uint64_t	frames;
+	uint64_t	new_conns;
+	uint64_t	reselects;
+	uint64_t	no_conn;
+	uint64_t	no_backend;
+	uint64_t	tx_errors;
+	uint64_t	replies;
+	uint64_t	unmatched;
+	uint64_t	lookup_errors;
+	uint64_t	rebuilds;
+	uint64_t	backend_frames;
+	uint64_t	backend_bytes;
+	uint64_t	backend_conns;
+	uint32_t	rebuild_time;
+	uint32_t	rebuild_changes;
+	uint32_t	backends;
+};
+
+struct lb_vip {
+	struct lb_vip_counters	cnt;
+	uint64_t		table_addr;
+	uint64_t		backends_addr;
+	uint64_t		rebuilds;
+	uint32_t		rebuild_time;
+	uint32_t		rebuild_changes;
+	uint32_t		addr[4];
+	uint32_t		tunnel_src;
+	uint32_t		idle_timeout;	/* microseconds */
+	/* Backends the frames may be sent to */
+	volatile uint32_t	enabled;
+	uint16_t		port;
+	uint16_t		ni;
+	uint8_t			gw_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t			src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t			protocol;
+	uint8_t			ip_version;
+	uint8_t			mode;
+	volatile uint8_t	valid;
+	/* Incremented when a backend is added: the connections of the
+	 * previous backend of the slot are moved */
+	uint8_t			gen[LB_MAX_BACKENDS];
+};
+
+static struct lb_vip	lb_vips[LB_MAX_VIPS] __attribute__((aligned(32)));
+/* Frames of no service, dropped */
+static int64_t		lb_unmatched;
+/* Frames dropped on a failed connection table lookup */
+static int64_t		lb_lookup_errors;
+/* Lookup tables of the services (DDR). Their address is also the mutex of
+ * the control path. */
+static uint64_t		lb_tables_addr;
+static uint64_t		lb_backends_addr;
+/* Lookup table built by the control path, before it is written to DDR */
+static uint8_t		*lb_table_build;
+static enum memory_partition_id	lb_mem_partition_id;
+static t_tbl_id		lb_table_id;
+static t_rule_id	lb_clock_rule_id;
+/* Next rule checked by the aging timer */
+static t_rule_id	lb_aging_rule_id;
+static uint64_t		lb_aging_lock;
+static uint8_t		lb_aging_busy;
+static uint32_t		lb_timer_handle;
+static uint8_t		lb_tmi_id;
+
+static void app_fill_kg_profile(struct dpkg_profile_cfg *kg_cfg);
+
+static inline uint64_t lb_backend_addr(struct lb_vip *vip, uint8_t slot)
+{
+	return vip->backends_addr + slot * sizeof(struct lb_backend);
+}
+
+static inline int lb_backend_valid(struct lb_vip *vip, uint8_t slot,
+				   uint8_t gen)
+{
+	return slot < LB_MAX_BACKENDS &&
+		(vip->enabled & LB_BACKEND_BIT(slot)) && vip->gen[slot] == gen;
+}
+
+/* Connection key of a TCP or UDP frame */
+static inline int lb_parse(struct lb_conn_key *key)
+{
+	struct ipv4hdr	*ipv4_hdr;
+	struct ipv6hdr	*ipv6_hdr;
+	uint16_t	*ports;
+
+	if (!PARSER_IS_TCP_OR_UDP_DEFAULT())
+		return -EINVAL;
+
+	memset(key, 0, sizeof(*key));
+	if (PARSER_IS_OUTER_IPV4_DEFAULT()) {
+		ipv4_hdr = (struct ipv4hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		key->src_addr[0] = ipv4_hdr->src_addr;
+		key->dst_addr[0] = ipv4_hdr->dst_addr;
+		key->ip_version = 4;
+	} else if (PARSER_IS_OUTER_IPV6_DEFAULT()) {
+		ipv6_hdr = (struct ipv6hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		memcpy(key->src_addr, ipv6_hdr->src_addr,
+		       sizeof(key->src_addr));
+		memcpy(key->dst_addr, ipv6_hdr->dst_addr,
+		       sizeof(key->dst_addr));
+		key->ip_version = 6;
+	} else {
+		return -EINVAL;
+	}
+	ports = (uint16_t *)PARSER_GET_L4_POINTER_DEFAULT();
+	key->src_port = ports[0];
+	key->dst_port = ports[1];
+	key->protocol = PARSER_IS_TCP_DEFAULT() ? LB_IP_PROTO_TCP :
+		LB_IP_PROTO_UDP;
+	return 0;
+}
+
+static inline struct lb_vip *lb_vip_find(const struct lb_conn_key *key)
+{
+	struct lb_vip	*vip;
+	int		i;
+
+	for (i = 0; i < LB_MAX_VIPS; i++) {
+		vip = &lb_vips[i];
+		if (vip->valid && vip->port == key->dst_port &&
+		    vip->protocol == key->protocol &&
+		    vip->ip_version == key->ip_version &&
+		    vip->addr[0] == key->dst_addr[0] &&
+		    vip->addr[1] == key->dst_addr[1] &&
+		    vip->addr[2] == key->dst_addr[2] &&
+		    vip->addr[3] == key->dst_addr[3])
+			return vip;
+	}
+	return NULL;
+}
+
+/* Backend of a new connection: the lookup table entry of the flow hash */
+static inline int lb_select(struct lb_vip *vip, struct lb_conn_key *key,
+			    uint8_t *slot)
+{
+	uint32_t	hash;
+
+	keygen_gen_hash(key, sizeof(*key), &hash);
+	cdma_read(slot, vip->table_addr + hash % LB_MAGLEV_SIZE, 1);
+	/* An entry of a backend being deleted, until the next lookup table
+	 * is written */
+	if (*slot >= LB_MAX_BACKENDS ||
+	    !(vip->enabled & LB_BACKEND_BIT(*slot))) {
+		atomic_incr64(&vip->cnt.no_backend, 1);
+		return -ENODEV;
+	}
+	return 0;
+}
+
+/* Rule of the replies of a LB_MODE_NAT backend */
+static int lb_reply_rule(struct lb_vip *vip, struct lb_conn_key *key,
+			 uint8_t slot, const struct lb_backend *b)
+{
+	struct table_rule	rule __attribute__((aligned(16)));
+	struct lb_conn_key	*reply;
+	t_rule_id		rule_id;
+	int			err;
+
+	memset(&rule, 0, sizeof(rule));
+	reply = (struct lb_conn_key *)rule.key_desc.em.key;
+	memcpy(reply->src_addr, b->cfg.addr, sizeof(reply->src_addr));
+	memcpy(reply->dst_addr, key->src_addr, sizeof(reply->dst_addr));
+	reply->src_port = b->cfg.port;
+	reply->dst_port = key->src_port;
+	reply->protocol = key->protocol;
+	reply->ip_version = key->ip_version;
+	rule.options = TABLE_RULE_TIMESTAMP_ENABLE;
+	rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
+	rule.result.data0 = LB_CONN_DATA(vip - lb_vips, slot, vip->gen[slot],
+					 LB_CONN_REPLY);
+	/* Replaces the rule of a previous connection of the same ports */
+	err = table_rule_create_or_replace(TABLE_ACCEL_ID_CTLU, lb_table_id,
+					   &rule, sizeof(*key), &rule_id,
+					   NULL, NULL, NULL);
+	return (err < 0) ? err : 0;
+}
+
+/*
+ * Creates the connection rules (or moves the connection to 'slot' when
+ * 'move' is set). Returns -EIO when another frame of the connection created
+ * it.
+ */
+static int lb_conn_create(struct lb_vip *vip, struct lb_conn_key *key,
+			  uint8_t slot, const struct lb_backend *b, int move)
+{
+	struct table_rule	rule __attribute__((aligned(16)));
+	t_rule_id		rule_id;
+	int			err;
+
+	memset(&rule, 0, sizeof(rule));
+	memcpy(rule.key_desc.em.key, key, sizeof(*key));
+	rule.options = TABLE_RULE_TIMESTAMP_ENABLE;
+	rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
+	rule.result.data0 = LB_CONN_DATA(vip - lb_vips, slot, vip->gen[slot],
+					 0);
+	if (move)
+		err = table_rule_replace_by_key_desc(TABLE_ACCEL_ID_CTLU,
+						     lb_table_id, &rule,
+						     sizeof(*key), NULL);
+	else
+		err = table_rule_create(TABLE_ACCEL_ID_CTLU, lb_table_id,
+					&rule, sizeof(*key), &rule_id);
+	if (err)
+		return err;
+
+	if (vip->mode == LB_MODE_NAT) {
+		err = lb_reply_rule(vip, key, slot, b);
+		if (err) {
+			/* Without its reply rule the connection can't
+			 * work */
+			table_rule_delete_by_key_desc(TABLE_ACCEL_ID_CTLU,
+						      lb_table_id,
+						      &rule.key_desc,
+						      sizeof(*key), NULL);
+			return err;
+		}
+	}
+	ste_inc_counter(lb_backend_addr(vip, slot) +
+			offsetof(struct lb_backend, conns), 1,
+			STE_MODE_64_BIT_CNTR_SIZE);
+	return 0;
+}
+
+/* Rewrites the frame to the backend */
+static inline int lb_to_backend(struct lb_vip *vip, const struct lb_backend *b)
+{
+	struct ipv4hdr	outer __attribute__((aligned(16)));
+	uint32_t	addr[4];
+	int		err;
+
+	if (vip->mode == LB_MODE_NAT) {
+		if (vip->ip_version == 4) {
+			err = nat_ipv4(NAT_MODIFY_MODE_IPDST |
+				       NAT_MODIFY_MODE_L4DST |
+				       NAT_MODIFY_MODE_L4_CHECKSUM, 0,
+				       b->cfg.addr[0], 0, b->cfg.port, 0, 0);
+		} else {
+			memcpy(addr, b->cfg.addr, sizeof(addr));
+			err = nat_ipv6(NAT_MODIFY_MODE_IPDST |
+				       NAT_MODIFY_MODE_L4DST |
+				       NAT_MODIFY_MODE_L4_CHECKSUM, NULL,
+				       addr, 0, b->cfg.port, 0, 0);
+		}
+	} else {
+		memset(&outer, 0, sizeof(outer));
+		outer.vsn_and_ihl = 0x45;
+		outer.ttl = LB_TUNNEL_TTL;
+		outer.protocol = (vip->ip_version == 4) ? LB_IP_PROTO_IPIP :
+			LB_IP_PROTO_IPV6;
+		outer.src_addr = vip->tunnel_src;
+		outer.dst_addr = b->cfg.addr[0];
+		err = ipv4_header_encapsulation(IPV4_ENCAP_MODE_TOS_DS |
+						IPV4_ENCAP_MODE_TOS_ECN,
+						&outer, sizeof(outer));
+	}
+	if (err)
+		return err;
+
+	l2_set_dl_dst((uint8_t *)b->cfg.dst_mac);
+	l2_set_dl_src((uint8_t *)b->src_mac);
+	return 0;
+}
+
+/* Translates a reply of a LB_MODE_NAT backend back to the service */
+static inline int lb_to_client(struct lb_vip *vip)
+{
+	int	err;
+
+	if (vip->ip_version == 4)
+		err = nat_ipv4(NAT_MODIFY_MODE_IPSRC | NAT_MODIFY_MODE_L4SRC |
+			       NAT_MODIFY_MODE_L4_CHECKSUM, vip->addr[0], 0,
+			       vip->port, 0, 0, 0);
+	else
+		err = nat_ipv6(NAT_MODIFY_MODE_IPSRC | NAT_MODIFY_MODE_L4SRC |
+			       NAT_MODIFY_MODE_L4_CHECKSUM, vip->addr, NULL,
+			       vip->port, 0, 0, 0);
+	if (err)
+		return err;
+
+	l2_set_dl_dst(vip->gw_mac);
+	l2_set_dl_src(vip->src_mac);
+	atomic_incr64(&vip->cnt.replies, 1);
+	return 0;
+}
+
+static inline void lb_backend_read(struct lb_vip *vip, uint8_t slot,
+				   struct lb_backend *b)
+{
+	cdma_read(&b->src_mac, lb_backend_addr(vip, slot) +
+		  offsetof(struct lb_backend, src_mac),
+		  sizeof(*b) - offsetof(struct lb_backend, src_mac));
+}
+
+/*
+ * Selects the destination of the frame and rewrites it. Returns the NI the
+ * frame is sent on.
+ */
+static inline int lb_forward(struct lb_conn_key *key, struct lb_vip **pvip,
+			     uint16_t *ni)
+{
+	struct table_lookup_result lookup_result __attribute__((aligned(16)));
+	union table_lookup_key_desc key_desc;
+	struct lb_backend	b;
+	struct lb_vip		*vip;
+	uint64_t		data;
+	uint8_t			slot;
+	int			err, move;
+
+	key_desc.em_key = key;
+	do {
+		vip = NULL;
+		err = table_lookup_by_key(TABLE_ACCEL_ID_CTLU, lb_table_id,
+					  key_desc, sizeof(*key),
+					  &lookup_result);
+		if (err != TABLE_STATUS_SUCCESS && err != TABLE_STATUS_MISS) {
+			atomic_incr64(&lb_lookup_errors, 1);
+			return -EIO;
+		}
+		/* A rule that is not valid anymore is replaced */
+		move = (err == TABLE_STATUS_SUCCESS);
+		if (move) {
+			data = lookup_result.data0;
+			vip = &lb_vips[LB_CONN_VIP(data)];
+			if (!vip->valid) {
+				/* Rule of a deleted service */
+				vip = NULL;
+			} else if (LB_CONN_FLAGS(data) & LB_CONN_REPLY) {
+				*pvip = vip;
+				*ni = vip->ni;
+				return lb_to_client(vip);
+			} else {
+				slot = LB_CONN_SLOT(data);
+				if (lb_backend_valid(vip, slot,
+						     LB_CONN_GEN(data))) {
+					lb_backend_read(vip, slot, &b);
+					goto forward;
+				}
+				/* The backend of the connection was
+				 * deleted */
+			}
+		}
+		if (!vip) {
+			vip = lb_vip_find(key);
+			if (!vip) {
+				atomic_incr64(&lb_unmatched, 1);
+				return -ENOENT;
+			}
+		}
+		err = lb_select(vip, key, &slot);
+		if (err)
+			return err;
+		lb_backend_read(vip, slot, &b);
+		err = lb_conn_create(vip, key, slot, &b, move);
+		/* -EIO: the rule was created (or deleted, when moved) by
+		 * another task meanwhile */
+	} while (err == -EIO);
+
+	if (!err) {
+		atomic_incr64(move ? &vip->cnt.reselects :
+			      &vip->cnt.new_conns, 1);
+	} else {
+		atomic_incr64(&vip->cnt.no_conn, 1);
+		/* The replies of a translated connection would be lost */
+		if (vip->mode == LB_MODE_NAT)
+			return err;
+	}
+
+forward:
+	*pvip = vip;
+	*ni = b.cfg.ni;
+	atomic_incr64(&vip->cnt.frames, 1);
+	ste_inc_and_acc_counters(lb_backend_addr(vip, slot),
+				 LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS),
+				 STE_MODE_COMPOUND_64_BIT_CNTR_SIZE |
+				 STE_MODE_COMPOUND_64_BIT_ACC_SIZE);
+	return lb_to_backend(vip, &b);
+}
+
+/* Performs frames processing */
+__HOT_CODE ENTRY_POINT static void app_l4_lb(void)
+{
+	struct lb_conn_key	key __attribute__((aligned(16)));
+	struct lb_vip		*vip = NULL;
+	uint16_t		ni;
+	int			err;
+
+	sl_prolog();
+
+	err = lb_parse(&key);
+	if (err) {
+		atomic_incr64(&lb_unmatched, 1);
+	} else {
+		err = lb_forward(&key, &vip, &ni);
+		if (!err) {
+			err = dpni_drv_send(ni, DPNI_DRV_SEND_MODE_TERM);
+			/* The task ends here unless the frame is not sent */
+			atomic_incr64(&vip->cnt.tx_errors, 1);
+			if (err == -ENOMEM)
+				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+			else /* (err == -EBUSY) */
+				ARCH_FDMA_DISCARD_FD((struct ldpaa_fd *)
+						     HWC_FD_ADDRESS);
+			fdma_terminate_task();
+		}
+	}
+
+	fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+	fdma_terminate_task();
+}
+
+static uint32_t lb_hash(const uint8_t *p, int size, uint32_t hash)
+{
+	while (size--) {
+		hash ^= *p++;
+		hash *= LB_FNV_PRIME;
+	}
+	return hash;
+}
+
+/*
+ * Maglev population of the lookup table with the backends of 'members': in
+ * turn, each backend takes the next free entry of its own permutation of the
+ * table (offset + n * skip).
+ */
+static __COLD_CODE void lb_maglev_build(struct lb_vip *vip, uint32_t members,
+					uint8_t *table)
+{
+	struct lb_backend_cfg	cfg;
+	uint16_t		next[LB_MAX_BACKENDS], skip[LB_MAX_BACKENDS];
+	uint8_t			hkey[sizeof(cfg.addr) + sizeof(cfg.port)];
+	uint32_t		filled = 0;
+	uint16_t		c;
+	int			i;
+
+	memset(table, LB_NO_BACKEND, LB_MAGLEV_SIZE);
+	if (!members)
+		return;
+
+	for (i = 0; i < LB_MAX_BACKENDS; i++) {
+		if (!(members & LB_BACKEND_BIT(i)))
+			continue;
+		cdma_read(&cfg, lb_backend_addr(vip, (uint8_t)i) +
+			  offsetof(struct lb_backend, cfg), sizeof(cfg));
+		memcpy(hkey, cfg.addr, sizeof(cfg.addr));
+		memcpy(&hkey[sizeof(cfg.addr)], &cfg.port, sizeof(cfg.port));
+		next[i] = (uint16_t)(lb_hash(hkey, sizeof(hkey),
+					     LB_HASH_SEED_OFFSET) %
+				     LB_MAGLEV_SIZE);
+		skip[i] = (uint16_t)(lb_hash(hkey, sizeof(hkey),
+					     LB_HASH_SEED_SKIP) %
+				     (LB_MAGLEV_SIZE - 1) + 1);
+	}
+
+	for (;;) {
+		for (i = 0; i < LB_MAX_BACKENDS; i++) {
+			if (!(members & LB_BACKEND_BIT(i)))
+				continue;
+			c = next[i];
+			while (table[c] != LB_NO_BACKEND) {
+				c += skip[i];
+				if (c >= LB_MAGLEV_SIZE)
+					c -= LB_MAGLEV_SIZE;
+			}
+			table[c] = (uint8_t)i;
+			c += skip[i];
+			if (c >= LB_MAGLEV_SIZE)
+				c -= LB_MAGLEV_SIZE;
+			next[i] = c;
+			if (++filled == LB_MAGLEV_SIZE)
+				return;
+		}
+	}
+}
+
+/*
+ * Writes the blocks of the built lookup table that differ from the table in
+ * use, one write per run of modified blocks. Each entry is read by the
+ * frames either before or after its update; the backends that are no longer
+ * referenced are kept until an RCU grace period ends. Returns the number of
+ * modified entries.
+ */
+static __COLD_CODE uint32_t lb_maglev_publish(uint64_t table_addr,
+					      const uint8_t *table)
+{
+	uint8_t		chunk[LB_CHUNK_SIZE];
+	uint32_t	changes = 0, diff;
+	uint16_t	off, size, i, j, blk, run = 0, run_len = 0;
+
+	for (off = 0; off < LB_MAGLEV_SIZE; off += size) {
+		size = MIN(LB_CHUNK_SIZE, LB_MAGLEV_SIZE - off);
+		cdma_read(chunk, table_addr + off, size);
+		for (i = 0; i < size; i += blk) {
+			blk = MIN(LB_BLOCK_SIZE, size - i);
+			for (j = i, diff = 0; j < i + blk; j++)
+				if (chunk[j] != table[off + j])
+					diff++;
+			if (diff) {
+				if (!run_len)
+					run = i;
+				run_len += blk;
+				changes += diff;
+			}
+			/* End of a run of modified blocks */
+			if (run_len && (!diff || i + blk == size)) {
+				memcpy(&chunk[run], &table[off + run],
+				       run_len);
+				cdma_write(table_addr + off + run,
+					   &chunk[run], run_len);
+				run_len = 0;
+			}
+		}
+	}
+	return changes;
+}
+
+static __COLD_CODE void lb_maglev_update(struct lb_vip *vip, uint32_t members)
+{
+	uint64_t	start, end;
+
+	tman_get_timestamp(&start);
+	lb_maglev_build(vip, members, lb_table_build);
+	vip->rebuild_changes = lb_maglev_publish(vip->table_addr,
+						 lb_table_build);
+	tman_get_timestamp(&end);
+	vip->rebuild_time = (uint32_t)(end - start);
+	vip->rebuilds++;
+}
+
+/* Current time of the connection table: the timestamp of the clock rule,
+ * refreshed by a lookup */
+static uint32_t lb_conn_clock(void)
+{
+	struct lb_conn_key	key __attribute__((aligned(16)));
+	struct table_lookup_result lookup_result __attribute__((aligned(16)));
+	union table_lookup_key_desc key_desc;
+	struct table_result	result;
+	uint32_t		ts = 0;
+	uint8_t			options;
+
+	memset(&key, 0, sizeof(key));
+	key.ip_version = LB_CLOCK_KEY;
+	key_desc.em_key = &key;
+	table_lookup_by_key(TABLE_ACCEL_ID_CTLU, lb_table_id, key_desc,
+			    sizeof(key), &lookup_result);
+	table_rule_query_get_result(TABLE_ACCEL_ID_CTLU, lb_table_id,
+				    lb_clock_rule_id, &result, &options, &ts);
+	return ts;
+}
+
+/*
+ * Deletes the connection rule 'rule_id' if it belongs to the service
+ * 'flush_vip', to a deleted service or if it is idle.
+ */
+static void lb_conn_check(t_rule_id rule_id, uint8_t flush_vip, uint32_t now)
+{
+	struct table_result	result;
+	struct lb_vip		*vip;
+	uint64_t		data;
+	uint32_t		ts;
+	uint8_t			options, vip_id, slot;
+
+	if (rule_id == lb_clock_rule_id ||
+	    table_rule_query_get_result(TABLE_ACCEL_ID_CTLU, lb_table_id,
+					rule_id, &result, &options, &ts))
+		return;
+
+	data = result.data0;
+	vip_id = LB_CONN_VIP(data);
+	vip = &lb_vips[vip_id];
+	if (vip_id != flush_vip && vip->valid &&
+	    now - ts < vip->idle_timeout)
+		return;
+	if (table_rule_delete(TABLE_ACCEL_ID_CTLU, lb_table_id, rule_id,
+			      NULL, NULL, NULL))
+		return;
+
+	slot = LB_CONN_SLOT(data);
+	if (!(LB_CONN_FLAGS(data) & LB_CONN_REPLY) && vip->valid &&
+	    lb_backend_valid(vip, slot, LB_CONN_GEN(data)))
+		ste_dec_counter(lb_backend_addr(vip, slot) +
+				offsetof(struct lb_backend, conns), 1,
+				STE_MODE_64_BIT_CNTR_SIZE);
+}
+
+/* Checks 'count' connection rules from 'rule_id'. Returns the next rule to
+ * check, 0 at the end of the table. */
+static t_rule_id lb_conn_scan(t_rule_id rule_id, uint32_t count,
+			      uint8_t flush_vip)
+{
+	t_rule_id	next;
+	uint32_t	now;
+
+	now = lb_conn_clock();
+	while (count--) {
+		if (table_get_next_ruleid(TABLE_ACCEL_ID_CTLU, lb_table_id,
+					  rule_id, &next))
+			return 0;
+		lb_conn_check(next, flush_vip, now);
+		if (next == LB_LAST_RULE_ID)
+			return 0;
+		rule_id = next + 1;
+	}
+	return rule_id;
+}
+
+/* Periodic timer of the connection aging */
+static void lb_aging_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	UNUSED(arg1);
+	UNUSED(arg2);
+	/* Confirm that timer callback finished execution */
+	tman_timer_completion_confirmation(LW_SWAP(16,
+						   (uint32_t *)HWC_FD_ADDRESS));
+
+	lock_spinlock(&lb_aging_lock);
+	if (lb_aging_busy) {
+		unlock_spinlock(&lb_aging_lock);
+		return;
+	}
+	lb_aging_busy = 1;
+	unlock_spinlock(&lb_aging_lock);
+
+	lb_aging_rule_id = lb_conn_scan(lb_aging_rule_id, LB_AGING_BATCH,
+					LB_MAX_VIPS);
+
+	lock_spinlock(&lb_aging_lock);
+	lb_aging_busy = 0;
+	unlock_spinlock(&lb_aging_lock);
+}
+
+static __COLD_CODE int lb_vip_add(uint8_t vip_id, struct lb_vip_cfg *cfg)
+{
+	struct lb_vip	*vip;
+	int		err;
+
+	if (vip_id >= LB_MAX_VIPS || cfg->mode > LB_MODE_IPIP ||
+	    (cfg->protocol != LB_IP_PROTO_TCP &&
+	     cfg->protocol != LB_IP_PROTO_UDP) ||
+	    (cfg->ip_version != 4 && cfg->ip_version != 6))
+		return -EINVAL;
+	if (cfg->ip_version == 4)
+		cfg->addr[1] = cfg->addr[2] = cfg->addr[3] = 0;
+
+	vip = &lb_vips[vip_id];
+	cdma_mutex_lock_take(lb_tables_addr, CDMA_MUTEX_WRITE_LOCK);
+	if (vip->valid) {
+		err = -EEXIST;
+		goto out;
+	}
+	err = dpni_drv_get_primary_mac_addr(cfg->ni, vip->src_mac);
+	if (err)
+		goto out;
+
+	memset(&vip->cnt, 0, sizeof(vip->cnt));
+	vip->table_addr = lb_tables_addr + vip_id * LB_TABLE_STRIDE;
+	vip->backends_addr = lb_backends_addr +
+		vip_id * LB_MAX_BACKENDS * sizeof(struct lb_backend);
+	vip->rebuilds = 0;
+	memcpy(vip->addr, cfg->addr, sizeof(vip->addr));
+	vip->tunnel_src = cfg->tunnel_src;
+	vip->idle_timeout = (cfg->idle_timeout ? cfg->idle_timeout :
+			     LB_DEF_IDLE_TIMEOUT) * LB_USEC_PER_SEC;
+	vip->enabled = 0;
+	vip->port = cfg->port;
+	vip->ni = cfg->ni;
+	memcpy(vip->gw_mac, cfg->gw_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	vip->protocol = cfg->protocol;
+	vip->ip_version = cfg->ip_version;
+	vip->mode = cfg->mode;
+	lb_maglev_update(vip, 0);
+	vip->valid = 1;
+	fsl_print("%s : service %d added\n", AIOP_APP_NAME, vip_id);
+out:
+	cdma_mutex_lock_release(lb_tables_addr);
+	return err;
+}
+
+static __COLD_CODE int lb_vip_delete(uint8_t vip_id)
+{
+	struct lb_vip	*vip;
+	t_rule_id	rule_id;
+
+	if (vip_id >= LB_MAX_VIPS)
+		return -EINVAL;
+
+	vip = &lb_vips[vip_id];
+	cdma_mutex_lock_take(lb_tables_addr, CDMA_MUTEX_WRITE_LOCK);
+	if (!vip->valid) {
+		cdma_mutex_lock_release(lb_tables_addr);
+		return -ENOENT;
+	}
+	vip->valid = 0;
+	/* The frames that saw the service are done, no more connections are
+	 * created */
+	rcu_synchronize();
+	rule_id = 0;
+	do {
+		rule_id = lb_conn_scan(rule_id, LB_AGING_BATCH, vip_id);
+	} while (rule_id);
+	vip->enabled = 0;
+	cdma_mutex_lock_release(lb_tables_addr);
+	fsl_print("%s : service %d deleted\n", AIOP_APP_NAME, vip_id);
+	return 0;
+}
+
+static __COLD_CODE int lb_backend_add(uint8_t vip_id, uint8_t slot,
+				      struct lb_backend_cfg *cfg)
+{
+	struct lb_backend	b;
+	struct lb_vip		*vip;
+	int			err = 0;
+
+	if (vip_id >= LB_MAX_VIPS || slot >= LB_MAX_BACKENDS)
+		return -EINVAL;
+	if (cfg->ip_version == 4)
+		cfg->addr[1] = cfg->addr[2] = cfg->addr[3] = 0;
+
+	vip = &lb_vips[vip_id];
+	cdma_mutex_lock_take(lb_tables_addr, CDMA_MUTEX_WRITE_LOCK);
+	if (!vip->valid) {
+		err = -ENOENT;
+		goto out;
+	}
+	if (vip->enabled & LB_BACKEND_BIT(slot)) {
+		err = -EEXIST;
+		goto out;
+	}
+	/* Translated to the same IP version, tunneled in IPv4 */
+	if ((vip->mode == LB_MODE_NAT && cfg->ip_version != vip->ip_version) ||
+	    (vip->mode == LB_MODE_IPIP && cfg->ip_version != 4)) {
+		err = -EINVAL;
+		goto out;
+	}
+
+	memset(&b, 0, sizeof(b));
+	err = dpni_drv_get_primary_mac_addr(cfg->ni, b.src_mac);
+	if (err)
+		goto out;
+	b.cfg = *cfg;
+	/* Counter updates of a previous backend of the slot are done */
+	ste_barrier();
+	cdma_write(lb_backend_addr(vip, slot), &b, sizeof(b));
+	vip->gen[slot]++;
+	/* Enabled before the lookup table references it */
+	vip->enabled |= LB_BACKEND_BIT(slot);
+	lb_maglev_update(vip, vip->enabled);
+out:
+	cdma_mutex_lock_release(lb_tables_addr);
+	return err;
+}
+
+static __COLD_CODE int lb_backend_delete(uint8_t vip_id, uint8_t slot)
+{
+	struct lb_vip	*vip;
+	uint32_t	members;
+	int		err = 0;
+
+	if (vip_id >= LB_MAX_VIPS || slot >= LB_MAX_BACKENDS)
+		return -EINVAL;
+
+	vip = &lb_vips[vip_id];
+	cdma_mutex_lock_take(lb_tables_addr, CDMA_MUTEX_WRITE_LOCK);
+	if (!vip->valid || !(vip->enabled & LB_BACKEND_BIT(slot))) {
+		err = -ENOENT;
+		goto out;
+	}
+	/* Disabled once the lookup table doesn't reference it, its
+	 * connections are moved by their next frame */
+	members = vip->enabled & ~LB_BACKEND_BIT(slot);
+	lb_maglev_update(vip, members);
+	vip->enabled = members;
+	/* The frames sent to the backend are done: the slot may be reused */
+	rcu_synchronize();
+out:
+	cdma_mutex_lock_release(lb_tables_addr);
+	return err;
+}
+
+static __COLD_CODE int lb_get_stats(uint8_t vip_id, uint8_t slot,
+				    struct lb_stats *stats)
+{
+	struct lb_backend	b;
+	struct lb_vip		*vip;
+
+	if (vip_id >= LB_MAX_VIPS)
+		return -EINVAL;
+
+	vip = &lb_vips[vip_id];
+	if (!vip->valid)
+		return -ENOENT;
+
+	memset(stats, 0, sizeof(*stats));
+	stats->frames = (uint64_t)vip->cnt.frames;
+	stats->new_conns = (uint64_t)vip->cnt.new_conns;
+	stats->reselects = (uint64_t)vip->cnt.reselects;
+	stats->no_conn = (uint64_t)vip->cnt.no_conn;
+	stats->no_backend = (uint64_t)vip->cnt.no_backend;
+	stats->tx_errors = (uint64_t)vip->cnt.tx_errors;
+	stats->replies = (uint64_t)vip->cnt.replies;
+	stats->unmatched = (uint64_t)lb_unmatched;
+	stats->lookup_errors = (uint64_t)lb_lookup_errors;
+	stats->rebuilds = vip->rebuilds;
+	stats->rebuild_time = vip->rebuild_time;
+	stats->rebuild_changes = vip->rebuild_changes;
+	stats->backends = vip->enabled;
+	if (slot < LB_MAX_BACKENDS && (vip->enabled & LB_BACKEND_BIT(slot))) {
+		/* Wait for the pending counter updates */
+		ste_barrier();
+		cdma_read(&b, lb_backend_addr(vip, slot),
+			  offsetof(struct lb_backend, src_mac));
+		stats->backend_frames = b.frames;
+		stats->backend_bytes = b.bytes;
+		stats->backend_conns = b.conns;
+	}
+	return 0;
+}
+
+static int lb_open_cb(uint8_t instance_id, void **dev)
+{
+	UNUSED(instance_id);
+	UNUSED(dev);
+	return 0;
+}
+
+static int lb_close_cb(void *dev)
+{
+	UNUSED(dev);
+	return 0;
+}
+
+static __COLD_CODE int lb_ctrl_cb(void *dev, uint16_t cmd, uint32_t size,
+				  void *data)
+{
+	struct lb_cmd_data	*cmd_data = (struct lb_cmd_data *)data;
+	struct lb_vip_cfg	vip_cfg;
+	struct lb_backend_cfg	backend_cfg;
+	struct lb_stats		stats;
+	uint8_t			vip, backend;
+	int			err, i;
+
+	UNUSED(dev);
+
+	switch (cmd) {
+	case LB_CMD_VIP_ADD:
+		if (size < LB_CMDSZ_VIP_ADD)
+			return -EINVAL;
+		memset(&vip_cfg, 0, sizeof(vip_cfg));
+		LB_CMD_VIP_ADD_CMD(LB_CMD_READ);
+		return lb_vip_add(vip, &vip_cfg);
+	case LB_CMD_VIP_DEL:
+		LB_CMD_ID_CMD(LB_CMD_READ);
+		return lb_vip_delete(vip);
+	case LB_CMD_BACKEND_ADD:
+		if (size < LB_CMDSZ_BACKEND_ADD)
+			return -EINVAL;
+		memset(&backend_cfg, 0, sizeof(backend_cfg));
+		LB_CMD_BACKEND_ADD_CMD(LB_CMD_READ);
+		return lb_backend_add(vip, backend, &backend_cfg);
+	case LB_CMD_BACKEND_DEL:
+		LB_CMD_ID_CMD(LB_CMD_READ);
+		return lb_backend_delete(vip, backend);
+	case LB_CMD_GET_STATS:
+		if (size < LB_CMDSZ_GET_STATS)
+			return -EINVAL;
+		LB_CMD_ID_CMD(LB_CMD_READ);
+		err = lb_get_stats(vip, backend, &stats);
+		if (err)
+			return err;
+		for (i = 1; i < LB_CMD_NUM_OF_PARAMS; i++)
+			cmd_data->params[i] = 0;
+		LB_CMD_GET_STATS_RSP(LB_RSP_PREP);
+		fdma_modify_default_segment_data(0, LB_CMDSZ_GET_STATS);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int app_dpni_add_cb(uint8_t generator_id, uint8_t event_id,
+			   uint64_t app_ctx, void *event_data)
+{
+	struct dpkg_profile_cfg kg_cfg;
+	uint16_t		dpni_id, ni = (uint16_t)((uint32_t)event_data);
+	char			dpni_ep_type[16];
+	int			dpni_ep_id, err, link_state;
+	struct ep_init_presentation init_presentation;
+
+	UNUSED(generator_id);
+	UNUSED(event_id);
+
+	/* Get endpoint and skip DPNI-DPNI connection from app initialization */
+	err = dpni_drv_get_connected_obj(ni, &dpni_ep_id,
+					 dpni_ep_type, &link_state);
+	if (err) {
+		pr_err("Cannot get connected object for NI %d\n", ni);
+		return err;
+	}
+	if (strcmp(dpni_ep_type, "dpni") == 0)
+		return 0;
+
+	/* Configure frame processing callback */
+	err = dpni_drv_register_rx_cb(ni, (rx_cb_t *)app_ctx);
+	if (err) {
+		pr_err("Cannot configure processing callback on NI %d\n", ni);
+		return err;
+	}
+
+	/* Get DPNI ID for current Network Interface ID */
+	err = dpni_drv_get_dpni_id(ni, &dpni_id);
+	if (err) {
+		pr_err("Cannot get DPNI ID for NI %d\n", ni);
+		return err;
+	}
+
+	/* Default ordering mode should be Concurrent */
+	err = dpni_drv_set_concurrent(ni);
+	if (err) {
+		pr_err("Cannot set Concurrent Execution on NI %d\n", ni);
+		return err;
+	}
+
+	/* The frames of a connection are ordered */
+	app_fill_kg_profile(&kg_cfg);
+	err = dpni_drv_set_order_scope(ni, &kg_cfg);
+	if (err) {
+		pr_err("Cannot set order scope on NI %d\n", ni);
+		return err;
+	}
+
+	/* Set the initial segment presentation size */
+	err = dpni_drv_get_initial_presentation(ni, &init_presentation);
+	if (err) {
+		pr_err("Cannot get initial presentation for NI %d\n", ni);
+		return err;
+	}
+
+	init_presentation.options = EP_INIT_PRESENTATION_OPT_SPS;
+	init_presentation.sps = PRESENTATION_LENGTH;
+	err = dpni_drv_set_initial_presentation(ni, &init_presentation);
+	if (err) {
+		pr_err("Cannot set initial presentation for NI %d to %d\n",
+				ni, init_presentation.sps);
+		return err;
+	}
+
+	/* Enable DPNI to receive frames */
+	err = dpni_drv_enable(ni);
+	if (err) {
+		pr_err("Cannot enable NI %d for Rx/Tx\n", ni);
+		return err;
+	}
+
+	fsl_print("%s : Successfully configured ni%d (dpni.%d)\n",
+		  AIOP_APP_NAME, ni, dpni_id);
+	fsl_print("%s : dpni.%d <---connected---> %s.%d\n",
+		  AIOP_APP_NAME, dpni_id, dpni_ep_type, dpni_ep_id);
+	return 0;
+}
+
+/* Early initialization */
+int app_early_init(void)
+{
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		lb_mem_partition_id = MEM_PART_DP_DDR;
+	else
+		lb_mem_partition_id = MEM_PART_SYSTEM_DDR;
+	/* Aging timer */
+	return slab_register_context_buffer_requirements(COMMITTED_BUFFERS,
+							 MAXIMUM_BUFFERS,
+							 LB_TMI_SIZE,
+							 BUFFERS_ALIGNMENT,
+							 lb_mem_partition_id,
+							 0, 0);
+}
+
+static __COLD_CODE int lb_conn_table_init(void)
+{
+	struct table_create_params tbl_params;
+	struct table_rule	rule __attribute__((aligned(16)));
+	struct lb_conn_key	*key;
+	int			err;
+
+	tbl_params.committed_rules = LB_MAX_RULES;
+	tbl_params.max_rules = LB_MAX_RULES;
+	tbl_params.attributes = TABLE_ATTRIBUTE_TYPE_EM |
+			TABLE_ATTRIBUTE_LOCATION_SYS_DDR |
+			TABLE_ATTRIBUTE_MR_NO_MISS;
+	tbl_params.timestamp_accuracy = 1;
+	tbl_params.key_size = sizeof(struct lb_conn_key);
+	err = table_create(TABLE_ACCEL_ID_CTLU, &tbl_params, &lb_table_id);
+	if (err != TABLE_STATUS_SUCCESS) {
+		pr_err("Cannot create the connection table\n");
+		return -ENOMEM;
+	}
+
+	memset(&rule, 0, sizeof(rule));
+	key = (struct lb_conn_key *)rule.key_desc.em.key;
+	key->ip_version = LB_CLOCK_KEY;
+	rule.options = TABLE_RULE_TIMESTAMP_ENABLE;
+	rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
+	err = table_rule_create(TABLE_ACCEL_ID_CTLU, lb_table_id, &rule,
+				sizeof(*key), &lb_clock_rule_id);
+	if (err) {
+		pr_err("Cannot create the clock rule\n");
+		return err;
+	}
+	return 0;
+}
+
+/* Initializes the application */
+int app_init(void)
+{
+	struct cmdif_module_ops	ops;
+	struct slab		*slab_handle = NULL;
+	uint64_t		tmi_addr = 0;
+	int			err;
+
+	err = fsl_get_mem(LB_MAX_VIPS * LB_TABLE_STRIDE, lb_mem_partition_id,
+			  64, &lb_tables_addr);
+	if (!err)
+		err = fsl_get_mem(LB_MAX_VIPS * LB_MAX_BACKENDS *
+				  sizeof(struct lb_backend),
+				  lb_mem_partition_id, 64, &lb_backends_addr);
+	if (err) {
+		pr_err("Cannot allocate the lookup tables\n");
+		return err;
+	}
+	lb_table_build = (uint8_t *)fsl_malloc(LB_MAGLEV_SIZE, 64);
+	if (!lb_table_build) {
+		pr_err("Cannot allocate the lookup table buffer\n");
+		return -ENOMEM;
+	}
+
+	err = lb_conn_table_init();
+	if (err)
+		return err;
+
+	err = slab_create(COMMITTED_BUFFERS, MAXIMUM_BUFFERS, LB_TMI_SIZE,
+			  BUFFERS_ALIGNMENT, lb_mem_partition_id, 0, NULL,
+			  &slab_handle);
+	if (err) {
+		pr_err("slab_create failed\n");
+		return err;
+	}
+	err = slab_acquire(slab_handle, &tmi_addr);
+	if (err) {
+		pr_err("slab_acquire failed\n");
+		return err;
+	}
+	err = tman_create_tmi(tmi_addr, LB_NUM_TIMERS, &lb_tmi_id);
+	if (err) {
+		pr_err("tman_create_tmi failed\n");
+		return err;
+	}
+	err = tman_create_timer(lb_tmi_id, TMAN_CREATE_TIMER_MODE_TPRI |
+				TMAN_CREATE_TIMER_MODE_10_MSEC_GRANULARITY,
+				LB_AGING_PERIOD, 0, 0, lb_aging_cb,
+				&lb_timer_handle);
+	if (err) {
+		pr_err("Cannot create the aging timer\n");
+		return err;
+	}
+
+	ops.open_cb = (open_cb_t *)lb_open_cb;
+	ops.close_cb = (close_cb_t *)lb_close_cb;
+	ops.ctrl_cb = (ctrl_cb_t *)lb_ctrl_cb;
+	err = cmdif_register_module(LB_MODULE_NAME, &ops);
+	if (err) {
+		pr_err("Cannot register %s cmdif module\n", LB_MODULE_NAME);
+		return err;
+	}
+
+	err = evmng_register(EVMNG_GENERATOR_AIOPSL, DPNI_EVENT_ADDED, 1,
+			     (uint64_t) app_l4_lb, app_dpni_add_cb);
+	if (err) {
+		pr_err("Cannot register DPNI ADD event\n");
+		return err;
+	}
+
+	return 0;
+}
+
+/* Frees application allocated resources */
+void app_free(void)
+{}
+
+static void app_fill_kg_profile(struct dpkg_profile_cfg *kg_cfg)
+{
+	/* Configure Initial Order Scope */
+	memset(kg_cfg, 0x0, sizeof(struct dpkg_profile_cfg));
+
+	kg_cfg->num_extracts = 5;
+	/* IP_SRC */
+	kg_cfg->extracts[0].type = DPKG_EXTRACT_FROM_HDR;
+	kg_cfg->extracts[0].extract.from_hdr.prot = NET_PROT_IP;
+	kg_cfg->extracts[0].extract.from_hdr.type = DPKG_FULL_FIELD;
+	kg_cfg->extracts[0].extract.from_hdr.field = NET_HDR_FLD_IP_SRC;
+	/* IP_DST */
+	kg_cfg->extracts[1].type = DPKG_EXTRACT_FROM_HDR;
+	kg_cfg->extracts[1].extract.from_hdr.prot = NET_PROT_IP;
+	kg_cfg->extracts[1].extract.from_hdr.type = DPKG_FULL_FIELD;
+	kg_cfg->extracts[1].extract.from_hdr.field = NET_HDR_FLD_IP_DST;
+	/* PROTO */
+	kg_cfg->extracts[2].type = DPKG_EXTRACT_FROM_HDR;
+	kg_cfg->extracts[2].extract.from_hdr.prot = NET_PROT_IP;
+	kg_cfg->extracts[2].extract.from_hdr.type = DPKG_FULL_FIELD;
+	kg_cfg->extracts[2].extract.from_hdr.field = NET_HDR_FLD_IP_PROTO;
+	/* L4 SRC PORT */
+	kg_cfg->extracts[3].type = DPKG_EXTRACT_FROM_HDR;
+	kg_cfg->extracts[3].extract.from_hdr.prot = NET_PROT_TCP;
+	kg_cfg->extracts[3].extract.from_hdr.type = DPKG_FULL_FIELD;
+	kg_cfg->extracts[3].extract.from_hdr.field = NH_FLD_L4_PORT_SRC;
+	/* L4 DST PORT */
+	kg_cfg->extracts[4].type = DPKG_EXTRACT_FROM_HDR;
+	kg_cfg->extracts[4].extract.from_hdr.prot = NET_PROT_TCP;
+	kg_cfg->extracts[4].extract.from_hdr.type = DPKG_FULL_FIELD;
+	kg_cfg->extracts[4].extract.from_hdr.field = NH_FLD_L4_PORT_DST;
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright 2014-2015 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __L4_LB_H
+#define __L4_LB_H
+
+#include "common/fsl_string.h"
+#include "fsl_sys.h"
+#include "apps.h"
+
+/* Functions prototype */
+int app_init(void);
+int app_early_init(void);
+void app_free(void);
+
+void build_apps_array(struct sys_module_desc *apps);
+
+/*
+ * Load balancer commands between GPP (client) and AIOP (server).
+ * The commands are sent on the LB_MODULE_NAME cmdif module.
+ */
+#define LB_MODULE_NAME		"L4LB"
+
+#define LB_MAX_VIPS		8	/* Number of virtual services */
+#define LB_MAX_BACKENDS		32	/* Backends of a virtual service */
+#define LB_MAX_CONNS		8192	/* Connections of all the services */
+
+/* Forwarding modes */
+#define LB_MODE_NAT		0	/* Destination NAT, reverse NAT of
+					 * the replies */
+#define LB_MODE_IPIP		1	/* IPv4 tunnel to the backend, the
+					 * backend replies directly */
+
+#define LB_CMD_NUM_OF_PARAMS	16
+
+struct lb_cmd_data {
+	uint64_t params[LB_CMD_NUM_OF_PARAMS];
+};
+
+/* lb_cmds */
+#define LB_CMD_VIP_ADD		0
+#define LB_CMD_VIP_DEL		1
+#define LB_CMD_BACKEND_ADD	2
+#define LB_CMD_BACKEND_DEL	3
+#define LB_CMD_GET_STATS	4
+
+/* cmd sizes */
+#define LB_CMDSZ_VIP_ADD	(5*8)
+#define LB_CMDSZ_VIP_DEL	8
+#define LB_CMDSZ_BACKEND_ADD	(4*8)
+#define LB_CMDSZ_BACKEND_DEL	8
+#define LB_CMDSZ_GET_STATS	(LB_CMD_NUM_OF_PARAMS*8)
+
+/*
+ * LB_CMD_VIP_ADD
+ * Virtual service 'vip' (0 to LB_MAX_VIPS - 1) receives the TCP or UDP
+ * ('protocol') frames sent to 'addr':'port'. IPv4 addresses are given in
+ * addr[0]. The replies of the backends (LB_MODE_NAT) are sent on NI 'ni',
+ * to 'gw_mac'. 'tunnel_src' is the source address of the LB_MODE_IPIP
+ * tunnels. A connection is forgotten after 'idle_timeout' seconds without
+ * frames (0 for 60 seconds).
+ */
+/*	param, offset, width,	type,			arg_name */
+#define LB_CMD_VIP_ADD_CMD(_OP) \
+do { \
+	_OP(0, 0,	8,	uint8_t,		vip); \
+	_OP(0, 8,	8,	uint8_t,		vip_cfg.protocol); \
+	_OP(0, 16,	8,	uint8_t,		vip_cfg.ip_version); \
+	_OP(0, 24,	8,	uint8_t,		vip_cfg.mode); \
+	_OP(0, 32,	16,	uint16_t,		vip_cfg.port); \
+	_OP(0, 48,	16,	uint16_t,		vip_cfg.ni); \
+	_OP(1, 0,	32,	uint32_t,		vip_cfg.addr[0]); \
+	_OP(1, 32,	32,	uint32_t,		vip_cfg.addr[1]); \
+	_OP(2, 0,	32,	uint32_t,		vip_cfg.addr[2]); \
+	_OP(2, 32,	32,	uint32_t,		vip_cfg.addr[3]); \
+	_OP(3, 0,	32,	uint32_t,		vip_cfg.tunnel_src); \
+	_OP(3, 32,	32,	uint32_t,		vip_cfg.idle_timeout); \
+	_OP(4, 0,	8,	uint8_t,		vip_cfg.gw_mac[0]); \
+	_OP(4, 8,	8,	uint8_t,		vip_cfg.gw_mac[1]); \
+	_OP(4, 16,	8,	uint8_t,		vip_cfg.gw_mac[2]); \
+	_OP(4, 24,	8,	uint8_t,		vip_cfg.gw_mac[3]); \
+	_OP(4, 32,	8,	uint8_t,		vip_cfg.gw_mac[4]); \
+	_OP(4, 40,	8,	uint8_t,		vip_cfg.gw_mac[5]); \
+} while (0)
+
+/*
+ * LB_CMD_BACKEND_ADD
+ * Backend 'backend' (0 to LB_MAX_BACKENDS - 1) of virtual service 'vip' is
+ * reached on NI 'ni', through 'dst_mac'. In LB_MODE_NAT mode the frames are
+ * translated to 'addr':'port' (same IP version as the service); in
+ * LB_MODE_IPIP mode they are tunneled to the IPv4 address 'addr'.
+ */
+/*	param, offset, width,	type,			arg_name */
+#define LB_CMD_BACKEND_ADD_CMD(_OP) \
+do { \
+	_OP(0, 0,	8,	uint8_t,		vip); \
+	_OP(0, 8,	8,	uint8_t,		backend); \
+	_OP(0, 16,	8,	uint8_t,		backend_cfg.ip_version); \
+	_OP(0, 32,	16,	uint16_t,		backend_cfg.port); \
+	_OP(0, 48,	16,	uint16_t,		backend_cfg.ni); \
+	_OP(1, 0,	32,	uint32_t,		backend_cfg.addr[0]); \
+	_OP(1, 32,	32,	uint32_t,		backend_cfg.addr[1]); \
+	_OP(2, 0,	32,	uint32_t,		backend_cfg.addr[2]); \
+	_OP(2, 32,	32,	uint32_t,		backend_cfg.addr[3]); \
+	_OP(3, 0,	8,	uint8_t,		backend_cfg.dst_mac[0]); \
+	_OP(3, 8,	8,	uint8_t,		backend_cfg.dst_mac[1]); \
+	_OP(3, 16,	8,	uint8_t,		backend_cfg.dst_mac[2]); \
+	_OP(3, 24,	8,	uint8_t,		backend_cfg.dst_mac[3]); \
+	_OP(3, 32,	8,	uint8_t,		backend_cfg.dst_mac[4]); \
+	_OP(3, 40,	8,	uint8_t,		backend_cfg.dst_mac[5]); \
+} while (0)
+
+/* LB_CMD_VIP_DEL, LB_CMD_BACKEND_DEL and LB_CMD_GET_STATS */
+/*	param, offset, width,	type,			arg_name */
+#define LB_CMD_ID_CMD(_OP) \
+do { \
+	_OP(0, 0,	8,	uint8_t,		vip); \
+	_OP(0, 8,	8,	uint8_t,		backend); \
+} while (0)
+
+/*
+ * LB_CMD_GET_STATS response
+ * Counters of the virtual service and of one of its backends. 'rebuild_time'
+ * (microseconds) and 'rebuild_changes' (lookup table entries written) are
+ * those of the last rebuild of the lookup table of the service.
+ * 'unmatched' and 'lookup_errors' (frames dropped on a failed connection
+ * table lookup) are not per service.
+ */
+/*	param, offset, width,	type,			arg_name */
+#define LB_CMD_GET_STATS_RSP(_OP) \
+do { \
+	_OP(1, 0,	64,	uint64_t,		stats.frames); \
+	_OP(2, 0,	64,	uint64_t,		stats.new_conns); \
+	_OP(3, 0,	64,	uint64_t,		stats.reselects); \
+	_OP(4, 0,	64,	uint64_t,		stats.no_conn); \
+	_OP(5, 0,	64,	uint64_t,		stats.no_backend); \
+	_OP(6, 0,	64,	uint64_t,		stats.tx_errors); \
+	_OP(7, 0,	64,	uint64_t,		stats.replies); \
+	_OP(8, 0,	64,	uint64_t,		stats.unmatched); \
+	_OP(9, 0,	64,	uint64_t,		stats.rebuilds); \
+	_OP(10, 0,	32,	uint32_t,		stats.rebuild_time); \
+	_OP(10, 32,	32,	uint32_t,		stats.rebuild_changes); \
+	_OP(11, 0,	32,	uint32_t,		stats.backends); \
+	_OP(12, 0,	64,	uint64_t,		stats.backend_frames); \
+	_OP(13, 0,	64,	uint64_t,		stats.backend_bytes); \
+	_OP(14, 0,	64,	uint64_t,		stats.backend_conns); \
+	_OP(15, 0,	64,	uint64_t,		stats.lookup_errors); \
+} while (0)
+
+#endif /* __L4_LB_H */
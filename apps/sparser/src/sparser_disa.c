@@ -3139,7 +3139,7 @@ static __COLD_CODE void sp_case3_dc_wr_to_wr(uint16_t **sp_code)
 			fsl_print("\t\t WR0[48:63](%04x) == WR1[16:31](%04x)\n",
 				  (uint16_t)sp_sim.wr[0],
 				  (uint16_t)(sp_sim.wr[1] >> 32));
-			set_jmp_gosub_destination(sp_code, jmp_dest2,
+			set_jmp_gosub_destination(sp_code, jmp_dest1,
 						  a1, g1, l1, 4);
 		} else {
 			fsl_print("\t\t WR0[48:63](%04x) != WR1[48:63](%04x)\n",
@@ -0,0 +1,883 @@
+/*
+ * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "fsl_types.h"
+#include "fsl_stdio.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_ip.h"
+#include "fsl_parser.h"
+#include "fsl_fdma.h"
+#include "fsl_frame_operations.h"
+#include "fsl_net.h"
+#include "fsl_dbg.h"
+#include "fsl_evmng.h"
+#include "fsl_stdlib.h"
+#include "fsl_spinlock.h"
+#include "fsl_malloc.h"
+#include "fsl_slab.h"
+#include "fsl_tman.h"
+#include "fsl_fd_batch.h"
+#include "fsl_cmdif_server.h"
+#include "fsl_mc_sys.h"
+#include "fsl_mc_cmd.h"
+#include "traffic_gen.h"
+
+#define AIOP_APP_NAME		"TRAFFIC_GEN"
+
+/*
+ * The application only looks at the headers of the looped back frames
+ * (Ethernet, IPv4, UDP and the generator header: 62 bytes).
+ */
+#define PRESENTATION_LENGTH	64
+
+/* Generator header magic ("TGN1") */
+#define TG_MAGIC		0x54474E31
+/* Frame sizes, without FCS */
+#define TG_MIN_FRAME_SIZE	((uint16_t)sizeof(struct tg_frame_hdr))
+#define TG_MAX_FRAME_SIZE	1514
+/* FCS, preamble, start of frame delimiter and inter frame gap bytes */
+#define TG_WIRE_OVERHEAD	24
+/* Number of frame templates of a stream, one per frame size */
+#define TG_MAX_TEMPLATES	4
+/* Size of the zeroed data appended to the headers of a template */
+#define TG_PAD_CHUNK		64
+
+/* Default and allowed timer periods (microseconds). The TMAN timer duration
+ * must be larger than 10 ticks. */
+#define TG_DEF_PERIOD		100
+#define TG_MIN_PERIOD		11
+#define TG_MAX_PERIOD		0xFFFF
+/* Default number of frames sent on each timer expiration */
+#define TG_DEF_BURST		32
+/* Time accounted for a timer expiration, at most (microseconds). Bounds the
+ * credits after a long stall. */
+#define TG_MAX_ELAPSED		1000000
+#define TG_USEC_PER_SEC		1000000ULL
+
+/* The number of created timers should be 3 timers larger than actually
+ * needed and larger than 4. The memory region used to hold the timers must be
+ * of at least 64 * (num_of_timers + 1) bytes, and 64 bytes aligned. */
+#define TG_NUM_TIMERS		(TG_MAX_STREAMS + 3)
+#define TG_TMI_SIZE		(64 * (TG_NUM_TIMERS + 1))
+#define COMMITTED_BUFFERS	1
+#define MAXIMUM_BUFFERS		1
+#define BUFFERS_ALIGNMENT	64
+
+/* Stream states */
+#define TG_STATE_IDLE		0	/* Not configured */
+#define TG_STATE_CONFIGURED	1
+#define TG_STATE_RUNNING	2
+#define TG_STATE_STOPPING	3	/* Stop requested, timer still running */
+#define TG_STATE_STOPPED	4
+
+#define TG_CMD_READ(_param, _offset, _width, _type, _arg) \
+	_arg = (_type)mc_dec(cmd_data->params[_param], _offset, _width);
+
+#define TG_RSP_PREP(_param, _offset, _width, _type, _arg) \
+	cmd_data->params[_param] |= mc_enc(_offset, _width, _arg);
+
+/* Generator header, at the start of the UDP payload */
+#pragma pack(push, 1)
+struct tg_hdr {
+	uint32_t	magic;
+	uint16_t	stream;
+	uint16_t	res;
+	uint32_t	seq;
+	/* TMAN timestamp (microseconds) of the transmission */
+	uint32_t	ts_hi;
+	uint32_t	ts_lo;
+};
+
+struct tg_frame_hdr {
+	struct ethernethdr	eth;
+	struct ipv4hdr		ip;
+	struct udphdr		udp;
+	struct tg_hdr		tg;
+};
+#pragma pack(pop)
+
+struct tg_cfg {
+	uint64_t	pps;
+	uint64_t	bps;
+	uint64_t	count;
+	uint32_t	period;
+	uint32_t	src_ip;
+	uint32_t	dst_ip;
+	uint16_t	ni;
+	uint16_t	burst;
+	uint16_t	src_ip_count;
+	uint16_t	dst_ip_count;
+	uint16_t	src_port;
+	uint16_t	dst_port;
+	uint16_t	src_port_count;
+	uint16_t	dst_port_count;
+	uint16_t	min_size;
+	uint16_t	max_size;
+	uint8_t		tc;
+	uint8_t		dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t		src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+};
+
+/* Counters updated by the timer and Rx tasks */
+struct tg_counters {
+	int64_t		tx_frames;
+	int64_t		tx_bytes;
+	int64_t		tx_drops;
+	int64_t		rx_frames;
+	int64_t		rx_bytes;
+	int64_t		lat_sum;
+	int64_t		lat_hist[TG_LAT_BUCKETS];
+	uint32_t	lat_min;
+	uint32_t	lat_max;
+};
+
+/* Statistics reported by TG_CMD_GET_STATS */
+struct tg_stats {
+	uint64_t	tx_frames;
+	uint64_t	tx_bytes;
+	uint64_t	tx_drops;
+	uint64_t	rx_frames;
+	uint64_t	rx_bytes;
+	uint64_t	elapsed;
+	uint64_t	tx_bps;
+	uint64_t	rx_bps;
+	uint32_t	tx_pps;
+	uint32_t	rx_pps;
+	uint32_t	lat_min;
+	uint32_t	lat_max;
+	uint32_t	lat_avg;
+	uint32_t	lat_hist[TG_LAT_BUCKETS];
+};
+
+struct tg_stream {
+	/* Template frames, never stored back to memory after they are built
+	 * except with the same data size */
+	struct ldpaa_fd		tmpl_fd[TG_MAX_TEMPLATES];
+	uint64_t		lock;
+	struct tg_cfg		cfg;
+	struct tg_counters	cnt;
+	uint64_t		start_ts;
+	uint64_t		stop_ts;
+	/* Following fields are owned by the running timer task (busy) */
+	uint64_t		last_ts;
+	uint64_t		pkt_credit;	/* Frames * 10^6 */
+	uint64_t		bit_credit;	/* Bits * 10^6 */
+	uint64_t		sent;
+	uint32_t		timer_handle;
+	uint32_t		seq;
+	uint16_t		tmpl_size[TG_MAX_TEMPLATES];
+	uint16_t		src_ip_idx;
+	uint16_t		dst_ip_idx;
+	uint16_t		src_port_idx;
+	uint16_t		dst_port_idx;
+	uint16_t		spid;
+	uint8_t			num_tmpl;
+	uint8_t			state;
+	uint8_t			busy;
+};
+
+static struct tg_stream	tg_streams[TG_MAX_STREAMS]
+					__attribute__((aligned(32)));
+static enum memory_partition_id	tg_mem_partition_id;
+static uint8_t			tg_tmi_id;
+
+static inline uint16_t tg_ipv4_cksum(const struct ipv4hdr *ip)
+{
+	const uint16_t	*w = (const uint16_t *)ip;
+	uint32_t	sum = 0;
+	int		i;
+
+	for (i = 0; i < (int)(sizeof(struct ipv4hdr) / 2); i++)
+		sum += w[i];
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	sum = (sum & 0xFFFF) + (sum >> 16);
+	return (uint16_t)~sum;
+}
+
+/* Bucket of a latency: i for [2^(i-1), 2^i) */
+static inline int tg_lat_bucket(uint32_t lat)
+{
+	int	i = 0;
+
+	while (lat && i < TG_LAT_BUCKETS - 1) {
+		lat >>= 1;
+		i++;
+	}
+	return i;
+}
+
+static __COLD_CODE void tg_fill_hdr(struct tg_stream *s,
+				    struct tg_frame_hdr *hdr, uint16_t size)
+{
+	memset(hdr, 0, sizeof(*hdr));
+	memcpy(hdr->eth.dst_addr, s->cfg.dst_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	memcpy(hdr->eth.src_addr, s->cfg.src_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	hdr->eth.ether_type = NET_ETH_ETYPE_IPV4;
+	hdr->ip.vsn_and_ihl = 0x45;
+	hdr->ip.total_length = (uint16_t)(size - sizeof(struct ethernethdr));
+	hdr->ip.flags_and_offset = 0x4000;	/* Don't fragment */
+	hdr->ip.ttl = 64;
+	hdr->ip.protocol = 17;			/* UDP */
+	hdr->udp.length = (uint16_t)(hdr->ip.total_length -
+				     sizeof(struct ipv4hdr));
+	/* No UDP checksum */
+	hdr->tg.magic = TG_MAGIC;
+	hdr->tg.stream = (uint16_t)(s - tg_streams);
+}
+
+/* Builds the templates of a stream: the headers and a zeroed payload */
+static __COLD_CODE int tg_build_templates(struct tg_stream *s)
+{
+	struct tg_frame_hdr	hdr __attribute__((aligned(8)));
+	uint8_t			pad[TG_PAD_CHUNK] __attribute__((aligned(8)));
+	uint16_t		len, chunk;
+	uint8_t			frame_handle;
+	int			t, err;
+
+	memset(pad, 0, sizeof(pad));
+	for (t = 0; t < TG_MAX_TEMPLATES && s->tmpl_size[t]; t++) {
+		/* The frame is created with the IP and UDP lengths of the
+		 * headers alone, so that it parses */
+		tg_fill_hdr(s, &hdr, sizeof(hdr));
+		err = ARCH_CREATE_FRAME((struct ldpaa_fd *)HWC_FD_ADDRESS,
+					&hdr, sizeof(hdr), (uint8_t)s->spid,
+					&frame_handle);
+		if (err) {
+			/* The frame is created unless the pool is empty */
+			if (err != -ENOMEM)
+				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+			return err;
+		}
+		/* Each chunk is inserted right after the headers: the
+		 * payload is all zeros */
+		for (len = sizeof(hdr); len < s->tmpl_size[t]; len += chunk) {
+			chunk = (uint16_t)MIN(TG_PAD_CHUNK,
+					      s->tmpl_size[t] - len);
+			fdma_insert_default_segment_data(sizeof(hdr), pad,
+							 chunk,
+							 FDMA_REPLACE_NO_FLAGS);
+		}
+		tg_fill_hdr(s, (struct tg_frame_hdr *)PRC_GET_SEGMENT_ADDRESS(),
+			    s->tmpl_size[t]);
+		fdma_modify_default_segment_data(0, sizeof(hdr));
+		err = fdma_store_default_frame_data();
+		if (err) {
+			fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+			return err;
+		}
+		s->tmpl_fd[t] = *((struct ldpaa_fd *)HWC_FD_ADDRESS);
+		s->num_tmpl++;
+	}
+	return 0;
+}
+
+/* Ends the run of a stream. Called by the timer task. */
+static __COLD_CODE void tg_stream_stop(struct tg_stream *s, uint64_t now)
+{
+	struct ldpaa_fd	fd __attribute__((aligned(sizeof(struct ldpaa_fd))));
+	int		err;
+
+	err = tman_delete_timer(s->timer_handle,
+				TMAN_TIMER_DELETE_MODE_WO_EXPIRATION);
+	if (err)
+		pr_err("Cannot delete the timer of stream %d\n",
+		       (int)(s - tg_streams));
+	while (s->num_tmpl) {
+		s->num_tmpl--;
+		fd = s->tmpl_fd[s->num_tmpl];
+		ARCH_FDMA_DISCARD_FD(&fd);
+	}
+
+	lock_spinlock(&s->lock);
+	s->stop_ts = now;
+	s->state = TG_STATE_STOPPED;
+	unlock_spinlock(&s->lock);
+
+	fsl_print("%s : stream %d stopped, %ll frames sent\n", AIOP_APP_NAME,
+		  (int)(s - tg_streams), (uint64_t)s->cnt.tx_frames);
+}
+
+/* Number of frames allowed by the target rates, at most 'burst' */
+static inline uint16_t tg_credit(struct tg_stream *s, uint64_t now,
+				 uint32_t wire_bits)
+{
+	uint64_t	elapsed, cap, n;
+
+	elapsed = now - s->last_ts;
+	s->last_ts = now;
+	if (elapsed > TG_MAX_ELAPSED)
+		elapsed = TG_MAX_ELAPSED;
+
+	n = s->cfg.burst;
+	if (s->cfg.pps) {
+		cap = n * TG_USEC_PER_SEC;
+		s->pkt_credit += elapsed * s->cfg.pps;
+		if (s->pkt_credit > cap)
+			s->pkt_credit = cap;
+		n = MIN(n, s->pkt_credit / TG_USEC_PER_SEC);
+	}
+	if (s->cfg.bps) {
+		cap = (uint64_t)s->cfg.burst *
+			((s->cfg.max_size + TG_WIRE_OVERHEAD) * 8) *
+			TG_USEC_PER_SEC;
+		s->bit_credit += elapsed * s->cfg.bps;
+		if (s->bit_credit > cap)
+			s->bit_credit = cap;
+		n = MIN(n, s->bit_credit / (wire_bits * TG_USEC_PER_SEC));
+	}
+	if (s->cfg.count)
+		n = MIN(n, s->cfg.count - s->sent);
+	return (uint16_t)n;
+}
+
+/* Sends n frames of template t. Each frame is a copy of the template with
+ * its own addresses, ports, sequence number and timestamp. */
+static inline void tg_send_burst(struct tg_stream *s, int t, uint16_t n)
+{
+	struct fdma_queueing_destination_params	qd_params;
+	struct tg_frame_hdr	hdr __attribute__((aligned(8)));
+	struct fd_batch		batch;
+	uint64_t		ts;
+	uint16_t		i, sent;
+
+	/* Open the template as the default frame and present its headers */
+	*((struct ldpaa_fd *)HWC_FD_ADDRESS) = s->tmpl_fd[t];
+	fdma_present_default_frame_without_segments();
+	fdma_present_default_frame_segment(FDMA_PRES_NO_FLAGS, &hdr, 0,
+					   sizeof(hdr));
+	task_set_tx_tc(s->cfg.tc);
+	dpni_send_prepare(s->cfg.ni, &qd_params);
+	fd_batch_init(&batch, FD_BATCH_NO_FLAGS);
+
+	for (i = 0; i < n; i++) {
+		hdr.ip.src_addr = s->cfg.src_ip + s->src_ip_idx;
+		hdr.ip.dst_addr = s->cfg.dst_ip + s->dst_ip_idx;
+		hdr.ip.id = (uint16_t)s->seq;
+		hdr.ip.hdr_cksum = 0;
+		hdr.ip.hdr_cksum = tg_ipv4_cksum(&hdr.ip);
+		hdr.udp.src_port = (uint16_t)(s->cfg.src_port +
+					      s->src_port_idx);
+		hdr.udp.dst_port = (uint16_t)(s->cfg.dst_port +
+					      s->dst_port_idx);
+		hdr.tg.seq = s->seq++;
+		tman_get_timestamp(&ts);
+		hdr.tg.ts_hi = (uint32_t)(ts >> 32);
+		hdr.tg.ts_lo = (uint32_t)ts;
+
+		if (++s->src_ip_idx == s->cfg.src_ip_count)
+			s->src_ip_idx = 0;
+		if (++s->dst_ip_idx == s->cfg.dst_ip_count)
+			s->dst_ip_idx = 0;
+		if (++s->src_port_idx == s->cfg.src_port_count)
+			s->src_port_idx = 0;
+		if (++s->dst_port_idx == s->cfg.dst_port_count)
+			s->dst_port_idx = 0;
+
+		fdma_modify_default_segment_data(0, sizeof(hdr));
+		/* The SPID of the stream was set by the expiration prolog */
+		fd_batch_replicate_default_frame(&batch, &qd_params);
+	}
+	/* Same data size: the template is updated in place */
+	fdma_store_default_frame_data();
+	s->tmpl_fd[t] = *((struct ldpaa_fd *)HWC_FD_ADDRESS);
+
+	s->sent += n;
+	sent = (uint16_t)(n - batch.drops);
+	atomic_incr64(&s->cnt.tx_frames, sent);
+	atomic_incr64(&s->cnt.tx_bytes, (int64_t)sent * s->tmpl_size[t]);
+	if (batch.drops)
+		atomic_incr64(&s->cnt.tx_drops, batch.drops);
+}
+
+/* Periodic timer of a running stream */
+static void tg_timer_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	struct tg_stream	*s = &tg_streams[(uint32_t)arg1];
+	uint64_t		now;
+	uint32_t		wire_bits;
+	uint16_t		n;
+	uint8_t			state;
+	int			t;
+
+	UNUSED(arg2);
+	/* Confirm that timer callback finished execution */
+	tman_timer_completion_confirmation(LW_SWAP(16,
+						   (uint32_t *)HWC_FD_ADDRESS));
+
+	lock_spinlock(&s->lock);
+	state = s->state;
+	/* Skip the expiration if the previous one is still sending, the
+	 * credits of the skipped period are granted to the next one */
+	if (s->busy || (state != TG_STATE_RUNNING &&
+			state != TG_STATE_STOPPING)) {
+		unlock_spinlock(&s->lock);
+		return;
+	}
+	s->busy = 1;
+	unlock_spinlock(&s->lock);
+
+	sl_tman_expiration_task_prolog(s->spid);
+	tman_get_timestamp(&now);
+
+	if (!s->num_tmpl && state == TG_STATE_RUNNING) {
+		if (tg_build_templates(s)) {
+			pr_err("Cannot build the frames of stream %d\n",
+			       (int)arg1);
+			state = TG_STATE_STOPPING;
+		}
+		/* Credits are counted from the first sent frame */
+		s->last_ts = now;
+	}
+
+	if (state == TG_STATE_STOPPING ||
+	    (s->cfg.count && s->sent >= s->cfg.count)) {
+		tg_stream_stop(s, now);
+	} else {
+		/* The frame size is chosen for each burst */
+		t = (s->num_tmpl > 1) ? (int)(fsl_rand() % s->num_tmpl) : 0;
+		wire_bits = (uint32_t)(s->tmpl_size[t] + TG_WIRE_OVERHEAD) * 8;
+		n = tg_credit(s, now, wire_bits);
+		if (n) {
+			tg_send_burst(s, t, n);
+			if (s->cfg.pps)
+				s->pkt_credit -= n * TG_USEC_PER_SEC;
+			if (s->cfg.bps)
+				s->bit_credit -= (uint64_t)n * wire_bits *
+					TG_USEC_PER_SEC;
+		}
+	}
+
+	lock_spinlock(&s->lock);
+	s->busy = 0;
+	unlock_spinlock(&s->lock);
+}
+
+/* Processes the looped back frames */
+__HOT_CODE ENTRY_POINT void app_traffic_gen_rx(void)
+{
+	struct tg_hdr		*tg;
+	struct tg_counters	*cnt;
+	uint64_t		now, ts;
+	uint32_t		lat;
+	uint16_t		offset;
+
+	sl_prolog();
+
+	if (PARSER_IS_OUTER_IPV4_DEFAULT() && PARSER_IS_UDP_DEFAULT()) {
+		offset = (uint16_t)(PARSER_GET_L4_OFFSET_DEFAULT() +
+				    sizeof(struct udphdr));
+		tg = (struct tg_hdr *)(PRC_GET_SEGMENT_ADDRESS() + offset);
+		if (offset + sizeof(struct tg_hdr) <= PRC_GET_SEGMENT_LENGTH() &&
+		    tg->magic == TG_MAGIC && tg->stream < TG_MAX_STREAMS) {
+			tman_get_timestamp(&now);
+			ts = ((uint64_t)tg->ts_hi << 32) | tg->ts_lo;
+			lat = (uint32_t)(now - ts);
+			cnt = &tg_streams[tg->stream].cnt;
+			atomic_incr64(&cnt->rx_frames, 1);
+			atomic_incr64(&cnt->rx_bytes,
+				      LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
+			atomic_incr64(&cnt->lat_sum, lat);
+			atomic_incr64(&cnt->lat_hist[tg_lat_bucket(lat)], 1);
+			if (lat < cnt->lat_min || lat > cnt->lat_max) {
+				lock_spinlock(&tg_streams[tg->stream].lock);
+				if (lat < cnt->lat_min)
+					cnt->lat_min = lat;
+				if (lat > cnt->lat_max)
+					cnt->lat_max = lat;
+				unlock_spinlock(&tg_streams[tg->stream].lock);
+			}
+		}
+	}
+
+	fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+	fdma_terminate_task();
+}
+
+/* Average rate (per second) of 'count' over 'elapsed' microseconds */
+static __COLD_CODE uint64_t tg_rate(uint64_t count, uint64_t elapsed)
+{
+	if (!elapsed)
+		return 0;
+	return (count / elapsed) * TG_USEC_PER_SEC +
+		((count % elapsed) * TG_USEC_PER_SEC) / elapsed;
+}
+
+static __COLD_CODE int tg_config(uint8_t stream, struct tg_cfg *cfg)
+{
+	struct tg_stream	*s;
+	uint16_t		spid, span;
+	int			i, num, err;
+
+	if (stream >= TG_MAX_STREAMS ||
+	    cfg->ni >= dpni_drv_get_num_of_nis() ||
+	    cfg->min_size < TG_MIN_FRAME_SIZE ||
+	    cfg->max_size < cfg->min_size ||
+	    cfg->max_size > TG_MAX_FRAME_SIZE ||
+	    cfg->period > TG_MAX_PERIOD)
+		return -EINVAL;
+	if (!cfg->period)
+		cfg->period = TG_DEF_PERIOD;
+	if (cfg->period < TG_MIN_PERIOD)
+		return -EINVAL;
+	if (!cfg->burst)
+		cfg->burst = TG_DEF_BURST;
+	if (!cfg->src_ip_count)
+		cfg->src_ip_count = 1;
+	if (!cfg->dst_ip_count)
+		cfg->dst_ip_count = 1;
+	if (!cfg->src_port_count)
+		cfg->src_port_count = 1;
+	if (!cfg->dst_port_count)
+		cfg->dst_port_count = 1;
+
+	err = dpni_drv_get_spid(cfg->ni, &spid);
+	if (err)
+		return err;
+	err = dpni_drv_get_primary_mac_addr(cfg->ni, cfg->src_mac);
+	if (err)
+		return err;
+
+	s = &tg_streams[stream];
+	lock_spinlock(&s->lock);
+	if (s->state == TG_STATE_RUNNING || s->state == TG_STATE_STOPPING) {
+		unlock_spinlock(&s->lock);
+		return -EBUSY;
+	}
+	s->cfg = *cfg;
+	s->spid = spid;
+	/* Frame sizes evenly spread between min_size and max_size */
+	span = (uint16_t)(cfg->max_size - cfg->min_size);
+	num = span ? TG_MAX_TEMPLATES : 1;
+	memset(s->tmpl_size, 0, sizeof(s->tmpl_size));
+	for (i = 0; i < num; i++)
+		s->tmpl_size[i] = (uint16_t)(cfg->min_size +
+					     (span * i) / MAX(num - 1, 1));
+	s->state = TG_STATE_CONFIGURED;
+	unlock_spinlock(&s->lock);
+	return 0;
+}
+
+static __COLD_CODE int tg_start(uint8_t stream)
+{
+	struct tg_stream	*s;
+	uint64_t		now;
+	int			err;
+
+	if (stream >= TG_MAX_STREAMS)
+		return -EINVAL;
+	s = &tg_streams[stream];
+	lock_spinlock(&s->lock);
+	if (s->state != TG_STATE_CONFIGURED && s->state != TG_STATE_STOPPED) {
+		unlock_spinlock(&s->lock);
+		return (s->state == TG_STATE_IDLE) ? -EINVAL : -EBUSY;
+	}
+	memset(&s->cnt, 0, sizeof(s->cnt));
+	s->cnt.lat_min = 0xFFFFFFFF;
+	tman_get_timestamp(&now);
+	s->start_ts = now;
+	s->last_ts = now;
+	s->pkt_credit = 0;
+	s->bit_credit = 0;
+	s->sent = 0;
+	s->seq = 0;
+	s->src_ip_idx = 0;
+	s->dst_ip_idx = 0;
+	s->src_port_idx = 0;
+	s->dst_port_idx = 0;
+	s->busy = 0;
+	s->state = TG_STATE_RUNNING;
+	unlock_spinlock(&s->lock);
+
+	err = tman_create_timer(tg_tmi_id,
+				TMAN_CREATE_TIMER_MODE_TPRI |
+				TMAN_CREATE_TIMER_MODE_USEC_GRANULARITY,
+				(uint16_t)s->cfg.period, stream, 0,
+				tg_timer_cb, &s->timer_handle);
+	if (err) {
+		pr_err("Cannot create the timer of stream %d\n", stream);
+		lock_spinlock(&s->lock);
+		s->state = TG_STATE_STOPPED;
+		unlock_spinlock(&s->lock);
+		return err;
+	}
+	fsl_print("%s : stream %d started on NI %d\n", AIOP_APP_NAME,
+		  stream, s->cfg.ni);
+	return 0;
+}
+
+static __COLD_CODE int tg_stop(uint8_t stream)
+{
+	struct tg_stream	*s;
+
+	if (stream >= TG_MAX_STREAMS)
+		return -EINVAL;
+	s = &tg_streams[stream];
+	lock_spinlock(&s->lock);
+	/* The timer task releases the stream resources */
+	if (s->state == TG_STATE_RUNNING)
+		s->state = TG_STATE_STOPPING;
+	unlock_spinlock(&s->lock);
+	return 0;
+}
+
+static __COLD_CODE int tg_get_stats(uint8_t stream, struct tg_stats *stats,
+				    int reset)
+{
+	struct tg_stream	*s;
+	struct tg_counters	*cnt;
+	uint64_t		now, wire_bytes;
+	int			i;
+
+	if (stream >= TG_MAX_STREAMS)
+		return -EINVAL;
+	s = &tg_streams[stream];
+	cnt = &s->cnt;
+	tman_get_timestamp(&now);
+
+	lock_spinlock(&s->lock);
+	if (s->state == TG_STATE_STOPPED)
+		now = s->stop_ts;
+	stats->elapsed = (s->state == TG_STATE_IDLE ||
+			  s->state == TG_STATE_CONFIGURED) ? 0 :
+			now - s->start_ts;
+	stats->tx_frames = (uint64_t)cnt->tx_frames;
+	stats->tx_bytes = (uint64_t)cnt->tx_bytes;
+	stats->tx_drops = (uint64_t)cnt->tx_drops;
+	stats->rx_frames = (uint64_t)cnt->rx_frames;
+	stats->rx_bytes = (uint64_t)cnt->rx_bytes;
+	stats->lat_min = cnt->rx_frames ? cnt->lat_min : 0;
+	stats->lat_max = cnt->lat_max;
+	stats->lat_avg = cnt->rx_frames ?
+		(uint32_t)((uint64_t)cnt->lat_sum / (uint64_t)cnt->rx_frames) :
+		0;
+	for (i = 0; i < TG_LAT_BUCKETS; i++)
+		stats->lat_hist[i] = (uint32_t)cnt->lat_hist[i];
+	if (reset) {
+		memset(cnt, 0, sizeof(*cnt));
+		cnt->lat_min = 0xFFFFFFFF;
+		s->start_ts = now;
+	}
+	unlock_spinlock(&s->lock);
+
+	stats->tx_pps = (uint32_t)tg_rate(stats->tx_frames, stats->elapsed);
+	stats->rx_pps = (uint32_t)tg_rate(stats->rx_frames, stats->elapsed);
+	wire_bytes = stats->tx_bytes + stats->tx_frames * TG_WIRE_OVERHEAD;
+	stats->tx_bps = tg_rate(wire_bytes * 8, stats->elapsed);
+	wire_bytes = stats->rx_bytes + stats->rx_frames * TG_WIRE_OVERHEAD;
+	stats->rx_bps = tg_rate(wire_bytes * 8, stats->elapsed);
+	return 0;
+}
+
+static int tg_open_cb(uint8_t instance_id, void **dev)
+{
+	UNUSED(instance_id);
+	UNUSED(dev);
+	return 0;
+}
+
+static int tg_close_cb(void *dev)
+{
+	UNUSED(dev);
+	return 0;
+}
+
+static __COLD_CODE int tg_ctrl_cb(void *dev, uint16_t cmd, uint32_t size,
+				  void *data)
+{
+	struct tg_cmd_data	*cmd_data = (struct tg_cmd_data *)data;
+	struct tg_cfg		cfg;
+	struct tg_stats		stats;
+	uint8_t			stream;
+	int			reset, err, i;
+
+	UNUSED(dev);
+
+	switch (cmd) {
+	case TG_CMD_CONFIG:
+		if (size < TG_CMDSZ_CONFIG)
+			return -EINVAL;
+		memset(&cfg, 0, sizeof(cfg));
+		TG_CMD_CONFIG_CMD(TG_CMD_READ);
+		return tg_config(stream, &cfg);
+	case TG_CMD_START:
+		TG_CMD_STREAM_CMD(TG_CMD_READ);
+		return tg_start(stream);
+	case TG_CMD_STOP:
+		TG_CMD_STREAM_CMD(TG_CMD_READ);
+		return tg_stop(stream);
+	case TG_CMD_GET_STATS:
+		if (size < TG_CMDSZ_GET_STATS)
+			return -EINVAL;
+		TG_CMD_GET_STATS_CMD(TG_CMD_READ);
+		err = tg_get_stats(stream, &stats, reset);
+		if (err)
+			return err;
+		for (i = 1; i < TG_CMD_NUM_OF_PARAMS; i++)
+			cmd_data->params[i] = 0;
+		TG_CMD_GET_STATS_RSP(TG_RSP_PREP);
+		fdma_modify_default_segment_data(0, TG_CMDSZ_GET_STATS);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static int app_dpni_add_cb(uint8_t generator_id, uint8_t event_id,
+			   uint64_t app_ctx, void *event_data)
+{
+	uint16_t		dpni_id, ni = (uint16_t)((uint32_t)event_data);
+	char			dpni_ep_type[16];
+	int			dpni_ep_id, err, link_state;
+	struct ep_init_presentation init_presentation;
+
+	UNUSED(generator_id);
+	UNUSED(event_id);
+
+	/* Get endpoint and skip DPNI-DPNI connection from app initialization */
+	err = dpni_drv_get_connected_obj(ni, &dpni_ep_id,
+					 dpni_ep_type, &link_state);
+	if (err) {
+		pr_err("Cannot get connected object for NI %d\n", ni);
+		return err;
+	}
+	if (strcmp(dpni_ep_type, "dpni") == 0)
+		return 0;
+
+	/* Configure frame processing callback */
+	err = dpni_drv_register_rx_cb(ni, (rx_cb_t *)app_ctx);
+	if (err) {
+		pr_err("Cannot configure processing callback on NI %d\n", ni);
+		return err;
+	}
+
+	/* Get DPNI ID for current Network Interface ID */
+	err = dpni_drv_get_dpni_id(ni, &dpni_id);
+	if (err) {
+		pr_err("Cannot get DPNI ID for NI %d\n", ni);
+		return err;
+	}
+
+	/* The looped back frames are only counted */
+	err = dpni_drv_set_concurrent(ni);
+	if (err) {
+		pr_err("Cannot set Concurrent Execution on NI %d\n", ni);
+		return err;
+	}
+
+	/* Set the initial segment presentation size */
+	err = dpni_drv_get_initial_presentation(ni, &init_presentation);
+	if (err) {
+		pr_err("Cannot get initial presentation for NI %d\n", ni);
+		return err;
+	}
+
+	init_presentation.options = EP_INIT_PRESENTATION_OPT_SPS;
+	init_presentation.sps = PRESENTATION_LENGTH;
+	err = dpni_drv_set_initial_presentation(ni, &init_presentation);
+	if (err) {
+		pr_err("Cannot set initial presentation for NI %d to %d\n",
+				ni, init_presentation.sps);
+		return err;
+	}
+
+	/* Enable DPNI to receive frames */
+	err = dpni_drv_enable(ni);
+	if (err) {
+		pr_err("Cannot enable NI %d for Rx/Tx\n", ni);
+		return err;
+	}
+
+	fsl_print("%s : Successfully configured ni%d (dpni.%d)\n",
+		  AIOP_APP_NAME, ni, dpni_id);
+	fsl_print("%s : dpni.%d <---connected---> %s.%d\n",
+		  AIOP_APP_NAME, dpni_id, dpni_ep_type, dpni_ep_id);
+	return 0;
+}
+
+/* Early initialization */
+int app_early_init(void)
+{
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		tg_mem_partition_id = MEM_PART_DP_DDR;
+	else
+		tg_mem_partition_id = MEM_PART_SYSTEM_DDR;
+	/* Timers of the streams */
+	return slab_register_context_buffer_requirements(COMMITTED_BUFFERS,
+							 MAXIMUM_BUFFERS,
+							 TG_TMI_SIZE,
+							 BUFFERS_ALIGNMENT,
+							 tg_mem_partition_id,
+							 0, 0);
+}
+
+/* Initializes the application */
+int app_init(void)
+{
+	struct cmdif_module_ops	ops;
+	struct slab		*slab_handle = NULL;
+	uint64_t		tmi_addr = 0;
+	int			err;
+
+	err = slab_create(COMMITTED_BUFFERS, MAXIMUM_BUFFERS, TG_TMI_SIZE,
+			  BUFFERS_ALIGNMENT, tg_mem_partition_id, 0, NULL,
+			  &slab_handle);
+	if (err) {
+		pr_err("slab_create failed\n");
+		return err;
+	}
+	err = slab_acquire(slab_handle, &tmi_addr);
+	if (err) {
+		pr_err("slab_acquire failed\n");
+		return err;
+	}
+	err = tman_create_tmi(tmi_addr, TG_NUM_TIMERS, &tg_tmi_id);
+	if (err) {
+		pr_err("tman_create_tmi failed\n");
+		return err;
+	}
+
+	ops.open_cb = (open_cb_t *)tg_open_cb;
+	ops.close_cb = (close_cb_t *)tg_close_cb;
+	ops.ctrl_cb = (ctrl_cb_t *)tg_ctrl_cb;
+	err = cmdif_register_module(TG_MODULE_NAME, &ops);
+	if (err) {
+		pr_err("Cannot register %s cmdif module\n", TG_MODULE_NAME);
+		return err;
+	}
+
+	err = evmng_register(EVMNG_GENERATOR_AIOPSL, DPNI_EVENT_ADDED, 1,
+			     (uint64_t) app_traffic_gen_rx, app_dpni_add_cb);
+	if (err) {
+		pr_err("Cannot register DPNI ADD event\n");
+		return err;
+	}
+
+	return 0;
+}
+
+/* Frees application allocated resources */
+void app_free(void)
+{}
@@ -0,0 +1,164 @@
+/*
+ * Copyright 2014-2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __TRAFFIC_GEN_H
+#define __TRAFFIC_GEN_H
+
+#ifndef LS2085A_REV1
+	#include "common/fsl_string.h"
+#else
+	#include "fsl_string.h"
+#endif
+#include "fsl_sys.h"
+#include "apps.h"
+
+/* Functions prototype */
+int app_init(void);
+int app_early_init(void);
+void app_free(void);
+
+void build_apps_array(struct sys_module_desc *apps);
+void app_traffic_gen_rx(void);
+
+/*
+ * Traffic generator commands between GPP (client) and AIOP (server).
+ * The commands are sent on the TG_MODULE_NAME cmdif module.
+ */
+#define TG_MODULE_NAME		"TGEN"
+
+#define TG_MAX_STREAMS		4	/* Number of streams */
+#define TG_LAT_BUCKETS		16	/* Latency histogram buckets */
+
+#define TG_CMD_NUM_OF_PARAMS	20
+
+struct tg_cmd_data {
+	uint64_t params[TG_CMD_NUM_OF_PARAMS];
+};
+
+/* tg_cmds */
+#define TG_CMD_CONFIG		0
+#define TG_CMD_START		1
+#define TG_CMD_STOP		2
+#define TG_CMD_GET_STATS	3
+
+/* cmd sizes */
+#define TG_CMDSZ_CONFIG		(8*8)
+#define TG_CMDSZ_START		8
+#define TG_CMDSZ_STOP		8
+#define TG_CMDSZ_GET_STATS	(TG_CMD_NUM_OF_PARAMS*8)
+
+/*
+ * TG_CMD_CONFIG
+ * The stream sends UDP/IPv4 frames on NI 'ni', traffic class 'tc'. The
+ * source address, destination address and ports of frame N are
+ * base + (N % count). The frame size (without FCS) is picked randomly
+ * between 'min_size' and 'max_size' for each burst of frames.
+ * 'pps' and 'bps' (layer 1 bits: frame, FCS, preamble and inter frame gap)
+ * are the target rates, 0 for no limit on that rate. At most 'burst' frames
+ * are sent every 'period' microseconds. 'count' frames are sent, 0 to send
+ * until TG_CMD_STOP.
+ */
+/*	param, offset, width,	type,			arg_name */
+#define TG_CMD_CONFIG_CMD(_OP) \
+do { \
+	_OP(0, 0,	8,	uint8_t,		stream); \
+	_OP(0, 8,	8,	uint8_t,		cfg.tc); \
+	_OP(0, 16,	16,	uint16_t,		cfg.ni); \
+	_OP(0, 32,	32,	uint32_t,		cfg.period); \
+	_OP(1, 0,	8,	uint8_t,		cfg.dst_mac[0]); \
+	_OP(1, 8,	8,	uint8_t,		cfg.dst_mac[1]); \
+	_OP(1, 16,	8,	uint8_t,		cfg.dst_mac[2]); \
+	_OP(1, 24,	8,	uint8_t,		cfg.dst_mac[3]); \
+	_OP(1, 32,	8,	uint8_t,		cfg.dst_mac[4]); \
+	_OP(1, 40,	8,	uint8_t,		cfg.dst_mac[5]); \
+	_OP(1, 48,	16,	uint16_t,		cfg.burst); \
+	_OP(2, 0,	32,	uint32_t,		cfg.src_ip); \
+	_OP(2, 32,	32,	uint32_t,		cfg.dst_ip); \
+	_OP(3, 0,	16,	uint16_t,		cfg.src_ip_count); \
+	_OP(3, 16,	16,	uint16_t,		cfg.dst_ip_count); \
+	_OP(3, 32,	16,	uint16_t,		cfg.src_port_count); \
+	_OP(3, 48,	16,	uint16_t,		cfg.dst_port_count); \
+	_OP(4, 0,	16,	uint16_t,		cfg.src_port); \
+	_OP(4, 16,	16,	uint16_t,		cfg.dst_port); \
+	_OP(4, 32,	16,	uint16_t,		cfg.min_size); \
+	_OP(4, 48,	16,	uint16_t,		cfg.max_size); \
+	_OP(5, 0,	64,	uint64_t,		cfg.pps); \
+	_OP(6, 0,	64,	uint64_t,		cfg.bps); \
+	_OP(7, 0,	64,	uint64_t,		cfg.count); \
+} while (0)
+
+/*	param, offset, width,	type,			arg_name */
+#define TG_CMD_STREAM_CMD(_OP) \
+	_OP(0, 0,	8,	uint8_t,		stream)
+
+/*	param, offset, width,	type,			arg_name */
+#define TG_CMD_GET_STATS_CMD(_OP) \
+do { \
+	_OP(0, 0,	8,	uint8_t,		stream); \
+	_OP(0, 8,	1,	int,			reset); \
+} while (0)
+
+/*
+ * TG_CMD_GET_STATS response
+ * Rates are averages since TG_CMD_START, over 'elapsed' microseconds (up to
+ * the stop of the stream). Latencies are in microseconds, bucket i of the
+ * histogram counts the frames with latency in [2^(i-1), 2^i).
+ */
+/*	param, offset, width,	type,			arg_name */
+#define TG_CMD_GET_STATS_RSP(_OP) \
+do { \
+	_OP(1, 0,	64,	uint64_t,		stats.tx_frames); \
+	_OP(2, 0,	64,	uint64_t,		stats.tx_bytes); \
+	_OP(3, 0,	64,	uint64_t,		stats.tx_drops); \
+	_OP(4, 0,	64,	uint64_t,		stats.rx_frames); \
+	_OP(5, 0,	64,	uint64_t,		stats.rx_bytes); \
+	_OP(6, 0,	64,	uint64_t,		stats.elapsed); \
+	_OP(7, 0,	32,	uint32_t,		stats.tx_pps); \
+	_OP(7, 32,	32,	uint32_t,		stats.rx_pps); \
+	_OP(8, 0,	64,	uint64_t,		stats.tx_bps); \
+	_OP(9, 0,	64,	uint64_t,		stats.rx_bps); \
+	_OP(10, 0,	32,	uint32_t,		stats.lat_min); \
+	_OP(10, 32,	32,	uint32_t,		stats.lat_max); \
+	_OP(11, 0,	32,	uint32_t,		stats.lat_avg); \
+	_OP(12, 0,	32,	uint32_t,		stats.lat_hist[0]); \
+	_OP(12, 32,	32,	uint32_t,		stats.lat_hist[1]); \
+	_OP(13, 0,	32,	uint32_t,		stats.lat_hist[2]); \
+	_OP(13, 32,	32,	uint32_t,		stats.lat_hist[3]); \
+	_OP(14, 0,	32,	uint32_t,		stats.lat_hist[4]); \
+	_OP(14, 32,	32,	uint32_t,		stats.lat_hist[5]); \
+	_OP(15, 0,	32,	uint32_t,		stats.lat_hist[6]); \
+	_OP(15, 32,	32,	uint32_t,		stats.lat_hist[7]); \
+	_OP(16, 0,	32,	uint32_t,		stats.lat_hist[8]); \
+	_OP(16, 32,	32,	uint32_t,		stats.lat_hist[9]); \
+	_OP(17, 0,	32,	uint32_t,		stats.lat_hist[10]); \
+	_OP(17, 32,	32,	uint32_t,		stats.lat_hist[11]); \
+	_OP(18, 0,	32,	uint32_t,		stats.lat_hist[12]); \
+	_OP(18, 32,	32,	uint32_t,		stats.lat_hist[13]); \
+	_OP(19, 0,	32,	uint32_t,		stats.lat_hist[14]); \
+	_OP(19, 32,	32,	uint32_t,		stats.lat_hist[15]); \
+} while (0)
+
+#endif /* __TRAFFIC_GEN_H */
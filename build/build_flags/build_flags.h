@@ -85,6 +85,30 @@
 #ifndef CWAPF_CODE_PLACEMENT
 #define CWAPF_CODE_PLACEMENT     __COLD_CODE
 #endif
+/*
+ * Forwarding Information Base module
+ */
+#ifndef FIB_CODE_PLACEMENT
+#define FIB_CODE_PLACEMENT     __COLD_CODE
+#endif
+/*
+ * srTCM/trTCM meter module
+ */
+#ifndef METER_CODE_PLACEMENT
+#define METER_CODE_PLACEMENT   __COLD_CODE
+#endif
+/*
+ * CoDel/PIE active queue management module
+ */
+#ifndef AQM_CODE_PLACEMENT
+#define AQM_CODE_PLACEMENT     __COLD_CODE
+#endif
+/*
+ * IPFIX / NetFlow v9 flow export module
+ */
+#ifndef IPFIX_CODE_PLACEMENT
+#define IPFIX_CODE_PLACEMENT   __COLD_CODE
+#endif
 /*
  * TCP Reassembly module
  */ 
@@ -109,6 +133,18 @@
 #ifndef SLAB_CODE_PLACEMENT
 #define SLAB_CODE_PLACEMENT    __COLD_CODE
 #endif
+/*
+ * Timer wheel module
+ */
+#ifndef TWHEEL_CODE_PLACEMENT
+#define TWHEEL_CODE_PLACEMENT  __COLD_CODE
+#endif
+/*
+ * Frame batch module
+ */
+#ifndef FD_BATCH_CODE_PLACEMENT
+#define FD_BATCH_CODE_PLACEMENT  __COLD_CODE
+#endif
 /*
  * IPSEC module
  */ 
@@ -202,6 +238,46 @@
  * Disabled by default.
  */
 
+/*
+ * Profiling regions
+ *
+ * #define ENABLE_PROF_REGIONS
+ *
+ * It enables the PROF_REGION_START/STOP markers (fsl_prof.h).
+ * Disabled by default.
+ */
+
+/*
+ * Accelerator cycle accounting
+ *
+ * #define ENABLE_ACCEL_ACCOUNTING
+ *
+ * It accounts the time spent in each accelerator, per task entry point
+ * (fsl_acct.h). Disabled by default.
+ */
+
+/*
+ * OSM contention profiling
+ *
+ * #define ENABLE_OSM_PROFILING
+ *
+ * It measures the time waited for and the time spent in exclusive ordering
+ * scopes, per OSM call site and per scope ID class (osm_prof_print() in
+ * fsl_osm.h). LS2088A/LS1088A only. Disabled by default.
+ */
+
+/*
+ * Allocation profiling
+ *
+ * #define ENABLE_ALLOC_PROFILING
+ *
+ * It records the fsl_malloc(), fsl_get_mem(), slab_acquire() and
+ * cdma_acquire_context_memory() calls and their releases per call site, and
+ * flags the data path allocations which are not served by a slab
+ * (fsl_alloc_prof.h). It uses about 24KB of shared RAM, two bytes of TLS and
+ * a TMAN instance with a periodic timer. Disabled by default.
+ */
+
 /*
  * Total size of boot memory manager
  */
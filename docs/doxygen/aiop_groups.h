@@ -616,6 +616,116 @@
 			/** @} */		
 		/** @} */
 		
+		/** @defgroup FSL_FIB FIB
+			@ingroup NETF
+			@{
+		*/
+			/** @defgroup FIB_MACROS FIB Macros
+				@ingroup FSL_FIB
+			*/
+			/** @defgroup FIB_STRUCTS FIB Data Structures
+				@ingroup FSL_FIB
+			*/
+			/** @defgroup FSL_FIB_Modes_And_Flags FIB Modes And Flags
+				@ingroup FSL_FIB
+				@{
+			*/
+				/** @defgroup FSL_FIBInsFlags FIB instance flags
+					@ingroup FSL_FIB_Modes_And_Flags
+				*/
+				/** @defgroup FSL_FIBNhFlags FIB next hop flags
+					@ingroup FSL_FIB_Modes_And_Flags
+				*/
+				/** @defgroup FSL_FIBFwdFlags FIB forwarding flags
+					@ingroup FSL_FIB_Modes_And_Flags
+				*/
+				/** @defgroup FSL_FIBReturnStatus FIB functions return status
+					@ingroup FSL_FIB_Modes_And_Flags
+				*/
+			/** @} */
+			/** @defgroup FSL_FIB_Functions FIB functions
+				@ingroup FSL_FIB
+			*/
+		/** @} */
+
+		/** @defgroup FSL_METER METER
+			@ingroup NETF
+			@{
+		*/
+			/** @defgroup METER_MACROS METER Macros
+				@ingroup FSL_METER
+			*/
+			/** @defgroup METER_STRUCTS METER Data Structures
+				@ingroup FSL_METER
+			*/
+			/** @defgroup FSL_METER_Modes_And_Flags METER Modes And Flags
+				@ingroup FSL_METER
+				@{
+			*/
+				/** @defgroup FSL_METERTableFlags meter table flags
+					@ingroup FSL_METER_Modes_And_Flags
+				*/
+				/** @defgroup FSL_METERProfileFlags meter profile flags
+					@ingroup FSL_METER_Modes_And_Flags
+				*/
+			/** @} */
+			/** @defgroup FSL_METER_Functions METER functions
+				@ingroup FSL_METER
+			*/
+		/** @} */
+
+		/** @defgroup FSL_AQM AQM
+			@ingroup NETF
+			@{
+		*/
+			/** @defgroup AQM_MACROS AQM Macros
+				@ingroup FSL_AQM
+			*/
+			/** @defgroup AQM_STRUCTS AQM Data Structures
+				@ingroup FSL_AQM
+			*/
+			/** @defgroup FSL_AQM_Modes_And_Flags AQM Modes And Flags
+				@ingroup FSL_AQM
+				@{
+			*/
+				/** @defgroup FSL_AQMFlags AQM flags
+					@ingroup FSL_AQM_Modes_And_Flags
+				*/
+				/** @defgroup FSL_AQMReturnStatus AQM return status
+					@ingroup FSL_AQM_Modes_And_Flags
+				*/
+			/** @} */
+			/** @defgroup FSL_AQM_Functions AQM functions
+				@ingroup FSL_AQM
+			*/
+		/** @} */
+
+		/** @defgroup FSL_IPFIX IPFIX
+			@ingroup NETF
+			@{
+		*/
+			/** @defgroup IPFIX_MACROS IPFIX Macros
+				@ingroup FSL_IPFIX
+			*/
+			/** @defgroup IPFIX_STRUCTS IPFIX Data Structures
+				@ingroup FSL_IPFIX
+			*/
+			/** @defgroup FSL_IPFIX_Modes_And_Flags IPFIX Modes And Flags
+				@ingroup FSL_IPFIX
+				@{
+			*/
+				/** @defgroup FSL_IPFIXFlags IPFIX instance flags
+					@ingroup FSL_IPFIX_Modes_And_Flags
+				*/
+				/** @defgroup FSL_IPFIXReturnStatus IPFIX return status
+					@ingroup FSL_IPFIX_Modes_And_Flags
+				*/
+			/** @} */
+			/** @defgroup FSL_IPFIX_Functions IPFIX functions
+				@ingroup FSL_IPFIX
+			*/
+		/** @} */
+
 		/** @defgroup FSL_IPF IPF
 			@ingroup NETF
 			@{
@@ -775,6 +885,18 @@
 	/** @defgroup rcu_g RCU
 	@ingroup kernel_g
 	@{ @} */
+
+	/** @defgroup twheel_g Timer Wheel
+	@ingroup kernel_g
+	@{
+	*/
+		/** @defgroup TWHEEL_MACROS Timer Wheel Macros
+			@ingroup twheel_g
+		*/
+		/** @defgroup TWHEELTimerCreateModeBits Timer wheel create flags
+			@ingroup twheel_g
+		*/
+	/** @} */
 	
 	
 	
@@ -6,6 +6,7 @@ from os import remove, close
 import fnmatch
 import re
 import sys
+import subprocess
 
 
 def check_if_file_exists(filename):
@@ -76,6 +77,23 @@ def stack():
 		print "Finished SUCCESSFULLY"
 		exit(0)
 
+#stack_usage() checks the worst case stack of the entry points and the code size
+#budgets with misc/tools/stack_usage/stack_usage.py
+def stack_usage():
+	global ls_arch
+	elf = "build/"+str(ls_arch)+"/rev1/tests/stack_estimation/out/aiop_app.elf"
+	if check_if_file_exists(elf) == False:
+		print "aiop_app.elf is missing in build/"+str(ls_arch)+"/rev1/tests/stack_estimation/out/"
+		exit(1)
+
+	tool = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "stack_usage", "stack_usage.py")
+	print "Start script to check static stack usage in AIOP"
+	if subprocess.call([sys.executable, tool, "-v", elf]) != 0:
+		print "Stack or code size budget exceeded"
+		exit(1)
+	print "Finished SUCCESSFULLY"
+	exit(0)
+
 #define() is used to add defines before the compilation of stack estimation and the aiopsl
 def defines():
 	orig_file = "build/build_flags/build_flags.h"
@@ -121,12 +139,14 @@ if __name__ == "__main__":
 
 	if control_param == "stack_check":
 		stack() #jump to stack checking part
+	elif control_param == "stack_usage":
+		stack_usage() #jump to static stack usage checking part
 	elif control_param == "add_defines":
 		defines() #jump to add defines
 	elif control_param == "['-h']":
-		print "python jenkins_aiop_stack_estimation.py [stack_check|add_defines] [ls2085a|ls1088a]"
+		print "python jenkins_aiop_stack_estimation.py [stack_check|stack_usage|add_defines] [ls2085a|ls1088a]"
 		exit(2)
 	else:
 		print "Wrong parameter " + control_param
-		print "python jenkins_aiop_stack_estimation.py [-h|stack_check|add_defines] [ls2085a|ls1088a]"
+		print "python jenkins_aiop_stack_estimation.py [-h|stack_check|stack_usage|add_defines] [ls2085a|ls1088a]"
 		exit(1)
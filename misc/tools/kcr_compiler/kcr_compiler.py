@@ -0,0 +1,502 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side Key Composition Rule (KCR) compiler.
+#
+# Compiles a declarative key description into validated KCR byte arrays,
+# emitted as a C header of constant struct kcr_builder objects that can be
+# passed directly to keygen_kcr_create(). See README.txt for the input format.
+#
+# The FEC encoding follows the keygen_kcr_builder_add_*() functions in
+# src/drivers/accel/keygen/01_01. The KCR and table constants are read from
+# the AIOP SL headers so the output always matches the firmware.
+
+from __future__ import print_function
+
+import os
+import re
+import sys
+import getopt
+
+AIOPSL_ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+			   "..", "..", "..")
+KEYGEN_H = "src/drivers/accel/keygen/01_01/keygen.h"
+FSL_KEYGEN_H = "src/include/drivers/accel/keygen/02_01/fsl_keygen.h"
+TABLE_H = "src/drivers/accel/table/02_01/table.h"
+FSL_TABLE_H = "src/include/drivers/accel/table/02_01/fsl_table.h"
+
+# Size (bytes) of the field extracted by each protocol specific FEC as
+# (IPv4 frame, IPv6 frame). From the CTLU key composition rule reference.
+PROTOCOL_FEC_SIZES = {
+	"MACDST":	(6, 6),
+	"MACSRC":	(6, 6),
+	"VLANTCI_1":	(2, 2),
+	"VLANTCI_N":	(2, 2),
+	"ETYPE":	(2, 2),
+	"PPPSID":	(2, 2),
+	"PPPPID":	(2, 2),
+	"MPLSL_1":	(4, 4),
+	"MPLSL_2":	(4, 4),
+	"MPLSL_N":	(4, 4),
+	"ARP_OP":	(2, 2),
+	"ARP_SPA":	(4, 4),
+	"ARP_TPA":	(4, 4),
+	"ARP_SHA":	(6, 6),
+	"ARP_THA":	(6, 6),
+	"IPSRC_1":	(4, 16),
+	"IPDST_1":	(4, 16),
+	"PTYPE_1":	(1, 1),
+	"IPTOS_TC_1":	(1, 1),
+	"IPID_1":	(2, 4),
+	"IPV6FL_1":	(3, 3),
+	"IPSRC_N":	(4, 16),
+	"IPDST_N":	(4, 16),
+	"PTYPE_N":	(1, 1),
+	"IPTOS_TC_N":	(1, 1),
+	"IPID_N":	(2, 4),
+	"IPV6FL_N":	(3, 3),
+	"GREPTYPE":	(2, 2),
+	"L4PSRC":	(2, 2),
+	"L4PDST":	(2, 2),
+	"TFLG":		(1, 1),
+	"IPSECSPI":	(4, 4),
+	"IPSECNH":	(1, 1),
+	"GTP_TEID":	(4, 4),
+	"ICMP_TYPE":	(1, 1),
+	"ICMP_CODE":	(1, 1),
+	"NXT_HDR":	(2, 2),
+}
+
+# enum kcr_builder_parse_result_offset, offsets in struct parse_result
+PR_OFFSETS = {
+	"SHIM_OFFSET_1": 0x10, "SHIM_OFFSET_2": 0x11,
+	"IP_1_PID_OFFSET": 0x12, "ETH_OFFSET": 0x13,
+	"LLC_SNAP_OFFSET": 0x14, "TCI1_OFFSET": 0x15,
+	"TCIN_OFFSET": 0x16, "LAST_ETYPE_OFFSET": 0x17,
+	"PPPOE_OFFSET": 0x18, "MPLS_OFFSET_1": 0x19,
+	"MPLS_OFFSET_N": 0x1A, "L3_OFFSET": 0x1B,
+	"IPN_OR_MINENCAP0_OFFSET": 0x1C, "GRE_OFFSET": 0x1D,
+	"L4_OFFSET": 0x1E, "L5_OFFSET": 0x1F,
+	"ROUTING_HDR_OFFSET_1": 0x20, "ROUTING_HDR_OFFSET_2": 0x21,
+	"NXT_HDR_OFFSET": 0x22, "IPV6_FRAG_OFFSET": 0x23,
+	"NXT_HDR_BEFORE_IPV6_FRAG_OFFSET": 0x29, "IP_N_PID_OFFSET": 0x2A,
+	"SOFT_PARSING_CONTEXT": 0x2B,
+}
+
+TABLE_TYPES = ("EM", "LPM", "MFLU")
+
+# License of the generated headers, as in the other sources of the tree
+LICENSE = """\
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+"""
+
+class KcrError(Exception):
+	pass
+
+def read_defines(path):
+	defines = {}
+	define_re = re.compile(r"^\s*#define\s+(\w+)\s+(0[xX][0-9a-fA-F]+|\d+)\b")
+	for line in open(os.path.join(AIOPSL_ROOT, path)):
+		m = define_re.match(line)
+		if m:
+			defines[m.group(1)] = int(m.group(2), 0)
+	return defines
+
+def read_fecids(path):
+	fecids = {}
+	fecid_re = re.compile(r"^\s*KEYGEN_KCR_(\w+)_FECID\s*=\s*(0[xX][0-9a-fA-F]+)")
+	for line in open(os.path.join(AIOPSL_ROOT, path)):
+		m = fecid_re.match(line)
+		if m:
+			fecids[m.group(1)] = int(m.group(2), 0)
+	return fecids
+
+class Kcr:
+	def __init__(self, name, k, fecids):
+		self.name = name
+		self.k = k
+		self.fecids = fecids
+		self.table = "EM"
+		self.kcr = [0] * k["KEYGEN_KCR_MAX_KCR_SIZE"]
+		self.length = 1
+		self.key_size = [0, 0]
+		self.fields = []
+
+	def append(self, fec, mask, what, size):
+		if mask:
+			fec[0] |= self.k["KEYGEN_KCR_MASK_EXT"]
+			fec.extend(mask)
+		if self.length + len(fec) > self.k["KEYGEN_KCR_MAX_KCR_SIZE"]:
+			raise KcrError("KCR exceeds maximum KCR size (%d bytes)" %
+				       self.k["KEYGEN_KCR_MAX_KCR_SIZE"])
+		self.kcr[self.length:self.length + len(fec)] = fec
+		self.length += len(fec)
+		self.kcr[self.k["KEYGEN_KCR_NFEC"]] += 1
+		self.key_size[0] += size[0]
+		self.key_size[1] += size[1]
+		self.fields.append((what, size))
+
+	def mask_bytes(self, masks, field_size):
+		"""Encodes the FEC mask extension as the builder does"""
+		if not masks:
+			return []
+		if len(masks) > 4:
+			raise KcrError("at most 4 masks are supported")
+		for (mask, offset) in masks:
+			if offset > 0xF:
+				raise KcrError("mask offset 0x%x exceeds 0xF" % offset)
+			if offset >= field_size:
+				raise KcrError("mask offset %d is beyond the %d bytes "
+					       "field" % (offset, field_size))
+			if mask > 0xFF:
+				raise KcrError("mask 0x%x is larger than 1 byte" % mask)
+		n = len(masks)
+		out = [0] * (2, 4, 5, 7)[n - 1]
+		if n >= 4:
+			out[6] = masks[3][0]
+			out[5] = masks[3][1]
+		if n >= 3:
+			out[4] = masks[2][0]
+			out[2] = masks[2][1]
+		if n >= 2:
+			out[3] = masks[1][0]
+			out[2] |= masks[1][1] << 4
+		out[1] = masks[0][0]
+		out[0] = ((n - 1) << 4) | masks[0][1]
+		return out
+
+	def add_protocol(self, field, masks):
+		if field not in self.fecids or field not in PROTOCOL_FEC_SIZES:
+			raise KcrError("unknown protocol specific field %s" % field)
+		size = PROTOCOL_FEC_SIZES[field]
+		mask = self.mask_bytes(masks, min(size))
+		self.append([self.fecids[field] << 1], mask, field, size)
+
+	def extract_size(self, size):
+		if size < 1 or size > self.k["KEYGEN_KCR_MAX_EXTRACT_SIZE"] + 1:
+			raise KcrError("extract size %d is not in 1-16" % size)
+		return size - 1
+
+	def add_protocol_based(self, pr_name, offset, size, masks):
+		if pr_name not in PR_OFFSETS:
+			raise KcrError("unknown parse result offset %s" % pr_name)
+		if offset > 0xFF:
+			raise KcrError("extract offset %d exceeds 255" % offset)
+		op0 = (self.k["KEYGEN_KCR_OP0_HET_PROTOCOL"] |
+		       self.k["KEYGEN_KCR_PROTOCOL_HVT"] | PR_OFFSETS[pr_name])
+		fec = [self.fecids["GEC"] << 1, op0, offset,
+		       self.extract_size(size)]
+		self.append(fec, self.mask_bytes(masks, size),
+			    "%s+%d" % (pr_name, offset), (size, size))
+
+	def add_generic(self, source, offset, size, masks):
+		if source == "frame":
+			if offset > 0xFF:
+				raise KcrError("frame offset %d exceeds 255" % offset)
+			eom = offset >> 4
+		elif source == "parse_result":
+			if offset > 0x3F:
+				raise KcrError("parse result offset %d exceeds 0x3F" %
+					       offset)
+			eom = self.k["KEYGEN_KCR_EOM_PARSE_RES_OFFSET_0x00"] + \
+			      (offset >> 4)
+		else:
+			raise KcrError("unknown generic extract source %s" % source)
+		op0 = self.k["KEYGEN_KCR_OP0_HET_GEC"] | eom
+		op1 = offset & self.k["KEYGEN_KCR_OFFSET_WITHIN_16_BYTES"]
+		fec = [self.fecids["GEC"] << 1, op0, op1, self.extract_size(size)]
+		self.append(fec, self.mask_bytes(masks, size),
+			    "%s[%d]" % (source, offset), (size, size))
+
+	def add_input_value(self, offset, size, masks):
+		if offset + size > 8:
+			raise KcrError("input value extract exceeds 8 bytes")
+		op0 = (self.k["KEYGEN_KCR_OP0_HET_GEC"] |
+		       self.k["KEYGEN_KCR_EXT_OPAQUE_IN_EOM"])
+		op1 = self.k["KEYGEN_KCR_EXT_OPAQUE_IN_BASIC_EO"] + offset
+		fec = [self.fecids["GEC"] << 1, op0, op1, self.extract_size(size)]
+		self.append(fec, self.mask_bytes(masks, size),
+			    "input[%d]" % offset, (size, size))
+
+	def add_constant(self, constant, num):
+		if num < 1 or num > 16:
+			raise KcrError("constant replication %d is not in 1-16" % num)
+		if constant > 0xFF:
+			raise KcrError("constant 0x%x is larger than 1 byte" %
+				       constant)
+		self.append([self.fecids["UDC"] << 1, num - 1, constant], None,
+			    "const 0x%02x x%d" % (constant, num), (num, num))
+
+	def add_valid_field(self, mask):
+		if mask:
+			fec = [(self.fecids["VF"] << 1) |
+			       self.k["KEYGEN_KCR_MASK_EXT"], 0x00, mask]
+		else:
+			fec = [self.fecids["VF"] << 1]
+		# the mask is part of the FEC, do not let append() add it again
+		if self.length + len(fec) > self.k["KEYGEN_KCR_MAX_KCR_SIZE"]:
+			raise KcrError("KCR exceeds maximum KCR size")
+		self.kcr[self.length:self.length + len(fec)] = fec
+		self.length += len(fec)
+		self.kcr[self.k["KEYGEN_KCR_NFEC"]] += 1
+		self.key_size[0] += 1
+		self.key_size[1] += 1
+		self.fields.append(("valid", (1, 1)))
+
+def calc_num_entries_per_rule(t, table_type, key_size):
+	"""Mirror of table_calc_num_entries_per_rule()"""
+	if table_type == "EM":
+		if key_size <= t["TABLE_ENTRY_EME24_LOOKUP_KEY_SIZE"]:
+			return t["TABLE_EM_KEYSIZE_1_TO_24_BYTES_ENTRIES_PER_RULE"]
+		if key_size <= (t["TABLE_ENTRY_EME44_LOOKUP_KEY_SIZE"] +
+				t["TABLE_ENTRY_EME16_LOOKUP_KEY_SIZE"]):
+			return t["TABLE_EM_KEYSIZE_25_TO_60_BYTES_ENTRIES_PER_RULE"]
+		if key_size <= (t["TABLE_ENTRY_EME44_LOOKUP_KEY_SIZE"] +
+				t["TABLE_ENTRY_EME36_LOOKUP_KEY_SIZE"] +
+				t["TABLE_ENTRY_EME16_LOOKUP_KEY_SIZE"]):
+			return t["TABLE_EM_KEYSIZE_61_TO_96_BYTES_ENTRIES_PER_RULE"]
+		return t["TABLE_EM_KEYSIZE_97_TO_124_BYTES_ENTRIES_PER_RULE"]
+	if table_type == "LPM":
+		if key_size > t["TABLE_KEY_LPM_IPV4_SIZE"]:
+			return t["TABLE_LPM_IPV6_WC_ENTRIES_PER_RULE"]
+		return t["TABLE_LPM_IPV4_WC_ENTRIES_PER_RULE"]
+	if key_size > t["TABLE_MFLU_SMALL_KEY_MAX_SIZE"]:
+		return t["TABLE_MFLU_BIG_KEY_WC_ENTRIES_PER_RULE"]
+	return t["TABLE_MFLU_SMALL_KEY_WC_ENTRIES_PER_RULE"]
+
+def parse_masks(words):
+	"""mask <mask>@<offset> [<mask>@<offset> ...]"""
+	masks = []
+	if not words:
+		return masks
+	if words[0] != "mask":
+		raise KcrError("unexpected '%s'" % " ".join(words))
+	for w in words[1:]:
+		try:
+			m, o = w.split("@")
+			masks.append((int(m, 0), int(o, 0)))
+		except ValueError:
+			raise KcrError("bad mask '%s', expected <mask>@<offset>" % w)
+	if not masks:
+		raise KcrError("mask without values")
+	return masks
+
+def parse_kv(words, keys):
+	"""Parses 'key value' pairs; returns (values, remaining words)"""
+	values = {}
+	i = 0
+	while i < len(words) and words[i] in keys:
+		if i + 1 >= len(words):
+			raise KcrError("missing value for %s" % words[i])
+		values[words[i]] = int(words[i + 1], 0)
+		i += 2
+	for key in keys:
+		if key not in values:
+			raise KcrError("missing %s" % key)
+	return values, words[i:]
+
+def compile_file(path, k, fecids):
+	kcrs = []
+	cur = None
+	for (lineno, line) in enumerate(open(path), 1):
+		words = line.split("#")[0].split()
+		if not words:
+			continue
+		try:
+			cmd = words[0]
+			if cmd == "kcr":
+				if len(words) != 2 or \
+				   not re.match(r"^[A-Za-z_]\w*$", words[1]):
+					raise KcrError("expected 'kcr <c_name>'")
+				cur = Kcr(words[1], k, fecids)
+				kcrs.append(cur)
+				continue
+			if cur is None:
+				raise KcrError("'%s' outside of a kcr block" % cmd)
+			if cmd == "table":
+				if len(words) != 2 or words[1] not in TABLE_TYPES:
+					raise KcrError("expected 'table EM|LPM|MFLU'")
+				cur.table = words[1]
+			elif cmd == "field":
+				cur.add_protocol(words[1], parse_masks(words[2:]))
+			elif cmd == "protocol_based":
+				v, rest = parse_kv(words[2:], ("offset", "size"))
+				cur.add_protocol_based(words[1], v["offset"],
+						       v["size"], parse_masks(rest))
+			elif cmd == "generic":
+				v, rest = parse_kv(words[2:], ("offset", "size"))
+				cur.add_generic(words[1], v["offset"], v["size"],
+						parse_masks(rest))
+			elif cmd == "input_value":
+				v, rest = parse_kv(words[1:], ("offset", "size"))
+				cur.add_input_value(v["offset"], v["size"],
+						    parse_masks(rest))
+			elif cmd == "constant":
+				v, rest = parse_kv(words[2:], ("num",))
+				if rest:
+					raise KcrError("unexpected '%s'" %
+						       " ".join(rest))
+				cur.add_constant(int(words[1], 0), v["num"])
+			elif cmd == "valid_field":
+				v, rest = parse_kv(words[1:], ("mask",))
+				cur.add_valid_field(v["mask"])
+			else:
+				raise KcrError("unknown command '%s'" % cmd)
+		except (KcrError, IndexError, ValueError) as e:
+			msg = str(e) if isinstance(e, KcrError) else \
+			      "malformed line"
+			raise KcrError("%s:%d: %s" % (path, lineno, msg))
+	if not kcrs:
+		raise KcrError("%s: no kcr defined" % path)
+	return kcrs
+
+def check_key(kcr, t, max_key_size):
+	if not kcr.fields:
+		raise KcrError("%s: empty KCR" % kcr.name)
+	if max(kcr.key_size) > max_key_size:
+		raise KcrError("%s: key size %d exceeds %d bytes" %
+			       (kcr.name, max(kcr.key_size), max_key_size))
+	if kcr.table == "LPM" and max(kcr.key_size) > \
+	   t["TABLE_KEY_LPM_IPV6_SIZE"]:
+		raise KcrError("%s: key too large for an LPM table" % kcr.name)
+
+def emit(kcrs, t, src, out):
+	guard = "__" + re.sub(r"\W", "_",
+			      os.path.basename(out.name).upper()) + "_"
+	out.write(LICENSE + "\n")
+	out.write("/*\n * Generated by misc/tools/kcr_compiler/kcr_compiler.py "
+		  "from %s.\n * Do not edit.\n */\n\n" % os.path.basename(src))
+	out.write("#ifndef %s\n#define %s\n\n" % (guard, guard))
+	out.write("#include \"fsl_keygen.h\"\n")
+	for kcr in kcrs:
+		up = kcr.name.upper()
+		v4, v6 = kcr.key_size
+		out.write("\n/* %s: %d FECs, KCR %d bytes\n" %
+			  (kcr.name, kcr.kcr[0], kcr.length))
+		for (what, size) in kcr.fields:
+			if size[0] == size[1]:
+				out.write(" *   %-24s %d\n" % (what, size[0]))
+			else:
+				out.write(" *   %-24s %d (IPv6 %d)\n" %
+					  (what, size[0], size[1]))
+		out.write(" */\n")
+		out.write("#define %s_KEY_SIZE\t\t%d\n" % (up, v4))
+		if v4 != v6:
+			out.write("#define %s_KEY_SIZE_IPV6\t%d\n" % (up, v6))
+		out.write("#define %s_ENTRIES_PER_RULE\t%d\n" %
+			  (up, calc_num_entries_per_rule(t, kcr.table, v6)))
+		out.write("static const struct kcr_builder %s "
+			  "__attribute__((aligned(16))) = {\n\t{\n" % kcr.name)
+		data = kcr.kcr + [0] * (t["KEYGEN_KCR_LENGTH"] - len(kcr.kcr))
+		for i in range(0, len(data), 8):
+			out.write("\t\t" + ", ".join("0x%02x" % b
+					     for b in data[i:i + 8]) + ",\n")
+		out.write("\t},\n\t%d\n};\n" % kcr.length)
+	out.write("\n#endif /* %s */\n" % guard)
+
+def usage():
+	print("Usage: kcr_compiler.py [-o <out.h>] [-m <max_key_size>] "
+	      "<description.kcr>")
+	print("  -o  output header (default: <description>_kcr.h)")
+	print("  -m  maximum key size (default 124; 80 on LS2085A CTLU,")
+	print("      48 on LS2085A MFLU due to ERR008450)")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "ho:m:")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	out_path = None
+	max_key_size = 124
+	for (o, a) in opts:
+		if o == "-h":
+			usage()
+			return 0
+		if o == "-o":
+			out_path = a
+		if o == "-m":
+			max_key_size = int(a, 0)
+	if len(args) != 1:
+		usage()
+		return 2
+
+	k = read_defines(KEYGEN_H)
+	k.update(read_defines(FSL_KEYGEN_H))
+	fecids = read_fecids(FSL_KEYGEN_H)
+	t = read_defines(TABLE_H)
+	t.update(read_defines(FSL_TABLE_H))
+	t["KEYGEN_KCR_LENGTH"] = k["KEYGEN_KCR_LENGTH"]
+
+	try:
+		kcrs = compile_file(args[0], k, fecids)
+		for kcr in kcrs:
+			check_key(kcr, t, max_key_size)
+	except KcrError as e:
+		print("[ERROR]: %s" % e)
+		return 1
+
+	if out_path is None:
+		out_path = os.path.splitext(args[0])[0] + "_kcr.h"
+	out = open(out_path, "w")
+	emit(kcrs, t, args[0], out)
+	out.close()
+
+	for kcr in kcrs:
+		v4, v6 = kcr.key_size
+		print("%-24s KCR %2d bytes, key %3d bytes%s, %s entries per rule %d"
+		      % (kcr.name, kcr.length, v4,
+			 " (IPv6 %d)" % v6 if v6 != v4 else "", kcr.table,
+			 calc_num_entries_per_rule(t, kcr.table, v6)))
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
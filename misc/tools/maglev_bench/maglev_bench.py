@@ -0,0 +1,299 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side benchmark of the Maglev lookup tables of the L4 load balancer.
+#
+# Builds the lookup table of a service like lb_maglev_build() in
+# apps/l4_lb/l4_lb.c (same hash, same population order) for a range of
+# backend counts. Reports the build time, the balance of the backends, and
+# the entries that change when a backend is added or deleted and the DDR
+# writes of lb_maglev_publish() to update them. See README.txt.
+
+from __future__ import print_function
+
+import sys
+import time
+import socket
+import struct
+import getopt
+
+# Must match apps/l4_lb/l4_lb.c
+LB_MAGLEV_SIZE = 4093
+LB_MAX_BACKENDS = 32
+LB_NO_BACKEND = 0xFF
+LB_CHUNK_SIZE = 128
+LB_BLOCK_SIZE = 16
+LB_FNV_PRIME = 0x01000193
+LB_HASH_SEED_OFFSET = 0x811C9DC5
+LB_HASH_SEED_SKIP = 0x050C5D1F
+
+DEF_COUNTS = "1,2,4,8,16,24,32"
+
+class BenchError(Exception):
+	pass
+
+def lb_hash(data, h):
+	for b in bytearray(data):
+		h ^= b
+		h = (h * LB_FNV_PRIME) & 0xFFFFFFFF
+	return h
+
+def backend_key(addr, port):
+	# struct lb_backend_cfg: addr[4] (IPv4 in addr[0]), port, big endian
+	return addr + struct.pack(">H", port)
+
+def is_prime(n):
+	if n < 2:
+		return False
+	i = 2
+	while i * i <= n:
+		if n % i == 0:
+			return False
+		i += 1
+	return True
+
+class Maglev(object):
+	def __init__(self, size):
+		self.size = size
+		self.probes = 0
+
+	def build(self, backends):
+		# backends: {slot: hash key}, populated in slot order
+		m = self.size
+		table = bytearray([LB_NO_BACKEND]) * m
+		self.probes = 0
+		if not backends:
+			return table
+		slots = sorted(backends)
+		nxt = {}
+		skip = {}
+		for i in slots:
+			nxt[i] = lb_hash(backends[i], LB_HASH_SEED_OFFSET) % m
+			skip[i] = lb_hash(backends[i], LB_HASH_SEED_SKIP) % \
+				(m - 1) + 1
+		filled = 0
+		probes = 0
+		while True:
+			for i in slots:
+				c = nxt[i]
+				while table[c] != LB_NO_BACKEND:
+					c += skip[i]
+					if c >= m:
+						c -= m
+					probes += 1
+				table[c] = i
+				c += skip[i]
+				if c >= m:
+					c -= m
+				nxt[i] = c
+				probes += 1
+				filled += 1
+				if filled == m:
+					self.probes = probes
+					return table
+
+def publish(old, new, chunk_size, block_size):
+	# Entries, bytes and writes of lb_maglev_publish()
+	changes = 0
+	written = 0
+	writes = 0
+	for off in range(0, len(new), chunk_size):
+		size = min(chunk_size, len(new) - off)
+		run_len = 0
+		for i in range(0, size, block_size):
+			blk = min(block_size, size - i)
+			diff = 0
+			for j in range(off + i, off + i + blk):
+				if old[j] != new[j]:
+					diff += 1
+			if diff:
+				run_len += blk
+				changes += diff
+			if run_len and (not diff or i + blk == size):
+				written += run_len
+				writes += 1
+				run_len = 0
+	return (changes, written, writes)
+
+def balance(table, n):
+	counts = {}
+	for e in table:
+		counts[e] = counts.get(e, 0) + 1
+	ideal = float(len(table)) / n
+	return (max(counts.values()) / ideal, min(counts.values()) / ideal)
+
+def make_backends(base, ipv6, port, count):
+	backends = {}
+	if ipv6:
+		(hi, lo) = struct.unpack(">QQ", socket.inet_pton(socket.AF_INET6,
+								 base))
+	else:
+		addr = struct.unpack(">I", socket.inet_aton(base))[0]
+	for i in range(count):
+		if ipv6:
+			raw = struct.pack(">QQ", hi,
+					  (lo + i) & 0xFFFFFFFFFFFFFFFF)
+		else:
+			raw = struct.pack(">I", (addr + i) & 0xFFFFFFFF) + \
+				b"\0" * 12
+		backends[i] = backend_key(raw, port)
+	return backends
+
+def fmt_change(changes, written, writes, size, n=1):
+	return "%6d %5.1f%%  %6d  %5d" % (changes // n,
+					  changes * 100.0 / n / size,
+					  written // n, writes // n)
+
+def run(counts, size, chunk_size, block_size, backends, repeat, tolerance):
+	mg = Maglev(size)
+	failed = False
+	none = "%13s  %6s  %5s" % ("-", "-", "-")
+	print("Table: %d entries, compared in %d bytes chunks, written in "
+	      "%d bytes blocks" % (size, chunk_size, block_size))
+	print()
+	print("%51s%-30s%s" % ("", "Add a backend",
+			       "Delete a backend (average)"))
+	print("Backends  Build(ms)  Probes  Max/ideal  Min/ideal"
+	      "  Entries         Bytes Writes  Entries         Bytes Writes")
+	for n in counts:
+		members = dict((i, backends[i]) for i in range(n))
+		start = time.time()
+		for r in range(repeat):
+			table = mg.build(members)
+		build_ms = (time.time() - start) * 1000.0 / repeat
+		probes = mg.probes
+		(bmax, bmin) = balance(table, n)
+		if tolerance is not None and \
+		   (bmax - 1) * 100 > tolerance:
+			failed = True
+
+		add = none
+		if n < LB_MAX_BACKENDS:
+			members[n] = backends[n]
+			add = fmt_change(*publish(table, mg.build(members),
+						  chunk_size, block_size),
+					 size=size)
+			del members[n]
+
+		dele = none
+		if n > 1:
+			total = [0, 0, 0]
+			for i in range(n):
+				key = members.pop(i)
+				res = publish(table, mg.build(members),
+					      chunk_size, block_size)
+				members[i] = key
+				total = [t + r for (t, r) in zip(total, res)]
+			dele = fmt_change(total[0], total[1], total[2],
+					  size, n)
+		print("%8d  %9.2f  %6d  %9.3f  %9.3f  %s  %s" %
+		      (n, build_ms, probes, bmax, bmin, add, dele))
+	print()
+	print("Ideal entries changed: M/(N+1) on add, M/N on delete")
+	if failed:
+		print("[ERROR]: imbalance above %.1f%%" % tolerance)
+	return failed
+
+def usage():
+	print("Usage: maglev_bench.py [options]")
+	print("  -n  backend counts, comma separated (default %s)" %
+	      DEF_COUNTS)
+	print("  -m  lookup table size, prime (default %d)" %
+	      LB_MAGLEV_SIZE)
+	print("  -a  address of the first backend (default 10.0.0.1), "
+	      "IPv4 or IPv6")
+	print("  -p  backend port (default 80)")
+	print("  -c  chunk size (default %d)" % LB_CHUNK_SIZE)
+	print("  -b  block size (default %d)" % LB_BLOCK_SIZE)
+	print("  -r  builds per count for the timing (default 5)")
+	print("  -T  fails if a backend gets more than this percentage "
+	      "above its share")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "hn:m:a:p:c:b:r:T:")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	counts_spec = DEF_COUNTS
+	size = LB_MAGLEV_SIZE
+	base = "10.0.0.1"
+	port = 80
+	chunk_size = LB_CHUNK_SIZE
+	block_size = LB_BLOCK_SIZE
+	repeat = 5
+	tolerance = None
+	try:
+		for (o, a) in opts:
+			if o == "-h":
+				usage()
+				return 0
+			if o == "-n":
+				counts_spec = a
+			if o == "-m":
+				size = int(a, 0)
+			if o == "-a":
+				base = a
+			if o == "-p":
+				port = int(a, 0)
+			if o == "-c":
+				chunk_size = int(a, 0)
+			if o == "-b":
+				block_size = int(a, 0)
+			if o == "-r":
+				repeat = int(a)
+			if o == "-T":
+				tolerance = float(a)
+		counts = [int(c, 0) for c in counts_spec.split(",")]
+		for n in counts:
+			if n < 1 or n > LB_MAX_BACKENDS:
+				raise BenchError("backend count must be in "
+						 "[1, %d]" % LB_MAX_BACKENDS)
+		if not is_prime(size) or size > 0xFFFF:
+			raise BenchError("table size must be a prime below "
+					 "65536")
+		if size <= LB_MAX_BACKENDS:
+			raise BenchError("table size must be larger than "
+					 "%d" % LB_MAX_BACKENDS)
+		if block_size < 1 or chunk_size < block_size or \
+		   chunk_size % block_size:
+			raise BenchError("the chunk size must be a multiple "
+					 "of the block size")
+		if repeat < 1 or not 0 < port < 65536:
+			raise BenchError("invalid repeat count or port")
+		backends = make_backends(base, ":" in base, port,
+					 LB_MAX_BACKENDS)
+	except (BenchError, ValueError, socket.error) as e:
+		print("[ERROR]: %s" % e)
+		return 1
+	if run(counts, size, chunk_size, block_size, backends, repeat,
+	       tolerance):
+		return 1
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,414 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side accuracy and throughput benchmark of the AIOP srTCM/trTCM meters.
+#
+# Runs synthetic traffic through a bit exact model of meter_color()
+# (src/drivers/netf/meter/00_01/meter.c: 1/65536 byte buckets, rates in
+# 1/65536 bytes per TMAN microsecond) and through an exact RFC 2697/2698
+# reference. Reports the marked rates against the configured ones, the
+# packets colored differently by the two models and the model speed.
+# See README.txt.
+
+from __future__ import print_function
+
+import sys
+import time
+import random
+import getopt
+
+# Must match src/drivers/netf/meter/00_01/meter.h
+METER_FP_SHIFT = 16
+METER_MAX_DELTA = 0x40000000
+METER_MAX_RATE = 25000000000
+METER_MAX_BURST = 0x7FFFFFFF
+
+GREEN = 0
+YELLOW = 1
+RED = 2
+COLORS = ("green", "yellow", "red")
+
+IMIX = ((64, 7), (576, 4), (1500, 1))
+
+class BenchError(Exception):
+	pass
+
+class Profile(object):
+	def __init__(self, algorithm, cir, cbs, pir, ebs, color_aware):
+		self.trtcm = (algorithm == "trtcm")
+		self.cir = cir
+		self.pir = pir
+		self.cbs = cbs
+		self.ebs = ebs
+		self.color_aware = color_aware
+
+	def check(self):
+		# Same checks as meter_profile_set()
+		if not self.cir or self.cir > METER_MAX_RATE:
+			raise BenchError("invalid CIR")
+		if self.cbs > METER_MAX_BURST or self.ebs > METER_MAX_BURST:
+			raise BenchError("invalid burst size")
+		if self.trtcm:
+			if self.pir < self.cir or self.pir > METER_MAX_RATE:
+				raise BenchError("PIR must be in [CIR, %d]" %
+						 METER_MAX_RATE)
+			if not self.cbs or not self.ebs:
+				raise BenchError("CBS and PBS must not be 0")
+		elif not self.cbs and not self.ebs:
+			raise BenchError("CBS or EBS must not be 0")
+
+class FixedMeter(object):
+	"""Model of meter_color(), fixed point, microsecond timestamps"""
+	def __init__(self, prof, ts):
+		self.cir = (prof.cir << METER_FP_SHIFT) // 1000000
+		self.pir = (prof.pir << METER_FP_SHIFT) // 1000000 \
+			   if prof.trtcm else 0
+		self.cbs = prof.cbs << METER_FP_SHIFT
+		self.ebs = prof.ebs << METER_FP_SHIFT
+		self.trtcm = prof.trtcm
+		self.color_aware = prof.color_aware
+		# meter_config(): full buckets
+		self.ts = ts
+		self.tc = self.cbs
+		self.te = self.ebs
+
+	def refill(self, level, delta, rate, burst):
+		if delta >= METER_MAX_DELTA:
+			return burst
+		return min(level + delta * rate, burst)
+
+	def color(self, now, length, in_color):
+		delta = now - self.ts
+		self.ts = now
+		if not self.trtcm:
+			if delta >= METER_MAX_DELTA:
+				self.tc = self.cbs
+				self.te = self.ebs
+			else:
+				self.tc += delta * self.cir
+				if self.tc > self.cbs:
+					self.te = min(self.te + self.tc -
+						      self.cbs, self.ebs)
+					self.tc = self.cbs
+		else:
+			self.tc = self.refill(self.tc, delta, self.cir,
+					      self.cbs)
+			self.te = self.refill(self.te, delta, self.pir,
+					      self.ebs)
+		if not self.color_aware:
+			in_color = GREEN
+		length <<= METER_FP_SHIFT
+		return self.mark(length, in_color)
+
+	def mark(self, length, in_color):
+		if not self.trtcm:
+			if in_color == GREEN and self.tc >= length:
+				self.tc -= length
+				return GREEN
+			if in_color != RED and self.te >= length:
+				self.te -= length
+				return YELLOW
+			return RED
+		if in_color == RED or self.te < length:
+			return RED
+		if in_color == YELLOW or self.tc < length:
+			self.te -= length
+			return YELLOW
+		self.te -= length
+		self.tc -= length
+		return GREEN
+
+class ExactMeter(FixedMeter):
+	"""RFC 2697/2698 reference: exact rational arithmetic on the arrival
+	times (seconds), no timestamp granularity"""
+	def __init__(self, prof, ts):
+		self.cir = prof.cir
+		self.pir = prof.pir
+		self.cbs = prof.cbs
+		self.ebs = prof.ebs
+		self.trtcm = prof.trtcm
+		self.color_aware = prof.color_aware
+		self.ts = ts
+		self.tc = float(self.cbs)
+		self.te = float(self.ebs)
+
+	def color(self, now, length, in_color):
+		delta = now - self.ts
+		self.ts = now
+		if not self.trtcm:
+			self.tc += delta * self.cir
+			if self.tc > self.cbs:
+				self.te = min(self.te + self.tc - self.cbs,
+					      self.ebs)
+				self.tc = self.cbs
+		else:
+			self.tc = min(self.tc + delta * self.cir, self.cbs)
+			self.te = min(self.te + delta * self.pir, self.ebs)
+		if not self.color_aware:
+			in_color = GREEN
+		return self.mark(length, in_color)
+
+def parse_rate(s):
+	"""bit/s with an optional k, M or G suffix -> bytes/s"""
+	mult = {"k": 1000, "K": 1000, "m": 1000000, "M": 1000000,
+		"g": 1000000000, "G": 1000000000}
+	try:
+		if s[-1] in mult:
+			return int(float(s[:-1]) * mult[s[-1]]) // 8
+		return int(float(s)) // 8
+	except (ValueError, IndexError):
+		raise BenchError("invalid rate '%s'" % s)
+
+def sizes(spec, rnd):
+	if spec == "imix":
+		bag = []
+		for (size, weight) in IMIX:
+			bag += [size] * weight
+		while True:
+			yield rnd.choice(bag)
+	size = int(spec)
+	if size <= 0:
+		raise BenchError("invalid packet size")
+	while True:
+		yield size
+
+def arrivals(pattern, rate, size_gen, duration, rnd):
+	"""Yields (time in seconds, length). rate in bytes/s."""
+	t = 0.0
+	on = True
+	# on/off: 10 ms periods, bursts at 4 times the average rate
+	period = 0.01
+	while t < duration:
+		length = next(size_gen)
+		if pattern == "cbr":
+			gap = float(length) / rate
+		elif pattern == "poisson":
+			gap = rnd.expovariate(float(rate) / length)
+		else:
+			gap = float(length) / (4 * rate)
+		if pattern == "onoff":
+			phase = t % period
+			if phase >= period / 4:
+				t += period - phase
+				continue
+		yield (t, length)
+		t += gap
+
+def run(prof, pattern, rate, size_spec, duration, num_meters, yellow,
+	seed):
+	"""Returns the per color [packets, bytes] of the fixed point model, the
+	number of packets, the packets colored differently by the exact model
+	and the time spent in the fixed point model"""
+	rnd = random.Random(seed)
+	size_gen = sizes(size_spec, rnd)
+	# Every meter gets the offered rate
+	events = []
+	for i in range(num_meters):
+		for (t, length) in arrivals(pattern, rate, size_gen, duration,
+					    random.Random(rnd.random())):
+			color = YELLOW if rnd.random() < yellow else GREEN
+			events.append((t, i, length, color))
+	events.sort()
+
+	fixed = [FixedMeter(prof, 0) for i in range(num_meters)]
+	stats = [[0, 0] for c in COLORS]
+	marked = []
+	start = time.time()
+	for (t, i, length, color) in events:
+		c = fixed[i].color(int(t * 1000000), length, color)
+		marked.append(c)
+	elapsed = time.time() - start
+
+	exact = [ExactMeter(prof, 0.0) for i in range(num_meters)]
+	mismatch = 0
+	for (n, (t, i, length, color)) in enumerate(events):
+		c = marked[n]
+		stats[c][0] += 1
+		stats[c][1] += length
+		if exact[i].color(t, length, color) != c:
+			mismatch += 1
+	return (stats, len(events), mismatch, elapsed)
+
+def expected(prof, offered):
+	"""Long term green and green+yellow rates (bytes/s) of a meter offered
+	'offered' bytes/s of uncolored traffic"""
+	green = min(offered, prof.cir)
+	if prof.trtcm:
+		return (green, min(offered, prof.pir))
+	# srTCM: the E bucket only gets the tokens overflowing the C bucket
+	return (green, green)
+
+def rate_str(bytes_per_s):
+	bits = bytes_per_s * 8.0
+	for (unit, div) in (("Gbps", 1e9), ("Mbps", 1e6), ("kbps", 1e3)):
+		if bits >= div:
+			return "%.3f %s" % (bits / div, unit)
+	return "%.0f bps" % bits
+
+def report(prof, stats, packets, mismatch, elapsed, duration, num_meters,
+	   offered, yellow):
+	print("Meter: %s, CIR %s, CBS %d, %s%s, %s" %
+	      ("trTCM" if prof.trtcm else "srTCM", rate_str(prof.cir),
+	       prof.cbs, ("PIR %s, " % rate_str(prof.pir)) if prof.trtcm
+	       else "", ("PBS %d" if prof.trtcm else "EBS %d") % prof.ebs,
+	       "color aware" if prof.color_aware else "color blind"))
+	print("Traffic: %d meter(s), %s offered per meter, %.3f s, "
+	      "%d packets" % (num_meters, rate_str(offered), duration,
+			      packets))
+	print("")
+	print("  Color      Packets          Bytes    Rate per meter")
+	for (c, name) in enumerate(COLORS):
+		print("  %-6s %11d %14d    %s" %
+		      (name, stats[c][0], stats[c][1],
+		       rate_str(float(stats[c][1]) / duration / num_meters)))
+	print("")
+	err = 0.0
+	if not yellow:
+		(green, green_yellow) = expected(prof, offered)
+		g = float(stats[GREEN][1]) / duration / num_meters
+		gy = float(stats[GREEN][1] + stats[YELLOW][1]) / duration / \
+		     num_meters
+		err = 100.0 * (g - green) / green
+		print("Green rate: %s, expected %s (%+.3f%%)" %
+		      (rate_str(g), rate_str(green), err))
+		if prof.trtcm:
+			print("Green+yellow rate: %s, expected %s (%+.3f%%)" %
+			      (rate_str(gy), rate_str(green_yellow),
+			       100.0 * (gy - green_yellow) / green_yellow))
+		print("  (the buckets are full at the start: the bursts add "
+		      "up to %d bytes per meter)" % (prof.cbs + prof.ebs))
+	print("Packets colored differently by the exact RFC model: %d "
+	      "(%.4f%%)" % (mismatch, 100.0 * mismatch / max(packets, 1)))
+	if elapsed > 0:
+		print("Host model: %.0f packets/s" % (packets / elapsed))
+	print("Per packet on the AIOP: 1 CDMA read with mutex lock (meter "
+	      "state), 1 CDMA read")
+	print("  (profile), 1 TMAN timestamp read, 1 CDMA write with mutex "
+	      "release, 1 STE counter increment")
+	return err
+
+def usage():
+	print("Usage: meter_bench.py [-a srtcm|trtcm] -c <cir> -C <cbs> "
+	      "[-p <pir>] -E <ebs|pbs> [-A]")
+	print("       [-r <rate>] [-s <size>|imix] [-t cbr|poisson|onoff] "
+	      "[-d <seconds>] [-m <meters>]")
+	print("       [-y <fraction>] [-S <seed>] [-T <tolerance>]")
+	print("  -a  algorithm (default srtcm)")
+	print("  -c  committed rate, bit/s with k, M or G suffix")
+	print("  -C  committed burst size (bytes)")
+	print("  -p  peak rate (trTCM)")
+	print("  -E  excess (srTCM) or peak (trTCM) burst size (bytes)")
+	print("  -A  color aware mode")
+	print("  -r  offered rate per meter (default 2 * CIR)")
+	print("  -s  packet size in bytes or 'imix' (default 1000)")
+	print("  -t  traffic pattern (default cbr)")
+	print("  -d  duration in seconds (default 1)")
+	print("  -m  number of meters (default 1)")
+	print("  -y  fraction of the packets pre-colored yellow "
+	      "(color aware mode)")
+	print("  -S  random seed (default 1)")
+	print("  -T  fails if the green rate error exceeds this percentage")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "ha:c:C:p:E:Ar:s:t:d:m:y:S:T:")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	algorithm = "srtcm"
+	cir = pir = offered = 0
+	cbs = ebs = 0
+	color_aware = False
+	size_spec = "1000"
+	pattern = "cbr"
+	duration = 1.0
+	num_meters = 1
+	yellow = 0.0
+	seed = 1
+	tolerance = None
+	try:
+		for (o, a) in opts:
+			if o == "-h":
+				usage()
+				return 0
+			if o == "-a":
+				algorithm = a.lower()
+			if o == "-c":
+				cir = parse_rate(a)
+			if o == "-C":
+				cbs = int(a, 0)
+			if o == "-p":
+				pir = parse_rate(a)
+			if o == "-E":
+				ebs = int(a, 0)
+			if o == "-A":
+				color_aware = True
+			if o == "-r":
+				offered = parse_rate(a)
+			if o == "-s":
+				size_spec = a
+			if o == "-t":
+				pattern = a
+			if o == "-d":
+				duration = float(a)
+			if o == "-m":
+				num_meters = int(a)
+			if o == "-y":
+				yellow = float(a)
+			if o == "-S":
+				seed = int(a)
+			if o == "-T":
+				tolerance = float(a)
+		if algorithm not in ("srtcm", "trtcm"):
+			raise BenchError("unknown algorithm '%s'" % algorithm)
+		if pattern not in ("cbr", "poisson", "onoff"):
+			raise BenchError("unknown pattern '%s'" % pattern)
+		if num_meters < 1 or duration <= 0:
+			raise BenchError("invalid number of meters or duration")
+		if yellow and not color_aware:
+			raise BenchError("-y needs the color aware mode (-A)")
+		prof = Profile(algorithm, cir, cbs, pir, ebs, color_aware)
+		prof.check()
+		if not offered:
+			offered = 2 * cir
+		(stats, packets, mismatch, elapsed) = run(prof, pattern,
+							  offered, size_spec,
+							  duration,
+							  num_meters, yellow,
+							  seed)
+	except (BenchError, ValueError) as e:
+		print("[ERROR]: %s" % e)
+		return 1
+	err = report(prof, stats, packets, mismatch, elapsed, duration,
+		     num_meters, offered, yellow)
+	if tolerance is not None and abs(err) > tolerance:
+		print("[ERROR]: green rate error above %.3f%%" % tolerance)
+		return 1
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
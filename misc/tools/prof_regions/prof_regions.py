@@ -0,0 +1,237 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side decoder of the AIOP SL profiling regions (fsl_prof.h).
+#
+# Reads the ".prof_regions" section and the region names from the AIOP ELF
+# image, decodes a memory dump of the section and prints per region call
+# counts, inclusive/exclusive time and elapsed time histograms.
+# See README.txt.
+
+from __future__ import print_function
+
+import sys
+import struct
+import getopt
+
+SECTION = ".prof_regions"
+
+# struct prof_region (fsl_prof.h), big endian
+PROF_HIST_BUCKETS = 16
+REGION_FMT = ">QQIIII%dI" % PROF_HIST_BUCKETS
+REGION_SIZE = struct.calcsize(REGION_FMT)
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+
+class ProfError(Exception):
+	pass
+
+class Elf(object):
+	"""Minimal ELF32 big endian reader: sections and symbols"""
+
+	def __init__(self, path):
+		self.data = open(path, "rb").read()
+		d = self.data
+		if d[:4] != b"\x7fELF" or d[4:5] != b"\x01" or \
+		   d[5:6] != b"\x02":
+			raise ProfError("%s: not an ELF32 big endian file" % path)
+		(shoff,) = struct.unpack_from(">I", d, 0x20)
+		(shentsize, shnum, shstrndx) = struct.unpack_from(">HHH", d,
+								  0x2E)
+		self.sections = []
+		for i in range(shnum):
+			self.sections.append(struct.unpack_from(">IIIIIIIIII", d,
+						shoff + i * shentsize))
+		strtab = self.sections[shstrndx]
+		self.names = [self.cstr(strtab[4] + s[0])
+			      for s in self.sections]
+		self.symbols = {}
+		for s in self.sections:
+			if s[1] != SHT_SYMTAB:
+				continue
+			names = self.sections[s[6]][4]
+			for off in range(s[4], s[4] + s[5], 16):
+				(name, value, size, info, other, shndx) = \
+					struct.unpack_from(">IIIBBH", d, off)
+				if name:
+					self.symbols.setdefault(value,
+						self.cstr(names + name))
+
+	def cstr(self, off):
+		end = self.data.index(b"\0", off)
+		return self.data[off:end].decode("ascii", "replace")
+
+	def section(self, name):
+		for (n, s) in zip(self.names, self.sections):
+			if n == name:
+				return s
+		return None
+
+	def string_at(self, addr):
+		"""C string at a target address, from the image contents"""
+		for s in self.sections:
+			if s[1] != SHT_NOBITS and s[3] and \
+			   s[3] <= addr < s[3] + s[5]:
+				return self.cstr(s[4] + addr - s[3])
+		return None
+
+class Region(object):
+	def __init__(self, elf, addr, image, raw):
+		# The name pointer is taken from the image, it is constant
+		name_ptr = struct.unpack_from(REGION_FMT, image)[2]
+		v = struct.unpack_from(REGION_FMT, raw)
+		(self.cycles, self.excl_cycles, _, self.calls,
+		 self.max_cycles) = v[:5]
+		self.hist = v[6:]
+		self.addr = addr
+		self.name = elf.string_at(name_ptr) or \
+			    elf.symbols.get(addr, "0x%08x" % addr)
+
+def read_regions(elf, dump, base):
+	sec = elf.section(SECTION)
+	if sec is None or not sec[5]:
+		raise ProfError("no %s section, build with ENABLE_PROF_REGIONS"
+				% SECTION)
+	addr, size = sec[3], sec[5]
+	image = elf.data[sec[4]:sec[4] + size]
+	if dump is None:
+		raw = image
+	else:
+		if base is None:
+			base = addr
+		off = addr - base
+		raw = open(dump, "rb").read()[off:off + size]
+		if off < 0 or len(raw) != size:
+			raise ProfError("dump does not cover %s at 0x%08x-0x%08x"
+					% (SECTION, addr, addr + size))
+	return [Region(elf, addr + i, image[i:i + REGION_SIZE],
+		       raw[i:i + REGION_SIZE])
+		for i in range(0, size - REGION_SIZE + 1, REGION_SIZE)]
+
+def bucket_range(i):
+	if i == 0:
+		return "< 32"
+	if i == PROF_HIST_BUCKETS - 1:
+		return ">= %d" % (1 << (i + 4))
+	return "%d-%d" % (1 << (i + 4), (1 << (i + 5)) - 1)
+
+def report(regions, scale, histograms):
+	total = sum(r.excl_cycles for r in regions) or 1
+	regions = sorted(regions, key=lambda r: r.excl_cycles, reverse=True)
+	print("%-28s %10s %14s %10s %14s %10s %10s %6s" %
+	      ("region", "calls", "incl", "incl/call", "excl", "excl/call",
+	       "max", "excl%"))
+	for r in regions:
+		calls = r.calls or 1
+		print("%-28s %10d %14d %10d %14d %10d %10d %5.1f%%" %
+		      (r.name, r.calls, r.cycles * scale,
+		       r.cycles * scale // calls, r.excl_cycles * scale,
+		       r.excl_cycles * scale // calls, r.max_cycles * scale,
+		       100.0 * r.excl_cycles / total))
+	if not histograms:
+		return
+	for r in regions:
+		if not r.calls:
+			continue
+		print("\n%s (time base ticks)" % r.name)
+		top = max(r.hist) or 1
+		for (i, n) in enumerate(r.hist):
+			if n:
+				print("  %-14s %10d %s" % (bucket_range(i), n,
+							  "#" * (n * 50 // top)))
+
+def csv(regions, scale):
+	print("region,calls,incl,excl,max," +
+	      ",".join("hist%d" % i for i in range(PROF_HIST_BUCKETS)))
+	for r in regions:
+		print("%s,%d,%d,%d,%d,%s" % (r.name, r.calls, r.cycles * scale,
+		      r.excl_cycles * scale, r.max_cycles * scale,
+		      ",".join(str(n) for n in r.hist)))
+
+def usage():
+	print("Usage: prof_regions.py [-l] [-a <base>] [-s <scale>] [-c] [-n] "
+	      "<aiop.elf> [<dump.bin>]")
+	print("  -l  list the regions and the memory range to dump")
+	print("  -a  target address of the first byte of the dump "
+	      "(default: %s address)" % SECTION)
+	print("  -s  core cycles per time base tick (default 1)")
+	print("  -c  CSV output")
+	print("  -n  no histograms")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "hla:s:cn")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	list_only = False
+	base = None
+	scale = 1
+	as_csv = False
+	histograms = True
+	for (o, a) in opts:
+		if o == "-h":
+			usage()
+			return 0
+		if o == "-l":
+			list_only = True
+		if o == "-a":
+			base = int(a, 0)
+		if o == "-s":
+			scale = int(a, 0)
+		if o == "-c":
+			as_csv = True
+		if o == "-n":
+			histograms = False
+	if len(args) not in (1, 2) or (len(args) == 1 and not list_only):
+		usage()
+		return 2
+
+	try:
+		elf = Elf(args[0])
+		regions = read_regions(elf, args[1] if len(args) > 1 else None,
+				       base)
+	except (ProfError, IOError, struct.error) as e:
+		print("[ERROR]: %s" % e)
+		return 1
+
+	if list_only:
+		sec = elf.section(SECTION)
+		print("%s: 0x%08x, %d bytes, %d regions" %
+		      (SECTION, sec[3], sec[5], len(regions)))
+		for r in regions:
+			print("  0x%08x %s" % (r.addr, r.name))
+		return 0
+	if as_csv:
+		csv(regions, scale)
+	else:
+		report(regions, scale, histograms)
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
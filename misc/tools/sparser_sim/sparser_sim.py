@@ -0,0 +1,1092 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side soft parser simulator and cycle estimator.
+#
+# Runs the soft parser byte-code (as generated with the sparser_gen API or
+# loaded with sparser_drv/dpni_drv) over the frames of a pcap file, fills a
+# Parse Result like the HW parser, and reports the per packet and per
+# instruction soft parser cycles. The instruction semantics are those of the
+# on target simulator (apps/sparser/src/sparser_disa.c), DPAA2 (Rev2)
+# instruction set. The hard HXSs are a simplified model.
+# See README.txt.
+
+from __future__ import print_function
+
+import os
+import re
+import sys
+import struct
+import getopt
+
+SP_MIN_PC = 0x20
+SP_MAX_PC = 0x7FD
+RET_TO_HARD_HXS = 0x7FE
+END_PARSING = 0x7FF
+DEST_ADDR_MASK = 0x7FF
+DEST_ADDR_SIGN_BIT = 0x400
+SP_LIB_PC = 0x73C
+
+# Frame bytes presented to the parser
+MAX_FRM_LEN = 256
+# Bound of the executed instructions when no cycle limit is given
+MAX_STEPS = 0x10000
+# Bound of the HXSs visited by a frame
+MAX_HXS = 64
+
+MASK64 = (1 << 64) - 1
+
+# Parse Array (RA) offsets
+RA_GPRV0 = 0
+RA_NXT_HDR = 16
+RA_FAF_EXT = 18
+RA_FAF = 20
+RA_SHIM1 = 32
+RA_SHIM2 = 33
+RA_IP_1_PID = 34
+RA_ETH = 35
+RA_LLC = 36
+RA_VLAN1 = 37
+RA_VLANN = 38
+RA_LAST_ETYPE = 39
+RA_PPPOE = 40
+RA_MPLS1 = 41
+RA_MPLSN = 42
+RA_L3 = 43
+RA_IPN = 44
+RA_GRE = 45
+RA_L4 = 46
+RA_L5 = 47
+RA_ROUTING1 = 48
+RA_ROUTING2 = 49
+RA_NXT_HDR_OFFSET = 50
+RA_IPV6_FRAG = 51
+RA_GROSS_RSUM = 52
+RA_RSUM = 54
+RA_PARSE_ERR = 56
+RA_NXT_HDR_BEFORE_FRAG = 57
+RA_IP_N_PID = 58
+RA_IP_LENGTH = 114
+RA_SIZE = 128
+
+OFFSET_FIELDS = (
+	("shim_offset_1", RA_SHIM1), ("shim_offset_2", RA_SHIM2),
+	("ip_1_pid_offset", RA_IP_1_PID), ("eth_offset", RA_ETH),
+	("llc_snap_offset", RA_LLC), ("vlan_tci1_offset", RA_VLAN1),
+	("vlan_tcin_offset", RA_VLANN),
+	("last_etype_offset", RA_LAST_ETYPE), ("pppoe_offset", RA_PPPOE),
+	("mpls_offset_1", RA_MPLS1), ("mpls_offset_n", RA_MPLSN),
+	("l3_offset", RA_L3), ("ipn_or_minencap_offset", RA_IPN),
+	("gre_offset", RA_GRE), ("l4_offset", RA_L4), ("l5_offset", RA_L5),
+	("routing_hdr_offset1", RA_ROUTING1),
+	("routing_hdr_offset2", RA_ROUTING2),
+	("nxt_hdr_offset", RA_NXT_HDR_OFFSET),
+	("ipv6_frag_offset", RA_IPV6_FRAG),
+	("nxt_hdr_before_ipv6_frag_ext", RA_NXT_HDR_BEFORE_FRAG),
+	("ip_n_pid_offset", RA_IP_N_PID))
+
+# Frame Attribute Flags (enum sparser_faf_bit), used by the HXS models
+FAF_PARSING_ERR = 9
+FAF_ETH_MAC = 10
+FAF_ETH_UCAST = 11
+FAF_ETH_MCAST = 12
+FAF_ETH_BCAST = 13
+FAF_VLAN_1 = 21
+FAF_VLAN_N = 22
+FAF_ARP = 30
+FAF_L2_UNKNOWN = 32
+FAF_IPV4_1 = 34
+FAF_IPV4_N = 38
+FAF_IPV6_1 = 42
+FAF_IPV6_N = 45
+FAF_IP_1_UNKNOWN = 49
+FAF_L3_UNKNOWN = 68
+FAF_UDP = 70
+FAF_TCP = 72
+FAF_L4_UNKNOWN = 85
+
+# Hard HXSs (DPAA2) : jump destination -> name
+HXS_NAMES = {
+	0x00: "eth", 0x01: "llc_snap", 0x02: "vlan", 0x03: "pppoe",
+	0x04: "mpls", 0x05: "arp", 0x06: "ip", 0x07: "ipv4", 0x08: "ipv6",
+	0x09: "gre", 0x0a: "minencap", 0x0b: "other_l3", 0x0c: "tcp",
+	0x0d: "udp", 0x0e: "ipsec", 0x0f: "sctp", 0x10: "dccp",
+	0x11: "other_l4", 0x12: "gtp", 0x13: "esp", 0x1e: "other_l5",
+	0x1f: "final"}
+HXS_IDS = dict((v, k) for (k, v) in HXS_NAMES.items())
+
+# Next header class selecting the next HXS (JMP_TO_Lx_PROTOCOL)
+NXT_ETYPE = 0
+NXT_IP_PROTO = 1
+NXT_PORT = 2
+
+class SimError(Exception):
+	pass
+
+class ParseError(Exception):
+	"""Ends the parsing of the current frame"""
+	pass
+
+def dispatch(cls, nxt):
+	"""Next hard HXS for a next header value (JMP_TO_Lx_PROTOCOL)"""
+	if cls == NXT_ETYPE:
+		if nxt <= 0x05DC:
+			return "llc_snap"
+		return {0x0800: "ipv4", 0x0806: "arp", 0x86DD: "ipv6",
+			0x8847: "mpls", 0x8848: "mpls", 0x8100: "vlan",
+			0x88A8: "vlan", 0x8864: "pppoe"}.get(nxt, "other_l3")
+	if cls == NXT_IP_PROTO:
+		return {4: "ipv4", 6: "tcp", 17: "udp", 33: "dccp",
+			41: "ipv6", 47: "gre", 50: "ipsec", 51: "ipsec",
+			55: "minencap", 132: "sctp"}.get(nxt, "other_l4")
+	return {2123: "gtp", 2152: "gtp", 3386: "gtp", 4500: "esp",
+		4789: "other_l5"}.get(nxt, "other_l5")
+
+class Frame(object):
+	"""Parsing state of one frame"""
+
+	def __init__(self, data):
+		self.frm = bytearray(data[:MAX_FRM_LEN])
+		self.ra = bytearray(RA_SIZE)
+		for (name, off) in OFFSET_FIELDS:
+			self.ra[off] = 0xff
+		self.hb = 0
+		self.wo = 0
+		self.wr = [0, 0]
+		self.pc_ret = 0
+		self.cycles = 0
+		self.sp_calls = 0
+		self.hxs = []
+		self.unmodeled = []
+		self.error = None
+		self.pclim = False
+		self.truncated = False
+
+	def ra_get(self, off, n):
+		v = 0
+		for b in self.ra[off:off + n]:
+			v = (v << 8) | b
+		return v
+
+	def ra_put(self, off, n, v):
+		for i in range(n):
+			self.ra[off + n - 1 - i] = (v >> (8 * i)) & 0xff
+
+	def byte(self, off):
+		return self.frm[off] if off < len(self.frm) else 0
+
+	def bytes_be(self, off, n):
+		v = 0
+		for i in range(n):
+			v = (v << 8) | self.byte(off + i)
+		return v
+
+	def faf_bit(self, j):
+		if j < 96:
+			return RA_FAF + j // 8, 7 - j % 8
+		return RA_FAF_EXT + (j // 8 - 12), 7 - j % 8
+
+	def set_faf(self, j, val=1):
+		(off, bit) = self.faf_bit(j)
+		if val:
+			self.ra[off] |= 1 << bit
+		else:
+			self.ra[off] &= ~(1 << bit) & 0xff
+
+	def faf(self, j):
+		(off, bit) = self.faf_bit(j)
+		return (self.ra[off] >> bit) & 1
+
+	def advance(self):
+		self.hb += self.wo
+		self.wo = 0
+		self.wr = [0, 0]
+
+# Hard HXS models. Each one fills its Parse Result fields, the next header
+# value and offset, and returns the next header class (None ends parsing).
+
+def hxs_eth(f, hb):
+	f.ra[RA_ETH] = hb
+	f.set_faf(FAF_ETH_MAC)
+	if f.frm[hb:hb + 6] == bytearray(b"\xff" * 6):
+		f.set_faf(FAF_ETH_BCAST)
+	elif f.byte(hb) & 1:
+		f.set_faf(FAF_ETH_MCAST)
+	else:
+		f.set_faf(FAF_ETH_UCAST)
+	f.ra[RA_LAST_ETYPE] = hb + 12
+	f.ra_put(RA_NXT_HDR, 2, f.bytes_be(hb + 12, 2))
+	f.ra[RA_NXT_HDR_OFFSET] = hb + 14
+	return NXT_ETYPE
+
+def hxs_vlan(f, hb):
+	if f.ra[RA_VLAN1] == 0xff:
+		f.ra[RA_VLAN1] = hb
+		f.set_faf(FAF_VLAN_1)
+	else:
+		f.ra[RA_VLANN] = hb
+		f.set_faf(FAF_VLAN_N)
+	f.ra[RA_LAST_ETYPE] = hb + 2
+	f.ra_put(RA_NXT_HDR, 2, f.bytes_be(hb + 2, 2))
+	f.ra[RA_NXT_HDR_OFFSET] = hb + 4
+	return NXT_ETYPE
+
+def hxs_arp(f, hb):
+	f.ra[RA_L3] = hb
+	f.set_faf(FAF_ARP)
+	return None
+
+def hxs_ip_common(f, hb, proto, hlen, first, nth):
+	if f.ra[RA_L3] == 0xff:
+		f.ra[RA_L3] = hb
+		f.set_faf(first)
+		pid = RA_IP_1_PID
+	else:
+		f.ra[RA_IPN] = hb
+		f.set_faf(nth)
+		pid = RA_IP_N_PID
+	f.ra_put(RA_NXT_HDR, 2, proto)
+	f.ra[RA_NXT_HDR_OFFSET] = (hb + hlen) & 0xff
+	return pid
+
+def hxs_ipv4(f, hb):
+	ihl = (f.byte(hb) & 0x0f) * 4
+	pid = hxs_ip_common(f, hb, f.byte(hb + 9), ihl, FAF_IPV4_1, FAF_IPV4_N)
+	f.ra[pid] = hb + 9
+	if pid == RA_IP_1_PID:
+		f.ra_put(RA_IP_LENGTH, 2, f.bytes_be(hb + 2, 2))
+	if f.bytes_be(hb + 6, 2) & 0x3fff:
+		# Fragment : no L4 parsing
+		return None
+	return NXT_IP_PROTO
+
+def hxs_ipv6(f, hb):
+	pid = hxs_ip_common(f, hb, f.byte(hb + 6), 40, FAF_IPV6_1, FAF_IPV6_N)
+	f.ra[pid] = hb + 6
+	if pid == RA_IP_1_PID:
+		f.ra_put(RA_IP_LENGTH, 2, f.bytes_be(hb + 4, 2))
+	if f.byte(hb + 6) in (0, 43, 44, 60, 135):
+		# Extension headers are not modeled
+		f.unmodeled.append("ipv6_ext")
+		return None
+	return NXT_IP_PROTO
+
+def hxs_tcp(f, hb):
+	f.ra[RA_L4] = hb
+	f.set_faf(FAF_TCP)
+	f.ra_put(RA_NXT_HDR, 2, f.bytes_be(hb + 2, 2))
+	f.ra[RA_NXT_HDR_OFFSET] = (hb + (f.byte(hb + 12) >> 4) * 4) & 0xff
+	return NXT_PORT
+
+def hxs_udp(f, hb):
+	f.ra[RA_L4] = hb
+	f.set_faf(FAF_UDP)
+	f.ra_put(RA_NXT_HDR, 2, f.bytes_be(hb + 2, 2))
+	f.ra[RA_NXT_HDR_OFFSET] = (hb + 8) & 0xff
+	return NXT_PORT
+
+def hxs_other_l3(f, hb):
+	f.set_faf(FAF_L3_UNKNOWN if f.ra[RA_L3] != 0xff else FAF_L2_UNKNOWN)
+	return None
+
+def hxs_other_l4(f, hb):
+	f.set_faf(FAF_L4_UNKNOWN if f.ra[RA_L3] != 0xff else
+		  FAF_IP_1_UNKNOWN)
+	return None
+
+def hxs_other_l5(f, hb):
+	if hb < len(f.frm):
+		f.ra[RA_L5] = hb
+	return None
+
+def hxs_final(f, hb):
+	return None
+
+HXS_MODELS = {
+	"eth": hxs_eth, "vlan": hxs_vlan, "arp": hxs_arp, "ipv4": hxs_ipv4,
+	"ipv6": hxs_ipv6, "tcp": hxs_tcp, "udp": hxs_udp,
+	"other_l3": hxs_other_l3, "other_l4": hxs_other_l4,
+	"other_l5": hxs_other_l5, "final": hxs_final}
+
+def dest_str(d):
+	s = ""
+	if d & 0x8000:
+		s += "G:"
+	if d & 0x4000:
+		off = d & 0x3ff
+		return s + ("-" if d & DEST_ADDR_SIGN_BIT else "+") + str(off)
+	d &= DEST_ADDR_MASK
+	if d == RET_TO_HARD_HXS:
+		return s + "RETURN_HXS"
+	if d == END_PARSING:
+		return s + "END_PARSING"
+	if d < SP_MIN_PC:
+		return s + HXS_NAMES.get(d, "0x%02x" % d).upper()
+	return s + "0x%03x" % d
+
+class Sim(object):
+	"""Soft parser instruction interpreter (DPAA2)"""
+
+	def __init__(self, pclim):
+		self.code = {}
+		self.pclim = pclim
+		self.exec_count = {}
+		# (syn, mask, length(op), name, handler)
+		self.table = [
+			(0x0007, 0xffff, "RETURN_SUB", self.i_return_sub),
+			(0x0300, 0xff00, "SET_CLR_FAF", self.i_set_clr_faf),
+			(0x0c00, 0xff00, "JMP_FAF", self.i_jump_faf),
+			(0x1800, 0xfffc, "JMP", self.i_jump),
+			(0x0000, 0xffff, "NOP", self.i_nop),
+			(0x0002, 0xffff, "ADVANCE_HB_BY_WO", self.i_advance),
+			(0x0004, 0xfffe, "ZERO_WR", self.i_zero_wr),
+			(0x0006, 0xffff, "CHECKSUM16", self.i_checksum16),
+			(0x0008, 0xfffc, "CASE1_DJ", self.i_case1_dj),
+			(0x000c, 0xfffc, "CASE2_DC", self.i_case2_dc),
+			(0x0010, 0xfff8, "CASE2_DJ", self.i_case2_dj),
+			(0x0018, 0xfff8, "CASE3_DC", self.i_case3_dc),
+			(0x0020, 0xfff0, "CASE3_DJ", self.i_case3_dj),
+			(0x0030, 0xfff0, "CASE4_DC", self.i_case4_dc),
+			(0x0044, 0xfffc, "JMP_TO_PROTOCOL", self.i_jump_proto),
+			(0x0048, 0xfff8, "ADD_SUB_WR_WR", self.i_add_sub_wr_wr),
+			(0x0050, 0xfff0, "ADD_SUB_WR_IV", self.i_add_sub_wr_iv),
+			(0x0070, 0xfff8, "BITWISE_WR_WR", self.i_bitwise_wr_wr),
+			(0x0078, 0xfff8, "CMP_WR0_WR1", self.i_cmp),
+			(0x0080, 0xfffc, "MODIFY_WO_BY_WR", self.i_modify_wo),
+			(0x00c0, 0xffc0, "BITWISE_WR_IV", self.i_bitwise_wr_iv),
+			(0x0100, 0xff80, "SHL_WR", self.i_shl),
+			(0x0180, 0xff80, "SHR_WR", self.i_shr),
+			(0x0200, 0xff00, "LD_IMM_BITS", self.i_load_bits_iv),
+			(0x0600, 0xff00, "LD_SV_TO_WO", self.i_load_sv_to_wo),
+			(0x0700, 0xff00, "ADD_SV_TO_WO", self.i_add_sv_to_wo),
+			(0x0800, 0xfc00, "ST_IMM_TO_RA", self.i_store_iv_to_ra),
+			(0x1000, 0xf800, "LD_PA_TO_WR", self.i_load_bytes_pa),
+			(0x2800, 0xf800, "ST_WR_TO_RA", self.i_store_wr_to_ra),
+			(0x3000, 0xf000, "LD_RA_TO_WR", self.i_load_bytes_ra),
+			(0x8000, 0x8000, "LD_FW_TO_WR", self.i_load_bits_fw)]
+
+	def load(self, pc, data):
+		if len(data) % 2:
+			raise SimError("byte-code size (%d) is not even" % len(data))
+		for i in range(0, len(data), 2):
+			if pc + i // 2 > SP_MAX_PC:
+				raise SimError("byte-code exceeds PC 0x%03x" %
+					       SP_MAX_PC)
+			self.code[pc + i // 2] = (data[i] << 8) | data[i + 1]
+
+	def word(self, pc):
+		if pc not in self.code:
+			raise ParseError("no byte-code at PC 0x%03x" % pc)
+		return self.code[pc]
+
+	def decode(self, op):
+		for (syn, mask, name, handler) in self.table:
+			if op & mask == syn:
+				return (name, handler)
+		return (None, None)
+
+	def iv(self, n):
+		"""Immediate value of n words, least significant word first"""
+		v = 0
+		for i in range(n):
+			v |= self.word(self.pc + 1 + i) << (16 * i)
+		return v
+
+	def next(self, n):
+		self.pc += n
+
+	# Jump handling, returns the next state for run()
+	def goto(self, dest, a, length):
+		f = self.f
+		pc_orig = self.pc
+		g = (dest >> 15) & 1
+		if (dest >> 14) & 1:
+			off = dest & DEST_ADDR_MASK
+			if not off:
+				raise ParseError("null offset relative jump at "
+						 "PC 0x%03x" % pc_orig)
+			if off & DEST_ADDR_SIGN_BIT:
+				jmp = pc_orig - (off & ~DEST_ADDR_SIGN_BIT)
+			else:
+				jmp = pc_orig + off
+		else:
+			jmp = dest & DEST_ADDR_MASK
+			if jmp == pc_orig and not a:
+				raise ParseError("jump on the same PC 0x%03x" %
+						 pc_orig)
+		if a:
+			f.advance()
+		if jmp < SP_MIN_PC:
+			if jmp not in HXS_NAMES:
+				raise ParseError("invalid HXS 0x%02x at PC 0x%03x"
+						 % (jmp, pc_orig))
+			# The hard HXS does the advancement
+			f.advance()
+			f.pc_ret = 0
+			self.hxs_next = HXS_NAMES[jmp]
+			return False
+		if jmp == END_PARSING:
+			self.hxs_next = None
+			return False
+		if jmp == RET_TO_HARD_HXS:
+			self.hxs_next = "return"
+			return False
+		if g:
+			if f.pc_ret:
+				raise ParseError("nested gosub at PC 0x%03x" %
+						 pc_orig)
+			f.pc_ret = pc_orig + length
+		self.pc = jmp
+		return True
+
+	def i_return_sub(self, op):
+		f = self.f
+		if not f.pc_ret:
+			raise ParseError("return without gosub at PC 0x%03x" %
+					 self.pc)
+		self.pc = f.pc_ret
+		f.pc_ret = 0
+		return True
+
+	def i_set_clr_faf(self, op):
+		self.f.set_faf(op & 0x7f, (op >> 7) & 1)
+		self.next(1)
+		return True
+
+	def i_jump_faf(self, op):
+		if self.f.faf(op & 0x7f):
+			return self.goto(self.word(self.pc + 1), (op >> 7) & 1, 2)
+		self.next(2)
+		return True
+
+	def i_jump(self, op):
+		return self.goto(self.word(self.pc + 1), op & 1, 2)
+
+	def i_nop(self, op):
+		self.next(1)
+		return True
+
+	def i_advance(self, op):
+		self.f.advance()
+		self.next(1)
+		return True
+
+	def i_zero_wr(self, op):
+		self.f.wr[op & 1] = 0
+		self.next(1)
+		return True
+
+	def i_checksum16(self, op):
+		wr = self.f.wr
+		s = wr[0] & 0xffff
+		for i in range(4):
+			s += (wr[1] >> (16 * i)) & 0xffff
+		while s >> 16:
+			s = (s & 0xffff) + (s >> 16)
+		wr[0] = (wr[0] & ~0xffff & MASK64) | s
+		self.next(1)
+		return True
+
+	def i_case(self, op, n, dj):
+		"""Compares WR0[48:63] to the 'n' right most 16-bit words of
+		WR1. 'dj' : jumps to the default destination on no match"""
+		length = 1 + n + (1 if dj else 0)
+		wr = self.f.wr
+		key = wr[0] & 0xffff
+		for i in range(n):
+			if key == (wr[1] >> (16 * i)) & 0xffff:
+				return self.goto(self.word(self.pc + 1 + i),
+						 (op >> i) & 1, length)
+		if dj:
+			return self.goto(self.word(self.pc + 1 + n),
+					 (op >> n) & 1, length)
+		self.next(length)
+		return True
+
+	def i_case1_dj(self, op):
+		return self.i_case(op, 1, True)
+
+	def i_case2_dc(self, op):
+		return self.i_case(op, 2, False)
+
+	def i_case2_dj(self, op):
+		return self.i_case(op, 2, True)
+
+	def i_case3_dc(self, op):
+		return self.i_case(op, 3, False)
+
+	def i_case3_dj(self, op):
+		return self.i_case(op, 3, True)
+
+	def i_case4_dc(self, op):
+		return self.i_case(op, 4, False)
+
+	def i_jump_proto(self, op):
+		p = op & 3
+		if p == 3:
+			p = 0
+		f = self.f
+		f.advance()
+		f.pc_ret = 0
+		self.hxs_next = dispatch(p, f.ra_get(RA_NXT_HDR, 2))
+		return False
+
+	def i_add_sub_wr_wr(self, op):
+		wr = self.f.wr
+		l = op & 1
+		o = (op >> 1) & 1
+		v = (op >> 2) & 1
+		op1 = wr[l] & 0xffffffff
+		op2 = wr[1 - l] & 0xffffffff
+		res = (op1 - op2 if o else op1 + op2) & 0xffffffff
+		wr[v] = (wr[v] & ~0xffffffff & MASK64) | res
+		self.next(1)
+		return True
+
+	def i_add_sub_wr_iv(self, op):
+		wr = self.f.wr
+		w = op & 1
+		o = (op >> 1) & 1
+		v = (op >> 2) & 1
+		s = (op >> 3) & 1
+		imm = self.iv(s + 1) & 0xffffffff
+		src = wr[w] & 0xffffffff
+		res = (src - imm if o else src + imm) & 0xffffffff
+		wr[v] = (wr[v] & ~0xffffffff & MASK64) | res
+		self.next(2 + s)
+		return True
+
+	def bitwise(self, f, a, b):
+		if f == 0:
+			return a | b
+		if f == 1:
+			return a & b
+		if f == 2:
+			return a ^ b
+		return 0
+
+	def i_bitwise_wr_wr(self, op):
+		wr = self.f.wr
+		wr[op & 1] = self.bitwise((op >> 1) & 3, wr[0], wr[1])
+		self.next(1)
+		return True
+
+	def i_bitwise_wr_iv(self, op):
+		wr = self.f.wr
+		i = (op >> 3) & 3
+		wr[(op >> 5) & 1] = self.bitwise((op >> 1) & 3, wr[op & 1],
+						 self.iv(i + 1))
+		self.next(2 + i)
+		return True
+
+	def i_cmp(self, op):
+		wr = self.f.wr
+		c = op & 7
+		cond = {0: wr[0] == wr[1], 1: wr[0] != wr[1],
+			2: wr[0] > wr[1], 3: wr[0] < wr[1],
+			4: wr[0] >= wr[1], 5: wr[0] <= wr[1]}.get(c, False)
+		if cond:
+			return self.goto(self.word(self.pc + 1), 0, 2)
+		self.next(2)
+		return True
+
+	def i_modify_wo(self, op):
+		f = self.f
+		val = f.wr[op & 1] & 0xff
+		if (op >> 1) & 1:
+			f.wo = (f.wo + val) & 0xff
+		else:
+			f.wo = val
+		self.next(1)
+		return True
+
+	def i_shl(self, op):
+		wr = self.f.wr
+		w = op & 1
+		wr[w] = (wr[w] << (((op >> 1) & 0x3f) + 1)) & MASK64
+		self.next(1)
+		return True
+
+	def i_shr(self, op):
+		wr = self.f.wr
+		w = op & 1
+		wr[w] >>= ((op >> 1) & 0x3f) + 1
+		self.next(1)
+		return True
+
+	def load_wr(self, w, s, nbits, val):
+		wr = self.f.wr
+		val &= (1 << nbits) - 1
+		if not s:
+			wr[w] = val
+		elif nbits >= 64:
+			wr[w] = val
+		else:
+			wr[w] = ((wr[w] << nbits) | val) & MASK64
+
+	def i_load_bits_iv(self, op):
+		n = (op >> 1) & 0x3f
+		self.load_wr(op & 1, (op >> 7) & 1, n + 1, self.iv(n // 16 + 1))
+		self.next(n // 16 + 2)
+		return True
+
+	def i_load_sv_to_wo(self, op):
+		self.f.wo = op & 0xff
+		self.next(1)
+		return True
+
+	def i_add_sv_to_wo(self, op):
+		self.f.wo = (self.f.wo + (op & 0xff)) & 0xff
+		self.next(1)
+		return True
+
+	def i_store_iv_to_ra(self, op):
+		t = op & 0x7f
+		s = (op >> 7) & 7
+		if t < s:
+			raise ParseError("RA store out of range at PC 0x%03x" %
+					 self.pc)
+		self.f.ra_put(t - s, s + 1, self.iv(s // 2 + 1))
+		self.next(s // 2 + 2)
+		return True
+
+	def i_load_bytes_pa(self, op):
+		j = (op >> 4) & 0x3f
+		k = (op >> 1) & 7
+		if j < k:
+			raise ParseError("PA load out of range at PC 0x%03x" %
+					 self.pc)
+		v = 0
+		for b in self.pa[j - k:j + 1]:
+			v = (v << 8) | b
+		self.load_wr(op & 1, (op >> 10) & 1, 8 * (k + 1), v)
+		self.next(1)
+		return True
+
+	def i_store_wr_to_ra(self, op):
+		t = (op >> 1) & 0x7f
+		s = (op >> 8) & 7
+		if t < s:
+			raise ParseError("RA store out of range at PC 0x%03x" %
+					 self.pc)
+		self.f.ra_put(t - s, s + 1, self.f.wr[op & 1])
+		self.next(1)
+		return True
+
+	def i_load_bytes_ra(self, op):
+		j = (op >> 4) & 0x7f
+		k = (op >> 1) & 7
+		if j < k:
+			raise ParseError("RA load out of range at PC 0x%03x" %
+					 self.pc)
+		self.load_wr(op & 1, (op >> 11) & 1, 8 * (k + 1),
+			     self.f.ra_get(j - k, k + 1))
+		self.next(1)
+		return True
+
+	def i_load_bits_fw(self, op):
+		f = self.f
+		m = (op >> 7) & 0x7f
+		n = (op >> 1) & 0x3f
+		if m < n:
+			raise ParseError("invalid frame window load at PC 0x%03x"
+					 % self.pc)
+		start = f.hb + f.wo
+		if start + (m + 8) // 8 > len(f.frm):
+			f.truncated = True
+		fw = f.bytes_be(start, 16)
+		self.load_wr(op & 1, (op >> 14) & 1, n + 1, fw >> (127 - m))
+		self.next(1)
+		return True
+
+	def run_sp(self, f, pc):
+		"""Runs the soft parser from 'pc'. Returns the next HXS name,
+		"return" or None (end of parsing)"""
+		self.f = f
+		self.pc = pc
+		self.hxs_next = None
+		f.sp_calls += 1
+		steps = MAX_STEPS
+		while True:
+			if self.pclim and f.cycles >= self.pclim:
+				f.pclim = True
+				raise ParseError("cycle limit (%d) exceeded at PC "
+						 "0x%03x" % (self.pclim, self.pc))
+			if not steps:
+				raise ParseError("more than %d instructions, loop "
+						 "at PC 0x%03x ?" %
+						 (MAX_STEPS, self.pc))
+			steps -= 1
+			op = self.word(self.pc)
+			(name, handler) = self.decode(op)
+			if not handler:
+				raise ParseError("invalid opcode 0x%04x at PC "
+						 "0x%03x" % (op, self.pc))
+			f.cycles += 1
+			self.exec_count[self.pc] = \
+				self.exec_count.get(self.pc, 0) + 1
+			if not handler(op):
+				return self.hxs_next
+
+	def parse(self, data, link, start_pc):
+		"""Parses one frame. 'link' is the hard HXS the soft parser is
+		linked to (None for a custom header first)"""
+		f = Frame(data)
+		try:
+			if link is None:
+				f.hxs.append("sp")
+				hxs = self.run_sp(f, start_pc)
+				if hxs == "return":
+					raise ParseError("return to hard HXS "
+							 "from a first header")
+				hb = f.hb
+			else:
+				(hxs, hb) = ("eth", 0)
+			while hxs is not None:
+				if len(f.hxs) >= MAX_HXS:
+					raise ParseError("too many HXSs")
+				f.hxs.append(hxs)
+				model = HXS_MODELS.get(hxs)
+				if model is None:
+					f.unmodeled.append(hxs)
+					break
+				cls = model(f, hb)
+				if hxs == link:
+					f.hb = hb
+					f.wo = 0
+					f.wr = [0, 0]
+					f.pc_ret = 0
+					f.hxs.append("sp")
+					nxt = self.run_sp(f, start_pc)
+					if nxt != "return":
+						hxs = nxt
+						hb = f.hb
+						continue
+				if cls is None:
+					break
+				hb = f.ra[RA_NXT_HDR_OFFSET]
+				hxs = dispatch(cls, f.ra_get(RA_NXT_HDR, 2))
+		except ParseError as e:
+			f.error = str(e)
+			f.set_faf(FAF_PARSING_ERR)
+		return f
+
+	def disasm(self, pc):
+		op = self.code.get(pc)
+		if op is None:
+			return "?"
+		(name, handler) = self.decode(op)
+		if name is None:
+			return "INVALID 0x%04x" % op
+		if name in ("JMP", "JMP_FAF", "CMP_WR0_WR1") and \
+		   pc + 1 in self.code:
+			extra = " " + dest_str(self.code[pc + 1])
+			if name == "JMP_FAF":
+				extra = " %d," % (op & 0x7f) + extra
+			return name + extra
+		if name == "SET_CLR_FAF":
+			return ("SET_FAF" if (op >> 7) & 1 else "CLR_FAF") + \
+				" %d" % (op & 0x7f)
+		if name == "LD_FW_TO_WR":
+			m = (op >> 7) & 0x7f
+			n = (op >> 1) & 0x3f
+			return "LD%s_FW_TO_WR%d %d, %d" % \
+				("S" if (op >> 14) & 1 else "", op & 1, m - n,
+				 n + 1)
+		if name in ("LD_PA_TO_WR", "LD_RA_TO_WR"):
+			j = (op >> 4) & (0x3f if name == "LD_PA_TO_WR" else 0x7f)
+			k = (op >> 1) & 7
+			s = (op >> (10 if name == "LD_PA_TO_WR" else 11)) & 1
+			return "LD%s_%s%d %d, %d" % ("S" if s else "", name[3:],
+						    op & 1, j - k, k + 1)
+		if name == "ST_WR_TO_RA":
+			t = (op >> 1) & 0x7f
+			s = (op >> 8) & 7
+			return "ST_WR%d_TO_RA %d, %d" % (op & 1, t - s, s + 1)
+		if name in ("ZERO_WR", "MODIFY_WO_BY_WR", "SHL_WR", "SHR_WR"):
+			return "%s%d" % (name, op & 1)
+		if name in ("LD_SV_TO_WO", "ADD_SV_TO_WO"):
+			return "%s %d" % (name, op & 0xff)
+		if name == "JMP_TO_PROTOCOL":
+			return "JMP_TO_L%d_PROTOCOL" % ((op & 3) % 3 + 2)
+		return name
+
+# Input files
+
+def strip_c_comments(text):
+	text = re.sub(r"/\*.*?\*/", " ", text, flags=re.S)
+	return re.sub(r"//[^\n]*", " ", text)
+
+def read_c_array(path, name):
+	"""Values of the initializer of the first 'name[]' array in a C file"""
+	text = strip_c_comments(open(path).read())
+	m = re.search(r"\b%s\s*\[[^\]]*\]\s*(__attribute__\s*\(\(.*?\)\)\s*)?"
+		      r"=\s*\{(.*?)\}" % re.escape(name), text, re.S)
+	if not m:
+		raise SimError("%s: array %s not found" % (path, name))
+	vals = [v.strip() for v in m.group(2).split(",")]
+	try:
+		return bytearray(int(v, 0) & 0xff for v in vals if v)
+	except ValueError:
+		raise SimError("%s: %s is not a byte array" % (path, name))
+
+def split_pc(spec, default):
+	if "@" in spec:
+		(spec, pc) = spec.rsplit("@", 1)
+		return spec, int(pc, 0)
+	return spec, default
+
+def read_bytes(spec):
+	"""'file.c:array', binary file or hex string"""
+	if ":" in spec:
+		(path, name) = spec.rsplit(":", 1)
+		if os.path.isfile(path):
+			return read_c_array(path, name)
+	if os.path.isfile(spec):
+		return bytearray(open(spec, "rb").read())
+	try:
+		return bytearray.fromhex(spec.replace(":", "").replace(" ", ""))
+	except ValueError:
+		raise SimError("%s: not a file, C array or hex string" % spec)
+
+def read_pcap(path):
+	d = bytearray(open(path, "rb").read())
+	if len(d) < 24:
+		raise SimError("%s: not a pcap file" % path)
+	magic = bytes(d[:4])
+	if magic in (b"\xd4\xc3\xb2\xa1", b"\x4d\x3c\xb2\xa1"):
+		e = "<"
+	elif magic in (b"\xa1\xb2\xc3\xd4", b"\xa1\xb2\x3c\x4d"):
+		e = ">"
+	else:
+		raise SimError("%s: not a pcap file (pcapng is not supported)"
+			       % path)
+	(linktype,) = struct.unpack_from(e + "I", d, 20)
+	if linktype != 1:
+		raise SimError("%s: link type %d is not Ethernet" %
+			       (path, linktype))
+	frames = []
+	off = 24
+	while off + 16 <= len(d):
+		(sec, frac, incl, orig) = struct.unpack_from(e + "IIII", d, off)
+		off += 16
+		frames.append(bytes(d[off:off + incl]))
+		off += incl
+	return frames
+
+def is_pcap(path):
+	if not os.path.isfile(path):
+		return False
+	with open(path, "rb") as fp:
+		return fp.read(4) in (b"\xd4\xc3\xb2\xa1", b"\x4d\x3c\xb2\xa1",
+				      b"\xa1\xb2\xc3\xd4", b"\xa1\xb2\x3c\x4d")
+
+def read_faf_names(path):
+	"""enum sparser_faf_bit names, from fsl_sparser_gen.h"""
+	names = {}
+	try:
+		text = open(path).read()
+	except IOError:
+		return names
+	for (name, val) in re.findall(r"\bsp_faf_(\w+)\s*=\s*(\d+)", text):
+		names[int(val)] = name
+	return names
+
+# Reports
+
+def print_frame(i, f, faf_names, length):
+	print("Frame %d: %d bytes, %d cycles, HXS: %s" %
+	      (i, length, f.cycles, " ".join(f.hxs)))
+	if f.error:
+		print("  ERROR: %s" % f.error)
+	if f.unmodeled:
+		print("  not modeled: %s" % " ".join(f.unmodeled))
+	if f.truncated:
+		print("  frame window read after the end of the frame")
+	for (name, off) in OFFSET_FIELDS:
+		if f.ra[off] != 0xff:
+			print("  %-28s %d" % (name, f.ra[off]))
+	print("  %-28s 0x%04x" % ("nxt_hdr", f.ra_get(RA_NXT_HDR, 2)))
+	if f.ra_get(RA_RSUM, 2):
+		print("  %-28s 0x%04x" % ("running_sum",
+					     f.ra_get(RA_RSUM, 2)))
+	gprv = [f.ra_get(RA_GPRV0 + 2 * j, 2) for j in range(8)]
+	if any(gprv):
+		print("  %-28s %s" % ("gprv0..7",
+				      " ".join("%04x" % v for v in gprv)))
+	fafs = [j for j in range(104) if f.faf(j)]
+	print("  faf: %s" % ", ".join(faf_names.get(j, str(j)) for j in fafs))
+
+def report(sim, frames, results, faf_names, verbose):
+	if verbose:
+		for (i, f) in enumerate(results):
+			print_frame(i, f, faf_names, len(frames[i]))
+		print("")
+	cycles = [f.cycles for f in results]
+	total = sum(cycles)
+	print("Frames: %d, soft parser invocations: %d" %
+	      (len(results), sum(f.sp_calls for f in results)))
+	if cycles:
+		print("Soft parser cycles per frame: min %d, avg %.1f, max %d"
+		      % (min(cycles), float(total) / len(cycles), max(cycles)))
+	errors = [i for (i, f) in enumerate(results) if f.error]
+	over = [i for (i, f) in enumerate(results) if f.pclim]
+	if sim.pclim:
+		print("Cycle limit %d: %d frames exceeded" %
+		      (sim.pclim, len(over)))
+	if errors:
+		print("Frames with errors: %d (first: frame %d, %s)" %
+		      (len(errors), errors[0], results[errors[0]].error))
+	unmodeled = {}
+	for f in results:
+		for h in f.unmodeled:
+			unmodeled[h] = unmodeled.get(h, 0) + 1
+	if unmodeled:
+		print("Not modeled HXSs (parsing ended): %s" %
+		      ", ".join("%s %d" % (h, unmodeled[h])
+				for h in sorted(unmodeled)))
+	print("")
+	print("   PC  Opcode  Executed  %Cycles  Instruction")
+	for pc in sorted(sim.exec_count):
+		n = sim.exec_count[pc]
+		print("0x%03x  0x%04x %9d  %6.2f%%  %s" %
+		      (pc, sim.code[pc], n, 100.0 * n / total if total else 0,
+		       sim.disasm(pc)))
+
+def csv(results, frames):
+	print("frame,length,cycles,hxs,error")
+	for (i, f) in enumerate(results):
+		print("%d,%d,%d,%s,%s" % (i, len(frames[i]), f.cycles,
+					  " ".join(f.hxs), f.error or ""))
+
+def usage():
+	print("Usage: sparser_sim.py -b <byte-code>[@pc] [-b ...] [-s <pc>] "
+	      "[-x <hxs> | -f] [-a <pa>] [-o <offset>] [-L <pclim>] "
+	      "[-l <lib>] [-v] [-c] <frames> ...")
+	print("  -b  soft parser byte-code: <file.c>:<array>, binary file "
+	      "or hex string,")
+	print("      loaded at PC 'pc' (default 0x%x)" % SP_MIN_PC)
+	print("  -s  soft parser starting PC (default: first -b PC)")
+	print("  -x  hard HXS the soft parser is linked to (default eth): "
+	      "%s" % ", ".join(sorted(HXS_MODELS)))
+	print("  -f  custom header first (soft parser starts the parsing)")
+	print("  -a  parameters array bytes (<file.c>:<array> or hex "
+	      "string)")
+	print("  -o  parameters offset in the parameters array (default 0)")
+	print("  -L  parsing cycle limit (PCLIM), fails if exceeded")
+	print("  -l  library byte-code loaded at PC 0x%x "
+	      "(default sp_aiop_lib_parsers from sparser_drv.c, 'none' "
+	      "to skip)" % SP_LIB_PC)
+	print("  -v  print the Parse Result of each frame")
+	print("  -c  CSV per frame output")
+	print("  <frames> : pcap files, <file.c>:<array> or hex strings")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "hb:s:x:fa:o:L:l:vc")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	root = os.path.normpath(os.path.join(os.path.dirname(
+		os.path.abspath(__file__)), "..", "..", ".."))
+	codes = []
+	start_pc = None
+	link = "eth"
+	pa = bytearray()
+	pa_off = 0
+	pclim = 0
+	lib = os.path.join(root, "src", "drivers", "sparser",
+			   "sparser_drv.c") + ":sp_aiop_lib_parsers"
+	verbose = False
+	as_csv = False
+	for (o, a) in opts:
+		if o == "-h":
+			usage()
+			return 0
+		if o == "-b":
+			codes.append(split_pc(a, SP_MIN_PC))
+		if o == "-s":
+			start_pc = int(a, 0)
+		if o == "-x":
+			link = a
+		if o == "-f":
+			link = None
+		if o == "-a":
+			pa = a
+		if o == "-o":
+			pa_off = int(a, 0)
+		if o == "-L":
+			pclim = int(a, 0)
+		if o == "-l":
+			lib = a
+		if o == "-v":
+			verbose = True
+		if o == "-c":
+			as_csv = True
+	if not codes or not args:
+		usage()
+		return 2
+	if link is not None and link not in HXS_MODELS:
+		print("[ERROR]: %s: not a modeled hard HXS" % link)
+		return 2
+	if start_pc is None:
+		start_pc = codes[0][1]
+
+	sim = Sim(pclim)
+	try:
+		if lib != "none":
+			sim.load(SP_LIB_PC, read_bytes(lib))
+		for (spec, pc) in codes:
+			sim.load(pc, read_bytes(spec))
+		if pa:
+			pa = read_bytes(pa)
+		if pa_off + len(pa) > 64:
+			raise SimError("parameters exceed the 64 bytes array")
+		sim.pa = bytearray(pa_off) + pa + \
+			 bytearray(64 - pa_off - len(pa))
+		frames = []
+		for spec in args:
+			if is_pcap(spec):
+				frames += read_pcap(spec)
+			else:
+				frames.append(bytes(read_bytes(spec)))
+	except (SimError, IOError, struct.error) as e:
+		print("[ERROR]: %s" % e)
+		return 1
+
+	faf_names = read_faf_names(os.path.join(root, "apps", "sparser",
+						"include",
+						"fsl_sparser_gen.h"))
+	results = [sim.parse(bytearray(d), link, start_pc) for d in frames]
+	if as_csv:
+		csv(results, frames)
+	else:
+		report(sim, frames, results, faf_names, verbose)
+	return 1 if any(f.error for f in results) else 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
@@ -0,0 +1,656 @@
+#! /usr/bin/python
+#
+# Copyright 2016 Freescale Semiconductor, Inc.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#   * Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#   * Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#   * Neither the name of Freescale Semiconductor nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+# EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+# DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#
+# Host side static stack and code size analyzer of the AIOP ELF image.
+#
+# Builds the call graph of the VLE code, takes the frame size of each
+# function from the DWARF call frame information (.debug_frame) and reports
+# the worst case stack depth from the task entry points and the size of the
+# hot (I-RAM), shared (Shared-RAM) and cold (DDR) code.
+# Exits with 1 when a budget is exceeded. See README.txt.
+
+from __future__ import print_function
+
+import sys
+import struct
+import getopt
+import bisect
+import itertools
+
+# Entry points checked by default, when present in the image
+ENTRY_POINTS = ("snic_process_packet", "app_process_packet",
+		"cmdif_srv_isr", "tman_timer_callback")
+
+# Workspace of the tasks of a core (LCF: stack ends at 0x8000) and the bytes
+# reserved at its start for the HW context, TLS and presentation area
+WORKSPACE_SIZE = 0x8000
+WORKSPACE_RESERVED = 0x400
+DEFAULT_NTASKS = 16
+I_RAM_SIZE = 0x20000
+
+# Output sections of the code placements (fsl_types.h, aiop_link.lcf)
+CODE_CLASSES = (("hot", (".itext", ".itext_vle")),
+		("shared", (".stext", ".stext_vle")),
+		("cold", (".dtext", ".dtext_vle", ".text", ".text_vle")))
+
+SHT_SYMTAB = 2
+SHT_NOBITS = 8
+SHF_EXECINSTR = 0x4
+STT_FUNC = 2
+
+class StackError(Exception):
+	pass
+
+class Elf(object):
+	"""Minimal ELF32 big endian reader: sections and function symbols"""
+
+	def __init__(self, path):
+		self.data = open(path, "rb").read()
+		d = self.data
+		if d[:4] != b"\x7fELF" or d[4:5] != b"\x01" or \
+		   d[5:6] != b"\x02":
+			raise StackError("%s: not an ELF32 big endian file" % path)
+		(shoff,) = struct.unpack_from(">I", d, 0x20)
+		(shentsize, shnum, shstrndx) = struct.unpack_from(">HHH", d,
+								  0x2E)
+		self.sections = []
+		for i in range(shnum):
+			self.sections.append(struct.unpack_from(">IIIIIIIIII", d,
+						shoff + i * shentsize))
+		strtab = self.sections[shstrndx]
+		self.names = [self.cstr(strtab[4] + s[0])
+			      for s in self.sections]
+		# Code functions: address -> (size, name, section index), and
+		# all the (name, address) of the function symbols
+		self.funcs = {}
+		self.func_names = []
+		for s in self.sections:
+			if s[1] != SHT_SYMTAB:
+				continue
+			names = self.sections[s[6]][4]
+			for off in range(s[4], s[4] + s[5], 16):
+				(name, value, size, info, other, shndx) = \
+					struct.unpack_from(">IIIBBH", d, off)
+				if not name or info & 0xf != STT_FUNC or \
+				   shndx >= len(self.sections) or \
+				   not self.sections[shndx][2] & SHF_EXECINSTR:
+					continue
+				name = self.cstr(names + name)
+				self.func_names.append((name, value))
+				old = self.funcs.get(value)
+				if old is None or old[0] < size:
+					self.funcs[value] = (size, name, shndx)
+
+	def cstr(self, off):
+		end = self.data.index(b"\0", off)
+		return self.data[off:end].decode("ascii", "replace")
+
+	def section(self, name):
+		for (n, s) in zip(self.names, self.sections):
+			if n == name:
+				return s
+		return None
+
+	def code(self, addr, size, shndx):
+		"""Contents of a function, empty when not in the image"""
+		s = self.sections[shndx]
+		if s[1] == SHT_NOBITS or not s[3] <= addr <= s[3] + s[5] - size:
+			return b""
+		return self.data[s[4] + addr - s[3]:s[4] + addr - s[3] + size]
+
+def uleb(d, off):
+	val = shift = 0
+	while True:
+		b = ord(d[off:off + 1])
+		off += 1
+		val |= (b & 0x7f) << shift
+		shift += 7
+		if not b & 0x80:
+			return (val, off)
+
+def sleb(d, off):
+	val = shift = 0
+	while True:
+		b = ord(d[off:off + 1])
+		off += 1
+		val |= (b & 0x7f) << shift
+		shift += 7
+		if not b & 0x80:
+			if b & 0x40:
+				val -= 1 << shift
+			return (val, off)
+
+def cfa_offsets(d, off, end, data_align, cfa):
+	"""Runs call frame instructions: (largest, last) CFA offset"""
+	top = cfa
+	while off < end:
+		op = ord(d[off:off + 1])
+		off += 1
+		if op & 0xc0 == 0x80:		# offset
+			(_, off) = uleb(d, off)
+		elif op & 0xc0:			# advance_loc, restore
+			pass
+		elif op in (0x00, 0x0a, 0x0b):	# nop, remember/restore_state
+			pass
+		elif op in (0x01, 0x04):	# set_loc, advance_loc4
+			off += 4
+		elif op == 0x02:		# advance_loc1
+			off += 1
+		elif op == 0x03:		# advance_loc2
+			off += 2
+		elif op in (0x05, 0x09, 0x14, 0x2f):
+			(_, off) = uleb(d, off)
+			(_, off) = uleb(d, off)
+		elif op in (0x06, 0x07, 0x08, 0x0d, 0x2e):
+			(_, off) = uleb(d, off)
+		elif op in (0x11, 0x15):
+			(_, off) = uleb(d, off)
+			(_, off) = sleb(d, off)
+		elif op == 0x0c:		# def_cfa
+			(_, off) = uleb(d, off)
+			(cfa, off) = uleb(d, off)
+		elif op == 0x0e:		# def_cfa_offset
+			(cfa, off) = uleb(d, off)
+		elif op == 0x12:		# def_cfa_sf
+			(_, off) = uleb(d, off)
+			(cfa, off) = sleb(d, off)
+			cfa *= data_align
+		elif op == 0x13:		# def_cfa_offset_sf
+			(cfa, off) = sleb(d, off)
+			cfa *= data_align
+		elif op == 0x0f:		# def_cfa_expression
+			(n, off) = uleb(d, off)
+			off += n
+		elif op in (0x10, 0x16):	# (val_)expression
+			(_, off) = uleb(d, off)
+			(n, off) = uleb(d, off)
+			off += n
+		else:
+			return None
+		top = max(top, cfa)
+	return (top, cfa)
+
+def cfi_frames(elf):
+	"""Function address -> frame size, from .debug_frame"""
+	frames = {}
+	sec = elf.section(".debug_frame")
+	if sec is None or sec[1] == SHT_NOBITS:
+		return frames
+	d = elf.data
+	base = off = sec[4]
+	end = sec[4] + sec[5]
+	cies = {}
+	while off + 8 <= end:
+		(length, cie_id) = struct.unpack_from(">II", d, off)
+		if length == 0xffffffff:
+			raise StackError("64-bit DWARF .debug_frame not supported")
+		start = off + 4
+		nxt = start + length
+		if cie_id == 0xffffffff:
+			p = start + 4
+			version = ord(d[p:p + 1])
+			aug_end = d.index(b"\0", p + 1)
+			aug = d[p + 1:aug_end]
+			p = aug_end + 1
+			(_, p) = uleb(d, p)
+			(data_align, p) = sleb(d, p)
+			if version == 1:
+				p += 1
+			else:
+				(_, p) = uleb(d, p)
+			if aug[:1] == b"z":
+				(n, p) = uleb(d, p)
+				p += n
+			init = cfa_offsets(d, p, nxt, data_align, 0)
+			cies[off - base] = (data_align, init and init[1],
+					    aug[:1] == b"z")
+		elif cie_id in cies and length >= 12:
+			(data_align, cfa, has_aug) = cies[cie_id]
+			(loc, rng) = struct.unpack_from(">II", d, start + 4)
+			p = start + 12
+			if has_aug:
+				(n, p) = uleb(d, p)
+				p += n
+			r = cfa is not None and \
+			    cfa_offsets(d, p, nxt, data_align, cfa)
+			if r:
+				frames[loc] = max(frames.get(loc, 0), r[0])
+		off = nxt
+	return frames
+
+def decode(code, addr):
+	"""VLE instructions: (address, opcode, length)"""
+	off = 0
+	while off + 2 <= len(code):
+		(hw,) = struct.unpack_from(">H", code, off)
+		if hw >> 12 in (1, 3, 5, 7) and off + 4 <= len(code):
+			(insn,) = struct.unpack_from(">I", code, off)
+			yield (addr + off, insn, 4)
+			off += 4
+		else:
+			yield (addr + off, hw, 2)
+			off += 2
+
+def prologue_frame(code):
+	"""Frame size of an e_stwu r1,-N(r1) in the first instructions"""
+	for (pc, insn, size) in itertools.islice(decode(code, 0), 8):
+		if size == 4 and insn & 0xffffff00 == 0x18210600 and \
+		   insn & 0x80:
+			return 0x100 - (insn & 0xff)
+	return None
+
+def se_reg(rx):
+	return rx if rx < 8 else rx + 16
+
+def branches(code, addr):
+	"""Direct calls, tail branches and unresolved indirect calls.
+
+	Far calls through CTR of an address built by e_lis/e_or2i (or
+	e_add16i) are resolved; se_bctr in the function is a switch table.
+	"""
+	calls = set()
+	tails = set()
+	indirect = 0
+	regs = {}
+	ctr = None
+	for (pc, insn, size) in decode(code, addr):
+		if size == 4:
+			rd = (insn >> 21) & 0x1f
+			ra = (insn >> 16) & 0x1f
+			ui = ((insn >> 5) & 0xf800) | (insn & 0x7ff)
+			if insn & 0xfe000000 == 0x78000000:	# e_b, e_bl
+				disp = insn & 0x01fffffe
+				if disp & 0x01000000:
+					disp -= 0x02000000
+				target = (pc + disp) & 0xffffffff
+				if insn & 1:
+					calls.add(target)
+				elif not addr <= target < addr + len(code):
+					tails.add(target)
+			elif insn & 0xfc00f800 == 0x7000e000:	# e_lis
+				regs[rd] = ui << 16
+			elif insn & 0xfc00f800 == 0x7000c000:	# e_or2i
+				if rd in regs:
+					regs[rd] |= ui
+			elif insn & 0xfc000000 == 0x1c000000:	# e_add16i
+				si = insn & 0xffff
+				if si & 0x8000:
+					si -= 0x10000
+				if ra in regs:
+					regs[rd] = (regs[ra] + si) & 0xffffffff
+				else:
+					regs.pop(rd, None)
+			elif insn & 0xfc1fffff == 0x7c0903a6:	# mtctr
+				ctr = regs.get(rd)
+		else:
+			if insn & 0xfe00 == 0xe800:		# se_b, se_bl
+				disp = (insn & 0xff) << 1
+				if disp & 0x100:
+					disp -= 0x200
+				target = (pc + disp) & 0xffffffff
+				if insn & 0x100:
+					calls.add(target)
+				elif not addr <= target < addr + len(code):
+					tails.add(target)
+			elif insn & 0xfff0 == 0x00b0:		# se_mtctr
+				ctr = regs.get(se_reg(insn & 0xf))
+			elif insn in (0x0005, 0x0007):		# se_blrl, se_bctrl
+				if insn == 0x0007 and ctr is not None:
+					calls.add(ctr)
+				else:
+					indirect += 1
+	return (calls, tails, indirect)
+
+class Func(object):
+	def __init__(self, addr, size, name, section):
+		self.addr = addr
+		self.size = size
+		self.name = name
+		self.section = section
+		self.frame = None
+		self.calls = set()
+		self.tails = set()
+		self.indirect = 0
+		self.unresolved = set()
+
+class CallGraph(object):
+	def __init__(self, elf):
+		self.funcs = []
+		for addr in sorted(elf.funcs):
+			(size, name, shndx) = elf.funcs[addr]
+			self.funcs.append(Func(addr, size, name, elf.names[shndx]))
+		self.starts = [f.addr for f in self.funcs]
+		self.by_name = {}
+		for (name, addr) in elf.func_names:
+			i = bisect.bisect_left(self.starts, addr)
+			if i not in self.by_name.get(name, []):
+				self.by_name.setdefault(name, []).append(i)
+
+		cfi = cfi_frames(elf)
+		for f in self.funcs:
+			(size, name, shndx) = elf.funcs[f.addr]
+			addr = f.addr
+			code = elf.code(addr, size, shndx)
+			f.frame = cfi.get(addr)
+			if f.frame is None:
+				f.frame = prologue_frame(code)
+			(calls, tails, f.indirect) = branches(code, addr)
+			for (targets, edges) in ((calls, f.calls),
+						 (tails, f.tails)):
+				for t in targets:
+					i = self.func_at(t)
+					if i is None:
+						f.unresolved.add(t)
+					else:
+						edges.add(i)
+		self.memo = {}
+		self.visiting = set()
+		self.recursive = set()
+
+	def func_at(self, addr):
+		i = bisect.bisect_right(self.starts, addr) - 1
+		if i < 0:
+			return None
+		f = self.funcs[i]
+		if addr == f.addr or addr < f.addr + f.size:
+			return i
+		return None
+
+	def lookup(self, name):
+		if name.startswith("0x"):
+			i = self.func_at(int(name, 16))
+			return [] if i is None else [i]
+		return self.by_name.get(name, [])
+
+	def worst(self, i):
+		"""(stack bytes, next function on the worst path) from i.
+
+		A call adds the frame of the caller, a tail branch does not.
+		Edges closing a cycle are ignored and reported as recursion.
+		"""
+		if i in self.memo:
+			return self.memo[i]
+		if i in self.visiting:
+			return None
+		self.visiting.add(i)
+		f = self.funcs[i]
+		frame = f.frame or 0
+		best = (frame, None)
+		for (edges, own) in ((f.calls, frame), (f.tails, 0)):
+			for c in sorted(edges):
+				w = self.worst(c)
+				if w is None:
+					self.recursive.add(i)
+				elif own + w[0] > best[0]:
+					best = (own + w[0], c)
+		self.visiting.remove(i)
+		self.memo[i] = best
+		return best
+
+	def reachable(self, i):
+		seen = set([i])
+		todo = [i]
+		while todo:
+			f = self.funcs[todo.pop()]
+			for c in f.calls | f.tails:
+				if c not in seen:
+					seen.add(c)
+					todo.append(c)
+		return seen
+
+def parse_specs(specs, what):
+	"""'name=value' pairs, given inline or as files of such lines"""
+	pairs = []
+	for spec in specs:
+		if "=" in spec:
+			lines = [spec]
+		else:
+			try:
+				lines = open(spec).read().splitlines()
+			except IOError as e:
+				raise StackError("%s file: %s" % (what, e))
+		for line in lines:
+			line = line.split("#")[0].strip()
+			if not line:
+				continue
+			if "=" not in line:
+				raise StackError("%s: expected name=value: %s" %
+						 (what, line))
+			(name, value) = line.split("=", 1)
+			pairs.append((name.strip(), value.strip()))
+	return pairs
+
+def apply_specs(graph, frames, indirect):
+	warnings = []
+	for (name, value) in frames:
+		found = graph.lookup(name)
+		if not found:
+			warnings.append("frame size of unknown function %s" % name)
+		for i in found:
+			graph.funcs[i].frame = int(value, 0)
+	for (name, value) in indirect:
+		found = graph.lookup(name)
+		if not found:
+			warnings.append("indirect calls of unknown function %s"
+					% name)
+		for i in found:
+			f = graph.funcs[i]
+			for callee in value.split(","):
+				targets = graph.lookup(callee.strip())
+				if not targets:
+					warnings.append("unknown callee %s of %s" %
+							(callee.strip(), name))
+				f.calls.update(targets)
+			f.indirect = 0
+	return warnings
+
+def report_stack(graph, entries, verbose):
+	"""Worst case stack of each entry: (exceeded budgets, warnings)"""
+	errors = []
+	warnings = []
+	print("%-36s %8s %8s" % ("entry point", "stack", "budget"))
+	for (name, i, budget) in entries:
+		(depth, _) = graph.worst(i)
+		status = "EXCEEDED" if depth > budget else "ok"
+		print("%-36s %8d %8d  %s" % (name, depth, budget, status))
+		if depth > budget:
+			errors.append("worst case stack of %s is %d bytes, "
+				      "budget %d" % (name, depth, budget))
+		if verbose or depth > budget:
+			j = i
+			tail = False
+			while j is not None:
+				f = graph.funcs[j]
+				(w, nxt) = graph.memo[j]
+				print("    %-32s %8s %8d%s" % (f.name,
+				      "?" if f.frame is None else f.frame, w,
+				      "  (tail branch)" if tail else ""))
+				tail = nxt in f.tails and nxt not in f.calls
+				j = nxt
+		reach = graph.reachable(i)
+		for j in sorted(reach):
+			f = graph.funcs[j]
+			if f.frame is None:
+				warnings.append("%s: no frame size for %s "
+						"(counted as 0)" % (name, f.name))
+			if f.indirect:
+				warnings.append("%s: %d indirect call(s) in %s "
+						"not counted" %
+						(name, f.indirect, f.name))
+			for t in sorted(f.unresolved):
+				warnings.append("%s: call from %s to 0x%08x "
+						"outside any function" %
+						(name, f.name, t))
+			if j in graph.recursive:
+				warnings.append("%s: recursion through %s is "
+						"not bounded" % (name, f.name))
+	return (errors, warnings)
+
+def report_code(elf, graph, budgets, top):
+	"""Size of the code per placement: exceeded budgets"""
+	errors = []
+	classes = [(c, list(s)) for (c, s) in CODE_CLASSES]
+	known = set(n for (c, s) in CODE_CLASSES for n in s)
+	other = [n for (n, s) in zip(elf.names, elf.sections)
+		 if s[2] & SHF_EXECINSTR and s[5] and n not in known]
+	classes.append(("other", other))
+	print("\n%-8s %8s %8s  %s" % ("code", "bytes", "budget", "sections"))
+	for (c, names) in classes:
+		secs = [(n, s) for (n, s) in zip(elf.names, elf.sections)
+			if n in names and s[5]]
+		size = sum(s[5] for (n, s) in secs)
+		budget = budgets.get(c)
+		status = ""
+		if budget is not None:
+			status = "EXCEEDED" if size > budget else "ok"
+			if size > budget:
+				errors.append("%s code is %d bytes, budget %d" %
+					      (c, size, budget))
+		print(("%-8s %8d %8s  %s  %s" % (c, size,
+		       "-" if budget is None else budget,
+		       " ".join(n for (n, s) in secs) or "-", status)).rstrip())
+		if not top:
+			continue
+		funcs = sorted((f for f in graph.funcs if f.section in names),
+			       key=lambda f: f.size, reverse=True)
+		for f in funcs[:top]:
+			print("    %-32s %8d" % (f.name, f.size))
+	return errors
+
+def usage():
+	print("Usage: stack_usage.py [-e <entry>[=<budget>]] [-n <ntasks>] "
+	      "[-s <bytes>]")
+	print("                      [-f <func>=<bytes>|<file>] "
+	      "[-i <func>=<callee>[,...]|<file>]")
+	print("                      [-H <bytes>] [-S <bytes>] [-C <bytes>] "
+	      "[-t <n>] [-v] [-W] <aiop.elf>")
+	print("  -e  entry point and its stack budget (default: %s)" %
+	      ", ".join(ENTRY_POINTS))
+	print("  -n  tasks per core, the default stack budget is "
+	      "0x%x / ntasks - 0x%x (default %d)" %
+	      (WORKSPACE_SIZE, WORKSPACE_RESERVED, DEFAULT_NTASKS))
+	print("  -s  default stack budget in bytes")
+	print("  -f  frame size of a function without call frame information")
+	print("  -i  callees of the indirect calls of a function "
+	      "(e.g. TMAN callbacks)")
+	print("  -H  hot code (I-RAM) budget (default 0x%x)" % I_RAM_SIZE)
+	print("  -S  shared code (Shared-RAM) budget")
+	print("  -C  cold code (DDR) budget")
+	print("  -t  list the <n> largest functions of each code placement")
+	print("  -v  print the worst case call path of every entry point")
+	print("  -W  fail on warnings (unknown frames, indirect calls, "
+	      "recursion)")
+
+def main(argv):
+	try:
+		opts, args = getopt.getopt(argv, "he:n:s:f:i:H:S:C:t:vW")
+	except getopt.GetoptError as e:
+		print(e)
+		usage()
+		return 2
+	entry_specs = []
+	ntasks = DEFAULT_NTASKS
+	stack_budget = None
+	frame_specs = []
+	indirect_specs = []
+	code_budgets = {"hot": I_RAM_SIZE}
+	top = 0
+	verbose = False
+	strict = False
+	try:
+		for (o, a) in opts:
+			if o == "-h":
+				usage()
+				return 0
+			if o == "-e":
+				entry_specs.append(a)
+			if o == "-n":
+				ntasks = int(a, 0)
+			if o == "-s":
+				stack_budget = int(a, 0)
+			if o == "-f":
+				frame_specs.append(a)
+			if o == "-i":
+				indirect_specs.append(a)
+			if o == "-H":
+				code_budgets["hot"] = int(a, 0)
+			if o == "-S":
+				code_budgets["shared"] = int(a, 0)
+			if o == "-C":
+				code_budgets["cold"] = int(a, 0)
+			if o == "-t":
+				top = int(a, 0)
+			if o == "-v":
+				verbose = True
+			if o == "-W":
+				strict = True
+	except ValueError as e:
+		print(e)
+		usage()
+		return 2
+	if len(args) != 1 or ntasks <= 0:
+		usage()
+		return 2
+	if stack_budget is None:
+		stack_budget = WORKSPACE_SIZE // ntasks - WORKSPACE_RESERVED
+
+	try:
+		elf = Elf(args[0])
+		graph = CallGraph(elf)
+		warnings = apply_specs(graph,
+				       parse_specs(frame_specs, "frame size"),
+				       parse_specs(indirect_specs, "indirect"))
+		entries = []
+		for spec in entry_specs or ENTRY_POINTS:
+			(name, _, budget) = spec.partition("=")
+			found = graph.lookup(name)
+			if not found and entry_specs:
+				raise StackError("entry point %s not found" % name)
+			for i in found:
+				entries.append((name, i, int(budget, 0) if budget
+						else stack_budget))
+	except (StackError, IOError, ValueError, struct.error) as e:
+		print("[ERROR]: %s" % e)
+		return 1
+	if not entries:
+		print("[ERROR]: none of the entry points %s found, use -e" %
+		      ", ".join(ENTRY_POINTS))
+		return 1
+
+	sys.setrecursionlimit(max(sys.getrecursionlimit(),
+				  4 * len(graph.funcs) + 100))
+	(errors, stack_warnings) = report_stack(graph, entries, verbose)
+	errors += report_code(elf, graph, code_budgets, top)
+	for w in warnings + sorted(set(stack_warnings)):
+		print("[WARNING]: %s" % w)
+	for e in errors:
+		print("[ERROR]: %s" % e)
+	if errors or (strict and (warnings or stack_warnings)):
+		return 1
+	return 0
+
+if __name__ == "__main__":
+	sys.exit(main(sys.argv[1:]))
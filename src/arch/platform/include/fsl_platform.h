@@ -77,6 +77,9 @@
 /**< Dedicated CWAP/DTLS buffer pool is created; must not be used together with
  * IPSEC_BUFFER_ALLOCATE_ENABLE */
 #define CWAP_DTLS_BUFFER_ALLOCATE_ENABLE 0x0008
+/**< IPSec SA shared descriptors are always built by the RTA, without
+ * templates */
+#define IPSEC_SD_TEMPLATES_DISABLE	0x0010
 /** @} end of group APP_CFG_OPT */
 
 /**************************************************************************//**
@@ -56,8 +56,11 @@ extern int aiop_sl_early_init(void);
 extern int aiop_sl_init(void);            extern void aiop_sl_free(void);
 extern int rcu_init();                    extern void rcu_free();
 extern int rcu_default_early_init();
-extern int ipsec_drv_init(void);
-extern int cwap_dtls_drv_init(void);
+extern int twheel_init(void);             extern void twheel_free(void);
+extern int alloc_prof_init(void);         extern void alloc_prof_free(void);
+extern int ipsec_drv_early_init(void);    extern int ipsec_drv_post_init(void);
+extern int cwap_dtls_drv_early_init(void);
+extern int cwap_dtls_drv_post_init(void);
 
 extern void build_apps_array(struct sys_module_desc *apps);
 
@@ -79,16 +82,17 @@ extern void build_apps_array(struct sys_module_desc *apps);
 	{sparser_drv_early_init, sparser_drv_init, NULL, NULL},		\
 	/* Must be after aiop_sl_init */				\
 	{NULL, dpni_drv_init, NULL, dpni_drv_free},			\
-	/* Must be after DPNI */					\
-	{NULL, ipsec_drv_init, NULL, NULL},				\
-	 /* Must be after IPSEC */					\
-	{NULL, cwap_dtls_drv_init, NULL, NULL},				\
-	 /* Must be after CWAP */					\
+	/* Filled by the first create_instance or at post init */	\
+	{ipsec_drv_early_init, NULL, ipsec_drv_post_init, NULL},	\
+	{cwap_dtls_drv_early_init, NULL, cwap_dtls_drv_post_init,	\
+							NULL},	\
 	{sp_drv_early_init, sp_drv_init, NULL, sp_drv_free},		\
 	 /* Must be after cmdif */					\
 	{evmng_early_init, evmng_init, NULL, evmng_free},		\
 	 /* Must be after slab */					\
 	{rcu_default_early_init, rcu_init, NULL, rcu_free},		\
+	{NULL, twheel_init, NULL, twheel_free},				\
+	{NULL, alloc_prof_init, NULL, alloc_prof_free},			\
 	/* Never remove */						\
 	{NULL, NULL, NULL, NULL}					\
 }
@@ -310,6 +314,13 @@ __COLD_CODE void core_ready_for_tasks(void)
 
 	sys.runtime_flag = 1;
 
+#if defined(ENABLE_PROF_REGIONS) || defined(ENABLE_ACCEL_ACCOUNTING) || \
+	defined(ENABLE_OSM_PROFILING)
+	/* Profiling regions, accelerator accounting and OSM profiling are
+	 * measured with the core time base */
+	booke_enable_time_base();
+#endif
+
 	cmgw_update_core_boot_completion();
 
 	CTSCSR_ntasks = (cmgw_get_ntasks() << 24) & CTSCSR_TASKS_MASK;
@@ -124,6 +124,10 @@
     #define ACCEL_CWAPR_REV2
     #define ACCEL_CWAPF_REV2
     #define ACCEL_CWAP_DTLS_REV1
+    #define ACCEL_FIB_REV1
+    #define ACCEL_METER_REV1
+    #define ACCEL_AQM_REV1
+    #define ACCEL_IPFIX_REV1
 #endif
 
 
@@ -126,6 +126,8 @@
     #define ACCEL_CWAPR_REV1
     #define ACCEL_CWAPF_REV1
     #define ACCEL_CWAP_DTLS_REV1
+    #define ACCEL_METER_REV1
+    #define ACCEL_AQM_REV1
 #endif
 
 #endif /* __FSL_SOC_H */
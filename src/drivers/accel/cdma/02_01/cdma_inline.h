@@ -535,4 +535,8 @@ inline int cdma_refcount_decrement_and_release(
 	return -1;
 }
 
+#define __CDMA_INLINE_H_DONE
+/* Allocation profiling wrappers (ENABLE_ALLOC_PROFILING) */
+#include "fsl_sl_alloc_prof.h"
+
 #endif /* __CDMA_INLINE_H */
@@ -325,6 +325,7 @@ int fdma_store_and_enqueue_default_frame_fqid(
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -360,6 +361,7 @@ int fdma_store_and_enqueue_frame_fqid(
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -397,6 +399,7 @@ int fdma_store_and_enqueue_frame_qd(
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS3)) = arg3;
 	/*__stqw(arg1, arg2, arg3, 0, HWC_ACC_IN_ADDRESS, 0);*/
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -432,6 +435,7 @@ int fdma_enqueue_default_fd_fqid(
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -466,6 +470,7 @@ int fdma_enqueue_fd_fqid(
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -502,6 +507,7 @@ int fdma_enqueue_default_fd_qd(
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -539,6 +545,7 @@ int fdma_enqueue_fd_qd(
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
 	
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -682,6 +682,7 @@ inline int fdma_store_and_enqueue_default_frame_qd(
 
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);	
 	
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
@@ -721,6 +722,7 @@ inline int fdma_store_and_ordered_enqueue_default_frame_qd(
 
 	FDMA_ENQUEUE_RCU_CHECK_UNLOCK_CANCEL(flags);
 
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if (__e_ordhwacceli_(FODMA_ACCEL_ID, OSM_SCOPE_TRANSITION_TO_EXCL_OP,
 			OSM_SCOPE_ID_STAGE_INCREMENT_MASK) == FDMA_SUCCESS) {
@@ -783,6 +785,7 @@ inline int fdma_prestore_and_ordered_enqueue_default_fd_qd(
 	/* store command parameters */
 	__stdw(arg1, arg2, HWC_ACC_IN_ADDRESS, 0);
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
+	ACCT_TASK_END_IF(flags & FDMA_EN_TC_TERM_BITS);
 	/* call FDMA Accelerator */
 	if (__e_ordhwacceli_(FODMA_ACCEL_ID,
 			OSM_SCOPE_TRANSITION_TO_EXCL_OP,
@@ -814,6 +817,7 @@ inline void fdma_terminate_task(void)
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS)) = arg1;
 	
 	RCU_CHECK_UNLOCK_CANCEL;
+	ACCT_TASK_END();
 	/* call FDMA Accelerator */
 	__e_hwacceli_(FODMA_ACCEL_ID);
 }
@@ -311,9 +311,12 @@ int fdma_store_and_enqueue_default_frame_fqid(
 	arg1 = FDMA_ENQUEUE_WF_ARG1(spid, PRC_GET_FRAME_HANDLE(), flags);
 	/* store command parameters */
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -344,9 +347,12 @@ int fdma_store_and_enqueue_frame_fqid(
 	arg1 = FDMA_ENQUEUE_WF_EXP_ARG1(spid, frame_handle, flags);
 	/* store command parameters */
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -381,9 +387,12 @@ int fdma_store_and_enqueue_frame_qd(
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS3)) = arg3;
 	/*__stqw(arg1, arg2, arg3, 0, HWC_ACC_IN_ADDRESS, 0);*/
 
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -417,9 +426,12 @@ int fdma_enqueue_default_fd_fqid(
 	}
 	/* store command parameters */
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -452,9 +464,12 @@ int fdma_enqueue_fd_fqid(
 	}
 	/* store command parameters */
 	__stdw(arg1, fqid, HWC_ACC_IN_ADDRESS, 0);
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -486,9 +501,12 @@ int fdma_enqueue_default_fd_qd(
 	/* store command parameters */
 	__stdw(arg1, arg2, HWC_ACC_IN_ADDRESS, 0);
 		*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -521,9 +539,12 @@ int fdma_enqueue_fd_qd(
 	/* store command parameters */
 	__stdw(arg1, arg2, HWC_ACC_IN_ADDRESS, 0);
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -544,6 +565,7 @@ void fdma_discard_frame(uint16_t frame, uint32_t flags)
 	/* prepare command parameters */
 	arg1 = FDMA_DISCARD_ARG1_FRAME(frame, flags);
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS)) = arg1;
+	ACCT_TASK_END_IF(flags & FDMA_DIS_FRAME_TC_BIT);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return;
@@ -512,6 +512,7 @@ inline void fdma_discard_default_frame(uint32_t flags)
 	/* prepare command parameters */
 	arg1 = FDMA_DISCARD_ARG1_WF(PRC_GET_FRAME_HANDLE(), flags);
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS)) = arg1;
+	ACCT_TASK_END_IF(flags & FDMA_DIS_WF_TC_BIT);
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return;
@@ -569,9 +570,12 @@ inline int fdma_store_and_enqueue_default_frame_qd(
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS3)) = arg3;
 	/*__stqw(arg1, arg2, arg3, 0, HWC_ACC_IN_ADDRESS, 0);*/
 
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if ((__e_hwacceli_(FODMA_ACCEL_ID)) == FDMA_SUCCESS)
 		return SUCCESS;
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -606,6 +610,7 @@ inline int fdma_store_and_ordered_enqueue_default_frame_qd(
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS3)) = arg3;
 	/*__stqw(arg1, arg2, arg3, 0, HWC_ACC_IN_ADDRESS, 0);*/
 
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if (__e_ordhwacceli_(FODMA_ACCEL_ID, OSM_SCOPE_TRANSITION_TO_EXCL_OP,
 			OSM_SCOPE_ID_STAGE_INCREMENT_MASK) == FDMA_SUCCESS) {
@@ -616,6 +621,8 @@ inline int fdma_store_and_ordered_enqueue_default_frame_qd(
 		return SUCCESS;
 	}
 
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -678,6 +685,7 @@ inline int fdma_prestore_and_ordered_enqueue_default_fd_qd(
 	/* store command parameters */
 	__stdw(arg1, arg2, HWC_ACC_IN_ADDRESS, 0);
 	*((uint32_t *) HWC_ACC_IN_ADDRESS3) = arg3;
+	ACCT_TASK_END_IF(flags & (FDMA_EN_TC_TERM_BITS | FDMA_EN_TC_CONDTERM_BITS));
 	/* call FDMA Accelerator */
 	if (__e_ordhwacceli_(FODMA_ACCEL_ID, OSM_SCOPE_TRANSITION_TO_EXCL_OP,
 				OSM_SCOPE_ID_STAGE_INCREMENT_MASK) == FDMA_SUCCESS) {
@@ -689,6 +697,8 @@ inline int fdma_prestore_and_ordered_enqueue_default_fd_qd(
 			return SUCCESS;
 	}
 
+	/* A failed conditional terminate enqueue does not end the task */
+	ACCT_TASK_RESUME_IF(flags & FDMA_EN_TC_CONDTERM_BITS);
 	/* load command results */
 	res1 = *((int8_t *) (FDMA_STATUS_ADDR));
 
@@ -714,6 +724,7 @@ inline void fdma_terminate_task(void)
 	/* prepare command parameters */
 	arg1 = FDMA_TERM_TASK_CMD_ARG1();
 	*((uint32_t *)(HWC_ACC_IN_ADDRESS)) = arg1;
+	ACCT_TASK_END();
 	/* call FDMA Accelerator */
 	__e_hwacceli_(FODMA_ACCEL_ID);
 }
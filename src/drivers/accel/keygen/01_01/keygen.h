@@ -58,6 +58,10 @@
 *//***************************************************************************/
 	/** Opaquein valid */
 #define KEYGEN_OPAQUEIN_VALID		0x10000000
+	/** End of the task workspace. KCRs located above this address
+	(e.g. precompiled constant KCRs) are copied to the workspace before
+	they are passed to the CTLU. */
+#define KEYGEN_WS_END_ADDR		0x00008000
 
 /** @} */ /* end of KEYGEN_DEFINES */
 
@@ -36,6 +36,7 @@
 
 #include "fsl_keygen.h"
 #include "keygen.h"
+#include <string.h>
 
 extern uint64_t ext_keyid_pool_address;
 
@@ -173,12 +174,18 @@ inline int keygen_kcr_create(enum keygen_hw_accel_id acc_id,
 			uint8_t *kcr,
 			uint8_t *keyid)
 {
-	
+	uint8_t ws_kcr[KEYGEN_KCR_LENGTH] __attribute__((aligned(16)));
+	int32_t status;
+
+	/* Precompiled KCR in constant data */
+	if ((uint32_t)kcr >= KEYGEN_WS_END_ADDR) {
+		memcpy(ws_kcr, kcr, KEYGEN_KCR_LENGTH);
+		kcr = ws_kcr;
+	}
+
 #ifdef CHECK_ALIGNMENT 	
 	DEBUG_ALIGN("keygen_inline.h",(uint32_t)kcr, ALIGNMENT_16B);
 #endif
-	
-	int32_t status;
 
 	status = get_id(ext_keyid_pool_address, keyid);
 
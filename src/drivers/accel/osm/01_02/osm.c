@@ -30,6 +30,9 @@
 @Description	This file contains the AIOP OSM Operations API implementation.
 *//***************************************************************************/
 
+/* The functions defined here are not wrapped by the OSM profiling */
+#define OSM_PROF_NO_WRAP
+
 #include "fsl_osm.h"
 #include "general.h"
 
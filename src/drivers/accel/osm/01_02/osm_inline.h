@@ -35,6 +35,7 @@
 #define __OSM_INLINE_H
 
 #include "osm.h"
+#include "osm_prof.h"
 #include "fsl_osm.h"
 #include "general.h"
 
@@ -66,6 +67,7 @@ inline void osm_task_init(void)
 			((osm_val & PRC_OEP_MASK) ? 1 : 0);*/
 	default_task_params.scope_mode_level_arr[0] = (osm_val & PRC_OEP_MASK)
 			>> PRC_OEP_BIT_OFFSET;
+	OSM_PROF_TASK_INIT();
 }
 
 inline void osm_scope_transition_to_exclusive_with_increment_scope_id(void)
@@ -154,4 +156,10 @@ inline void osm_scope_enter_to_exclusive_with_new_scope_id(
 	}
 }
 
+#define __OSM_INLINE_H_DONE
+#if defined(ENABLE_OSM_PROFILING) && defined(__FSL_LIB_OSM_H_DONE)
+/* Wrap the OSM functions once they are declared and defined */
+#include "osm_prof_wrap.h"
+#endif
+
 #endif /*__OSM_INLINE_H*/
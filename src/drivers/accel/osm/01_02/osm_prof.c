@@ -0,0 +1,385 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		osm_prof.c
+
+@Description	OSM contention profiling implementation.
+*//***************************************************************************/
+
+/* The OSM API calls of this file are not profiled */
+#define OSM_PROF_NO_WRAP
+
+#include "general.h"
+#include "fsl_types.h"
+#include "fsl_stdio.h"
+#include "fsl_string.h"
+#include "fsl_malloc.h"
+#include "fsl_osm.h"
+#include "osm.h"
+#include "osm_prof.h"
+
+#ifdef ENABLE_OSM_PROFILING
+
+/* Call sites per core. The last one accounts the call sites which did not fit
+ * in the table. */
+#define OSM_PROF_MAX_SITES	16
+#define OSM_PROF_OTHER_SITE	(OSM_PROF_MAX_SITES - 1)
+/* Scope ID classes: scope level (1 to 4) and scope ID source */
+#define OSM_PROF_NUM_CLASSES	8
+#define OSM_PROF_CLASS(_level, _src)	((((_level) - 1) << 1) | (_src))
+/* Exclusive sections shown by osm_prof_print() */
+#define OSM_PROF_PRINT_SITES	10
+
+/* Wait and hold times, in time base ticks */
+struct osm_prof_times {
+	uint64_t	wait_total;
+	uint64_t	hold_total;
+	uint32_t	acquires;
+	uint32_t	wait_max;
+	uint32_t	holds;
+	uint32_t	hold_max;
+};
+
+struct osm_prof_site {
+	const char		*file;
+	uint32_t		line;
+	/* Exclusive sections acquired at this site */
+	struct osm_prof_times	times;
+	/* Exclusive sections ended at this site */
+	uint32_t		releases;
+	/* Site which ended the longest section acquired at this site */
+	uint8_t			max_release;
+	/* Scope ID class of the last section acquired at this site */
+	uint8_t			cls;
+	uint8_t			res[2];
+};
+
+struct osm_prof_core {
+	struct osm_prof_site	sites[OSM_PROF_MAX_SITES];
+	struct osm_prof_times	classes[OSM_PROF_NUM_CLASSES];
+	uint32_t		num_sites;
+	uint32_t		res;
+};
+
+/* Merged call site, for the report */
+struct osm_prof_report_site {
+	const char		*file;
+	uint32_t		line;
+	const char		*max_release_file;
+	uint32_t		max_release_line;
+	struct osm_prof_times	times;
+	uint32_t		releases;
+	uint8_t			cls;
+};
+
+__TASK uint32_t osm_prof_cmd_tb;
+__TASK uint32_t osm_prof_excl_tb;
+__TASK uint8_t osm_prof_site;
+__TASK uint8_t osm_prof_class;
+/* Section closed by the last osm_prof_task_end() */
+__TASK uint32_t osm_prof_end_tb;
+__TASK uint8_t osm_prof_end_site;
+
+/* Per core counters, updated without locking */
+struct osm_prof_core g_osm_prof[INTG_MAX_NUM_OF_CORES]
+					__attribute__((aligned(8)));
+
+static const char osm_prof_task_end_file[] = "(task end)";
+static const char osm_prof_other_file[] = "(other)";
+
+static inline struct osm_prof_core *osm_prof_get_core(void)
+{
+	register uint32_t pir;
+
+	asm {mfspr pir, 286}	/* PIR */
+	return &g_osm_prof[(pir >> 4) & (INTG_MAX_NUM_OF_CORES - 1)];
+}
+
+static uint8_t osm_prof_get_site(struct osm_prof_core *pc, const char *file,
+				 uint32_t line)
+{
+	uint32_t i;
+
+	for (i = 0; i < pc->num_sites; i++)
+		if (pc->sites[i].line == line && pc->sites[i].file == file)
+			return (uint8_t)i;
+	if (pc->num_sites == OSM_PROF_OTHER_SITE) {
+		pc->sites[OSM_PROF_OTHER_SITE].file = osm_prof_other_file;
+		return OSM_PROF_OTHER_SITE;
+	}
+	pc->sites[i].file = file;
+	pc->sites[i].line = line;
+	pc->num_sites++;
+	return (uint8_t)i;
+}
+
+static inline void osm_prof_max(uint32_t *max, uint32_t val)
+{
+	if (val > *max)
+		*max = val;
+}
+
+static void osm_prof_close(struct osm_prof_core *pc, uint8_t release,
+			   uint32_t now)
+{
+	struct osm_prof_site *site = &pc->sites[osm_prof_site];
+	struct osm_prof_times *cls = &pc->classes[osm_prof_class];
+	uint32_t hold = now - osm_prof_excl_tb;
+
+	if (hold > site->times.hold_max) {
+		site->times.hold_max = hold;
+		site->max_release = release;
+	}
+	site->times.hold_total += hold;
+	site->times.holds++;
+	pc->sites[release].releases++;
+	osm_prof_max(&cls->hold_max, hold);
+	cls->hold_total += hold;
+	cls->holds++;
+	osm_prof_site = OSM_PROF_NO_SITE;
+}
+
+/* The task is exclusive as long as one of its scope levels is exclusive */
+static int osm_prof_is_exclusive(void)
+{
+	uint8_t i;
+
+	for (i = 0; i < default_task_params.current_scope_level && i < 4; i++)
+		if (default_task_params.scope_mode_level_arr[i] == EXCLUSIVE)
+			return 1;
+	return 0;
+}
+
+void osm_prof_cmd_end(const char *file, uint32_t line, uint8_t src)
+{
+	struct osm_prof_core *pc = osm_prof_get_core();
+	uint32_t now = osm_prof_time_base();
+	uint32_t wait;
+	uint8_t level, site, cls;
+
+	if (osm_prof_is_exclusive()) {
+		if (src == OSM_PROF_SRC_NONE)
+			return;
+		/* The OSM command returned once the task was granted
+		 * exclusivity */
+		level = default_task_params.current_scope_level;
+		site = osm_prof_get_site(pc, file, line);
+		cls = OSM_PROF_CLASS(level, src);
+		wait = now - osm_prof_cmd_tb;
+		osm_prof_max(&pc->sites[site].times.wait_max, wait);
+		pc->sites[site].times.wait_total += wait;
+		pc->sites[site].times.acquires++;
+		pc->sites[site].cls = cls;
+		osm_prof_max(&pc->classes[cls].wait_max, wait);
+		pc->classes[cls].wait_total += wait;
+		pc->classes[cls].acquires++;
+		/* A nested exclusive scope is part of the open section */
+		if (osm_prof_site == OSM_PROF_NO_SITE) {
+			osm_prof_site = site;
+			osm_prof_class = cls;
+			osm_prof_excl_tb = now;
+		}
+	} else if (osm_prof_site != OSM_PROF_NO_SITE) {
+		osm_prof_close(pc, osm_prof_get_site(pc, file, line), now);
+	}
+}
+
+void osm_prof_task_end(void)
+{
+	struct osm_prof_core *pc;
+
+	osm_prof_end_site = osm_prof_site;
+	if (osm_prof_site == OSM_PROF_NO_SITE)
+		return;
+	pc = osm_prof_get_core();
+	osm_prof_end_tb = osm_prof_time_base();
+	osm_prof_close(pc, osm_prof_get_site(pc, osm_prof_task_end_file, 0),
+		       osm_prof_end_tb);
+}
+
+/* The task was not terminated: its section is still open. The hold counted
+ * by osm_prof_task_end() is removed. The maximum is kept: the full hold is
+ * longer and replaces it. */
+void osm_prof_task_resume(void)
+{
+	struct osm_prof_core *pc;
+	struct osm_prof_site *site;
+	struct osm_prof_times *cls;
+	uint32_t hold;
+
+	if (osm_prof_end_site == OSM_PROF_NO_SITE)
+		return;
+	pc = osm_prof_get_core();
+	site = &pc->sites[osm_prof_end_site];
+	cls = &pc->classes[osm_prof_class];
+	hold = osm_prof_end_tb - osm_prof_excl_tb;
+	site->times.hold_total -= hold;
+	site->times.holds--;
+	pc->sites[osm_prof_get_site(pc, osm_prof_task_end_file, 0)].releases--;
+	cls->hold_total -= hold;
+	cls->holds--;
+	osm_prof_site = osm_prof_end_site;
+	osm_prof_end_site = OSM_PROF_NO_SITE;
+}
+
+__COLD_CODE void osm_prof_reset(void)
+{
+	memset(g_osm_prof, 0, sizeof(g_osm_prof));
+}
+
+static void osm_prof_add_times(struct osm_prof_times *sum,
+			       const struct osm_prof_times *t)
+{
+	sum->wait_total += t->wait_total;
+	sum->hold_total += t->hold_total;
+	sum->acquires += t->acquires;
+	sum->holds += t->holds;
+	osm_prof_max(&sum->wait_max, t->wait_max);
+	osm_prof_max(&sum->hold_max, t->hold_max);
+}
+
+static uint32_t osm_prof_avg(uint64_t total, uint32_t count)
+{
+	return count ? (uint32_t)(total / count) : 0;
+}
+
+/* Merge the call sites of all the cores */
+static int osm_prof_merge(struct osm_prof_report_site *rs)
+{
+	struct osm_prof_core *pc;
+	struct osm_prof_site *s;
+	int core, i, j, num = 0;
+
+	for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+		pc = &g_osm_prof[core];
+		for (i = 0; i < OSM_PROF_MAX_SITES; i++) {
+			s = &pc->sites[i];
+			if (!s->file)
+				continue;
+			for (j = 0; j < num; j++)
+				if (rs[j].file == s->file &&
+				    rs[j].line == s->line)
+					break;
+			if (j == num) {
+				memset(&rs[j], 0, sizeof(rs[j]));
+				rs[j].file = s->file;
+				rs[j].line = s->line;
+				num++;
+			}
+			if (s->times.hold_max > rs[j].times.hold_max) {
+				rs[j].max_release_file =
+					pc->sites[s->max_release].file;
+				rs[j].max_release_line =
+					pc->sites[s->max_release].line;
+			}
+			if (s->times.acquires)
+				rs[j].cls = s->cls;
+			osm_prof_add_times(&rs[j].times, &s->times);
+			rs[j].releases += s->releases;
+		}
+	}
+	return num;
+}
+
+__COLD_CODE void osm_prof_print(void)
+{
+	struct osm_prof_report_site *rs, tmp;
+	struct osm_prof_times sum;
+	int core, num, i, j, max;
+
+	fsl_print("OSM contention (time base ticks):\n");
+	fsl_print("Scope ID classes:\n");
+	for (i = 0; i < OSM_PROF_NUM_CLASSES; i++) {
+		memset(&sum, 0, sizeof(sum));
+		for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++)
+			osm_prof_add_times(&sum, &g_osm_prof[core].classes[i]);
+		if (!sum.acquires)
+			continue;
+		fsl_print("\tlevel %d %s: acquires %d wait avg %d max %d "
+			  "hold avg %d max %d\n", (i >> 1) + 1,
+			  (i & 1) ? "new id" : "increment", sum.acquires,
+			  osm_prof_avg(sum.wait_total, sum.acquires),
+			  sum.wait_max, osm_prof_avg(sum.hold_total, sum.holds),
+			  sum.hold_max);
+	}
+
+	rs = fsl_malloc(sizeof(struct osm_prof_report_site) *
+			OSM_PROF_MAX_SITES * INTG_MAX_NUM_OF_CORES, 8);
+	if (!rs) {
+		fsl_print("No memory for the OSM call sites report\n");
+		return;
+	}
+	num = osm_prof_merge(rs);
+	/* Longest exclusive sections first */
+	for (i = 0; i < num - 1; i++) {
+		max = i;
+		for (j = i + 1; j < num; j++)
+			if (rs[j].times.hold_max > rs[max].times.hold_max)
+				max = j;
+		if (max != i) {
+			tmp = rs[i];
+			rs[i] = rs[max];
+			rs[max] = tmp;
+		}
+	}
+	fsl_print("Longest exclusive sections:\n");
+	for (i = 0; i < num && i < OSM_PROF_PRINT_SITES; i++) {
+		if (!rs[i].times.holds)
+			break;
+		fsl_print("\t%s:%d (level %d %s) -> %s:%d\n", rs[i].file,
+			  rs[i].line, (rs[i].cls >> 1) + 1,
+			  (rs[i].cls & 1) ? "new id" : "increment",
+			  rs[i].max_release_file, rs[i].max_release_line);
+		fsl_print("\t\tacquires %d wait avg %d max %d "
+			  "hold avg %d max %d\n", rs[i].times.acquires,
+			  osm_prof_avg(rs[i].times.wait_total,
+				       rs[i].times.acquires),
+			  rs[i].times.wait_max,
+			  osm_prof_avg(rs[i].times.hold_total,
+				       rs[i].times.holds),
+			  rs[i].times.hold_max);
+	}
+	fsl_print("Exclusivity ends:\n");
+	for (i = 0; i < num; i++)
+		if (rs[i].releases)
+			fsl_print("\t%s:%d: %d\n", rs[i].file, rs[i].line,
+				  rs[i].releases);
+	fsl_free(rs);
+}
+
+#else
+
+__COLD_CODE void osm_prof_reset(void)
+{
+}
+
+__COLD_CODE void osm_prof_print(void)
+{
+	fsl_print("OSM profiling is disabled\n");
+}
+
+#endif /* ENABLE_OSM_PROFILING */
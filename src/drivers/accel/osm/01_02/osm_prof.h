@@ -0,0 +1,102 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		osm_prof.h
+
+@Description	OSM contention profiling internal API (ENABLE_OSM_PROFILING).
+
+@note		This file is intended for internal use only. The OSM functions
+		are wrapped in osm_prof_wrap.h.
+*//***************************************************************************/
+
+#ifndef __OSM_PROF_H_
+#define __OSM_PROF_H_
+
+#include "fsl_types.h"
+
+#ifdef ENABLE_OSM_PROFILING
+
+/* Scope ID source of an exclusive section, with the scope level it makes the
+ * scope ID class */
+#define OSM_PROF_SRC_INC	0	/* Incremented scope ID */
+#define OSM_PROF_SRC_NEW	1	/* Scope ID given by the caller */
+#define OSM_PROF_SRC_NONE	2	/* Call which does not acquire
+					 * exclusivity */
+
+/* No exclusive section is open for the task */
+#define OSM_PROF_NO_SITE	0xFF
+
+/* Time base when the current OSM call was issued */
+extern __TASK uint32_t osm_prof_cmd_tb;
+/* Time base when the open exclusive section was acquired */
+extern __TASK uint32_t osm_prof_excl_tb;
+/* Call site index of the open exclusive section, or OSM_PROF_NO_SITE */
+extern __TASK uint8_t osm_prof_site;
+/* Scope ID class of the open exclusive section */
+extern __TASK uint8_t osm_prof_class;
+
+static inline uint32_t osm_prof_time_base(void)
+{
+	register uint32_t tbl;
+
+	asm {mfspr tbl, 284}	/* TBL */
+	return tbl;
+}
+
+inline void osm_prof_cmd_start(void)
+{
+	osm_prof_cmd_tb = osm_prof_time_base();
+}
+
+/* Called after an OSM call made at file:line. Accounts the time waited for
+ * exclusivity, opens an exclusive section or closes it when the task has no
+ * more exclusive scope. */
+void osm_prof_cmd_end(const char *file, uint32_t line, uint8_t src);
+
+/* Wrap an OSM API call made at the current call site */
+#define OSM_PROF_CALL(_call, _src)					\
+	(osm_prof_cmd_start(), _call,					\
+	 osm_prof_cmd_end(__FILE__, __LINE__, (_src)))
+
+/* Scope ID source of osm_scope_enter() */
+#define OSM_PROF_ENTER_SRC(_flags)					\
+	((!((_flags) & OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE)) ?		\
+	 OSM_PROF_SRC_NONE :						\
+	 ((_flags) & OSM_SCOPE_ENTER_CHILD_SCOPE_INCREMENT) ?		\
+	 OSM_PROF_SRC_INC : OSM_PROF_SRC_NEW)
+
+/* Called when a task starts, the exclusive section of a previous task of the
+ * same TLS is discarded */
+#define OSM_PROF_TASK_INIT()	(osm_prof_site = OSM_PROF_NO_SITE)
+
+#else
+
+#define OSM_PROF_TASK_INIT()
+
+#endif /* ENABLE_OSM_PROFILING */
+
+#endif /* __OSM_PROF_H_ */
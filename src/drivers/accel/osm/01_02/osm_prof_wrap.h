@@ -0,0 +1,81 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		osm_prof_wrap.h
+
+@Description	Wrappers of the OSM functions recording their call site for
+		the OSM contention profiling (osm_prof.h).
+
+@note		Included by fsl_osm.h and osm_inline.h once the OSM functions
+		are declared and defined. Files defining OSM functions set
+		OSM_PROF_NO_WRAP.
+*//***************************************************************************/
+
+#ifndef __OSM_PROF_WRAP_H_
+#define __OSM_PROF_WRAP_H_
+
+#if defined(ENABLE_OSM_PROFILING) && !defined(OSM_PROF_NO_WRAP)
+
+#define osm_scope_transition_to_exclusive_with_increment_scope_id()	\
+	OSM_PROF_CALL(							\
+		osm_scope_transition_to_exclusive_with_increment_scope_id(), \
+		OSM_PROF_SRC_INC)
+#define osm_scope_transition_to_exclusive_with_increment_scope_id_wrp() \
+	OSM_PROF_CALL(							\
+		osm_scope_transition_to_exclusive_with_increment_scope_id_wrp(), \
+		OSM_PROF_SRC_INC)
+#define osm_scope_transition_to_exclusive_with_new_scope_id(_id)	\
+	OSM_PROF_CALL(							\
+		osm_scope_transition_to_exclusive_with_new_scope_id(_id), \
+		OSM_PROF_SRC_NEW)
+#define osm_scope_transition_to_concurrent_with_increment_scope_id()	\
+	OSM_PROF_CALL(							\
+		osm_scope_transition_to_concurrent_with_increment_scope_id(), \
+		OSM_PROF_SRC_NONE)
+#define osm_scope_transition_to_concurrent_with_new_scope_id(_id)	\
+	OSM_PROF_CALL(							\
+		osm_scope_transition_to_concurrent_with_new_scope_id(_id), \
+		OSM_PROF_SRC_NONE)
+#define osm_scope_relinquish_exclusivity()				\
+	OSM_PROF_CALL(osm_scope_relinquish_exclusivity(), OSM_PROF_SRC_NONE)
+#define osm_scope_enter_to_exclusive_with_increment_scope_id()		\
+	OSM_PROF_CALL(							\
+		osm_scope_enter_to_exclusive_with_increment_scope_id(),	\
+		OSM_PROF_SRC_INC)
+#define osm_scope_enter_to_exclusive_with_new_scope_id(_id)		\
+	OSM_PROF_CALL(							\
+		osm_scope_enter_to_exclusive_with_new_scope_id(_id),	\
+		OSM_PROF_SRC_NEW)
+#define osm_scope_enter(_flags, _id)					\
+	OSM_PROF_CALL(osm_scope_enter((_flags), (_id)),			\
+		      OSM_PROF_ENTER_SRC(_flags))
+#define osm_scope_exit()						\
+	OSM_PROF_CALL(osm_scope_exit(), OSM_PROF_SRC_NONE)
+
+#endif /* ENABLE_OSM_PROFILING */
+
+#endif /* __OSM_PROF_WRAP_H_ */
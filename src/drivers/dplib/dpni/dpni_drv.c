@@ -494,6 +494,7 @@ void dpni_drv_unprobe(uint16_t aiop_niid)
 		DPNI_DRV_FLG_PARSE | DPNI_DRV_FLG_PARSER_DIS;
 
 	clear_fs_table(aiop_niid);
+	dpni_drv_pres_tuning_stop(aiop_niid);
 
 }
 
@@ -1249,6 +1250,7 @@ __COLD_CODE int dpni_drv_init(void)
 	pr_info("AIOP Egress parse profile ID : %d\n", egress_parse_profile_id);
 	/* Initialize internal AIOP NI table */
 	dpni_drv_init_ni_table(prpid, prpid_egr);
+	dpni_drv_pres_tuning_init();
 	/* TODO - add initialization of global default DP-IO
 	 * (i.e. call 'dpio_open', 'dpio_init');
 	 * This should be mapped to ALL cores of AIOP and to ALL the tasks */
@@ -1266,6 +1268,11 @@ __COLD_CODE int dpni_drv_init(void)
 		pr_err("configure_bpids_for_dpni failed %d\n",err);
 		return err;
 	}
+#ifndef LS2085A_REV1
+	err = dpni_drv_mcast_init();
+	if (err)
+		return err;
+#endif
 
 
 
@@ -1412,6 +1419,10 @@ static int dpni_drv_evmng_cb(uint8_t generator_id, uint8_t event_id, uint64_t ap
 
 __COLD_CODE void dpni_drv_free(void)
 {
+#ifndef LS2085A_REV1
+	dpni_drv_mcast_free();
+#endif
+	dpni_drv_pres_tuning_free();
 	if (nis)
 		fsl_free(nis);
 	nis = NULL;
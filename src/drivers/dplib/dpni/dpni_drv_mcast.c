@@ -0,0 +1,409 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		dpni_drv_mcast.c
+
+@Description	Multi-destination send and multicast groups
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_types.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_dbg.h"
+#include "fsl_fdma.h"
+#include "fsl_ste.h"
+#include "fsl_cdma.h"
+#include "fsl_osm.h"
+#include "fsl_malloc.h"
+#include "fsl_mem_mng.h"
+#include "fsl_spinlock.h"
+#include "fsl_cmdif_server.h"
+#include "fsl_mc_sys.h"
+#include "fsl_mc_cmd.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_dpni_drv_mcast_cmd.h"
+#include "fsl_fd_batch.h"
+#include "dpni_drv.h"
+
+#ifndef LS2085A_REV1
+
+#define __ERR_MODULE__  MODULE_DPNI
+
+/* Multicast group, in the shared SRAM */
+struct dpni_drv_mcast_group {
+	/* Protects num_nis and ni_ids */
+	uint64_t	lock;
+	/* Physical address of the group counters
+	 * (struct dpni_drv_mcast_counters) */
+	uint64_t	counters;
+	uint16_t	ni_ids[DPNI_DRV_MAX_MULTI_DEST];
+	uint8_t		valid;
+	uint8_t		num_nis;
+	uint8_t		res[6];
+};
+
+/* Group counters, aligned for the STE and the CDMA */
+#define DPNI_DRV_MCAST_COUNTERS_SIZE	32
+
+static struct dpni_drv_mcast_group *mcast_groups;
+static uint64_t mcast_counters_paddr;
+static uint64_t mcast_groups_lock __attribute__((aligned(8)));
+
+#define DPNI_MCAST_CMD_READ(_param, _offset, _width, _type, _arg) \
+	_arg = (_type)mc_dec(cmd_data->params[_param], _offset, _width);
+
+#define DPNI_MCAST_RSP_PREP(_param, _offset, _width, _type, _arg) \
+	cmd_data->params[_param] |= mc_enc(_offset, _width, _arg);
+
+/* Send the default Working Frame to ni_ids[]. Returns the status of the last
+ * destination send and the number of failed copies in *drops. */
+static int dpni_drv_send_multi_common(const uint16_t *ni_ids, uint8_t num_nis,
+				      uint32_t flags, dpni_drv_multi_cb *cb,
+				      void *arg, uint32_t *drops)
+{
+	struct fdma_queueing_destination_params enqueue_params;
+	struct fd_batch batch;
+	uint8_t i;
+	int err;
+
+	if (flags & DPNI_DRIVER_SEND_MODE_ATTRIBUTE_MASK) {
+		/* Order the copies too: a single transition before the first
+		 * replication */
+		osm_scope_transition_to_exclusive_with_increment_scope_id();
+		flags &= ~DPNI_DRIVER_SEND_MODE_ATTRIBUTE_MASK;
+	}
+	fd_batch_init(&batch, FD_BATCH_NO_FLAGS);
+	for (i = 0; i < num_nis - 1; i++) {
+		if (cb)
+			cb(ni_ids[i], i, arg);
+		dpni_send_prepare(ni_ids[i], &enqueue_params);
+		/* The FDMA stores the working frame updates, copies it and
+		 * enqueues the copy */
+		fd_batch_replicate_default_frame(&batch, &enqueue_params);
+	}
+	*drops = batch.drops;
+	if (cb)
+		cb(ni_ids[i], i, arg);
+	err = dpni_drv_send(ni_ids[i], flags);
+	if (err)
+		(*drops)++;
+	return err;
+}
+
+int dpni_drv_send_multi(const uint16_t *ni_ids, uint8_t num_nis,
+			uint32_t flags, dpni_drv_multi_cb *cb, void *arg)
+{
+	uint32_t drops;
+
+	if (!num_nis || num_nis > DPNI_DRV_MAX_MULTI_DEST)
+		return -EINVAL;
+	return dpni_drv_send_multi_common(ni_ids, num_nis, flags, cb, arg,
+					  &drops);
+}
+
+int dpni_drv_send_mcast_group(uint16_t group_id, uint32_t flags,
+			      dpni_drv_multi_cb *cb, void *arg)
+{
+	struct dpni_drv_mcast_group *group;
+	uint16_t ni_ids[DPNI_DRV_MAX_MULTI_DEST];
+	uint64_t counters;
+	uint32_t drops;
+	uint8_t num_nis;
+	int err;
+
+	if (group_id >= DPNI_DRV_MCAST_MAX_GROUPS)
+		return -EINVAL;
+	group = &mcast_groups[group_id];
+	/* The members are copied: the send yields */
+	lock_spinlock(&group->lock);
+	if (!group->valid) {
+		unlock_spinlock(&group->lock);
+		return -EINVAL;
+	}
+	num_nis = group->num_nis;
+	counters = group->counters;
+	memcpy(ni_ids, group->ni_ids, num_nis * sizeof(uint16_t));
+	unlock_spinlock(&group->lock);
+	if (!num_nis)
+		return -ENAVAIL;
+
+	ste_inc_counter(counters +
+			offsetof(struct dpni_drv_mcast_counters, frames),
+			1, STE_MODE_64_BIT_CNTR_SIZE);
+	err = dpni_drv_send_multi_common(ni_ids, num_nis, flags, cb, arg,
+					 &drops);
+	ste_inc_counter(counters +
+			offsetof(struct dpni_drv_mcast_counters, copies),
+			num_nis - drops, STE_MODE_64_BIT_CNTR_SIZE);
+	if (drops)
+		ste_inc_counter(counters +
+				offsetof(struct dpni_drv_mcast_counters, drops),
+				drops, STE_MODE_64_BIT_CNTR_SIZE);
+	return err;
+}
+
+__COLD_CODE int dpni_drv_mcast_group_create(uint16_t *group_id)
+{
+	struct dpni_drv_mcast_counters counters = {0};
+	struct dpni_drv_mcast_group *group;
+	uint16_t i;
+
+	lock_spinlock(&mcast_groups_lock);
+	for (i = 0; i < DPNI_DRV_MCAST_MAX_GROUPS; i++)
+		if (!mcast_groups[i].valid)
+			break;
+	if (i == DPNI_DRV_MCAST_MAX_GROUPS) {
+		unlock_spinlock(&mcast_groups_lock);
+		return -ENOSPC;
+	}
+	group = &mcast_groups[i];
+	lock_spinlock(&group->lock);
+	group->num_nis = 0;
+	group->valid = 1;
+	unlock_spinlock(&group->lock);
+	unlock_spinlock(&mcast_groups_lock);
+
+	cdma_write(group->counters, &counters, sizeof(counters));
+	*group_id = i;
+	return 0;
+}
+
+__COLD_CODE int dpni_drv_mcast_group_delete(uint16_t group_id)
+{
+	struct dpni_drv_mcast_group *group;
+
+	if (group_id >= DPNI_DRV_MCAST_MAX_GROUPS)
+		return -EINVAL;
+	group = &mcast_groups[group_id];
+	lock_spinlock(&mcast_groups_lock);
+	lock_spinlock(&group->lock);
+	if (!group->valid) {
+		unlock_spinlock(&group->lock);
+		unlock_spinlock(&mcast_groups_lock);
+		return -EINVAL;
+	}
+	group->valid = 0;
+	group->num_nis = 0;
+	unlock_spinlock(&group->lock);
+	unlock_spinlock(&mcast_groups_lock);
+	return 0;
+}
+
+__COLD_CODE int dpni_drv_mcast_group_add_ni(uint16_t group_id, uint16_t ni_id)
+{
+	struct dpni_drv_mcast_group *group;
+	int i, err = 0;
+
+	if (group_id >= DPNI_DRV_MCAST_MAX_GROUPS ||
+	    ni_id >= SOC_MAX_NUM_OF_DPNI)
+		return -EINVAL;
+	group = &mcast_groups[group_id];
+	lock_spinlock(&group->lock);
+	if (!group->valid) {
+		err = -EINVAL;
+		goto unlock;
+	}
+	for (i = 0; i < group->num_nis; i++)
+		if (group->ni_ids[i] == ni_id) {
+			err = -EEXIST;
+			goto unlock;
+		}
+	if (group->num_nis == DPNI_DRV_MAX_MULTI_DEST) {
+		err = -ENOSPC;
+		goto unlock;
+	}
+	group->ni_ids[group->num_nis++] = ni_id;
+unlock:
+	unlock_spinlock(&group->lock);
+	return err;
+}
+
+__COLD_CODE int dpni_drv_mcast_group_remove_ni(uint16_t group_id,
+					       uint16_t ni_id)
+{
+	struct dpni_drv_mcast_group *group;
+	int i, err = -ENAVAIL;
+
+	if (group_id >= DPNI_DRV_MCAST_MAX_GROUPS)
+		return -EINVAL;
+	group = &mcast_groups[group_id];
+	lock_spinlock(&group->lock);
+	if (!group->valid) {
+		err = -EINVAL;
+		goto unlock;
+	}
+	for (i = 0; i < group->num_nis; i++)
+		if (group->ni_ids[i] == ni_id) {
+			/* Keep the members packed */
+			group->num_nis--;
+			group->ni_ids[i] = group->ni_ids[group->num_nis];
+			err = 0;
+			break;
+		}
+unlock:
+	unlock_spinlock(&group->lock);
+	return err;
+}
+
+__COLD_CODE int dpni_drv_mcast_group_get_counters(uint16_t group_id,
+				struct dpni_drv_mcast_counters *counters,
+				int reset)
+{
+	struct dpni_drv_mcast_counters zero = {0};
+	uint64_t counters_addr;
+
+	if (group_id >= DPNI_DRV_MCAST_MAX_GROUPS ||
+	    !mcast_groups[group_id].valid)
+		return -EINVAL;
+	counters_addr = mcast_groups[group_id].counters;
+	/* Wait for the pending STE updates of this task */
+	ste_barrier();
+	cdma_read(counters, counters_addr, sizeof(*counters));
+	if (reset)
+		cdma_write(counters_addr, &zero, sizeof(zero));
+	return 0;
+}
+
+static int dpni_drv_mcast_open_cb(uint8_t instance_id, void **dev)
+{
+	UNUSED(instance_id);
+	UNUSED(dev);
+	return 0;
+}
+
+static int dpni_drv_mcast_close_cb(void *dev)
+{
+	UNUSED(dev);
+	return 0;
+}
+
+__COLD_CODE static int dpni_drv_mcast_ctrl_cb(void *dev, uint16_t cmd,
+					      uint32_t size, void *data)
+{
+	struct dpni_mcast_cmd_data *cmd_data =
+					(struct dpni_mcast_cmd_data *)data;
+	struct dpni_drv_mcast_counters counters;
+	uint16_t group_id, ni_id;
+	int reset, err;
+
+	UNUSED(dev);
+	UNUSED(size);
+
+	switch (cmd) {
+	case DPNI_MCAST_GROUP_CREATE:
+		err = dpni_drv_mcast_group_create(&group_id);
+		if (err)
+			return err;
+		cmd_data->params[0] = 0;
+		DPNI_MCAST_GROUP_CREATE_RSP(DPNI_MCAST_RSP_PREP);
+		fdma_modify_default_segment_data(0,
+						 DPNI_MCAST_CMDSZ_GROUP_CREATE);
+		return 0;
+	case DPNI_MCAST_GROUP_DELETE:
+		DPNI_MCAST_GROUP_DELETE_CMD(DPNI_MCAST_CMD_READ);
+		return dpni_drv_mcast_group_delete(group_id);
+	case DPNI_MCAST_GROUP_ADD_NI:
+		DPNI_MCAST_GROUP_NI_CMD(DPNI_MCAST_CMD_READ);
+		return dpni_drv_mcast_group_add_ni(group_id, ni_id);
+	case DPNI_MCAST_GROUP_REMOVE_NI:
+		DPNI_MCAST_GROUP_NI_CMD(DPNI_MCAST_CMD_READ);
+		return dpni_drv_mcast_group_remove_ni(group_id, ni_id);
+	case DPNI_MCAST_GROUP_GET_COUNTERS:
+		DPNI_MCAST_GROUP_GET_COUNTERS_CMD(DPNI_MCAST_CMD_READ);
+		err = dpni_drv_mcast_group_get_counters(group_id, &counters,
+							reset);
+		if (err)
+			return err;
+		cmd_data->params[1] = 0;
+		cmd_data->params[2] = 0;
+		cmd_data->params[3] = 0;
+		DPNI_MCAST_GROUP_GET_COUNTERS_RSP(DPNI_MCAST_RSP_PREP);
+		fdma_modify_default_segment_data(0,
+					DPNI_MCAST_CMDSZ_GROUP_GET_COUNTERS);
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+__COLD_CODE int dpni_drv_mcast_register_cmdif(void)
+{
+	struct cmdif_module_ops ops;
+	int err;
+
+	ops.open_cb = (open_cb_t *)dpni_drv_mcast_open_cb;
+	ops.close_cb = (close_cb_t *)dpni_drv_mcast_close_cb;
+	ops.ctrl_cb = (ctrl_cb_t *)dpni_drv_mcast_ctrl_cb;
+	err = cmdif_register_module(DPNI_DRV_MCAST_MODULE_NAME, &ops);
+	if (err)
+		pr_err("Failed to register %s cmdif module\n",
+		       DPNI_DRV_MCAST_MODULE_NAME);
+	return err;
+}
+
+__COLD_CODE int dpni_drv_mcast_init(void)
+{
+	enum memory_partition_id mem_pid = MEM_PART_SYSTEM_DDR;
+	int i, err;
+
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		mem_pid = MEM_PART_DP_DDR;
+	mcast_groups = fsl_malloc(sizeof(struct dpni_drv_mcast_group) *
+				  DPNI_DRV_MCAST_MAX_GROUPS, 64);
+	if (!mcast_groups) {
+		pr_err("No memory for the multicast groups\n");
+		return -ENOMEM;
+	}
+	err = fsl_get_mem(DPNI_DRV_MCAST_COUNTERS_SIZE *
+			  DPNI_DRV_MCAST_MAX_GROUPS, mem_pid,
+			  DPNI_DRV_MCAST_COUNTERS_SIZE, &mcast_counters_paddr);
+	if (err) {
+		pr_err("No memory for the multicast group counters\n");
+		fsl_free(mcast_groups);
+		mcast_groups = NULL;
+		return err;
+	}
+	memset(mcast_groups, 0, sizeof(struct dpni_drv_mcast_group) *
+	       DPNI_DRV_MCAST_MAX_GROUPS);
+	for (i = 0; i < DPNI_DRV_MCAST_MAX_GROUPS; i++)
+		mcast_groups[i].counters = mcast_counters_paddr +
+				(uint64_t)(i * DPNI_DRV_MCAST_COUNTERS_SIZE);
+	mcast_groups_lock = 0;
+	return 0;
+}
+
+__COLD_CODE void dpni_drv_mcast_free(void)
+{
+	if (mcast_groups) {
+		fsl_free(mcast_groups);
+		fsl_put_mem(mcast_counters_paddr);
+	}
+	mcast_groups = NULL;
+}
+
+#endif /* LS2085A_REV1 */
@@ -0,0 +1,305 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		dpni_drv_pres.c
+
+@Description	Adaptive initial presentation of the NI entry points
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_types.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_dbg.h"
+#include "fsl_cdma.h"
+#include "fsl_parser.h"
+#include "fsl_malloc.h"
+#include "fsl_spinlock.h"
+#include "fsl_core.h"
+#include "fsl_platform.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_ep_mng.h"
+#include "dpni_drv.h"
+
+#define __ERR_MODULE__  MODULE_DPNI
+
+/* The parse depth (nxt_hdr_offset) is an 8 bit offset */
+#define DPNI_DRV_PRES_MAX_DEPTH		256
+#define DPNI_DRV_PRES_BUCKETS		\
+	(DPNI_DRV_PRES_MAX_DEPTH / DPNI_DRV_PRES_TUNING_STEP)
+
+/* Tuning state of a NI, in the shared SRAM. Allocated on the first enable
+ * and kept until dpni_drv_free(), so that a task sampling the NI never uses
+ * freed memory. */
+struct dpni_drv_pres_tuner {
+	/* Protects all the fields below */
+	uint64_t				lock;
+	struct dpni_drv_pres_tuning_cfg		cfg;
+	struct dpni_drv_pres_tuning_stats	stats;
+	/* Samples of the current window, per parse depth bucket */
+	uint32_t				hist[DPNI_DRV_PRES_BUCKETS];
+	uint32_t				window_samples;
+	uint16_t				epid;
+	/* Segment presentation offset of the EPID */
+	uint16_t				spo;
+	/* SPS when tuning was enabled, restored on disable */
+	uint16_t				orig_sps;
+	uint8_t					enabled;
+	/* A sampling task is updating the EPID table */
+	uint8_t					updating;
+};
+
+struct dpni_drv_pres_tuner *dpni_drv_pres_tuners[SOC_MAX_NUM_OF_DPNI];
+
+/* Frames seen by each core while sampling */
+static uint32_t pres_sample_tick[INTG_MAX_NUM_OF_CORES];
+
+extern struct dpni_drv *nis;
+
+/* Smallest SPS presenting the headers of 'percentile' percent of the window.
+ * Called with the tuner lock taken. */
+static uint16_t pres_tuning_decide(struct dpni_drv_pres_tuner *tuner)
+{
+	uint32_t target, sum = 0;
+	int32_t sps;
+	int i;
+
+	target = (tuner->window_samples * tuner->cfg.percentile + 99) / 100;
+	for (i = 0; i < DPNI_DRV_PRES_BUCKETS - 1; i++) {
+		sum += tuner->hist[i];
+		if (sum >= target)
+			break;
+	}
+	sps = (int32_t)((i + 1) * DPNI_DRV_PRES_TUNING_STEP) +
+		tuner->cfg.margin - tuner->spo;
+	if (sps < (int32_t)tuner->cfg.min_sps)
+		sps = tuner->cfg.min_sps;
+	if (sps > (int32_t)tuner->cfg.max_sps)
+		sps = tuner->cfg.max_sps;
+	return (uint16_t)sps;
+}
+
+static int pres_tuning_set_sps(uint16_t epid, uint16_t sps)
+{
+	struct ep_init_presentation init_presentation;
+
+	init_presentation.options = EP_INIT_PRESENTATION_OPT_SPS;
+	init_presentation.sps = sps;
+	return ep_mng_set_initial_presentation(epid, &init_presentation);
+}
+
+void dpni_drv_pres_tuning_sample(struct dpni_drv_pres_tuner *tuner)
+{
+	uint32_t core_id = core_get_id();
+	uint16_t depth, sps = 0, epid = 0;
+	int update = 0, err;
+
+	if (!tuner->enabled)
+		return;
+	if (pres_sample_tick[core_id]++ &
+	    ((1 << tuner->cfg.sample_shift) - 1))
+		return;
+	if (PARSER_IS_PARSING_ERROR_DEFAULT())
+		return;
+	depth = PARSER_GET_NEXT_HEADER_OFFSET_DEFAULT();
+
+	lock_spinlock(&tuner->lock);
+	tuner->stats.samples++;
+	/* The application has to extend the segment to reach the headers */
+	if (depth > PRC_GET_SEGMENT_OFFSET() + PRC_GET_SEGMENT_LENGTH())
+		tuner->stats.extend_needed++;
+	tuner->hist[depth / DPNI_DRV_PRES_TUNING_STEP]++;
+	if (++tuner->window_samples >= tuner->cfg.window) {
+		sps = pres_tuning_decide(tuner);
+		memset(tuner->hist, 0, sizeof(tuner->hist));
+		tuner->window_samples = 0;
+		tuner->stats.decisions++;
+		if (sps != tuner->stats.sps && !tuner->updating) {
+			tuner->updating = 1;
+			epid = tuner->epid;
+			update = 1;
+		}
+	}
+	unlock_spinlock(&tuner->lock);
+	if (!update)
+		return;
+
+	/* The EPID table is written under a CDMA mutex, not the spinlock;
+	 * the tuner mutex orders the update with a disable */
+	cdma_mutex_lock_take((uint64_t)tuner, CDMA_MUTEX_WRITE_LOCK);
+	err = tuner->enabled ? pres_tuning_set_sps(epid, sps) : -EINVAL;
+	lock_spinlock(&tuner->lock);
+	if (!err) {
+		tuner->stats.sps = sps;
+		tuner->stats.updates++;
+	}
+	tuner->updating = 0;
+	unlock_spinlock(&tuner->lock);
+	cdma_mutex_lock_release((uint64_t)tuner);
+}
+
+int dpni_drv_enable_presentation_tuning(
+	uint16_t ni_id,
+	const struct dpni_drv_pres_tuning_cfg *cfg)
+{
+	struct dpni_drv_pres_tuner *tuner, *new_tuner = NULL;
+	struct ep_init_presentation init_presentation;
+	uint16_t epid, max_sps;
+	int err;
+
+	if (ni_id >= SOC_MAX_NUM_OF_DPNI || !cfg || !cfg->window ||
+	    !cfg->percentile || cfg->percentile > 100 ||
+	    cfg->sample_shift > 15)
+		return -EINVAL;
+	cdma_mutex_lock_take((uint64_t)nis, CDMA_MUTEX_READ_LOCK);
+	epid = nis[ni_id].dpni_drv_params_var.epid_idx;
+	if (nis[ni_id].dpni_id == DPNI_NOT_IN_USE)
+		err = -EINVAL;
+	else
+		err = 0;
+	cdma_mutex_lock_release((uint64_t)nis);
+	if (err)
+		return err;
+
+	err = ep_mng_get_initial_presentation(epid, &init_presentation);
+	if (err)
+		return err;
+	if (init_presentation.nds || init_presentation.sr)
+		return -ENOTSUP;
+	max_sps = cfg->max_sps ? cfg->max_sps : init_presentation.sps;
+	if (cfg->min_sps > max_sps)
+		return -EINVAL;
+
+	if (!dpni_drv_pres_tuners[ni_id]) {
+		new_tuner = fsl_malloc(sizeof(struct dpni_drv_pres_tuner), 64);
+		if (!new_tuner)
+			return -ENOMEM;
+		memset(new_tuner, 0, sizeof(struct dpni_drv_pres_tuner));
+	}
+	cdma_mutex_lock_take((uint64_t)dpni_drv_pres_tuners,
+			     CDMA_MUTEX_WRITE_LOCK);
+	tuner = dpni_drv_pres_tuners[ni_id];
+	if (!tuner) {
+		tuner = new_tuner;
+		new_tuner = NULL;
+	}
+	lock_spinlock(&tuner->lock);
+	if (tuner->enabled) {
+		err = -EINVAL;
+	} else {
+		tuner->cfg = *cfg;
+		tuner->cfg.max_sps = max_sps;
+		memset(&tuner->stats, 0, sizeof(tuner->stats));
+		memset(tuner->hist, 0, sizeof(tuner->hist));
+		tuner->stats.sps = init_presentation.sps;
+		tuner->window_samples = 0;
+		tuner->epid = epid;
+		tuner->spo = init_presentation.spo;
+		tuner->orig_sps = init_presentation.sps;
+		tuner->enabled = 1;
+	}
+	unlock_spinlock(&tuner->lock);
+	/* Published last, sl_prolog() starts sampling the NI */
+	dpni_drv_pres_tuners[ni_id] = tuner;
+	cdma_mutex_lock_release((uint64_t)dpni_drv_pres_tuners);
+	if (new_tuner)
+		fsl_free(new_tuner);
+	return err;
+}
+
+int dpni_drv_disable_presentation_tuning(uint16_t ni_id)
+{
+	struct dpni_drv_pres_tuner *tuner;
+	uint16_t epid, sps;
+	uint8_t enabled;
+	int err;
+
+	if (ni_id >= SOC_MAX_NUM_OF_DPNI)
+		return -EINVAL;
+	tuner = dpni_drv_pres_tuners[ni_id];
+	if (!tuner)
+		return -EINVAL;
+	/* Serialized with the updates of the sampling tasks, the original
+	 * SPS is written last */
+	cdma_mutex_lock_take((uint64_t)tuner, CDMA_MUTEX_WRITE_LOCK);
+	lock_spinlock(&tuner->lock);
+	enabled = tuner->enabled;
+	tuner->enabled = 0;
+	epid = tuner->epid;
+	sps = tuner->orig_sps;
+	if (enabled)
+		tuner->stats.sps = sps;
+	unlock_spinlock(&tuner->lock);
+	err = enabled ? pres_tuning_set_sps(epid, sps) : -EINVAL;
+	cdma_mutex_lock_release((uint64_t)tuner);
+	return err;
+}
+
+int dpni_drv_get_presentation_tuning_stats(
+	uint16_t ni_id,
+	struct dpni_drv_pres_tuning_stats *stats)
+{
+	struct dpni_drv_pres_tuner *tuner;
+
+	if (ni_id >= SOC_MAX_NUM_OF_DPNI || !stats)
+		return -EINVAL;
+	tuner = dpni_drv_pres_tuners[ni_id];
+	if (!tuner)
+		return -EINVAL;
+	lock_spinlock(&tuner->lock);
+	*stats = tuner->stats;
+	unlock_spinlock(&tuner->lock);
+	return 0;
+}
+
+void dpni_drv_pres_tuning_stop(uint16_t ni_id)
+{
+	struct dpni_drv_pres_tuner *tuner = dpni_drv_pres_tuners[ni_id];
+
+	if (!tuner)
+		return;
+	lock_spinlock(&tuner->lock);
+	tuner->enabled = 0;
+	unlock_spinlock(&tuner->lock);
+}
+
+__COLD_CODE void dpni_drv_pres_tuning_init(void)
+{
+	memset(dpni_drv_pres_tuners, 0, sizeof(dpni_drv_pres_tuners));
+	memset(pres_sample_tick, 0, sizeof(pres_sample_tick));
+}
+
+__COLD_CODE void dpni_drv_pres_tuning_free(void)
+{
+	int i;
+
+	for (i = 0; i < SOC_MAX_NUM_OF_DPNI; i++) {
+		if (dpni_drv_pres_tuners[i])
+			fsl_free(dpni_drv_pres_tuners[i]);
+		dpni_drv_pres_tuners[i] = NULL;
+	}
+}
@@ -45,6 +45,9 @@ extern struct dpni_drv *nis;
 extern __PROFILE_SRAM
 	struct storage_profile storage_profile[SP_NUM_OF_STORAGE_PROFILES];
 extern uint8_t egress_parse_profile_id;
+extern struct dpni_drv_pres_tuner *dpni_drv_pres_tuners[];
+
+void dpni_drv_pres_tuning_sample(struct dpni_drv_pres_tuner *tuner);
 
 static inline void sl_prolog_common(void)
 {
@@ -77,12 +80,19 @@ static inline void sl_prolog_common(void)
 	*((uint8_t *)HWC_SPID_ADDRESS) = dpni_drv->dpni_drv_params_var.spid;
 
 	SET_FRAME_TYPE(PRC_GET_FRAME_HANDLE(), HWC_FD_ADDRESS);
+
+	/* Presentation tuning (dpni_drv_enable_presentation_tuning()) */
+	if (dpni_drv_pres_tuners[PRC_GET_PARAMETER()])
+		dpni_drv_pres_tuning_sample(
+				dpni_drv_pres_tuners[PRC_GET_PARAMETER()]);
 }
 
 inline int sl_prolog(void)
 {
 	int err;
 	struct parse_result *pr;
+
+	ACCT_TASK_START(ACCT_EP_APP);
 	pr = (struct parse_result *)HWC_PARSE_RES_ADDRESS;
 
 	/* Need to save running-sum in parse-results LE-> BE */
@@ -101,6 +111,8 @@ inline int sl_prolog_with_ref_take(void)
 {
 	int err;
 	struct parse_result *pr;
+
+	ACCT_TASK_START(ACCT_EP_APP);
 	pr = (struct parse_result *)HWC_PARSE_RES_ADDRESS;
 
 	/* Need to save running-sum in parse-results LE-> BE */
@@ -128,6 +140,7 @@ inline int sl_prolog_with_custom_header(uint16_t start_hxs)
 	 * the starting offset must be 0.*/
 	start_hxs = 0;
 #endif
+	ACCT_TASK_START(ACCT_EP_APP);
 	pr = (struct parse_result *)HWC_PARSE_RES_ADDRESS;
 	/* Need to save running-sum in parse-results LE-> BE */
 	pr->gross_running_sum = LH_SWAP(HWC_FD_ADDRESS + FD_FLC_RUNNING_SUM, 0);
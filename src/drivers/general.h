@@ -38,6 +38,7 @@
 
 #include "fsl_general.h"
 #include "fsl_stdio.h"
+#include "fsl_acct.h"
 
 #pragma section RW ".exception_data" ".exception_data_bss"
 
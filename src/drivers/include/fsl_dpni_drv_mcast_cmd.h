@@ -0,0 +1,89 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//*
+ @File          fsl_dpni_drv_mcast_cmd.h
+
+ @Description   DPNI multicast group commands between GPP (client) and
+                AIOPSL (server), see dpni_drv_mcast_register_cmdif().
+
+ @Cautions      None.
+ *//***************************************************************************/
+
+#ifndef _FSL_DPNI_DRV_MCAST_CMD_H
+#define _FSL_DPNI_DRV_MCAST_CMD_H
+
+#define DPNI_MCAST_CMD_NUM_OF_PARAMS	4
+
+struct dpni_mcast_cmd_data {
+	uint64_t params[DPNI_MCAST_CMD_NUM_OF_PARAMS];
+};
+
+/* dpni_mcast_cmds */
+#define DPNI_MCAST_GROUP_CREATE		0
+#define DPNI_MCAST_GROUP_DELETE		1
+#define DPNI_MCAST_GROUP_ADD_NI		2
+#define DPNI_MCAST_GROUP_REMOVE_NI	3
+#define DPNI_MCAST_GROUP_GET_COUNTERS	4
+
+/* cmd sizes */
+#define DPNI_MCAST_CMDSZ_GROUP_CREATE		8
+#define DPNI_MCAST_CMDSZ_GROUP_DELETE		8
+#define DPNI_MCAST_CMDSZ_GROUP_ADD_NI		8
+#define DPNI_MCAST_CMDSZ_GROUP_REMOVE_NI	8
+#define DPNI_MCAST_CMDSZ_GROUP_GET_COUNTERS	(4*8)
+
+/*	param, offset, width,	type,			arg_name */
+#define DPNI_MCAST_GROUP_CREATE_RSP(_OP) \
+	_OP(0, 0,	16,	uint16_t,		group_id)
+
+/*	param, offset, width,	type,			arg_name */
+#define DPNI_MCAST_GROUP_DELETE_CMD(_OP) \
+	_OP(0, 0,	16,	uint16_t,		group_id)
+
+/*	param, offset, width,	type,			arg_name */
+#define DPNI_MCAST_GROUP_NI_CMD(_OP) \
+do { \
+	_OP(0, 0,	16,	uint16_t,		group_id); \
+	_OP(0, 16,	16,	uint16_t,		ni_id); \
+} while (0)
+
+/*	param, offset, width,	type,			arg_name */
+#define DPNI_MCAST_GROUP_GET_COUNTERS_CMD(_OP) \
+do { \
+	_OP(0, 0,	16,	uint16_t,		group_id); \
+	_OP(0, 16,	1,	int,			reset); \
+} while (0)
+
+/*	param, offset, width,	type,			arg_name */
+#define DPNI_MCAST_GROUP_GET_COUNTERS_RSP(_OP) \
+do { \
+	_OP(1, 0,	64,	uint64_t,		counters.frames); \
+	_OP(2, 0,	64,	uint64_t,		counters.copies); \
+	_OP(3, 0,	64,	uint64_t,		counters.drops); \
+} while (0)
+
+#endif /* _FSL_DPNI_DRV_MCAST_CMD_H */
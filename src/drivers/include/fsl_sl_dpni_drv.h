@@ -208,5 +208,57 @@ void dpni_drv_get_ingress_parse_profile_id(uint16_t ni_id, uint8_t *prpid);
 *//***************************************************************************/
 void dpni_drv_get_egress_parse_profile_id(uint16_t ni_id, uint8_t *prpid);
 
+#ifndef LS2085A_REV1
+/**************************************************************************//**
+@Function	dpni_drv_mcast_init
+
+@Description	Allocate the multicast groups table and the group counters.
+		Called by dpni_drv_init().
+
+@Return		0 on success; error code, otherwise.
+*//***************************************************************************/
+int dpni_drv_mcast_init(void);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_free
+
+@Description	Free the multicast groups table and the group counters.
+
+@Return		None
+*//***************************************************************************/
+void dpni_drv_mcast_free(void);
+#endif
+
+/**************************************************************************//**
+@Function	dpni_drv_pres_tuning_init
+
+@Description	Clear the presentation tuning table. Called by
+		dpni_drv_init().
+
+@Return		None
+*//***************************************************************************/
+void dpni_drv_pres_tuning_init(void);
+
+/**************************************************************************//**
+@Function	dpni_drv_pres_tuning_free
+
+@Description	Free the presentation tuning state of all the NIs.
+
+@Return		None
+*//***************************************************************************/
+void dpni_drv_pres_tuning_free(void);
+
+/**************************************************************************//**
+@Function	dpni_drv_pres_tuning_stop
+
+@Description	Stop the presentation tuning of a removed NI, without
+		touching its EPID table entry. Called by dpni_drv_unprobe().
+
+@Param[in]	ni_id : The AIOP Network Interface ID.
+
+@Return		None
+*//***************************************************************************/
+void dpni_drv_pres_tuning_stop(uint16_t ni_id);
+
 /** @} */ /* end of DPNI_DRV_STATUS group */
 #endif /* __FSL_SL_DPNI_DRV_H */
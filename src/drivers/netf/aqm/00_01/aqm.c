@@ -0,0 +1,453 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		aqm.c
+
+@Description	This file contains the AIOP SW CoDel/PIE active queue
+		management implementation.
+
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_stdlib.h"
+#include "fsl_ldpaa_aiop.h"
+#include "fsl_fdma.h"
+#include "fsl_parser.h"
+#include "fsl_net.h"
+#include "fsl_ip.h"
+#include "fsl_tman.h"
+#include "fsl_spinlock.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_dbg.h"
+#include "aqm.h"
+
+static struct aqm_rec g_aqm[AQM_MAX_INSTANCES] __attribute__((aligned(8)));
+static uint64_t g_aqm_lock __attribute__((aligned(8)));
+
+static uint32_t aqm_isqrt(uint32_t x)
+{
+	uint32_t res = 0, bit = 1UL << 30;
+
+	while (bit > x)
+		bit >>= 2;
+	while (bit) {
+		if (x >= res + bit) {
+			x -= res + bit;
+			res = (res >> 1) + bit;
+		} else {
+			res >>= 1;
+		}
+		bit >>= 2;
+	}
+	return res;
+}
+
+int aqm_create(uint16_t ni_id, uint8_t tc, const struct aqm_params *params,
+	       aqm_handle_t *aqm)
+{
+	struct dpni_drv_congestion_notification_cfg cn_cfg;
+	struct aqm_rec *rec;
+	uint64_t ts;
+	int i, err;
+
+	if (tc >= DPNI_DRV_MAX_TC || !params->rate ||
+	    params->rate > AQM_MAX_RATE ||
+	    (params->algorithm != AQM_CODEL && params->algorithm != AQM_PIE))
+		return -EINVAL;
+	/* At least one 1/65536 byte per microsecond */
+	if (!((params->rate << AQM_FP_SHIFT) / 1000000))
+		return -EINVAL;
+	if (params->target > AQM_MAX_DELAY || params->interval > AQM_MAX_DELAY)
+		return -EINVAL;
+
+	memset(&cn_cfg, 0, sizeof(cn_cfg));
+	if (params->flags & AQM_FLG_CONG_NOTIF) {
+		err = dpni_drv_get_congestion_notification(ni_id, tc,
+							   DPNI_QUEUE_TX,
+							   &cn_cfg);
+		if (err)
+			return err;
+	}
+
+	lock_spinlock(&g_aqm_lock);
+	for (i = 0; i < AQM_MAX_INSTANCES; i++)
+		if (!g_aqm[i].valid)
+			break;
+	if (i == AQM_MAX_INSTANCES) {
+		unlock_spinlock(&g_aqm_lock);
+		return -ENOSPC;
+	}
+	rec = &g_aqm[i];
+	/* Reserve the entry; it is usable only once valid */
+	rec->valid = AQM_RESERVED;
+	unlock_spinlock(&g_aqm_lock);
+
+	memset(&rec->last_ts, 0, offsetof(struct aqm_rec, valid) -
+	       offsetof(struct aqm_rec, last_ts));
+	rec->rate = (uint32_t)((params->rate << AQM_FP_SHIFT) / 1000000);
+	rec->limit = params->limit;
+	rec->ni_id = ni_id;
+	rec->tc = tc;
+	rec->algorithm = (uint8_t)params->algorithm;
+	rec->flags = (uint8_t)params->flags;
+	rec->avg_len = 512;
+	if (params->flags & AQM_FLG_CONG_NOTIF) {
+		rec->cn_entry = cn_cfg.threshold_entry;
+		rec->cn_exit = cn_cfg.threshold_exit;
+		rec->cn_frames = (uint8_t)(cn_cfg.units ==
+					   DPNI_DRV_CONGESTION_UNIT_FRAMES);
+	}
+	if (params->algorithm == AQM_CODEL) {
+		rec->target = params->target ? params->target :
+			AQM_CODEL_DEFAULT_TARGET;
+		rec->interval = params->interval ? params->interval :
+			AQM_CODEL_DEFAULT_INTERVAL;
+	} else {
+		rec->target = params->target ? params->target :
+			AQM_PIE_DEFAULT_TARGET;
+		rec->interval = params->interval ? params->interval :
+			AQM_PIE_DEFAULT_TUPDATE;
+		rec->max_burst = params->max_burst ? params->max_burst :
+			AQM_PIE_DEFAULT_MAX_BURST;
+		rec->alpha = params->alpha ? params->alpha :
+			AQM_PIE_DEFAULT_ALPHA;
+		rec->beta = params->beta ? params->beta :
+			AQM_PIE_DEFAULT_BETA;
+		rec->burst_allowance = rec->max_burst;
+	}
+	tman_get_timestamp(&ts);
+	rec->last_ts = ts;
+	rec->next_ts = ts;
+
+	rec->valid = AQM_VALID;
+	*aqm = (aqm_handle_t)i;
+	return 0;
+}
+
+void aqm_delete(aqm_handle_t aqm)
+{
+	ASSERT_COND(aqm < AQM_MAX_INSTANCES && g_aqm[aqm].valid == AQM_VALID);
+	lock_spinlock(&g_aqm_lock);
+	g_aqm[aqm].valid = 0;
+	unlock_spinlock(&g_aqm_lock);
+}
+
+AQM_CODE_PLACEMENT int aqm_stamp_frame(void)
+{
+	uint8_t pta[64] __attribute__((aligned(64)));
+	uint64_t ts;
+
+	if (fdma_read_default_frame_pta(pta) ||
+	    !LDPAA_FD_GET_PTV1(HWC_FD_ADDRESS))
+		memset(pta, 0, sizeof(pta));
+	tman_get_timestamp(&ts);
+	*(uint64_t *)&pta[AQM_PTA_TS_OFFSET] = ts;
+	return fdma_replace_default_pta_segment_data(
+			FDMA_REPLACE_SA_CLOSE_BIT, pta, NULL,
+			LDPAA_FD_GET_PTV2(HWC_FD_ADDRESS) ? PTA_SIZE_PTV1_2 :
+			PTA_SIZE_PTV1);
+}
+
+AQM_CODE_PLACEMENT int aqm_get_frame_stamp(uint64_t *ts)
+{
+	uint8_t pta[64] __attribute__((aligned(64)));
+
+	if (!LDPAA_FD_GET_PTV1(HWC_FD_ADDRESS) ||
+	    fdma_read_default_frame_pta(pta))
+		return -ENAVAIL;
+	*ts = *(uint64_t *)&pta[AQM_PTA_TS_OFFSET];
+	return 0;
+}
+
+void aqm_set_congestion_state(aqm_handle_t aqm, int congested)
+{
+	struct aqm_rec *rec = &g_aqm[aqm];
+
+	ASSERT_COND_LIGHT(aqm < AQM_MAX_INSTANCES && rec->valid == AQM_VALID);
+	lock_spinlock(&rec->lock);
+	rec->congested = (uint8_t)(congested ? 1 : 0);
+	unlock_spinlock(&rec->lock);
+}
+
+static inline uint64_t aqm_cn_bytes(struct aqm_rec *rec, uint32_t threshold)
+{
+	return rec->cn_frames ? (uint64_t)threshold * rec->avg_len : threshold;
+}
+
+/* Removes from the queue model the bytes drained since the last update */
+static inline void aqm_drain(struct aqm_rec *rec, uint64_t now)
+{
+	uint64_t elapsed, drained;
+
+	if (now > rec->last_ts) {
+		elapsed = now - rec->last_ts;
+		drained = (elapsed >> 31) ? rec->backlog :
+			(elapsed * rec->rate) >> AQM_FP_SHIFT;
+		rec->backlog = (drained >= rec->backlog) ? 0 :
+			rec->backlog - drained;
+		rec->last_ts = now;
+	}
+	if (!(rec->flags & AQM_FLG_CONG_NOTIF))
+		return;
+	/* The Tx queue holds at least the exit threshold while congested and
+	 * at most the entry threshold otherwise */
+	if (rec->congested) {
+		if (rec->backlog < aqm_cn_bytes(rec, rec->cn_exit))
+			rec->backlog = aqm_cn_bytes(rec, rec->cn_exit);
+	} else if (rec->cn_entry) {
+		if (rec->backlog > aqm_cn_bytes(rec, rec->cn_entry))
+			rec->backlog = aqm_cn_bytes(rec, rec->cn_entry);
+	}
+}
+
+static inline uint64_t aqm_codel_control_law(struct aqm_rec *rec, uint64_t t)
+{
+	/* t + interval / sqrt(count) */
+	return t + ((uint64_t)rec->interval << 8) /
+		aqm_isqrt(rec->count << 16);
+}
+
+static enum aqm_verdict aqm_codel(struct aqm_rec *rec, uint64_t now,
+				  uint32_t delay)
+{
+	uint32_t delta;
+	int ok_to_drop = 0;
+
+	if (delay < rec->target || rec->backlog <= AQM_MIN_BACKLOG)
+		rec->first_above_time = 0;
+	else if (!rec->first_above_time)
+		rec->first_above_time = now + rec->interval;
+	else if (now >= rec->first_above_time)
+		ok_to_drop = 1;
+
+	if (rec->dropping) {
+		if (!ok_to_drop) {
+			rec->dropping = 0;
+			return AQM_PASS;
+		}
+		if (now < rec->next_ts)
+			return AQM_PASS;
+		if (rec->count < AQM_CODEL_MAX_COUNT)
+			rec->count++;
+		rec->next_ts = aqm_codel_control_law(rec, rec->next_ts);
+		return AQM_DROP;
+	}
+	if (!ok_to_drop)
+		return AQM_PASS;
+
+	rec->dropping = 1;
+	/* Resume at the previous drop rate if the last dropping state ended
+	 * recently */
+	delta = rec->count - rec->lastcount;
+	if (delta > 1 && delta <= AQM_CODEL_MAX_COUNT &&
+	    (now < rec->next_ts ||
+	     now - rec->next_ts < 16 * (uint64_t)rec->interval))
+		rec->count = delta;
+	else
+		rec->count = 1;
+	rec->lastcount = rec->count;
+	rec->next_ts = aqm_codel_control_law(rec, now);
+	return AQM_DROP;
+}
+
+static void aqm_pie_update(struct aqm_rec *rec, uint64_t now, uint32_t delay)
+{
+	uint32_t prob = rec->drop_prob;
+	int64_t p;
+
+	/* alpha and beta are in 1/256 Hz and the delays in microseconds: the
+	 * probability step is in 1/2^32 units */
+	p = (int64_t)rec->alpha * ((int64_t)delay - rec->target) +
+		(int64_t)rec->beta * ((int64_t)delay - rec->delay);
+	p = p * 16777216 / 1000000;
+	/* RFC 8033: smaller steps while the probability is low */
+	if (prob < 4295)
+		p /= 2048;
+	else if (prob < 42950)
+		p /= 512;
+	else if (prob < 429497)
+		p /= 128;
+	else if (prob < 4294967)
+		p /= 32;
+	else if (prob < 42949673)
+		p /= 8;
+	else if (prob < 429496730)
+		p /= 2;
+	p += prob;
+	/* Decay while the queue is idle */
+	if (!delay && !rec->delay)
+		p -= p >> 6;
+	if (p < 0)
+		p = 0;
+	else if (p > 0xFFFFFFFF)
+		p = 0xFFFFFFFF;
+	rec->drop_prob = (uint32_t)p;
+
+	rec->burst_allowance = (rec->burst_allowance > rec->interval) ?
+		rec->burst_allowance - rec->interval : 0;
+	if (!rec->drop_prob && delay < rec->target / 2 &&
+	    rec->delay < rec->target / 2)
+		rec->burst_allowance = rec->max_burst;
+	rec->delay = delay;
+	rec->next_ts = now;
+}
+
+static enum aqm_verdict aqm_pie(struct aqm_rec *rec, uint64_t now,
+				uint32_t delay)
+{
+	if (now - rec->next_ts >= rec->interval)
+		aqm_pie_update(rec, now, delay);
+	if (rec->burst_allowance)
+		return AQM_PASS;
+	if (rec->delay < rec->target / 2 && rec->drop_prob < AQM_PIE_LOW_PROB)
+		return AQM_PASS;
+	if (rec->backlog < 2 * (uint64_t)rec->avg_len)
+		return AQM_PASS;
+	return (fsl_rand() < rec->drop_prob) ? AQM_DROP : AQM_PASS;
+}
+
+AQM_CODE_PLACEMENT enum aqm_verdict aqm_check(aqm_handle_t aqm,
+					      uint64_t ingress_ts,
+					      uint32_t length, int ect)
+{
+	struct aqm_rec *rec = &g_aqm[aqm];
+	enum aqm_verdict verdict;
+	uint64_t now, delay;
+
+	ASSERT_COND_LIGHT(aqm < AQM_MAX_INSTANCES && rec->valid == AQM_VALID);
+	lock_spinlock(&rec->lock);
+	tman_get_timestamp(&now);
+	rec->avg_len = (uint16_t)((int32_t)rec->avg_len +
+				  ((int32_t)length - rec->avg_len) / 8);
+	aqm_drain(rec, now);
+
+	/* Time to drain the queue model plus the time spent in the AIOP */
+	delay = (rec->backlog << AQM_FP_SHIFT) / rec->rate;
+	if (ingress_ts && now > ingress_ts)
+		delay += now - ingress_ts;
+	if (delay > AQM_MAX_DELAY)
+		delay = AQM_MAX_DELAY;
+
+	if (rec->limit && rec->backlog + length > rec->limit) {
+		verdict = AQM_DROP;
+		ect = 0;
+	} else if (rec->algorithm == AQM_CODEL) {
+		verdict = aqm_codel(rec, now, (uint32_t)delay);
+		rec->delay = (uint32_t)delay;
+	} else {
+		verdict = aqm_pie(rec, now, (uint32_t)delay);
+		if (rec->drop_prob > AQM_PIE_MARK_MAX_PROB)
+			ect = 0;
+	}
+
+	if (verdict == AQM_DROP && ect && (rec->flags & AQM_FLG_ECN))
+		verdict = AQM_MARK;
+	if (verdict == AQM_DROP) {
+		rec->dropped++;
+	} else {
+		rec->backlog += length;
+		rec->passed++;
+		if (verdict == AQM_MARK)
+			rec->marked++;
+	}
+	unlock_spinlock(&rec->lock);
+	return verdict;
+}
+
+AQM_CODE_PLACEMENT int aqm_send(aqm_handle_t aqm, uint64_t ingress_ts,
+				uint32_t send_flags)
+{
+	struct aqm_rec *rec = &g_aqm[aqm];
+	struct ipv4hdr *ipv4_hdr = NULL;
+	struct ipv6hdr *ipv6_hdr = NULL;
+	enum aqm_verdict verdict;
+	uint32_t length;
+	uint8_t tos = 0;
+	int err;
+
+	if (PARSER_IS_OUTER_IPV4_DEFAULT()) {
+		ipv4_hdr = (struct ipv4hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		tos = ipv4_hdr->tos;
+	} else if (PARSER_IS_OUTER_IPV6_DEFAULT()) {
+		ipv6_hdr = (struct ipv6hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		tos = (uint8_t)(ipv6_hdr->vsn_traffic_flow >> 20);
+	}
+	length = LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS);
+	verdict = aqm_check(aqm, ingress_ts, length, tos & AQM_ECN_MASK);
+	if (verdict == AQM_DROP) {
+		fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+		return AQM_STATUS_DROPPED;
+	}
+	if (verdict == AQM_MARK && (tos & AQM_ECN_MASK) != AQM_ECN_CE) {
+		if (ipv4_hdr)
+			ipv4_header_modification(IPV4_MODIFY_MODE_IPTOS,
+						 tos | AQM_ECN_CE, 0, 0, 0);
+		else
+			ipv6_header_modification(IPV6_MODIFY_MODE_IPTC,
+						 tos | AQM_ECN_CE, 0, NULL,
+						 NULL);
+	}
+
+	task_set_tx_tc(rec->tc);
+	err = dpni_drv_send(rec->ni_id, send_flags);
+	if (err == -EBUSY) {
+		/* Rejected by QMan: the Tx queue is congested */
+		lock_spinlock(&rec->lock);
+		rec->backlog = (rec->backlog > length) ?
+			rec->backlog - length : 0;
+		rec->congested = 1;
+		unlock_spinlock(&rec->lock);
+	}
+	return err;
+}
+
+int aqm_get_stats(aqm_handle_t aqm, struct aqm_stats *stats, int reset)
+{
+	struct aqm_rec *rec = &g_aqm[aqm];
+
+	if (aqm >= AQM_MAX_INSTANCES || rec->valid != AQM_VALID)
+		return -EINVAL;
+	lock_spinlock(&rec->lock);
+	stats->passed = rec->passed;
+	stats->marked = rec->marked;
+	stats->dropped = rec->dropped;
+	stats->delay = rec->delay;
+	stats->backlog = (rec->backlog > 0xFFFFFFFF) ? 0xFFFFFFFF :
+		(uint32_t)rec->backlog;
+	stats->drop_prob = rec->drop_prob;
+	if (reset) {
+		rec->passed = 0;
+		rec->marked = 0;
+		rec->dropped = 0;
+	}
+	unlock_spinlock(&rec->lock);
+	return 0;
+}
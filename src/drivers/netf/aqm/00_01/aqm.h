@@ -0,0 +1,127 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		aqm.h
+
+@Description	This file contains the AIOP SW internal AQM API
+
+*//***************************************************************************/
+
+#ifndef __AIOP_AQM_H
+#define __AIOP_AQM_H
+
+#include "fsl_types.h"
+#include "fsl_aqm.h"
+
+/**************************************************************************//**
+@addtogroup	FSL_AQM FSL_AIOP_AQM
+
+@Description	AIOP AQM functions macros and definitions
+
+@{
+*//***************************************************************************/
+
+/*
+ * The drain rate is kept in 1/65536 byte per microsecond (the TMAN timestamp
+ * unit). Delays are in microseconds and are clamped to AQM_MAX_DELAY so that
+ * the PIE controller arithmetic fits in 64 bits.
+ */
+#define AQM_FP_SHIFT		16
+#define AQM_MAX_DELAY		1000000
+	/** Below this backlog (bytes) no frame is dropped: the queue holds
+	 * at most one maximum sized frame */
+#define AQM_MIN_BACKLOG		1518
+	/** Largest CoDel drop count used in the control law */
+#define AQM_CODEL_MAX_COUNT	0xFFFF
+	/** PIE: drop probability above which ECN capable frames are dropped
+	 * rather than marked (10%) */
+#define AQM_PIE_MARK_MAX_PROB	0x1999999A
+	/** PIE: no drop while the delay is below half the target and the
+	 * drop probability below this value (20%) */
+#define AQM_PIE_LOW_PROB	0x33333333
+	/** ECN field of the IPv4 TOS / IPv6 traffic class */
+#define AQM_ECN_MASK		0x03
+#define AQM_ECN_CE		0x03
+
+#define AQM_VALID		1
+#define AQM_RESERVED		2
+
+/**************************************************************************//**
+@Description	AQM instance record (Shared RAM)
+*//***************************************************************************/
+struct aqm_rec {
+	/** Protects the record */
+	uint64_t lock;
+	/** Time of the last queue model update */
+	uint64_t last_ts;
+	/** Bytes in the queue model */
+	uint64_t backlog;
+	/** CoDel: time at which the delay went above the target */
+	uint64_t first_above_time;
+	/** CoDel: time of the next drop / PIE: time of the last update */
+	uint64_t next_ts;
+	uint64_t passed;
+	uint64_t marked;
+	uint64_t dropped;
+	/** Drain rate (1/65536 byte per microsecond) */
+	uint32_t rate;
+	uint32_t target;
+	uint32_t interval;
+	uint32_t max_burst;
+	uint32_t limit;
+	/** Congestion notification thresholds (bytes or frames) */
+	uint32_t cn_entry;
+	uint32_t cn_exit;
+	/** CoDel: drop counts */
+	uint32_t count;
+	uint32_t lastcount;
+	/** PIE: drop probability (1/2^32 units) */
+	uint32_t drop_prob;
+	/** PIE: remaining burst allowance (microseconds) */
+	uint32_t burst_allowance;
+	/** Last delay estimate: PIE uses it as qdelay_old */
+	uint32_t delay;
+	/** Average frame length, for frame based thresholds */
+	uint16_t avg_len;
+	uint16_t alpha;
+	uint16_t beta;
+	uint16_t ni_id;
+	uint8_t tc;
+	uint8_t algorithm;
+	uint8_t flags;
+	uint8_t cn_frames;
+	/** CoDel: dropping state */
+	uint8_t dropping;
+	/** Tx congestion state, from the congestion notifications */
+	uint8_t congested;
+	uint8_t valid;
+	uint8_t res;
+};
+
+/** @} */ /* end of group FSL_AQM */
+
+#endif /* __AIOP_AQM_H */
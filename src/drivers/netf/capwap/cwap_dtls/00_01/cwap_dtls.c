@@ -49,6 +49,7 @@
 #include "rta.h"
 #include "desc/tls.h"
 #include "cwap_dtls.h"
+#include "arw.h"
 
 #include "fsl_dprc.h"
 #include "dpni_drv.h"
@@ -58,9 +59,37 @@
 #include "fsl_icontext.h"
 
 #include "fsl_mem_mng.h"
+#include "fsl_lazy.h"
 
 uint16_t cwap_dtls_bpid;
 
+/* The CWAP/DTLS buffer pool is filled on the first instance creation made at
+ * boot, else by cwap_dtls_drv_post_init() */
+static LAZY_MODULE_DEFINE(cwap_dtls_lazy, "CWAP/DTLS", cwap_dtls_drv_init);
+
+/* Set by cwap_dtls_early_init(): an application uses CWAP/DTLS */
+static uint8_t cwap_dtls_used;
+
+int cwap_dtls_drv_early_init(void)
+{
+	if (!(g_app_params.app_config_flags & CWAP_DTLS_BUFFER_ALLOCATE_ENABLE))
+		return 0;
+
+	return lazy_register(&cwap_dtls_lazy,
+			     (uint64_t)g_app_params.dpni_num_buffs *
+			     g_app_params.dpni_buff_size);
+}
+
+int cwap_dtls_drv_post_init(void)
+{
+	/* Instances may be created at run time, when the lazy module cannot
+	 * be initialized any more */
+	if (!cwap_dtls_used)
+		return 0;
+
+	return lazy_init(&cwap_dtls_lazy);
+}
+
 int cwap_dtls_drv_init(void)
 {
 	struct mc_dprc *dprc = sys_get_unique_handle(FSL_MOD_AIOP_RC);
@@ -160,6 +189,7 @@ int cwap_dtls_early_init(uint32_t total_instance_num,
 
 	committed_buffs = total_instance_num + total_committed_sa_num;
 	max_buffs = total_instance_num + total_max_sa_num;
+	cwap_dtls_used = 1;
 	mem_id = fsl_mem_exists(CWAP_DTLS_PRIMARY_MEM_PARTITION_ID) ?
 			CWAP_DTLS_PRIMARY_MEM_PARTITION_ID :
 			CWAP_DTLS_SECONDARY_MEM_PARTITION_ID;
@@ -176,6 +206,11 @@ int cwap_dtls_create_instance(uint32_t committed_sa_num, uint32_t max_sa_num,
 	struct cwap_dtls_instance_params instance;
 	int err, mem_id;
 
+	/* Reserve and fill the CWAP/DTLS buffer pool, if not done yet */
+	err = lazy_init(&cwap_dtls_lazy);
+	if (err)
+		return err;
+
 	mem_id = fsl_mem_exists(CWAP_DTLS_PRIMARY_MEM_PARTITION_ID) ?
 			CWAP_DTLS_PRIMARY_MEM_PARTITION_ID :
 			CWAP_DTLS_SECONDARY_MEM_PARTITION_ID;
@@ -761,6 +796,19 @@ int cwap_dtls_add_sa_descriptor(struct cwap_dtls_sa_descriptor_params *params,
 	 */
 	if (rta_tls_cipher_mode(params->protcmd.protinfo) == RTA_TLS_CIPHER_GCM)
 		params->flags |= CWAP_DTLS_FLG_CIPHER_GCM;
+
+	/* With the extended anti-replay window, SEC runs without window */
+	if (params->flags & CWAP_DTLS_FLG_EXT_ARW) {
+		if (CWAP_DTLS_IS_OUTBOUND_DIR(params->protcmd.optype))
+			params->flags &= ~CWAP_DTLS_FLG_EXT_ARW;
+		else if (params->flags & CWAP_DTLS_FLG_CIPHER_GCM)
+			params->pdb.gcm.dtls_dec.options &=
+					~DTLS_PDBOPTS_ARS_MASK;
+		else
+			params->pdb.cbc.dtls_dec.options &=
+					~DTLS_PDBOPTS_ARS_MASK;
+	}
+
 	if (CWAP_DTLS_IS_OUTBOUND_DIR(params->protcmd.optype))
 		err = cwap_dtls_generate_encap_sd(params,
 						  CWAP_DTLS_SD_ADDR(desc_addr),
@@ -792,6 +840,31 @@ int cwap_dtls_add_sa_descriptor(struct cwap_dtls_sa_descriptor_params *params,
 	/* Initialize the debug area */
 	cwap_dtls_init_debug_info(desc_addr);
 
+	/* Allocate and initialize the extended anti-replay window */
+	if (params->flags & CWAP_DTLS_FLG_EXT_ARW) {
+		uint64_t seq_num;
+
+		/* Initial epoch (16 bits) and sequence number (48 bits) */
+		if (params->flags & CWAP_DTLS_FLG_CIPHER_GCM)
+			seq_num = ((uint64_t)params->pdb.gcm.dtls_dec.word2 <<
+				   32) | params->pdb.gcm.dtls_dec.seq_num_lo;
+		else
+			seq_num = ((uint64_t)params->pdb.cbc.dtls_dec.word2 <<
+				   32) | params->pdb.cbc.dtls_dec.seq_num_lo;
+
+		err = arw_init(CWAP_DTLS_ARW_ADDR(desc_addr),
+			       params->ar_window_size, seq_num,
+			       fsl_mem_exists(
+					CWAP_DTLS_PRIMARY_MEM_PARTITION_ID) ?
+					CWAP_DTLS_PRIMARY_MEM_PARTITION_ID :
+					CWAP_DTLS_SECONDARY_MEM_PARTITION_ID);
+		if (err) {
+			/* Release the buffer. No check for error here */
+			cwap_dtls_release_buffer(instance_handle, *sa_handle);
+			return err;
+		}
+	}
+
 	return SUCCESS;
 }
 
@@ -799,9 +872,16 @@ int cwap_dtls_del_sa_descriptor(cwap_dtls_sa_handle_t sa_handle)
 {
 	cwap_dtls_instance_handle_t instance_handle;
 	cwap_dtls_sa_handle_t desc_addr;
+	uint32_t params_flags;
 
 	desc_addr = CWAP_DTLS_SA_DESC_ADDR(sa_handle);
 
+	/* Release the extended anti-replay window */
+	cdma_read(&params_flags, CWAP_DTLS_FLAGS_ADDR(desc_addr),
+		  sizeof(params_flags));
+	if (params_flags & CWAP_DTLS_FLG_EXT_ARW)
+		arw_free(CWAP_DTLS_ARW_ADDR(desc_addr));
+
 	/* Read the instance handle from params area */
 	cdma_read(&instance_handle, CWAP_DTLS_INSTANCE_HANDLE_ADDR(desc_addr),
 		  sizeof(instance_handle));
@@ -1124,6 +1204,7 @@ int cwap_dtls_frame_decrypt(cwap_dtls_sa_handle_t sa_handle)
 	uint32_t orig_frc, sec_frc;
 	uint32_t dpovrd = TLS_DPOVRD_USE;
 	uint16_t orig_seg_addr;
+	uint64_t seq_num = 0;
 
 	pr = (struct parse_result *)HWC_PARSE_RES_ADDRESS;
 	prc = (struct presentation_context *) HWC_PRC_ADDRESS;
@@ -1135,13 +1216,6 @@ int cwap_dtls_frame_decrypt(cwap_dtls_sa_handle_t sa_handle)
 	/* Save the original segment address */
 	orig_seg_addr = PRC_GET_SEGMENT_ADDRESS();
 
-	/* 5. Save original FD[FLC], FD[FRC] (to stack) */
-	orig_flc = LDPAA_FD_GET_FLC(HWC_FD_ADDRESS);
-	orig_frc = LDPAA_FD_GET_FRC(HWC_FD_ADDRESS);
-
-	/* 6. Update the FD[FLC] with the flow context buffer address */
-	LDPAA_FD_SET_FLC(HWC_FD_ADDRESS, CWAP_DTLS_FLC_ADDR(desc_addr));
-
 	/*
 	 * Prepare DPOVRD parameters - metadata (headers to be copied verbatim
 	 * to output frame) length
@@ -1154,6 +1228,32 @@ int cwap_dtls_frame_decrypt(cwap_dtls_sa_handle_t sa_handle)
 	metadata_length = (uint8_t)((uint8_t *)PARSER_GET_L5_OFFSET_DEFAULT() -
 				    (uint8_t *)PARSER_GET_ETH_OFFSET_DEFAULT());
 #endif
+
+	/*
+	 * Extended anti-replay window check. The window is updated only after
+	 * SEC has authenticated the record.
+	 */
+	if (sap.flags & CWAP_DTLS_FLG_EXT_ARW) {
+		uint32_t *seq_ptr;
+
+		seq_ptr = (uint32_t *)((uint8_t *)PRC_GET_SEGMENT_ADDRESS() +
+				       PARSER_GET_ETH_OFFSET_DEFAULT() +
+				       metadata_length +
+				       CWAP_DTLS_SEQ_NUM_OFFSET);
+		seq_num = ((uint64_t)seq_ptr[0] << 32) | seq_ptr[1];
+		err = arw_check(CWAP_DTLS_ARW_ADDR(desc_addr), seq_num);
+		if (err)
+			return (err == ARW_LATE) ? CWAP_DTLS_AR_LATE_PACKET :
+						   CWAP_DTLS_AR_REPLAY_PACKET;
+	}
+
+	/* 5. Save original FD[FLC], FD[FRC] (to stack) */
+	orig_flc = LDPAA_FD_GET_FLC(HWC_FD_ADDRESS);
+	orig_frc = LDPAA_FD_GET_FRC(HWC_FD_ADDRESS);
+
+	/* 6. Update the FD[FLC] with the flow context buffer address */
+	LDPAA_FD_SET_FLC(HWC_FD_ADDRESS, CWAP_DTLS_FLC_ADDR(desc_addr));
+
 	dpovrd |= (metadata_length << DTLS_DPOVRD_METADATA_LEN_SHIFT) &
 		  DTLS_DPOVRD_METADATA_LEN_MASK;
 
@@ -1301,6 +1401,18 @@ int cwap_dtls_frame_decrypt(cwap_dtls_sa_handle_t sa_handle)
 		return dec_status;
 	}
 
+	/*
+	 * The record is authenticated, record it in the extended anti-replay
+	 * window. Another task may have moved the window or received the same
+	 * sequence number since the check.
+	 */
+	if (sap.flags & CWAP_DTLS_FLG_EXT_ARW) {
+		err = arw_update(CWAP_DTLS_ARW_ADDR(desc_addr), seq_num);
+		if (err)
+			return (err == ARW_LATE) ? CWAP_DTLS_AR_LATE_PACKET :
+						   CWAP_DTLS_AR_REPLAY_PACKET;
+	}
+
 	/*
 	 * Check DTLS padding
 	 * When CWAP_DTLS_FLG_PAD_CHECK is enabled, outFMT=2b'10 which means
@@ -1579,6 +1691,13 @@ void cwap_dtls_get_ar_info(cwap_dtls_sa_handle_t sa_handle,
 	cdma_read(&params_flags, CWAP_DTLS_FLAGS_ADDR(desc_addr),
 		  sizeof(params_flags));
 
+	/* Extended anti-replay window, the PDB has no window */
+	if (params_flags & CWAP_DTLS_FLG_EXT_ARW) {
+		arw_get_info(CWAP_DTLS_ARW_ADDR(desc_addr), sequence_number,
+			     anti_replay_bitmap);
+		return;
+	}
+
 	if (params_flags & CWAP_DTLS_FLG_CIPHER_GCM)
 		cwap_dtls_get_ar_info_gcm(desc_addr, params_flags,
 					  sequence_number, anti_replay_bitmap);
@@ -1587,6 +1706,23 @@ void cwap_dtls_get_ar_info(cwap_dtls_sa_handle_t sa_handle,
 					  sequence_number, anti_replay_bitmap);
 }
 
+int cwap_dtls_get_ar_stats(cwap_dtls_sa_handle_t sa_handle,
+			   uint64_t *replay_pkts, uint64_t *late_pkts)
+{
+	cwap_dtls_sa_handle_t desc_addr = CWAP_DTLS_SA_DESC_ADDR(sa_handle);
+	uint32_t params_flags;
+
+	cdma_read(&params_flags, CWAP_DTLS_FLAGS_ADDR(desc_addr),
+		  sizeof(params_flags));
+
+	if (!(params_flags & CWAP_DTLS_FLG_EXT_ARW))
+		return -EINVAL;
+
+	arw_get_counters(CWAP_DTLS_ARW_ADDR(desc_addr), replay_pkts, late_pkts);
+
+	return SUCCESS;
+}
+
 void cwap_dtls_error_handler(cwap_dtls_sa_handle_t sa_handle,
 			     enum cwap_dtls_function_identifier func_id,
 			     enum cwap_dtls_service_identifier service_id,
@@ -182,7 +182,9 @@ struct cwap_dtls_debug_info {
 /**
  *                  SA Descriptor Structure
  * ------------------------------------------------------
- * | cwap_dtls_sa_params              | 128 bytes       | + 0
+ * | cwap_dtls_sa_params              | 64 bytes        | + 0
+ * ------------------------------------------------------
+ * | Extended anti-replay window      | 64 bytes        | + 64
  * ------------------------------------------------------
  * | sec_flow_context                 | 64 bytes        | + 128
  * -----------------------------------------------------
@@ -264,6 +266,19 @@ struct cwap_dtls_debug_info {
 /* PDB address */
 #define CWAP_DTLS_PDB_ADDR(ADDRESS)	(CWAP_DTLS_SD_ADDR(ADDRESS) + 4)
 
+/*
+ * Extended anti-replay window context (struct arw_context), in the second
+ * half of the parameters area
+ */
+#define CWAP_DTLS_ARW_OFFSET		64
+#define CWAP_DTLS_ARW_ADDR(ADDRESS)	((ADDRESS) + CWAP_DTLS_ARW_OFFSET)
+
+/*
+ * Offset of the DTLS epoch and sequence number from the end of the metadata:
+ * 4-byte CAPWAP DTLS header, 1-byte type, 2-byte version
+ */
+#define CWAP_DTLS_SEQ_NUM_OFFSET	7
+
 #ifndef CWAP_DTLS_PRIMARY_MEM_PARTITION_ID
 	#define CWAP_DTLS_PRIMARY_MEM_PARTITION_ID	MEM_PART_DP_DDR
 #endif
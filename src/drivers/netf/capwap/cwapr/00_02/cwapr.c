@@ -57,12 +57,194 @@
 #include "fsl_dbg.h"
 #include "fsl_sl_slab.h"
 #endif
+#include "fsl_mem_mng.h"
+#include "fsl_prof.h"
 
 /* TODO: do we actually need a structure? */
 struct  cwapr_global_parameters g_cwapr_params;
 extern struct dpni_drv *nis;
 extern __TASK struct aiop_default_task_params default_task_params;
 
+static enum memory_partition_id g_mem_pid = MEM_PART_SYSTEM_DDR;
+
+PROF_REGION_DEFINE(cwapr_lookup);
+PROF_REGION_DEFINE(cwapr_delete);
+
+/* CWAPR_SW_TABLE */
+static int cwapr_sw_table_create(struct cwapr_instance *cwapr_instance,
+				 uint32_t num_of_bins, uint32_t table_location)
+{
+	struct cwapr_sw_table_entry bin[CWAPR_SW_TABLE_BIN_ENTRIES]
+						__attribute__((aligned(16)));
+	enum memory_partition_id mem_pid;
+	uint64_t paddr = 0;
+	uint32_t id;
+	int err;
+
+	if (!num_of_bins)
+		num_of_bins = CWAPR_SW_TABLE_DEFAULT_BINS;
+	/* the hash is reduced to a bin number with a mask */
+	if (num_of_bins & (num_of_bins - 1))
+		return -EINVAL;
+
+	if (table_location == CWAPR_MODE_TABLE_LOCATION_PEB)
+		mem_pid = MEM_PART_PEB;
+#ifndef LS1088A_REV1
+	else if (table_location == CWAPR_MODE_TABLE_LOCATION_DP_DDR)
+		mem_pid = MEM_PART_DP_DDR;
+#endif
+	else if (table_location == CWAPR_MODE_TABLE_LOCATION_SYS_DDR)
+		mem_pid = MEM_PART_SYSTEM_DDR;
+	else
+		return -EINVAL;
+
+	err = fsl_get_mem(num_of_bins * CWAPR_SW_TABLE_BIN_SIZE,
+			  mem_pid, CWAPR_SW_TABLE_BIN_SIZE, &paddr);
+	if (err)
+		return err;
+
+	/* the virtual address of a bin is its scope_id */
+	cwapr_instance->sw_table_id =
+			(uint32_t)sys_fast_phys_to_virt(paddr, mem_pid);
+	if (!cwapr_instance->sw_table_id) {
+		fsl_put_mem(paddr);
+		return -ENOMEM;
+	}
+	cwapr_instance->sw_table_addr = paddr;
+	cwapr_instance->sw_table_mask = num_of_bins - 1;
+
+	/* Clear the table */
+	memset(bin, 0, sizeof(bin));
+	for (id = 0; id < num_of_bins; id++)
+		cdma_write(paddr + id * CWAPR_SW_TABLE_BIN_SIZE,
+			   bin, sizeof(bin));
+	return 0;
+}
+
+static CWAPR_CODE_PLACEMENT void cwapr_sw_table_key_delete(
+		struct cwapr_instance *cwapr_instance,
+		struct cwapr_rfdc *rfdc, uint32_t rfdc_virt_addr,
+		uint8_t lock_with_osm_enter)
+{
+	uint32_t bin = (uint32_t)rfdc->table_key[0];
+	uint32_t virt_addr;
+	uint64_t entry_addr;
+
+	/* get exclusive access to the bin */
+	if (lock_with_osm_enter)
+		osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE,
+				cwapr_instance->sw_table_id +
+				bin * CWAPR_SW_TABLE_BIN_SIZE);
+	else
+		osm_scope_transition_to_exclusive_with_new_scope_id(
+				cwapr_instance->sw_table_id +
+				bin * CWAPR_SW_TABLE_BIN_SIZE);
+
+	entry_addr = cwapr_instance->sw_table_addr +
+		     bin * CWAPR_SW_TABLE_BIN_SIZE +
+		     rfdc->table_key[1] * sizeof(struct cwapr_sw_table_entry) +
+		     offsetof(struct cwapr_sw_table_entry, virt_addr);
+
+	cdma_read(&virt_addr, entry_addr, sizeof(virt_addr));
+	/* the entry was already released and taken by another frame */
+	if (virt_addr != rfdc_virt_addr)
+		return;
+
+	/* clear the entry */
+	virt_addr = 0;
+	cdma_write(entry_addr, &virt_addr, sizeof(virt_addr));
+}
+
+static CWAPR_CODE_PLACEMENT int sw_cwapr_lookup_or_insert(
+		struct cwapr_instance *cwapr_instance,
+		uint32_t osm_status, uint64_t tunnel_id,
+		struct cwapr_rfdc *rfdc,
+		cwapr_instance_handle_t cwapr_instance_handle,
+		uint64_t *rfdc_ext_addr)
+{
+	struct cwapr_sw_table_entry bin[CWAPR_SW_TABLE_BIN_ENTRIES]
+						__attribute__((aligned(16)));
+	struct cwapr_sw_table_entry key __attribute__((aligned(16)));
+	struct capwaphdr *capwap_hdr;
+	uint64_t bin_addr;
+	uint32_t h, scope_id;
+	uint8_t i, first_free = CWAPR_SW_TABLE_BIN_ENTRIES;
+	int status;
+
+	capwap_hdr = (struct capwaphdr *)(
+		PARSER_GET_NEXT_HEADER_OFFSET_DEFAULT() +
+		PRC_GET_SEGMENT_ADDRESS());
+
+	key.tunnel_id = tunnel_id;
+	key.frag_id = capwap_hdr->frag_id;
+
+	/* Generate a hash over the key and reduce it to a bin number */
+	keygen_gen_hash(&key, CWAPR_KEY_SIZE, &h);
+	h &= cwapr_instance->sw_table_mask;
+	scope_id = cwapr_instance->sw_table_id + h * CWAPR_SW_TABLE_BIN_SIZE;
+	bin_addr = cwapr_instance->sw_table_addr + h * CWAPR_SW_TABLE_BIN_SIZE;
+
+	/* create nested per bin. Same levels as the nested per reassembled
+	 * frame of the CTLU table mode */
+	if ((osm_status == NO_BYPASS_OSM) || (osm_status & START_CONCURRENT))
+		/* release parent to concurrent */
+		osm_scope_enter_to_exclusive_with_new_scope_id(scope_id);
+	else
+		/* doesn't release parent to concurrent */
+		osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE, scope_id);
+
+	cdma_read(bin, bin_addr, sizeof(bin));
+
+	/* search the key */
+	for (i = 0; i < CWAPR_SW_TABLE_BIN_ENTRIES; i++) {
+		if (bin[i].virt_addr == 0) {
+			if (first_free == CWAPR_SW_TABLE_BIN_ENTRIES)
+				first_free = i;
+		} else if ((bin[i].tunnel_id == key.tunnel_id) &&
+			   (bin[i].frag_id == key.frag_id)) {
+			/* Hit */
+			*rfdc_ext_addr = sys_fast_virt_to_phys(
+					(void *)bin[i].virt_addr, g_mem_pid);
+			/* get exclusive access to the RFDC */
+			osm_scope_transition_to_exclusive_with_new_scope_id(
+							bin[i].virt_addr);
+			return TABLE_STATUS_SUCCESS;
+		}
+	}
+
+	if ((first_free == CWAPR_SW_TABLE_BIN_ENTRIES) ||
+	    (cwapr_instance->num_of_open_reass_frames >=
+	     cwapr_instance->max_open_frames)) {
+		/* The bin is full or maximum open reassembly is reached */
+		update_stats_cwapr(cwapr_instance,
+				offsetof(struct cwapr_stats_cntrs,
+				open_reass_frms_exceed_cntr));
+		return_to_correct_ordering_scope(osm_status);
+		return -ENOSPC;
+	}
+
+	/* Miss */
+	status = miss_cwapr_flow(cwapr_instance, osm_status, tunnel_id, rfdc,
+				 cwapr_instance_handle, rfdc_ext_addr);
+	if (status)
+		return status;
+
+	/* store the entry in RFDC, to know what to delete from the table */
+	rfdc->table_key[0] = h;
+	rfdc->table_key[1] = first_free;
+
+	key.res = 0;
+	key.virt_addr = (uint32_t)sys_fast_phys_to_virt(*rfdc_ext_addr,
+							g_mem_pid);
+	cdma_write(bin_addr + first_free * sizeof(key), &key, sizeof(key));
+
+	/* get exclusive access to the RFDC */
+	osm_scope_transition_to_exclusive_with_new_scope_id(key.virt_addr);
+
+	/* TABLE_STATUS_MISS is expected by cwapr_reassemble() */
+	return TABLE_STATUS_MISS;
+}
+
 
 #ifndef AIOP_VERIF
 int cwapr_early_init(uint32_t num_of_instances, uint32_t num_of_context_buffers)
@@ -87,6 +269,13 @@ int cwapr_early_init(uint32_t num_of_instances, uint32_t num_of_context_buffers)
 		pr_err("Failed to register CWAPR context buffers\n");
 		return err;
 	}
+
+	/* Check that the software table bin alignment matches the
+	 * OSM_SCOPE_ID mask */
+	ASSERT_COND(SW_CWAPR_OSM_MASK == CWAPR_SW_TABLE_BIN_SIZE - 1);
+	ASSERT_COND(CWAPR_SW_TABLE_BIN_ENTRIES *
+		    sizeof(struct cwapr_sw_table_entry) ==
+		    CWAPR_SW_TABLE_BIN_SIZE);
 	return 0;
 }
 #endif
@@ -97,6 +286,9 @@ int cwapr_init(void)
 	int    status;
 	uint8_t  cwapr_key_id;
 
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		g_mem_pid = MEM_PART_DP_DDR;
+
 	/* CAPWAP key: tunnel ID + fragment ID */
 	keygen_kcr_builder_init(&kb);
 
@@ -161,7 +353,21 @@ int cwapr_create_instance(struct cwapr_params *params,
 
 	/* Initialize instance parameters */
 	cwapr_instance.table_id = 0;
-	if (params->max_open_frames) {
+	cwapr_instance.sw_table_id = 0;
+	cwapr_instance.sw_table_addr = 0;
+	cwapr_instance.sw_table_mask = 0;
+	if (params->max_open_frames && (params->flags & CWAPR_MODE_SW_TABLE)) {
+		cwapr_instance.max_open_frames = params->max_open_frames;
+		status = cwapr_sw_table_create(&cwapr_instance,
+					       params->sw_table_bins,
+					       params->flags & 0x0C000000);
+		if (status) {
+			cdma_release_context_memory(*cwapr_instance_handle);
+			cwapr_exception_handler(CWAPR_CREATE_INSTANCE, __LINE__,
+					(status == -EINVAL) ? EINVAL_SW_TABLE :
+					ENOMEM_TABLE);
+		}
+	} else if (params->max_open_frames) {
 		cwapr_instance.max_open_frames = params->max_open_frames;
 		tbl_params.committed_rules = params->max_open_frames;
 		tbl_params.max_rules = params->max_open_frames;
@@ -273,7 +479,11 @@ void delete_cwapr_instance_at_timeout(
 		cdma_release_context_memory(cwapr_instance_handle);
 
 	/* error case */
-	table_delete(TABLE_ACCEL_ID_CTLU, cwapr_instance.table_id);
+	if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE) {
+		if (cwapr_instance.sw_table_addr)
+			fsl_put_mem(cwapr_instance.sw_table_addr);
+	} else
+		table_delete(TABLE_ACCEL_ID_CTLU, cwapr_instance.table_id);
 
 	cwapr_instance.confirm_delete_cb(cwapr_instance.delete_arg);
 }
@@ -341,26 +551,41 @@ CWAPR_CODE_PLACEMENT int cwapr_reassemble(
 	cdma_read_wrp(&cwapr_instance, instance_handle, CWAPR_INSTANCE_SIZE);
 
 	if (check_for_capwap_frag_error(capwap_hdr) == NO_ERROR) {
-
-		sr_status = lookup_cwapr_flow(&cwapr_instance,
-				tunnel_id, &rfdc_ext_addr);
+		PROF_REGION_START(cwapr_lookup);
+		if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE)
+			/* Enters the OSM scope of the RFDC */
+			sr_status = sw_cwapr_lookup_or_insert(&cwapr_instance,
+							      osm_status,
+							      tunnel_id,
+							      &rfdc,
+							      instance_handle,
+							      &rfdc_ext_addr);
+		else
+			sr_status = lookup_cwapr_flow(&cwapr_instance,
+					tunnel_id, &rfdc_ext_addr);
 		if (sr_status == TABLE_STATUS_SUCCESS) {
 			/* Hit */
 
 			/* create nested per reassembled frame
-			 * Also serve as mutex for Timeout */
-			if ((osm_status == NO_BYPASS_OSM) ||
-				(osm_status & START_CONCURRENT)) {
-				/* release parent to concurrent */
-				osm_scope_enter_to_exclusive_with_new_scope_id(
+			 * Also serve as mutex for Timeout.
+			 * Already done by the software table lookup */
+			if (!(cwapr_instance.flags & CWAPR_MODE_SW_TABLE)) {
+				if ((osm_status == NO_BYPASS_OSM) ||
+					(osm_status & START_CONCURRENT)) {
+					/* release parent to concurrent */
+					osm_scope_enter_to_exclusive_with_new_scope_id(
 						  (uint32_t)rfdc_ext_addr);
-			} else {
-			      /* Next step is needed only for mutex with
-			       * Timeout.
-			       * Doesn't release parent to concurrent */
-			     osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE,
-					     (uint32_t)rfdc_ext_addr);
+				} else {
+					/* Next step is needed only for mutex
+					 * with Timeout.
+					 * Doesn't release parent to
+					 * concurrent */
+					osm_scope_enter(
+					    OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE,
+					    (uint32_t)rfdc_ext_addr);
+				}
 			}
+			PROF_REGION_STOP(cwapr_lookup);
 
 			/* read RFDC */
 			cdma_read_wrp(&rfdc, rfdc_ext_addr, CWAPR_RFDC_SIZE);
@@ -376,16 +601,27 @@ CWAPR_CODE_PLACEMENT int cwapr_reassemble(
 				return -ETIMEDOUT;
 			}
 		} else if (sr_status == TABLE_STATUS_MISS) {
-			sr_status = miss_cwapr_flow(&cwapr_instance,
-						   osm_status,
-						   tunnel_id,
-						   &rfdc,
-						   instance_handle,
-						   &rfdc_ext_addr);
+			if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE)
+				/* the entry was already added into the
+				 * software table */
+				sr_status = SUCCESS;
+			else
+				sr_status = miss_cwapr_flow(&cwapr_instance,
+							   osm_status,
+							   tunnel_id,
+							   &rfdc,
+							   instance_handle,
+							   &rfdc_ext_addr);
+			PROF_REGION_STOP(cwapr_lookup);
 			if (sr_status)
 				return sr_status;
 
+		} else if (sr_status == -ENOSPC) {
+			/* Software table bin or instance is full */
+			PROF_REGION_STOP(cwapr_lookup);
+			return sr_status;
 		} else {
+		PROF_REGION_STOP(cwapr_lookup);
 		/* TLU lookup SR error */
 		pr_err("CWAPR Lookup failed\n");
 	}
@@ -485,12 +721,16 @@ CWAPR_CODE_PLACEMENT int cwapr_reassemble(
 	/* Reset Valid bit of RFDC */
 	rfdc.status = rfdc.status & ~RFDC_VALID;
 
-	table_rule_delete_wrp(TABLE_ACCEL_ID_CTLU,
-			  cwapr_instance.table_id,
-			  (union table_key_desc *)&rfdc.table_key,
-			  CWAPR_KEY_SIZE,
-			  NULL);
-	/* DEBUG : check EIO */
+	if (!(cwapr_instance.flags & CWAPR_MODE_SW_TABLE)) {
+		PROF_REGION_START(cwapr_delete);
+		table_rule_delete_wrp(TABLE_ACCEL_ID_CTLU,
+				  cwapr_instance.table_id,
+				  (union table_key_desc *)&rfdc.table_key,
+				  CWAPR_KEY_SIZE,
+				  NULL);
+		PROF_REGION_STOP(cwapr_delete);
+		/* DEBUG : check EIO */
+	}
 
 	/* Open segment for reassembled frame */
 	/* Retrieve original seg length,seg addr and seg offset from RFDC */
@@ -520,6 +760,17 @@ CWAPR_CODE_PLACEMENT int cwapr_reassemble(
 				  CWAPR_RFDC_SIZE,
 				  (uint32_t *)CWAPR_REF_COUNT_ADDR);
 
+	if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE) {
+		PROF_REGION_START(cwapr_delete);
+		/* delete this late the entry from the software table because
+		   of OSM transition */
+		cwapr_sw_table_key_delete(&cwapr_instance, &rfdc,
+					  (uint32_t)sys_fast_phys_to_virt(
+						rfdc_ext_addr, g_mem_pid),
+					  FALSE);
+		PROF_REGION_STOP(cwapr_delete);
+	}
+
 	return_to_correct_ordering_scope(osm_status);
 
 	/* Decrement no of IPv4 open frames in instance data structure*/
@@ -607,8 +858,18 @@ CWAPR_CODE_PLACEMENT int miss_cwapr_flow(struct cwapr_instance *cwapr_instance,
 
 	/* Miss */
 	status = cdma_acquire_context_memory(cwapr_instance->bpid, rfdc_ext_addr);
-	if (status)
+	if (status) {
+		if (cwapr_instance->flags & CWAPR_MODE_SW_TABLE) {
+			/* The context buffers of the instance are exhausted.
+			 * The OSM scope of the bin was entered */
+			update_stats_cwapr(cwapr_instance,
+					offsetof(struct cwapr_stats_cntrs,
+					open_reass_frms_exceed_cntr));
+			return_to_correct_ordering_scope(osm_status);
+			return -ENOSPC;
+		}
 		cwapr_exception_handler(CWAPR_REASSEMBLE, __LINE__, status);
+	}
 
 	/* increment reference count */
 
@@ -616,39 +877,42 @@ CWAPR_CODE_PLACEMENT int miss_cwapr_flow(struct cwapr_instance *cwapr_instance,
 	/*cdma_ws_memory_init((void *)&rfdc,
 			SIZE_TO_INIT,
 			0);  */
-	/* Add entry to TLU table */
-	/* Generate key */
-	rule.options = 0;
-	rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
-	rule.result.data0 = *rfdc_ext_addr;
-	
-	*(uint64_t *)rule.key_desc.em.key = tunnel_id;
-	*(uint16_t *)((uint8_t *)rule.key_desc.em.key + sizeof(uint64_t)) =
-			capwap_hdr->frag_id;
-
-	status = table_rule_create_wrp(
-			TABLE_ACCEL_ID_CTLU,
-			cwapr_instance->table_id,
-			&rule,
-			CWAPR_KEY_SIZE,
-			&rule_id);
+	/* CWAPR_SW_TABLE: the entry is added by the caller */
+	if (!(cwapr_instance->flags & CWAPR_MODE_SW_TABLE)) {
+		/* Add entry to TLU table */
+		/* Generate key */
+		rule.options = 0;
+		rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
+		rule.result.data0 = *rfdc_ext_addr;
+
+		*(uint64_t *)rule.key_desc.em.key = tunnel_id;
+		*(uint16_t *)((uint8_t *)rule.key_desc.em.key +
+			      sizeof(uint64_t)) = capwap_hdr->frag_id;
+
+		status = table_rule_create_wrp(
+				TABLE_ACCEL_ID_CTLU,
+				cwapr_instance->table_id,
+				&rule,
+				CWAPR_KEY_SIZE,
+				&rule_id);
+
+		if (status == -ENOMEM) {
+			/* Maximum open reassembly is reached */
+			update_stats_cwapr(cwapr_instance,
+					offsetof(struct cwapr_stats_cntrs,
+					open_reass_frms_exceed_cntr));
+			/* Release acquired buffer */
+			cdma_release_context_memory(*rfdc_ext_addr);
+			/* Handle ordering scope */
+			move_to_correct_cwapr_ordering_scope(osm_status);
+			return -ENOSPC;
+		}
 
-	if (status == -ENOMEM) {
-		/* Maximum open reassembly is reached */
-		update_stats_cwapr(cwapr_instance,
-				offsetof(struct cwapr_stats_cntrs,
-				open_reass_frms_exceed_cntr));
-		/* Release acquired buffer */
-		cdma_release_context_memory(*rfdc_ext_addr);
-		/* Handle ordering scope */
-		move_to_correct_cwapr_ordering_scope(osm_status);
-		return -ENOSPC;
+		/* store key in RDFC */
+		rfdc->table_key[0] = *(uint64_t *)rule.key_desc.em.key;
+		rfdc->table_key[1] = *(uint64_t *)(rule.key_desc.em.key + 8);
 	}
 
-	/* store key in RDFC */
-	rfdc->table_key[0] = *(uint64_t *)rule.key_desc.em.key;
-	rfdc->table_key[1] = *(uint64_t *)(rule.key_desc.em.key + 8);
-
 	/* Increment number of open frames in instance data structure */
 	ste_inc_counter_wrp(cwapr_instance_handle +
 		 offsetof(struct cwapr_instance, num_of_open_reass_frames),
@@ -683,6 +947,11 @@ CWAPR_CODE_PLACEMENT int miss_cwapr_flow(struct cwapr_instance *cwapr_instance,
 	if (status)
 		cwapr_exception_handler(CWAPR_REASSEMBLE, __LINE__, ENOSPC_TIMER);
 
+	/* CWAPR_SW_TABLE: the caller already entered the nested scope of
+	 * the bin and transitions it to the RFDC scope */
+	if (cwapr_instance->flags & CWAPR_MODE_SW_TABLE)
+		return SUCCESS;
+
 	/* create nested per reassembled frame
 	 * Also serve as mutex for Timeout */
 	if ((osm_status == NO_BYPASS_OSM) || (osm_status & START_CONCURRENT)) {
@@ -1206,6 +1475,7 @@ void timeout_cwapr_reassemble(uint64_t rfdc_ext_addr, uint16_t opaque)
 	uint16_t rfdc_status;
 	uint32_t flags;
 	uint32_t i;
+	uint32_t scope_id;
 	uint8_t  enter_number;
 	uint8_t  num_of_frags;
 	uint8_t  first_frag_idx;
@@ -1222,12 +1492,28 @@ void timeout_cwapr_reassemble(uint64_t rfdc_ext_addr, uint16_t opaque)
 	/* Recover OSM scope */
 	enter_number = (uint8_t)((rfdc.status & SCOPE_LEVEL) >> 4) -
 					default_task_params.current_scope_level;
+	scope_id = (uint32_t)rfdc_ext_addr;
+	if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE) {
+		/* Use virtual addresses for scope_id since they are unique */
+		scope_id = (uint32_t)sys_fast_phys_to_virt(rfdc_ext_addr,
+							   g_mem_pid);
+		/* The saved level already includes the scope of the bin */
+		enter_number--;
+	}
 	for (i = 0; i < enter_number; i++) {
 		/* Intentionally doesn't relinquish parent automatically */
-		osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE,
-						(uint32_t)rfdc_ext_addr);
+		osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE, scope_id);
+	}
+	if (cwapr_instance.flags & CWAPR_MODE_SW_TABLE) {
+		/* first delete the entry from the software table because
+		   of OSM */
+		cwapr_sw_table_key_delete(&cwapr_instance, &rfdc, scope_id,
+					  TRUE);
+		/* get exclusive access to the RFDC */
+		osm_scope_transition_to_exclusive_with_new_scope_id(scope_id);
+	} else {
+		osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE, scope_id);
 	}
-	osm_scope_enter(OSM_SCOPE_ENTER_CHILD_TO_EXCLUSIVE, (uint32_t)rfdc_ext_addr);
 
 	/* confirm timer expiration */
 	tman_timer_completion_confirmation(rfdc.timer_handle);
@@ -1239,11 +1525,12 @@ void timeout_cwapr_reassemble(uint64_t rfdc_ext_addr, uint16_t opaque)
 	if (!(rfdc_status & RFDC_VALID))
 		fdma_terminate_task();
 
-	table_rule_delete_by_key_desc(TABLE_ACCEL_ID_CTLU,
-			  cwapr_instance.table_id,
-			  (union table_key_desc *)&rfdc.table_key,
-			  CWAPR_KEY_SIZE,
-			  NULL);
+	if (!(cwapr_instance.flags & CWAPR_MODE_SW_TABLE))
+		table_rule_delete_by_key_desc(TABLE_ACCEL_ID_CTLU,
+				  cwapr_instance.table_id,
+				  (union table_key_desc *)&rfdc.table_key,
+				  CWAPR_KEY_SIZE,
+				  NULL);
 	/* DEBUG: check EIO */
 
 	/* Decrement no of IPv4 open frames in instance data structure*/
@@ -1727,6 +2014,9 @@ void cwapr_exception_handler(enum cwapr_function_identifier func_id,
 			err_msg = "Not enough memory available to create "
 				   "table\n";
 			break;
+		case EINVAL_SW_TABLE:
+			err_msg = "Invalid software table bins or location\n";
+			break;
 		default:
 			err_msg = "Unknown or Invalid status Error.\n";
 		}
@@ -84,8 +84,38 @@
 				TMAN_CREATE_TIMER_MODE_LOW_PRIORITY_TASK)
 #define ENOSPC_TIMER		2
 #define ENOMEM_TABLE		3
+#define EINVAL_SW_TABLE		4
 #define CWAPR_ERROR		1
 
+/*
+ * CWAPR_SW_TABLE: software hash table used instead of the CTLU table when
+ * CWAPR_MODE_SW_TABLE is set (see USE_IPR_SW_TABLE in IPR).
+ *
+ * The table is an array of bins allocated at instance creation. A bin is
+ * 64 bytes and holds CWAPR_SW_TABLE_BIN_ENTRIES entries, so it is read and
+ * written with a single CDMA access. The lookup key (tunnel ID + fragment ID)
+ * is hashed and reduced to a bin number.
+ *
+ * A bin is protected with an exclusive OSM scope whose scope_id is the
+ * virtual address of the bin. The RFDC scope_id is its virtual address too.
+ * The virtual addresses are unique and aligned to 64, so the portion of the
+ * scope_id reserved for the OSM infrastructure stays zero.
+ */
+#define CWAPR_SW_TABLE_BIN_SIZE		64
+#define SW_CWAPR_OSM_MASK		(OSM_SCOPE_ID_STAGE_INCREMENT_MASK | \
+					 OSM_SCOPE_ID_LEVEL_INCREMENT_MASK)
+
+#pragma pack(push, 1)
+struct cwapr_sw_table_entry {
+	/* lookup key: CWAPR_KEY_SIZE bytes */
+	uint64_t	tunnel_id;
+	uint16_t	frag_id;
+	uint16_t	res;
+	/* virtual address of the RFDC, 0 if the entry is free */
+	uint32_t	virt_addr;
+};	/* 16 byte */
+#pragma pack(pop)
+
 /* todo should move to general or OSM include file */
 #define CONCURRENT		0
 #define EXCLUSIVE		1
@@ -118,7 +148,14 @@ struct cwapr_instance {
 	uint16_t	timeout_value;
 	/* TMAN Instance ID */
 	uint8_t		tmi_id;
-	uint8_t		res[7];
+	uint8_t		res[3];
+	/* CWAPR_SW_TABLE: virtual address of the table, used for scope_id */
+	uint32_t	sw_table_id;
+	/* CWAPR_SW_TABLE: physical address of the table */
+	uint64_t	sw_table_addr;
+	/* CWAPR_SW_TABLE: number of bins - 1 */
+	uint32_t	sw_table_mask;
+	uint8_t		res1[4];
 };
 #pragma pack(pop)
 
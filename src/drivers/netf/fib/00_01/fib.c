@@ -0,0 +1,797 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fib.c
+
+@Description	This file contains the AIOP SW IPv4/IPv6 FIB implementation.
+
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_parser.h"
+#include "fsl_table.h"
+#include "fsl_keygen.h"
+#include "fsl_cdma.h"
+#include "cdma.h"
+#include "fsl_net.h"
+#include "fsl_l2.h"
+#include "fsl_ip.h"
+#include "fsl_rcu.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_sl_dpni_drv.h"
+#include "fsl_dbg.h"
+#include "fsl_sl_slab.h"
+#include "fsl_mem_mng.h"
+#include "fib.h"
+
+static enum memory_partition_id g_mem_pid = MEM_PART_SYSTEM_DDR;
+
+#ifndef AIOP_VERIF
+int fib_early_init(uint32_t nbr_of_instances, uint32_t nbr_of_next_hops,
+		   uint32_t nbr_of_nh_groups)
+{
+	int err;
+
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		g_mem_pid = MEM_PART_DP_DDR;
+
+	err = slab_register_context_buffer_requirements(nbr_of_instances,
+							nbr_of_instances,
+							FIB_INSTANCE_BUF_SIZE,
+							FIB_MEM_ALIGN,
+							g_mem_pid,
+							0,
+							0);
+	if (err) {
+		pr_err("Failed to register FIB instance buffers\n");
+		return err;
+	}
+
+	if (nbr_of_next_hops) {
+		err = slab_register_context_buffer_requirements(
+							nbr_of_next_hops,
+							nbr_of_next_hops,
+							FIB_NH_BUF_SIZE,
+							FIB_MEM_ALIGN,
+							g_mem_pid,
+							0,
+							0);
+		if (err) {
+			pr_err("Failed to register FIB next hop buffers\n");
+			return err;
+		}
+	}
+
+	if (nbr_of_nh_groups) {
+		err = slab_register_context_buffer_requirements(
+							nbr_of_nh_groups,
+							nbr_of_nh_groups,
+							FIB_NHG_BUF_SIZE,
+							FIB_MEM_ALIGN,
+							g_mem_pid,
+							0,
+							0);
+		if (err) {
+			pr_err("Failed to register FIB group buffers\n");
+			return err;
+		}
+	}
+
+	return 0;
+}
+#endif
+
+static uint16_t fib_table_location_attr(uint32_t flags)
+{
+	switch (flags & FIB_MODE_TABLE_LOCATION_MASK) {
+	case FIB_MODE_TABLE_LOCATION_PEB:
+		return TABLE_ATTRIBUTE_LOCATION_PEB;
+	case FIB_MODE_TABLE_LOCATION_EXT1:
+#ifndef LS1088A_REV1
+		return TABLE_ATTRIBUTE_LOCATION_DP_DDR;
+#endif
+		/* No DP-DDR on LS1088A: system DDR */
+	case FIB_MODE_TABLE_LOCATION_EXT2:
+		return TABLE_ATTRIBUTE_LOCATION_SYS_DDR;
+	default:
+		return 0x0200;
+	}
+}
+
+static int fib_kcr_create(uint8_t with_ports, uint8_t *keyid)
+{
+	struct kcr_builder kb __attribute__((aligned(16)));
+
+	keygen_kcr_builder_init(&kb);
+	keygen_kcr_builder_add_protocol_specific_field(KEYGEN_KCR_IPSRC_1_FECID,
+						       NULL, &kb);
+	keygen_kcr_builder_add_protocol_specific_field(KEYGEN_KCR_IPDST_1_FECID,
+						       NULL, &kb);
+	keygen_kcr_builder_add_protocol_specific_field(KEYGEN_KCR_PTYPE_1_FECID,
+						       NULL, &kb);
+	if (with_ports) {
+		keygen_kcr_builder_add_protocol_specific_field(
+				KEYGEN_KCR_L4PSRC_FECID, NULL, &kb);
+		keygen_kcr_builder_add_protocol_specific_field(
+				KEYGEN_KCR_L4PDST_FECID, NULL, &kb);
+	}
+	return keygen_kcr_create(KEYGEN_ACCEL_ID_CTLU, kb.kcr, keyid);
+}
+
+int fib_create_instance(struct fib_params *fib_params_ptr,
+			fib_instance_handle_t *fib_instance_ptr)
+{
+	struct fib_instance instance;
+	struct table_create_params tbl_params;
+	int sr_status;
+
+	memset(&instance, 0, sizeof(instance));
+
+	/* Instance buffer */
+	sr_status = slab_find_and_reserve_bpid(1, FIB_INSTANCE_BUF_SIZE,
+					       FIB_MEM_ALIGN, g_mem_pid,
+					       NULL, &instance.bpid);
+	if (sr_status < 0)
+		fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+				      (int32_t)sr_status);
+
+	sr_status = cdma_acquire_context_memory(instance.bpid,
+						fib_instance_ptr);
+	if (sr_status)
+		fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+				      (int32_t)sr_status);
+
+	/* Next hops and groups */
+	if (fib_params_ptr->max_next_hops) {
+		sr_status = slab_find_and_reserve_bpid(
+					fib_params_ptr->max_next_hops,
+					FIB_NH_BUF_SIZE, FIB_MEM_ALIGN,
+					g_mem_pid, NULL, &instance.bpid_nh);
+		if (sr_status < 0)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      (int32_t)sr_status);
+		instance.max_next_hops = fib_params_ptr->max_next_hops;
+	}
+	if (fib_params_ptr->max_nh_groups) {
+		sr_status = slab_find_and_reserve_bpid(
+					fib_params_ptr->max_nh_groups,
+					FIB_NHG_BUF_SIZE, FIB_MEM_ALIGN,
+					g_mem_pid, NULL, &instance.bpid_nhg);
+		if (sr_status < 0)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      (int32_t)sr_status);
+		instance.max_nh_groups = fib_params_ptr->max_nh_groups;
+
+		/* ECMP flow hash */
+		sr_status = fib_kcr_create(1, &instance.keyid_5tuple);
+		if (sr_status < 0)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      (int32_t)sr_status);
+		sr_status = fib_kcr_create(0, &instance.keyid_3tuple);
+		if (sr_status < 0)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      (int32_t)sr_status);
+	}
+
+	/* LPM tables. The VRF ID is the exact match part of the key. */
+	tbl_params.attributes = TABLE_ATTRIBUTE_TYPE_LPM |
+			fib_table_location_attr(fib_params_ptr->flags) |
+			TABLE_ATTRIBUTE_MR_NO_MISS;
+	tbl_params.timestamp_accuracy = 1;
+
+	if (fib_params_ptr->max_routes_ipv4) {
+		tbl_params.committed_rules = fib_params_ptr->max_routes_ipv4;
+		tbl_params.max_rules = fib_params_ptr->max_routes_ipv4;
+		tbl_params.key_size = TABLE_KEY_LPM_IPV4_SIZE;
+		sr_status = table_create(TABLE_ACCEL_ID_CTLU, &tbl_params,
+					 &instance.table_id_ipv4);
+		if (sr_status != TABLE_STATUS_SUCCESS)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      ENOMEM_TABLE);
+		instance.flags |= FIB_IPV4_VALID;
+	}
+	if (fib_params_ptr->max_routes_ipv6) {
+		tbl_params.committed_rules = fib_params_ptr->max_routes_ipv6;
+		tbl_params.max_rules = fib_params_ptr->max_routes_ipv6;
+		tbl_params.key_size = TABLE_KEY_LPM_IPV6_SIZE;
+		sr_status = table_create(TABLE_ACCEL_ID_CTLU, &tbl_params,
+					 &instance.table_id_ipv6);
+		if (sr_status != TABLE_STATUS_SUCCESS)
+			fib_exception_handler(FIB_CREATE_INSTANCE, __LINE__,
+					      ENOMEM_TABLE);
+		instance.flags |= FIB_IPV6_VALID;
+	}
+
+	cdma_write(*fib_instance_ptr, &instance, sizeof(instance));
+
+	return SUCCESS;
+}
+
+static void fib_target_put(uint64_t addr, uint8_t type);
+
+/* Deletes an LPM table. The remaining routes drop their references, which
+ * releases the next hops and groups that were already deleted by the user. */
+static void fib_table_delete(uint16_t table_id)
+{
+	struct table_result result __attribute__((aligned(16)));
+	t_rule_id rule_id;
+
+	while (!table_get_next_ruleid(TABLE_ACCEL_ID_CTLU, table_id, 0,
+				      &rule_id)) {
+		if (table_rule_delete(TABLE_ACCEL_ID_CTLU, table_id, rule_id,
+				      &result, NULL, NULL))
+			break;
+		fib_target_put(result.data0, (uint8_t)result.data1);
+	}
+	table_delete(TABLE_ACCEL_ID_CTLU, table_id);
+}
+
+void fib_delete_instance(fib_instance_handle_t fib_instance)
+{
+	struct fib_instance instance;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+
+	if (instance.flags & FIB_IPV4_VALID)
+		fib_table_delete(instance.table_id_ipv4);
+	if (instance.flags & FIB_IPV6_VALID)
+		fib_table_delete(instance.table_id_ipv6);
+	if (instance.bpid_nhg) {
+		keygen_kcr_delete(KEYGEN_ACCEL_ID_CTLU, instance.keyid_5tuple);
+		keygen_kcr_delete(KEYGEN_ACCEL_ID_CTLU, instance.keyid_3tuple);
+	}
+
+	cdma_release_context_memory(fib_instance);
+
+	/* Return the reservations of the instance to the slab */
+	slab_find_and_unreserve_bpid(1, instance.bpid);
+	if (instance.bpid_nh)
+		slab_find_and_unreserve_bpid((int32_t)instance.max_next_hops,
+					     instance.bpid_nh);
+	if (instance.bpid_nhg)
+		slab_find_and_unreserve_bpid((int32_t)instance.max_nh_groups,
+					     instance.bpid_nhg);
+}
+
+/* Takes a reference on a next hop or a group */
+static inline void fib_target_get(uint64_t addr)
+{
+	cdma_access_context_memory(addr,
+				   CDMA_ACCESS_CONTEXT_MEM_INC_REFCOUNT,
+				   0, (void *)0, 0,
+				   (uint32_t *)REF_COUNT_ADDR_DUMMY);
+}
+
+/* Drops a reference on a next hop or a group. A released group drops the
+ * references it holds on its members. */
+static void fib_target_put(uint64_t addr, uint8_t type)
+{
+	struct fib_nhg_data nhg_data;
+	uint32_t active;
+	int i;
+
+	if (type == FIB_RESULT_NHG) {
+		/* The reference held by the caller keeps the record valid */
+		cdma_read(&active, addr, sizeof(active));
+		cdma_read(&nhg_data, addr + offsetof(struct fib_nhg, data) +
+			  active * sizeof(struct fib_nhg_data),
+			  sizeof(nhg_data));
+		if (cdma_refcount_decrement_and_release(addr) !=
+				CDMA_REFCOUNT_DECREMENT_TO_ZERO)
+			return;
+		for (i = 0; i < nhg_data.num_members; i++)
+			cdma_refcount_decrement_and_release(
+					nhg_data.members[i]);
+		return;
+	}
+
+	cdma_refcount_decrement_and_release(addr);
+}
+
+static void fib_nh_data_set(struct fib_nh_data *data,
+			    struct fib_nh_params *nh_params)
+{
+	memcpy(data->dst_mac, nh_params->dst_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	memcpy(data->src_mac, nh_params->src_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	data->ni_id = nh_params->ni_id;
+	data->vlan_vid = nh_params->vlan_vid;
+	data->flags = nh_params->flags;
+}
+
+int fib_nh_create(fib_instance_handle_t fib_instance,
+		  struct fib_nh_params *nh_params,
+		  fib_nh_handle_t *nh)
+{
+	struct fib_instance instance;
+	struct fib_nh nh_rec;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!instance.bpid_nh)
+		return -ENOSPC;
+	if (cdma_acquire_context_memory(instance.bpid_nh, nh))
+		return -ENOSPC;
+
+	memset(&nh_rec, 0, sizeof(nh_rec));
+	fib_nh_data_set(&nh_rec.data[0], nh_params);
+	cdma_write(*nh, &nh_rec, sizeof(nh_rec));
+
+	return 0;
+}
+
+void fib_nh_modify(fib_nh_handle_t nh, struct fib_nh_params *nh_params)
+{
+	struct fib_nh_data data;
+	uint32_t active;
+
+	fib_nh_data_set(&data, nh_params);
+
+	cdma_mutex_lock_take(nh, CDMA_MUTEX_WRITE_LOCK);
+	cdma_read(&active, nh, sizeof(active));
+	active ^= 1;
+	/* Fill the inactive copy, then publish it */
+	cdma_write(nh + offsetof(struct fib_nh, data) +
+		   active * sizeof(struct fib_nh_data), &data, sizeof(data));
+	cdma_write(nh, &active, sizeof(active));
+	/* The old copy is rewritten by the next modify only after all the
+	 * readers that may have selected it are done */
+	rcu_synchronize();
+	cdma_mutex_lock_release(nh);
+}
+
+void fib_nh_delete(fib_nh_handle_t nh)
+{
+	fib_target_put(nh, FIB_RESULT_NH);
+}
+
+static int fib_nhg_data_set(struct fib_nhg_data *data,
+			    fib_nh_handle_t *members, uint8_t num_members)
+{
+	int i;
+
+	if (!num_members || num_members > FIB_NHG_MAX_MEMBERS)
+		return -EINVAL;
+
+	memset(data, 0, sizeof(*data));
+	data->num_members = num_members;
+	for (i = 0; i < num_members; i++) {
+		data->members[i] = members[i];
+		fib_target_get(members[i]);
+	}
+
+	return 0;
+}
+
+int fib_nhg_create(fib_instance_handle_t fib_instance,
+		   fib_nh_handle_t *members,
+		   uint8_t num_members,
+		   fib_nhg_handle_t *nhg)
+{
+	struct fib_instance instance;
+	struct fib_nhg nhg_rec;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!instance.bpid_nhg)
+		return -ENOSPC;
+	if (!num_members || num_members > FIB_NHG_MAX_MEMBERS)
+		return -EINVAL;
+	if (cdma_acquire_context_memory(instance.bpid_nhg, nhg))
+		return -ENOSPC;
+
+	memset(&nhg_rec, 0, sizeof(nhg_rec));
+	fib_nhg_data_set(&nhg_rec.data[0], members, num_members);
+	cdma_write(*nhg, &nhg_rec, sizeof(nhg_rec));
+
+	return 0;
+}
+
+int fib_nhg_modify(fib_nhg_handle_t nhg, fib_nh_handle_t *members,
+		   uint8_t num_members)
+{
+	struct fib_nhg_data data;
+	uint64_t old_data_addr;
+	uint32_t active;
+	int i, err;
+
+	err = fib_nhg_data_set(&data, members, num_members);
+	if (err)
+		return err;
+
+	cdma_mutex_lock_take(nhg, CDMA_MUTEX_WRITE_LOCK);
+	cdma_read(&active, nhg, sizeof(active));
+	old_data_addr = nhg + offsetof(struct fib_nhg, data) +
+			active * sizeof(struct fib_nhg_data);
+	active ^= 1;
+	cdma_write(nhg + offsetof(struct fib_nhg, data) +
+		   active * sizeof(struct fib_nhg_data), &data, sizeof(data));
+	cdma_write(nhg, &active, sizeof(active));
+	rcu_synchronize();
+
+	/* No reader uses the old members any more */
+	cdma_read(&data, old_data_addr, sizeof(data));
+	cdma_mutex_lock_release(nhg);
+	for (i = 0; i < data.num_members; i++)
+		cdma_refcount_decrement_and_release(data.members[i]);
+
+	return 0;
+}
+
+void fib_nhg_delete(fib_nhg_handle_t nhg)
+{
+	fib_target_put(nhg, FIB_RESULT_NHG);
+}
+
+static int fib_route_add(uint16_t table_id, struct table_rule *rule,
+			 uint8_t key_size, struct fib_route_target *target)
+{
+	struct table_result old_result __attribute__((aligned(16)));
+	t_rule_id rule_id;
+	int sr_status;
+
+	rule->options = TABLE_RULE_TIMESTAMP_NONE;
+	rule->result.type = TABLE_RESULT_TYPE_OPAQUE;
+	rule->result.data0 = target->handle;
+	rule->result.data1 = target->is_group ? FIB_RESULT_NHG : FIB_RESULT_NH;
+	rule->result.data2 = 0;
+
+	/* The route holds a reference on its target */
+	fib_target_get(target->handle);
+
+	sr_status = table_rule_create_or_replace(TABLE_ACCEL_ID_CTLU, table_id,
+						 rule, key_size, &rule_id,
+						 &old_result, NULL, NULL);
+	if (sr_status == TABLE_STATUS_MISS)
+		/* New route */
+		return 0;
+	if (sr_status < 0) {
+		fib_target_put(target->handle, (uint8_t)rule->result.data1);
+		return sr_status;
+	}
+
+	/* Replaced route: release the old target after the readers that may
+	 * have looked it up are done */
+	rcu_synchronize();
+	fib_target_put(old_result.data0, (uint8_t)old_result.data1);
+
+	return 0;
+}
+
+static int fib_route_delete(uint16_t table_id, union table_key_desc *key_desc,
+			    uint8_t key_size)
+{
+	struct table_result old_result __attribute__((aligned(16)));
+	int sr_status;
+
+	sr_status = table_rule_delete_by_key_desc(TABLE_ACCEL_ID_CTLU,
+						  table_id, key_desc, key_size,
+						  &old_result);
+	if (sr_status)
+		return sr_status;
+
+	rcu_synchronize();
+	fib_target_put(old_result.data0, (uint8_t)old_result.data1);
+
+	return 0;
+}
+
+static inline uint32_t fib_prefix_mask(uint8_t prefix_length)
+{
+	return prefix_length ? 0xFFFFFFFF << (32 - prefix_length) : 0;
+}
+
+static void fib_rule_key_ipv4(struct table_rule *rule, uint16_t vrf_id,
+			      struct fib_prefix_ipv4 *prefix)
+{
+	rule->key_desc.lpm_ipv4.exact_match = vrf_id;
+	rule->key_desc.lpm_ipv4.addr = prefix->addr &
+				fib_prefix_mask(prefix->prefix_length);
+	rule->key_desc.lpm_ipv4.prefix_length = prefix->prefix_length;
+}
+
+static void fib_rule_key_ipv6(struct table_rule *rule, uint16_t vrf_id,
+			      struct fib_prefix_ipv6 *prefix)
+{
+	uint64_t addr0, addr1;
+	uint8_t len = prefix->prefix_length;
+
+	addr0 = ((uint64_t)prefix->addr[0] << 32) | prefix->addr[1];
+	addr1 = ((uint64_t)prefix->addr[2] << 32) | prefix->addr[3];
+	if (len < FIB_IPV6_HALF_PREFIX) {
+		addr0 &= ~(0xFFFFFFFFFFFFFFFFULL >> len);
+		addr1 = 0;
+	} else if (len < 2 * FIB_IPV6_HALF_PREFIX) {
+		addr1 &= ~(0xFFFFFFFFFFFFFFFFULL >>
+				(len - FIB_IPV6_HALF_PREFIX));
+	}
+	rule->key_desc.lpm_ipv6.exact_match = vrf_id;
+	rule->key_desc.lpm_ipv6.addr0 = addr0;
+	rule->key_desc.lpm_ipv6.addr1 = addr1;
+	rule->key_desc.lpm_ipv6.prefix_length = len;
+}
+
+int fib_route_add_ipv4(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+		       struct fib_prefix_ipv4 *prefix,
+		       struct fib_route_target *target)
+{
+	struct table_rule rule __attribute__((aligned(16)));
+	struct fib_instance instance;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!(instance.flags & FIB_IPV4_VALID) ||
+	    !prefix->prefix_length || prefix->prefix_length > 32)
+		return -EINVAL;
+
+	fib_rule_key_ipv4(&rule, vrf_id, prefix);
+
+	return fib_route_add(instance.table_id_ipv4, &rule,
+			     TABLE_KEY_LPM_IPV4_SIZE, target);
+}
+
+int fib_route_delete_ipv4(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+			  struct fib_prefix_ipv4 *prefix)
+{
+	struct table_rule rule __attribute__((aligned(16)));
+	struct fib_instance instance;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!(instance.flags & FIB_IPV4_VALID) ||
+	    !prefix->prefix_length || prefix->prefix_length > 32)
+		return -EINVAL;
+
+	fib_rule_key_ipv4(&rule, vrf_id, prefix);
+
+	return fib_route_delete(instance.table_id_ipv4, &rule.key_desc,
+				TABLE_KEY_LPM_IPV4_SIZE);
+}
+
+int fib_route_add_ipv6(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+		       struct fib_prefix_ipv6 *prefix,
+		       struct fib_route_target *target)
+{
+	struct table_rule rule __attribute__((aligned(16)));
+	struct fib_instance instance;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!(instance.flags & FIB_IPV6_VALID) ||
+	    !prefix->prefix_length || prefix->prefix_length > 128)
+		return -EINVAL;
+
+	fib_rule_key_ipv6(&rule, vrf_id, prefix);
+
+	return fib_route_add(instance.table_id_ipv6, &rule,
+			     TABLE_KEY_LPM_IPV6_SIZE, target);
+}
+
+int fib_route_delete_ipv6(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+			  struct fib_prefix_ipv6 *prefix)
+{
+	struct table_rule rule __attribute__((aligned(16)));
+	struct fib_instance instance;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+	if (!(instance.flags & FIB_IPV6_VALID) ||
+	    !prefix->prefix_length || prefix->prefix_length > 128)
+		return -EINVAL;
+
+	fib_rule_key_ipv6(&rule, vrf_id, prefix);
+
+	return fib_route_delete(instance.table_id_ipv6, &rule.key_desc,
+				TABLE_KEY_LPM_IPV6_SIZE);
+}
+
+/* Looks up the default frame destination and selects the next hop */
+static FIB_CODE_PLACEMENT int fib_resolve(fib_instance_handle_t fib_instance,
+					  uint16_t vrf_id,
+					  struct fib_nh_data *nh_data)
+{
+	struct table_lookup_result lookup_result __attribute__((aligned(16)));
+	union {
+		struct table_lookup_key_desc_lpm_ipv4 ipv4;
+		struct table_lookup_key_desc_lpm_ipv6 ipv6;
+	} key __attribute__((aligned(16)));
+	/* keygen_gen_key() writes 128 bytes, whatever the key size */
+	uint8_t flow_key[128] __attribute__((aligned(16)));
+	union table_lookup_key_desc key_desc;
+	struct fib_instance instance;
+	struct fib_nhg_data nhg_data;
+	struct ipv4hdr *ipv4_hdr;
+	struct ipv6hdr *ipv6_hdr;
+	uint64_t target;
+	uint32_t active, hash;
+	uint8_t key_size, keyid;
+	int sr_status;
+
+	cdma_read(&instance, fib_instance, sizeof(instance));
+
+	if (PARSER_IS_OUTER_IPV4_DEFAULT() &&
+	    (instance.flags & FIB_IPV4_VALID)) {
+		ipv4_hdr = (struct ipv4hdr *)(PARSER_GET_OUTER_IP_OFFSET_DEFAULT()
+				+ PRC_GET_SEGMENT_ADDRESS());
+		key.ipv4.exact_match = vrf_id;
+		key.ipv4.addr = ipv4_hdr->dst_addr;
+		key.ipv4.max_prefix = 0xFF;
+		key_desc.lpm_ipv4 = &key.ipv4;
+		sr_status = table_lookup_by_key(TABLE_ACCEL_ID_CTLU,
+						instance.table_id_ipv4,
+						key_desc,
+						TABLE_KEY_LPM_IPV4_SIZE,
+						&lookup_result);
+	} else if (PARSER_IS_OUTER_IPV6_DEFAULT() &&
+		   (instance.flags & FIB_IPV6_VALID)) {
+		ipv6_hdr = (struct ipv6hdr *)(PARSER_GET_OUTER_IP_OFFSET_DEFAULT()
+				+ PRC_GET_SEGMENT_ADDRESS());
+		key.ipv6.exact_match = vrf_id;
+		key.ipv6.addr0 = ((uint64_t)ipv6_hdr->dst_addr[0] << 32) |
+				 ipv6_hdr->dst_addr[1];
+		key.ipv6.addr1 = ((uint64_t)ipv6_hdr->dst_addr[2] << 32) |
+				 ipv6_hdr->dst_addr[3];
+		key.ipv6.max_prefix = 0xFF;
+		key_desc.lpm_ipv6 = &key.ipv6;
+		sr_status = table_lookup_by_key(TABLE_ACCEL_ID_CTLU,
+						instance.table_id_ipv6,
+						key_desc,
+						TABLE_KEY_LPM_IPV6_SIZE,
+						&lookup_result);
+	} else {
+		return FIB_STATUS_NOT_IP;
+	}
+
+	if (sr_status == TABLE_STATUS_MISS)
+		return FIB_STATUS_NO_ROUTE;
+	if (sr_status != TABLE_STATUS_SUCCESS)
+		return sr_status;
+
+	target = lookup_result.data0;
+	if (lookup_result.data1 == FIB_RESULT_NHG) {
+		cdma_read(&active, target, sizeof(active));
+		cdma_read(&nhg_data, target + offsetof(struct fib_nhg, data) +
+			  active * sizeof(struct fib_nhg_data),
+			  sizeof(nhg_data));
+		if (nhg_data.num_members > 1) {
+			/* ECMP: the flow hash keeps a flow on one member */
+			keyid = PARSER_IS_TCP_OR_UDP_DEFAULT() ?
+				instance.keyid_5tuple : instance.keyid_3tuple;
+			hash = 0;
+			if (!keygen_gen_key(KEYGEN_ACCEL_ID_CTLU, keyid, 0,
+					    flow_key, &key_size))
+				keygen_gen_hash(flow_key, key_size, &hash);
+			target = nhg_data.members[hash %
+						  nhg_data.num_members];
+		} else {
+			target = nhg_data.members[0];
+		}
+	}
+
+	cdma_read(&active, target, sizeof(active));
+	cdma_read(nh_data, target + offsetof(struct fib_nh, data) +
+		  active * sizeof(struct fib_nh_data),
+		  sizeof(struct fib_nh_data));
+
+	if (nh_data->flags & FIB_NH_FLAG_DROP)
+		return FIB_STATUS_DROP;
+	if (nh_data->flags & FIB_NH_FLAG_LOCAL)
+		return FIB_STATUS_LOCAL;
+
+	return 0;
+}
+
+FIB_CODE_PLACEMENT int fib_lookup(fib_instance_handle_t fib_instance,
+				  uint16_t vrf_id,
+				  struct fib_nh_params *nh_params)
+{
+	struct fib_nh_data nh_data;
+	int status;
+
+	status = fib_resolve(fib_instance, vrf_id, &nh_data);
+	if (status && status != FIB_STATUS_LOCAL && status != FIB_STATUS_DROP)
+		return status;
+
+	memcpy(nh_params->dst_mac, nh_data.dst_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	memcpy(nh_params->src_mac, nh_data.src_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	nh_params->ni_id = nh_data.ni_id;
+	nh_params->vlan_vid = nh_data.vlan_vid;
+	nh_params->flags = nh_data.flags;
+
+	return status;
+}
+
+FIB_CODE_PLACEMENT int fib_forward(fib_instance_handle_t fib_instance,
+				   uint16_t vrf_id, uint32_t flags,
+				   uint32_t send_flags)
+{
+	struct fib_nh_data nh_data;
+	uint8_t *ip_hdr;
+	int status;
+
+	status = fib_resolve(fib_instance, vrf_id, &nh_data);
+	if (status)
+		return status;
+
+	if (!(flags & FIB_FWD_NO_TTL_DEC)) {
+		ip_hdr = (uint8_t *)(PARSER_GET_OUTER_IP_OFFSET_DEFAULT() +
+				     PRC_GET_SEGMENT_ADDRESS());
+		if (PARSER_IS_OUTER_IPV4_DEFAULT()) {
+			if (((struct ipv4hdr *)ip_hdr)->ttl <= 1)
+				return FIB_STATUS_TTL_EXPIRED;
+			ipv4_dec_ttl_modification();
+		} else {
+			if (((struct ipv6hdr *)ip_hdr)->hop_limit <= 1)
+				return FIB_STATUS_TTL_EXPIRED;
+			ipv6_dec_hop_limit_modification();
+		}
+	}
+
+	l2_set_dl_dst(nh_data.dst_mac);
+	l2_set_dl_src(nh_data.src_mac);
+	if (nh_data.flags & FIB_NH_FLAG_SET_VLAN_VID)
+		l2_set_vlan_vid(nh_data.vlan_vid);
+
+	return dpni_drv_send(nh_data.ni_id, send_flags);
+}
+
+#pragma push
+	/* make all following data go into .exception_data */
+#pragma section data_type ".exception_data"
+#pragma stackinfo_ignore on
+void fib_exception_handler(enum fib_function_identifier func_id,
+			   uint32_t line,
+			   int32_t status)
+{
+	char *func_name;
+	char *err_msg;
+
+	status = status & 0xFF;
+
+	/* Translate function ID to function name string */
+	switch (func_id) {
+	case FIB_CREATE_INSTANCE:
+		func_name = "fib_create_instance";
+		switch (status) {
+		case EINVAL:
+			err_msg = "KCR exceeds maximum KCR size\n";
+			break;
+		case ENOMEM:
+			err_msg = "Not enough memory for partition id\n";
+			break;
+		case ENOSPC:
+			err_msg = "No more KCRs or buffers are available\n";
+			break;
+		case ENOMEM_TABLE:
+			err_msg = "Not enough memory available to create table\n";
+			break;
+		default:
+			err_msg = "Unknown or Invalid status Error.\n";
+		}
+		break;
+	default:
+		/* create own exception */
+		func_name = "Unknown Function";
+		err_msg = "Unknown or Invalid status Error.\n";
+	}
+
+	exception_handler(__FILE__, func_name, line, err_msg);
+}
+#pragma pop
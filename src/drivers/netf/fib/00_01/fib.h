@@ -0,0 +1,191 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fib.h
+
+@Description	This file contains the AIOP SW internal FIB API
+
+*//***************************************************************************/
+
+#ifndef __AIOP_FIB_H
+#define __AIOP_FIB_H
+
+#include "fsl_types.h"
+#include "fsl_fib.h"
+
+/**************************************************************************//**
+@addtogroup	FSL_FIB FSL_AIOP_FIB
+
+@Description	AIOP FIB functions macros and definitions
+
+@{
+*//***************************************************************************/
+
+#define FIB_MEM_ALIGN		64
+
+/* Workspace address used as reference count output of CDMA commands */
+#define REF_COUNT_ADDR_DUMMY	(HWC_ACC_OUT_ADDRESS + CDMA_REF_CNT_OFFSET)
+
+/*
+ * Next hops and next hop groups are DDR context buffers shared by all the
+ * routes pointing to them. The CDMA reference count of a buffer is the number
+ * of routes and groups pointing to it plus one for the creator. The buffer is
+ * released when the count drops to zero.
+ *
+ * A record holds two copies of its data and the index of the active one.
+ * A writer (serialized by a CDMA mutex on the record address) fills the
+ * inactive copy, flips the index and waits for an RCU grace period before the
+ * old copy may be reused. Readers fetch the whole record in a single CDMA read
+ * and use the copy selected by the index, without any lock.
+ *
+ * Route results hold the next hop (group) address in data0 and its type in
+ * data1. On route delete or replace the old target reference is dropped only
+ * after an RCU grace period.
+ */
+
+/** Route result types (table_result.data1) */
+#define FIB_RESULT_NH		0x01
+#define FIB_RESULT_NHG		0x02
+
+/** Internal status for the exception handler */
+#define ENOMEM_TABLE		3
+
+/** Instance flags */
+#define FIB_IPV4_VALID		0x01
+#define FIB_IPV6_VALID		0x02
+
+/** Mask of the table location bits of fib_params.flags */
+#define FIB_MODE_TABLE_LOCATION_MASK	0x0C000000
+
+/** Bit of fib_prefix_ipv6.prefix_length splitting addr0 / addr1 */
+#define FIB_IPV6_HALF_PREFIX	64
+
+#pragma pack(push, 1)
+/**************************************************************************//**
+@Description	FIB instance (DDR)
+*//***************************************************************************/
+struct fib_instance {
+	/** BPID of the next hop records */
+	uint16_t bpid_nh;
+	/** BPID of the next hop group records */
+	uint16_t bpid_nhg;
+	/** IPv4 LPM table ID */
+	uint16_t table_id_ipv4;
+	/** IPv6 LPM table ID */
+	uint16_t table_id_ipv6;
+	/** FIB_IPV4_VALID / FIB_IPV6_VALID */
+	uint8_t  flags;
+	/** ECMP key composition rule: IP src, IP dst, protocol, L4 ports */
+	uint8_t  keyid_5tuple;
+	/** ECMP key composition rule for non TCP/UDP frames:
+	 * IP src, IP dst, protocol */
+	uint8_t  keyid_3tuple;
+	uint8_t  reserved;
+	/** BPID of the instance buffer */
+	uint16_t bpid;
+	uint16_t reserved1;
+	/** Number of next hop buffers reserved in bpid_nh */
+	uint32_t max_next_hops;
+	/** Number of group buffers reserved in bpid_nhg */
+	uint32_t max_nh_groups;
+};
+
+/**************************************************************************//**
+@Description	Next hop data
+*//***************************************************************************/
+struct fib_nh_data {
+	uint8_t  dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t  src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint16_t ni_id;
+	uint16_t vlan_vid;
+	uint16_t flags;
+};
+
+/**************************************************************************//**
+@Description	Next hop record (DDR)
+*//***************************************************************************/
+struct fib_nh {
+	/** Index of the active copy. Must be the first field: a reader that
+	 * sees the new index also sees the new copy. */
+	uint32_t active;
+	uint32_t reserved;
+	struct fib_nh_data data[2];
+};
+
+/**************************************************************************//**
+@Description	Next hop group data
+*//***************************************************************************/
+struct fib_nhg_data {
+	uint8_t  num_members;
+	uint8_t  reserved[7];
+	uint64_t members[FIB_NHG_MAX_MEMBERS];
+};
+
+/**************************************************************************//**
+@Description	Next hop group record (DDR)
+*//***************************************************************************/
+struct fib_nhg {
+	/** Index of the active copy. Must be the first field. */
+	uint32_t active;
+	uint32_t reserved;
+	struct fib_nhg_data data[2];
+};
+#pragma pack(pop)
+
+/* The CDMA reference count is kept in the 8 bytes before the buffer */
+#define FIB_INSTANCE_BUF_SIZE	(64 - 8)
+#define FIB_NH_BUF_SIZE		(64 - 8)
+#define FIB_NHG_BUF_SIZE	(192 - 8)
+
+/**************************************************************************//**
+@Description	FIB functions identifiers (for the exception handler)
+*//***************************************************************************/
+enum fib_function_identifier {
+	FIB_CREATE_INSTANCE = 0
+};
+
+/**************************************************************************//**
+@Function	fib_exception_handler
+
+@Description	Handler for the error status returned from the FIB API
+		functions.
+
+@Param[in]	func_id - The function in which the error occurred.
+@Param[in]	line - The line in which the error occurred.
+@Param[in]	status - Status to be handled by this function.
+
+@Return		None.
+
+@Cautions	This is a non return function.
+*//***************************************************************************/
+void fib_exception_handler(enum fib_function_identifier func_id,
+			   uint32_t line,
+			   int32_t status);
+
+/** @} */ /* end of group FSL_FIB */
+
+#endif /* __AIOP_FIB_H */
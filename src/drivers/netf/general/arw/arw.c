@@ -0,0 +1,245 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		arw.c
+
+@Description	This file contains the AIOP SW extended anti-replay window
+		implementation.
+
+*//***************************************************************************/
+
+#include "fsl_types.h"
+#include "fsl_errors.h"
+#include "fsl_general.h"
+#include "fsl_cdma.h"
+#include "fsl_ste.h"
+#include "fsl_malloc.h"
+#include "arw.h"
+
+#ifdef LS2085A_REV1
+	#define ARW_READ_METHOD		READ_DATA_USING_CDMA
+#else
+	/* The counters are written by the STE, bypassing the CDMA cache */
+	#define ARW_READ_METHOD		READ_DATA_USING_FDMA
+#endif
+
+#define ARW_MEM_ALIGN		64
+#define ARW_WORD_ADDR(CTX, BIT) \
+	((CTX)->bitmap_addr + (((BIT) >> 5) << 2))
+#define ARW_BIT_MASK(BIT)	((uint32_t)1 << ((BIT) & 0x1F))
+
+#define ARW_CNTR_FLAGS		(STE_MODE_SATURATE | STE_MODE_64_BIT_CNTR_SIZE)
+
+/* Clears the whole bitmap */
+static void arw_clear_all(struct arw_context *ctx)
+{
+	uint32_t zero[ARW_MEM_ALIGN / 4] = {0};
+	uint32_t offset;
+
+	for (offset = 0; offset < (ctx->size >> 3); offset += ARW_MEM_ALIGN)
+		cdma_write(ctx->bitmap_addr + offset, zero, ARW_MEM_ALIGN);
+}
+
+/* Clears the bits of the 'count' sequence numbers following 'seq_num' */
+static void arw_clear(struct arw_context *ctx, uint64_t seq_num,
+		      uint32_t count)
+{
+	uint32_t bit, n, mask, word;
+
+	bit = (uint32_t)(seq_num + 1) & (ctx->size - 1);
+	while (count) {
+		n = 32 - (bit & 0x1F);
+		if (n > count)
+			n = count;
+		word = 0;
+		if (n < 32) {
+			mask = (((uint32_t)1 << n) - 1) << (bit & 0x1F);
+			cdma_read(&word, ARW_WORD_ADDR(ctx, bit), sizeof(word));
+			word &= ~mask;
+		}
+		cdma_write(ARW_WORD_ADDR(ctx, bit), &word, sizeof(word));
+		count -= n;
+		bit = (bit + n) & (ctx->size - 1);
+	}
+}
+
+int arw_init(uint64_t ctx_addr, uint32_t size, uint64_t seq_num, int mem_pid)
+{
+	struct arw_context ctx = {0};
+	int err;
+
+	if (size < ARW_MIN_SIZE || size > ARW_MAX_SIZE || (size & (size - 1)))
+		return -EINVAL;
+
+	err = fsl_get_mem(size >> 3, mem_pid, ARW_MEM_ALIGN, &ctx.bitmap_addr);
+	if (err)
+		return -ENOMEM;
+
+	ctx.top = seq_num;
+	ctx.size = size;
+	arw_clear_all(&ctx);
+	cdma_write(ctx_addr, &ctx, sizeof(ctx));
+
+	return 0;
+}
+
+void arw_free(uint64_t ctx_addr)
+{
+	struct arw_context ctx;
+
+	cdma_read(&ctx, ctx_addr, sizeof(ctx));
+
+	/* Flush the pending counter updates and clear the STE cache */
+	ste_barrier();
+	ste_set_64bit_counter(ARW_REPLAY_PKTS_ADDR(ctx_addr), 0);
+	ste_set_64bit_counter(ARW_LATE_PKTS_ADDR(ctx_addr), 0);
+
+	fsl_put_mem(ctx.bitmap_addr);
+}
+
+int arw_check(uint64_t ctx_addr, uint64_t seq_num)
+{
+	struct arw_context ctx;
+	uint32_t bit, word;
+
+	cdma_read(&ctx, ctx_addr, sizeof(ctx));
+
+	if (seq_num > ctx.top)
+		return ARW_OK;
+
+	if (ctx.top - seq_num >= ctx.size) {
+		ste_inc_counter(ARW_LATE_PKTS_ADDR(ctx_addr), 1,
+				ARW_CNTR_FLAGS);
+		return ARW_LATE;
+	}
+
+	bit = (uint32_t)seq_num & (ctx.size - 1);
+	cdma_read(&word, ARW_WORD_ADDR(&ctx, bit), sizeof(word));
+	if (word & ARW_BIT_MASK(bit)) {
+		ste_inc_counter(ARW_REPLAY_PKTS_ADDR(ctx_addr), 1,
+				ARW_CNTR_FLAGS);
+		return ARW_REPLAY;
+	}
+
+	return ARW_OK;
+}
+
+int arw_update(uint64_t ctx_addr, uint64_t seq_num)
+{
+	struct arw_context ctx;
+	uint32_t bit, word;
+
+	cdma_read_with_mutex(ctx_addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &ctx,
+			     sizeof(ctx));
+
+	bit = (uint32_t)seq_num & (ctx.size - 1);
+
+	if (seq_num > ctx.top) {
+		/* Move the window; the bits of the new entries are cleared */
+		if (seq_num - ctx.top >= ctx.size)
+			arw_clear_all(&ctx);
+		else
+			arw_clear(&ctx, ctx.top,
+				  (uint32_t)(seq_num - ctx.top));
+
+		cdma_read(&word, ARW_WORD_ADDR(&ctx, bit), sizeof(word));
+		word |= ARW_BIT_MASK(bit);
+		cdma_write(ARW_WORD_ADDR(&ctx, bit), &word, sizeof(word));
+
+		ctx.top = seq_num;
+		cdma_write_with_mutex(ctx_addr, CDMA_POSTDMA_MUTEX_RM_BIT,
+				      &ctx.top, sizeof(ctx.top));
+		return ARW_OK;
+	}
+
+	/* The window may have moved since the check */
+	if (ctx.top - seq_num >= ctx.size) {
+		cdma_mutex_lock_release(ctx_addr);
+		ste_inc_counter(ARW_LATE_PKTS_ADDR(ctx_addr), 1,
+				ARW_CNTR_FLAGS);
+		return ARW_LATE;
+	}
+
+	cdma_read(&word, ARW_WORD_ADDR(&ctx, bit), sizeof(word));
+	if (word & ARW_BIT_MASK(bit)) {
+		cdma_mutex_lock_release(ctx_addr);
+		ste_inc_counter(ARW_REPLAY_PKTS_ADDR(ctx_addr), 1,
+				ARW_CNTR_FLAGS);
+		return ARW_REPLAY;
+	}
+
+	word |= ARW_BIT_MASK(bit);
+	cdma_write(ARW_WORD_ADDR(&ctx, bit), &word, sizeof(word));
+	cdma_mutex_lock_release(ctx_addr);
+
+	return ARW_OK;
+}
+
+void arw_get_info(uint64_t ctx_addr, uint64_t *seq_num, uint32_t bitmap[4])
+{
+	struct arw_context ctx;
+	uint32_t i, bit, word_idx, word = 0;
+
+	cdma_read_with_mutex(ctx_addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &ctx,
+			     sizeof(ctx));
+
+	*seq_num = ctx.top;
+	bitmap[0] = 0;
+	bitmap[1] = 0;
+	bitmap[2] = 0;
+	bitmap[3] = 0;
+
+	/* Walk the ring down from the top entry, one word read at a time */
+	word_idx = ctx.size;
+	for (i = 0; i < 128; i++) {
+		bit = (uint32_t)(ctx.top - i) & (ctx.size - 1);
+		if ((bit >> 5) != word_idx) {
+			word_idx = bit >> 5;
+			cdma_read(&word, ARW_WORD_ADDR(&ctx, bit),
+				  sizeof(word));
+		}
+		if (word & ARW_BIT_MASK(bit))
+			bitmap[i >> 5] |= ARW_BIT_MASK(i);
+	}
+
+	cdma_mutex_lock_release(ctx_addr);
+}
+
+void arw_get_counters(uint64_t ctx_addr, uint64_t *replay_pkts,
+		      uint64_t *late_pkts)
+{
+	struct arw_context ctx;
+
+	/* Flush the pending counter updates */
+	ste_barrier();
+
+	fsl_read_external_data(&ctx, ctx_addr, (uint16_t)sizeof(ctx),
+			       ARW_READ_METHOD);
+
+	*replay_pkts = ctx.replay_pkts;
+	*late_pkts = ctx.late_pkts;
+}
@@ -0,0 +1,172 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		arw.h
+
+@Description	This file contains the AIOP SW internal extended anti-replay
+		window API, shared by the IPsec and CAPWAP DTLS inbound SAs
+
+*//***************************************************************************/
+
+#ifndef __AIOP_ARW_H
+#define __AIOP_ARW_H
+
+#include "fsl_types.h"
+
+/*
+ * The extended anti-replay window replaces the SEC window (up to 128 entries)
+ * when packets of one SA may be processed far out of order, e.g. in a
+ * concurrent ordering scope. SEC runs with no window and the sequence number
+ * is checked by software before SEC and recorded after the ICV check passed.
+ *
+ * The window state is a context (struct arw_context) kept in the SA
+ * descriptor and a bitmap ring of size bits in DDR. The bit of sequence
+ * number S is (S & (size - 1)). The bits of (top - size, top] are valid.
+ *
+ * The check only reads the context and one bitmap word, without a lock. The
+ * update is serialized by a CDMA mutex on the context address and changes the
+ * bitmap one 32 bit word at a time, so concurrent updates of the same SA are
+ * never lost. A packet that passes the check may still be found late or
+ * replayed by the update, if another task moved the window or accepted the
+ * same sequence number in the meantime.
+ */
+
+/** Extended anti-replay window minimum size, in packets */
+#define ARW_MIN_SIZE		1024
+/** Extended anti-replay window maximum size, in packets */
+#define ARW_MAX_SIZE		4096
+
+/** Window check/update status */
+#define ARW_OK			0
+#define ARW_LATE		1
+#define ARW_REPLAY		2
+
+/**************************************************************************//**
+ @Description	Extended anti-replay window context. 40 bytes.
+*//***************************************************************************/
+struct arw_context {
+	/** Highest recorded sequence number */
+	uint64_t top;
+	/** Bitmap ring address (size / 8 bytes) */
+	uint64_t bitmap_addr;
+	/** Replayed packets counter (STE) */
+	uint64_t replay_pkts;
+	/** Late packets counter (STE) */
+	uint64_t late_pkts;
+	/** Window size, in packets */
+	uint32_t size;
+	uint32_t reserved;
+};
+
+#define ARW_REPLAY_PKTS_ADDR(ADDRESS) \
+	((ADDRESS) + offsetof(struct arw_context, replay_pkts))
+
+#define ARW_LATE_PKTS_ADDR(ADDRESS) \
+	((ADDRESS) + offsetof(struct arw_context, late_pkts))
+
+/**************************************************************************//**
+@Function	arw_init
+
+@Description	Allocates and clears the window bitmap and writes the window
+		context.
+
+@Param[in]	ctx_addr - Window context address.
+@Param[in]	size - Window size, in packets. A power of 2 between
+		ARW_MIN_SIZE and ARW_MAX_SIZE.
+@Param[in]	seq_num - Initial highest sequence number.
+@Param[in]	mem_pid - Memory partition of the bitmap.
+
+@Return		0 on success, -EINVAL for an invalid size, -ENOMEM if the
+		bitmap cannot be allocated.
+*//***************************************************************************/
+int arw_init(uint64_t ctx_addr, uint32_t size, uint64_t seq_num, int mem_pid);
+
+/**************************************************************************//**
+@Function	arw_free
+
+@Description	Releases the window bitmap and clears the window counters.
+
+@Param[in]	ctx_addr - Window context address.
+*//***************************************************************************/
+void arw_free(uint64_t ctx_addr);
+
+/**************************************************************************//**
+@Function	arw_check
+
+@Description	Checks a received sequence number against the window, before
+		the packet is authenticated. Late and replayed packets are
+		counted.
+
+@Param[in]	ctx_addr - Window context address.
+@Param[in]	seq_num - Received sequence number.
+
+@Return		ARW_OK, ARW_LATE or ARW_REPLAY.
+*//***************************************************************************/
+int arw_check(uint64_t ctx_addr, uint64_t seq_num);
+
+/**************************************************************************//**
+@Function	arw_update
+
+@Description	Records the sequence number of an authenticated packet and
+		moves the window if it is the highest one. Late and replayed
+		packets are counted and not recorded.
+
+@Param[in]	ctx_addr - Window context address.
+@Param[in]	seq_num - Received sequence number.
+
+@Return		ARW_OK, ARW_LATE or ARW_REPLAY.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int arw_update(uint64_t ctx_addr, uint64_t seq_num);
+
+/**************************************************************************//**
+@Function	arw_get_info
+
+@Description	Returns the highest recorded sequence number and the 128 most
+		recent entries of the window.
+
+@Param[in]	ctx_addr - Window context address.
+@Param[out]	seq_num - Highest recorded sequence number.
+@Param[out]	bitmap - Bit i (bitmap[i / 32], bit i % 32) is set if the
+		sequence number (seq_num - i) was recorded.
+*//***************************************************************************/
+void arw_get_info(uint64_t ctx_addr, uint64_t *seq_num, uint32_t bitmap[4]);
+
+/**************************************************************************//**
+@Function	arw_get_counters
+
+@Description	Returns the window counters.
+
+@Param[in]	ctx_addr - Window context address.
+@Param[out]	replay_pkts - Replayed packets.
+@Param[out]	late_pkts - Late packets.
+*//***************************************************************************/
+void arw_get_counters(uint64_t ctx_addr, uint64_t *replay_pkts,
+		      uint64_t *late_pkts);
+
+#endif /* __AIOP_ARW_H */
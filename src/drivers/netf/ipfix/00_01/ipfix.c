@@ -0,0 +1,975 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		ipfix.c
+
+@Description	This file contains the AIOP SW IPFIX / NetFlow v9 flow
+		metering and export implementation.
+
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_stdlib.h"
+#include "fsl_ldpaa_aiop.h"
+#include "fsl_fdma.h"
+#include "fsl_parser.h"
+#include "fsl_table.h"
+#include "fsl_cdma.h"
+#include "fsl_ste.h"
+#include "fsl_tman.h"
+#include "fsl_net.h"
+#include "fsl_frame_operations.h"
+#include "fsl_spinlock.h"
+#include "fsl_rcu.h"
+#include "fsl_dpni_drv.h"
+#include "fsl_dbg.h"
+#include "fsl_slab.h"
+#include "fsl_sl_slab.h"
+#include "fsl_mem_mng.h"
+#include "ipfix.h"
+
+/* Information element of a template */
+struct ipfix_field {
+	uint16_t id;
+	uint16_t length;
+};
+
+#define IPFIX_NUM_FIELDS	10
+
+/* Templates, indexed by [NetFlow v9][IPv6] */
+static const struct ipfix_field
+		ipfix_templates[2][2][IPFIX_NUM_FIELDS] = {
+	{
+		{
+			{IPFIX_IE_SRC_IPV4, 4}, {IPFIX_IE_DST_IPV4, 4},
+			{IPFIX_IE_SRC_PORT, 2}, {IPFIX_IE_DST_PORT, 2},
+			{IPFIX_IE_PROTOCOL, 1}, {IPFIX_IE_INGRESS_INTERFACE, 4},
+			{IPFIX_IE_PACKET_DELTA_COUNT, 8},
+			{IPFIX_IE_OCTET_DELTA_COUNT, 8},
+			{IPFIX_IE_START_MILLISECONDS, 8},
+			{IPFIX_IE_END_MILLISECONDS, 8}
+		},
+		{
+			{IPFIX_IE_SRC_IPV6, 16}, {IPFIX_IE_DST_IPV6, 16},
+			{IPFIX_IE_SRC_PORT, 2}, {IPFIX_IE_DST_PORT, 2},
+			{IPFIX_IE_PROTOCOL, 1}, {IPFIX_IE_INGRESS_INTERFACE, 4},
+			{IPFIX_IE_PACKET_DELTA_COUNT, 8},
+			{IPFIX_IE_OCTET_DELTA_COUNT, 8},
+			{IPFIX_IE_START_MILLISECONDS, 8},
+			{IPFIX_IE_END_MILLISECONDS, 8}
+		}
+	},
+	{
+		{
+			{IPFIX_IE_SRC_IPV4, 4}, {IPFIX_IE_DST_IPV4, 4},
+			{IPFIX_IE_SRC_PORT, 2}, {IPFIX_IE_DST_PORT, 2},
+			{IPFIX_IE_PROTOCOL, 1}, {IPFIX_IE_INGRESS_INTERFACE, 4},
+			{IPFIX_IE_PACKET_DELTA_COUNT, 8},
+			{IPFIX_IE_OCTET_DELTA_COUNT, 8},
+			{IPFIX_IE_START_SYS_UP_TIME, 4},
+			{IPFIX_IE_END_SYS_UP_TIME, 4}
+		},
+		{
+			{IPFIX_IE_SRC_IPV6, 16}, {IPFIX_IE_DST_IPV6, 16},
+			{IPFIX_IE_SRC_PORT, 2}, {IPFIX_IE_DST_PORT, 2},
+			{IPFIX_IE_PROTOCOL, 1}, {IPFIX_IE_INGRESS_INTERFACE, 4},
+			{IPFIX_IE_PACKET_DELTA_COUNT, 8},
+			{IPFIX_IE_OCTET_DELTA_COUNT, 8},
+			{IPFIX_IE_START_SYS_UP_TIME, 4},
+			{IPFIX_IE_END_SYS_UP_TIME, 4}
+		}
+	}
+};
+
+static struct ipfix_rec g_ipfix[IPFIX_MAX_INSTANCES] __attribute__((aligned(8)));
+static uint64_t g_ipfix_lock __attribute__((aligned(8)));
+static enum memory_partition_id g_mem_pid = MEM_PART_SYSTEM_DDR;
+static uint8_t g_ipfix_tmi_id;
+static uint8_t g_ipfix_tmi_state;
+
+#ifndef AIOP_VERIF
+int ipfix_early_init(uint32_t nbr_of_instances, uint32_t nbr_of_flows)
+{
+	int err;
+
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		g_mem_pid = MEM_PART_DP_DDR;
+
+	/* Timers of the wheels */
+	err = slab_register_context_buffer_requirements(1, 1, IPFIX_TMI_SIZE,
+							IPFIX_MEM_ALIGN,
+							g_mem_pid, 0, 0);
+	if (err) {
+		pr_err("Failed to register IPFIX timer buffers\n");
+		return err;
+	}
+
+	err = slab_register_context_buffer_requirements(nbr_of_flows,
+							nbr_of_flows,
+							IPFIX_FLOW_BUF_SIZE,
+							IPFIX_MEM_ALIGN,
+							g_mem_pid,
+							0,
+							0);
+	if (err) {
+		pr_err("Failed to register IPFIX flow buffers\n");
+		return err;
+	}
+
+	UNUSED(nbr_of_instances);
+	return 0;
+}
+#endif
+
+static uint16_t ipfix_table_location_attr(uint32_t flags)
+{
+	switch (flags & IPFIX_MODE_TABLE_LOCATION_MASK) {
+	case IPFIX_MODE_TABLE_LOCATION_PEB:
+		return TABLE_ATTRIBUTE_LOCATION_PEB;
+	case IPFIX_MODE_TABLE_LOCATION_EXT1:
+#ifndef LS1088A_REV1
+		return TABLE_ATTRIBUTE_LOCATION_DP_DDR;
+#endif
+		/* No DP-DDR on LS1088A: system DDR */
+	case IPFIX_MODE_TABLE_LOCATION_EXT2:
+		return TABLE_ATTRIBUTE_LOCATION_SYS_DDR;
+	default:
+		return 0x0200;
+	}
+}
+
+/* Microseconds since the creation of the instance. The wheel ticks and the
+ * record times are derived from it; the 32 bit export fields wrap, it does
+ * not. */
+static inline uint64_t ipfix_time_us(struct ipfix_rec *rec, uint64_t ts)
+{
+	return ts - rec->start_ts;
+}
+
+/* Wheel tick of a time since the creation of the instance */
+static inline uint32_t ipfix_tick(uint64_t us)
+{
+	return (uint32_t)(us / 1000000);
+}
+
+/* Big endian store of a field of 1 to 8 bytes */
+static void ipfix_put(uint8_t *p, uint64_t val, uint16_t length)
+{
+	while (length--) {
+		p[length] = (uint8_t)val;
+		val >>= 8;
+	}
+}
+
+/* Flow sampling hash. Any mix of the key words does, it only has to be
+ * independent of the CTLU table hash. */
+static inline uint32_t ipfix_key_hash(const struct ipfix_flow_key *key)
+{
+	const uint32_t *w = (const uint32_t *)key;
+	uint32_t h = 0x811C9DC5;
+	uint32_t i;
+
+	for (i = 0; i < sizeof(*key) / sizeof(uint32_t); i++)
+		h = (h ^ w[i]) * 0x01000193;
+	return h ^ (h >> 16);
+}
+
+static int ipfix_tmi_init(void)
+{
+	struct slab *slab_handle = NULL;
+	uint64_t tmi_addr = 0;
+	uint8_t state;
+	int err;
+
+	lock_spinlock(&g_ipfix_lock);
+	state = g_ipfix_tmi_state;
+	if (!state)
+		g_ipfix_tmi_state = IPFIX_TMI_CREATING;
+	unlock_spinlock(&g_ipfix_lock);
+	if (state)
+		return (state == IPFIX_TMI_READY) ? 0 : -EBUSY;
+
+	err = slab_create(1, 1, IPFIX_TMI_SIZE, IPFIX_MEM_ALIGN, g_mem_pid, 0,
+			  NULL, &slab_handle);
+	if (err) {
+		pr_err("Cannot create the IPFIX timer buffer\n");
+		g_ipfix_tmi_state = 0;
+		return err;
+	}
+	err = slab_acquire(slab_handle, &tmi_addr);
+	if (!err)
+		err = tman_create_tmi(tmi_addr, IPFIX_NUM_TIMERS,
+				      &g_ipfix_tmi_id);
+	if (err) {
+		pr_err("Cannot create the IPFIX TMI\n");
+		if (tmi_addr)
+			slab_release(slab_handle, tmi_addr);
+		slab_free(&slab_handle);
+		g_ipfix_tmi_state = 0;
+		return err;
+	}
+	g_ipfix_tmi_state = IPFIX_TMI_READY;
+	return 0;
+}
+
+/* Adds a record to the slot of its deadline. The record is linked before the
+ * head is switched, so the wheel task never sees a partial list. */
+static void ipfix_wheel_add(struct ipfix_rec *rec, uint64_t flow,
+			    uint32_t deadline)
+{
+	uint64_t head;
+	uint32_t tick, slot;
+
+	/* Not in the slot being processed, not beyond the wheel. The record
+	 * keeps its deadline and is rechecked. */
+	tick = rec->tick;
+	if ((int32_t)(deadline - tick) <= 0)
+		deadline = tick + 1;
+	else if (deadline - tick >= IPFIX_WHEEL_SIZE)
+		deadline = tick + IPFIX_WHEEL_SIZE - 1;
+	slot = deadline % IPFIX_WHEEL_SIZE;
+
+	for (;;) {
+		head = rec->wheel[slot];
+		cdma_write(flow + offsetof(struct ipfix_flow, next), &head,
+			   sizeof(head));
+		lock_spinlock(&rec->lock);
+		if (rec->wheel[slot] == head) {
+			rec->wheel[slot] = flow;
+			unlock_spinlock(&rec->lock);
+			return;
+		}
+		unlock_spinlock(&rec->lock);
+	}
+}
+
+static int ipfix_flow_create(struct ipfix_rec *rec,
+			     struct ipfix_flow_key *key, uint64_t *flow_addr)
+{
+	struct table_rule rule __attribute__((aligned(16)));
+	struct ipfix_flow flow;
+	t_rule_id rule_id;
+	uint64_t addr, ts;
+	int err;
+
+	err = cdma_acquire_context_memory(rec->bpid, &addr);
+	if (err)
+		return -ENOSPC;
+
+	tman_get_timestamp(&ts);
+	memset(&flow, 0, sizeof(flow));
+	flow.key = *key;
+	/* The frame creating the record is accounted by the caller */
+	flow.seen_packets = 1;
+	flow.start_us = ipfix_time_us(rec, ts);
+	flow.last_us = flow.start_us;
+	flow.deadline = ipfix_tick(flow.start_us) + rec->idle_timeout;
+	cdma_write(addr, &flow, sizeof(flow));
+
+	memset(&rule, 0, sizeof(rule));
+	memcpy(rule.key_desc.em.key, key, sizeof(*key));
+	rule.options = TABLE_RULE_TIMESTAMP_NONE;
+	rule.result.type = TABLE_RESULT_TYPE_OPAQUE;
+	rule.result.data0 = addr;
+	err = table_rule_create(TABLE_ACCEL_ID_CTLU, rec->table_id, &rule,
+				sizeof(*key), &rule_id);
+	if (err) {
+		cdma_release_context_memory(addr);
+		return err;
+	}
+	cdma_write(addr + offsetof(struct ipfix_flow, rule_id), &rule_id,
+		   sizeof(rule_id));
+
+	ipfix_wheel_add(rec, addr, flow.deadline);
+	atomic_incr64((int64_t *)&rec->stats.flows, 1);
+	*flow_addr = addr;
+	return 0;
+}
+
+IPFIX_CODE_PLACEMENT int ipfix_meter_frame(ipfix_handle_t ipfix)
+{
+	struct ipfix_flow_key key __attribute__((aligned(16)));
+	struct table_lookup_result lookup_result __attribute__((aligned(16)));
+	union table_lookup_key_desc key_desc;
+	struct ipfix_rec *rec = &g_ipfix[ipfix];
+	struct ipv4hdr *ipv4_hdr;
+	struct ipv6hdr *ipv6_hdr;
+	uint16_t *ports;
+	uint32_t sel;
+	uint64_t flow = 0;
+	int err;
+
+	if (ipfix >= IPFIX_MAX_INSTANCES || rec->valid != IPFIX_VALID)
+		return -EINVAL;
+
+	memset(&key, 0, sizeof(key));
+	if (PARSER_IS_OUTER_IPV4_DEFAULT()) {
+		ipv4_hdr = (struct ipv4hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		key.src_addr[0] = ipv4_hdr->src_addr;
+		key.dst_addr[0] = ipv4_hdr->dst_addr;
+		key.protocol = ipv4_hdr->protocol;
+		key.ip_version = 4;
+	} else if (PARSER_IS_OUTER_IPV6_DEFAULT()) {
+		ipv6_hdr = (struct ipv6hdr *)
+			PARSER_GET_OUTER_IP_POINTER_DEFAULT();
+		memcpy(key.src_addr, ipv6_hdr->src_addr, sizeof(key.src_addr));
+		memcpy(key.dst_addr, ipv6_hdr->dst_addr, sizeof(key.dst_addr));
+		key.protocol = ipv6_hdr->next_header;
+		key.ip_version = 6;
+	} else {
+		atomic_incr64((int64_t *)&rec->stats.not_ip, 1);
+		return IPFIX_STATUS_NOT_IP;
+	}
+	/* The parser skips the IPv6 extension headers */
+	if (PARSER_IS_TCP_OR_UDP_DEFAULT() || PARSER_IS_SCTP_DEFAULT()) {
+		ports = (uint16_t *)PARSER_GET_L4_POINTER_DEFAULT();
+		key.src_port = ports[0];
+		key.dst_port = ports[1];
+		if (PARSER_IS_TCP_DEFAULT())
+			key.protocol = IPFIX_IP_PROTO_TCP;
+		else if (PARSER_IS_UDP_DEFAULT())
+			key.protocol = IPFIX_IP_PROTO_UDP;
+		else
+			key.protocol = IPFIX_IP_PROTO_SCTP;
+	}
+	key.ni_id = task_get_receive_niid();
+
+	if (rec->sampling_rate > 1) {
+		if (rec->flags & IPFIX_FLG_RANDOM_SAMPLING)
+			sel = (uint32_t)fsl_rand();
+		else
+			sel = ipfix_key_hash(&key);
+		if (sel % rec->sampling_rate)
+			return IPFIX_STATUS_NOT_SAMPLED;
+	}
+	atomic_incr64((int64_t *)&rec->stats.sampled, 1);
+
+	/* A miss creates the record. EIO: another frame of the flow created
+	 * it meanwhile. */
+	key_desc.em_key = &key;
+	do {
+		err = table_lookup_by_key(TABLE_ACCEL_ID_CTLU, rec->table_id,
+					  key_desc, sizeof(key),
+					  &lookup_result);
+		if (err != TABLE_STATUS_MISS) {
+			flow = lookup_result.data0;
+			break;
+		}
+		err = ipfix_flow_create(rec, &key, &flow);
+	} while (err == -EIO);
+	if (err) {
+		atomic_incr64((int64_t *)&rec->stats.flow_drops, 1);
+		return err;
+	}
+
+	ste_inc_and_acc_counters(flow + offsetof(struct ipfix_flow, packets),
+				 LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS),
+				 STE_MODE_COMPOUND_64_BIT_CNTR_SIZE |
+				 STE_MODE_COMPOUND_64_BIT_ACC_SIZE);
+	return 0;
+}
+
+static void ipfix_set_close(struct ipfix_msg *msg)
+{
+	uint16_t pad;
+
+	if (!msg->set_offset)
+		return;
+	/* NetFlow v9 sets are padded to 32 bits, the IPFIX ones may be */
+	pad = (uint16_t)((4 - ((msg->len - msg->set_offset) & 3)) & 3);
+	memset(&msg->buf[msg->len], 0, pad);
+	msg->len += pad;
+	ipfix_put(&msg->buf[msg->set_offset + 2],
+		  msg->len - msg->set_offset, 2);
+	msg->set_offset = 0;
+}
+
+static void ipfix_set_open(struct ipfix_msg *msg, uint16_t set_id)
+{
+	ipfix_put(&msg->buf[msg->len], set_id, 2);
+	msg->set_offset = msg->len;
+	msg->set_id = set_id;
+	msg->len += IPFIX_SET_HDR_SIZE;
+}
+
+static void ipfix_msg_start(struct ipfix_rec *rec, struct ipfix_msg *msg)
+{
+	const struct ipfix_field *fields;
+	int v9 = !!(rec->flags & IPFIX_FLG_NETFLOW_V9);
+	int i, j;
+
+	msg->len = sizeof(struct ethernethdr) + sizeof(struct ipv4hdr) +
+		sizeof(struct udphdr) +
+		(v9 ? IPFIX_NETFLOW_V9_HDR_SIZE : IPFIX_HDR_SIZE);
+	msg->set_offset = 0;
+	msg->set_id = 0;
+	msg->num_records = 0;
+	msg->count = 0;
+	if (rec->tmpl_count)
+		return;
+
+	ipfix_set_open(msg, v9 ? IPFIX_NETFLOW_V9_TEMPLATE_SET_ID :
+		       IPFIX_TEMPLATE_SET_ID);
+	for (i = 0; i < 2; i++) {
+		fields = ipfix_templates[v9][i];
+		ipfix_put(&msg->buf[msg->len], i ? IPFIX_TEMPLATE_ID_IPV6 :
+			  IPFIX_TEMPLATE_ID_IPV4, 2);
+		ipfix_put(&msg->buf[msg->len + 2], IPFIX_NUM_FIELDS, 2);
+		msg->len += 4;
+		for (j = 0; j < IPFIX_NUM_FIELDS; j++) {
+			ipfix_put(&msg->buf[msg->len], fields[j].id, 2);
+			ipfix_put(&msg->buf[msg->len + 2], fields[j].length, 2);
+			msg->len += 4;
+		}
+		msg->count++;
+	}
+	ipfix_set_close(msg);
+}
+
+static uint16_t ipfix_ip_cksum(const uint8_t *hdr, uint16_t length)
+{
+	uint32_t sum = 0;
+	uint16_t i;
+
+	for (i = 0; i < length; i += 2)
+		sum += (uint32_t)((hdr[i] << 8) | hdr[i + 1]);
+	while (sum >> 16)
+		sum = (sum & 0xFFFF) + (sum >> 16);
+	return (uint16_t)~sum;
+}
+
+/* Sets the IP and UDP lengths and the IP checksum of a frame of len bytes */
+static void ipfix_set_ip_udp_len(uint8_t *frame, uint16_t len)
+{
+	struct ipv4hdr *ip;
+	struct udphdr *udp;
+
+	ip = (struct ipv4hdr *)(frame + sizeof(struct ethernethdr));
+	udp = (struct udphdr *)(ip + 1);
+	ip->total_length = (uint16_t)(len - sizeof(struct ethernethdr));
+	ip->hdr_cksum = 0;
+	ip->hdr_cksum = ipfix_ip_cksum((uint8_t *)ip, sizeof(*ip));
+	udp->length = (uint16_t)(ip->total_length - sizeof(*ip));
+}
+
+/* Sends the message. Called by the wheel task. */
+static void ipfix_msg_send(struct ipfix_rec *rec, struct ipfix_msg *msg)
+{
+	uint8_t chunk[IPFIX_MSG_CHUNK] __attribute__((aligned(16)));
+	struct ethernethdr *eth;
+	struct ipv4hdr *ip;
+	struct udphdr *udp;
+	uint8_t *hdr;
+	uint64_t ts, now_us;
+	uint16_t first, offset, size;
+	uint8_t frame_handle;
+	int err;
+
+	ipfix_set_close(msg);
+	tman_get_timestamp(&ts);
+	now_us = ipfix_time_us(rec, ts);
+
+	eth = (struct ethernethdr *)msg->buf;
+	memcpy(eth->dst_addr, rec->dst_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	memcpy(eth->src_addr, rec->src_mac, NET_HDR_FLD_ETH_ADDR_SIZE);
+	eth->ether_type = NET_ETH_ETYPE_IPV4;
+
+	ip = (struct ipv4hdr *)(eth + 1);
+	ip->vsn_and_ihl = 0x45;
+	ip->tos = 0;
+	ip->id = rec->ip_id++;
+	ip->flags_and_offset = 0;
+	ip->ttl = IPFIX_IP_TTL;
+	ip->protocol = IPFIX_IP_PROTO_UDP;
+	ip->src_addr = rec->src_ip;
+	ip->dst_addr = rec->dst_ip;
+
+	udp = (struct udphdr *)(ip + 1);
+	udp->src_port = rec->src_port;
+	udp->dst_port = rec->dst_port;
+	udp->checksum = 0;
+	ipfix_set_ip_udp_len(msg->buf, msg->len);
+
+	/* The 32 bit time fields are truncated here only */
+	hdr = (uint8_t *)(udp + 1);
+	if (rec->flags & IPFIX_FLG_NETFLOW_V9) {
+		ipfix_put(hdr, IPFIX_NETFLOW_V9_VERSION, 2);
+		ipfix_put(hdr + 2, msg->count, 2);
+		ipfix_put(hdr + 4, now_us / 1000, 4);
+		ipfix_put(hdr + 8, rec->time_base + ipfix_tick(now_us), 4);
+		ipfix_put(hdr + 12, rec->sequence++, 4);
+		ipfix_put(hdr + 16, rec->observation_domain_id, 4);
+	} else {
+		ipfix_put(hdr, IPFIX_VERSION, 2);
+		ipfix_put(hdr + 2, udp->length - sizeof(*udp), 2);
+		ipfix_put(hdr + 4, rec->time_base + ipfix_tick(now_us), 4);
+		ipfix_put(hdr + 8, rec->sequence, 4);
+		ipfix_put(hdr + 12, rec->observation_domain_id, 4);
+		rec->sequence += msg->num_records;
+	}
+
+	/* The FDMA reads the workspace only: the message is copied through
+	 * a stack chunk. The frame is created with the first chunk, whose IP
+	 * and UDP lengths are its own so that it parses. The other chunks
+	 * are inserted right after it, the last one first, and the headers
+	 * of the whole message are written back. */
+	first = (uint16_t)MIN(msg->len, IPFIX_MSG_CHUNK);
+	memcpy(chunk, msg->buf, first);
+	if (first < msg->len)
+		ipfix_set_ip_udp_len(chunk, first);
+	err = create_frame((struct ldpaa_fd *)HWC_FD_ADDRESS, chunk, first,
+			   (uint8_t)rec->spid, &frame_handle);
+	if (!err && first < msg->len) {
+		for (offset = msg->len; offset > first; ) {
+			size = (uint16_t)((offset - first) % IPFIX_MSG_CHUNK);
+			if (!size)
+				size = IPFIX_MSG_CHUNK;
+			offset -= size;
+			memcpy(chunk, &msg->buf[offset], size);
+			fdma_insert_default_segment_data(first, chunk, size,
+							 FDMA_REPLACE_NO_FLAGS);
+		}
+		memcpy((void *)(PRC_GET_SEGMENT_ADDRESS() + sizeof(*eth)), ip,
+		       sizeof(*ip) + sizeof(*udp));
+		fdma_modify_default_segment_data(sizeof(*eth),
+						 sizeof(*ip) + sizeof(*udp));
+	}
+	if (!err) {
+		err = dpni_drv_send(rec->ni_id, DPNI_DRV_SEND_MODE_NONE);
+		if (err == -ENOMEM)
+			fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+		else if (err)
+			fdma_discard_fd((struct ldpaa_fd *)HWC_FD_ADDRESS, 0,
+					FDMA_DIS_AS_BIT);
+	}
+	if (err) {
+		rec->stats.tx_errors++;
+	} else {
+		rec->stats.messages++;
+		rec->stats.records += msg->num_records;
+	}
+
+	if (++rec->tmpl_count >= rec->template_refresh)
+		rec->tmpl_count = 0;
+	msg->len = 0;
+}
+
+/* Adds the data record of a flow to the message: the counters since the
+ * last export. Called by the wheel task. */
+static void ipfix_flow_export(struct ipfix_rec *rec, struct ipfix_msg *msg,
+			      const struct ipfix_flow *flow, uint64_t now_us)
+{
+	const struct ipfix_field *fields;
+	uint64_t packets, bytes, val, end_us;
+	uint16_t set_id, size;
+	int v9 = !!(rec->flags & IPFIX_FLG_NETFLOW_V9);
+	int v6 = (flow->key.ip_version == 6);
+	int i;
+
+	packets = flow->packets - flow->exp_packets;
+	bytes = flow->bytes - flow->exp_bytes;
+	if (!packets)
+		return;
+	/* Frames received since the last check of the wheel */
+	end_us = (flow->packets != flow->seen_packets) ? now_us :
+			flow->last_us;
+
+	fields = ipfix_templates[v9][v6];
+	set_id = v6 ? IPFIX_TEMPLATE_ID_IPV6 : IPFIX_TEMPLATE_ID_IPV4;
+	size = 0;
+	for (i = 0; i < IPFIX_NUM_FIELDS; i++)
+		size += fields[i].length;
+	if (msg->len && (!msg->set_offset || msg->set_id != set_id))
+		/* New set: header and padding of the open one */
+		size += IPFIX_SET_HDR_SIZE + 3;
+	if (msg->len && msg->len + size + 3 > IPFIX_MSG_SIZE)
+		ipfix_msg_send(rec, msg);
+	if (!msg->len)
+		ipfix_msg_start(rec, msg);
+	if (!msg->set_offset || msg->set_id != set_id) {
+		ipfix_set_close(msg);
+		ipfix_set_open(msg, set_id);
+	}
+
+	for (i = 0; i < IPFIX_NUM_FIELDS; i++) {
+		switch (fields[i].id) {
+		case IPFIX_IE_SRC_IPV4:
+		case IPFIX_IE_SRC_IPV6:
+			memcpy(&msg->buf[msg->len], flow->key.src_addr,
+			       fields[i].length);
+			break;
+		case IPFIX_IE_DST_IPV4:
+		case IPFIX_IE_DST_IPV6:
+			memcpy(&msg->buf[msg->len], flow->key.dst_addr,
+			       fields[i].length);
+			break;
+		case IPFIX_IE_SRC_PORT:
+			memcpy(&msg->buf[msg->len], &flow->key.src_port, 2);
+			break;
+		case IPFIX_IE_DST_PORT:
+			memcpy(&msg->buf[msg->len], &flow->key.dst_port, 2);
+			break;
+		default:
+			switch (fields[i].id) {
+			case IPFIX_IE_PROTOCOL:
+				val = flow->key.protocol;
+				break;
+			case IPFIX_IE_INGRESS_INTERFACE:
+				val = flow->key.ni_id;
+				break;
+			case IPFIX_IE_PACKET_DELTA_COUNT:
+				val = packets;
+				break;
+			case IPFIX_IE_OCTET_DELTA_COUNT:
+				val = bytes;
+				break;
+			case IPFIX_IE_START_MILLISECONDS:
+				val = (uint64_t)rec->time_base * 1000 +
+					flow->start_us / 1000;
+				break;
+			case IPFIX_IE_END_MILLISECONDS:
+				val = (uint64_t)rec->time_base * 1000 +
+					end_us / 1000;
+				break;
+			case IPFIX_IE_START_SYS_UP_TIME:
+				val = flow->start_us / 1000;
+				break;
+			default:
+				val = end_us / 1000;
+			}
+			ipfix_put(&msg->buf[msg->len], val, fields[i].length);
+		}
+		msg->len += fields[i].length;
+	}
+	msg->num_records++;
+	msg->count++;
+}
+
+/* Checks a record of the current slot. Returns the next record of the slot.
+ * Idle records are removed from the table and added to the expired list. */
+static uint64_t ipfix_flow_check(struct ipfix_rec *rec, struct ipfix_msg *msg,
+				 uint64_t addr, uint64_t now_us,
+				 uint64_t *expired)
+{
+	struct ipfix_flow flow;
+	uint32_t tick = rec->tick;
+	uint32_t start_tick, last_tick, idle_deadline, active_deadline;
+	int idle;
+
+	cdma_read(&flow, addr, sizeof(flow));
+	if ((int32_t)(flow.deadline - tick) > 0) {
+		/* Deadline beyond the wheel */
+		ipfix_wheel_add(rec, addr, flow.deadline);
+		return flow.next;
+	}
+
+	if (flow.packets != flow.seen_packets) {
+		flow.seen_packets = flow.packets;
+		flow.last_us = now_us;
+	}
+
+	/* Times of the current second are ahead of a catching up tick */
+	start_tick = ipfix_tick(flow.start_us);
+	last_tick = ipfix_tick(flow.last_us);
+	idle = ((int32_t)(tick - last_tick) >= rec->idle_timeout);
+	if (idle) {
+		table_rule_delete(TABLE_ACCEL_ID_CTLU, rec->table_id,
+				  flow.rule_id, NULL, NULL, NULL);
+	} else if ((int32_t)(tick - start_tick) >= rec->active_timeout) {
+		ipfix_flow_export(rec, msg, &flow, now_us);
+		flow.exp_packets = flow.packets;
+		flow.exp_bytes = flow.bytes;
+		flow.start_us = now_us;
+		start_tick = ipfix_tick(now_us);
+	}
+
+	idle_deadline = last_tick + rec->idle_timeout;
+	active_deadline = start_tick + rec->active_timeout;
+	flow.deadline = ((int32_t)(idle_deadline - active_deadline) < 0) ?
+			idle_deadline : active_deadline;
+	cdma_write(addr + IPFIX_FLOW_STATE_OFFSET,
+		   (uint8_t *)&flow + IPFIX_FLOW_STATE_OFFSET,
+		   IPFIX_FLOW_STATE_SIZE);
+
+	if (idle) {
+		cdma_write(addr + offsetof(struct ipfix_flow, next), expired,
+			   sizeof(*expired));
+		*expired = addr;
+	} else {
+		ipfix_wheel_add(rec, addr, flow.deadline);
+	}
+	return flow.next;
+}
+
+/* Exports and releases records removed from the table */
+static void ipfix_flows_release(struct ipfix_rec *rec, struct ipfix_msg *msg,
+				uint64_t addr, uint64_t now_us)
+{
+	struct ipfix_flow flow;
+
+	while (addr) {
+		cdma_read(&flow, addr, sizeof(flow));
+		ipfix_flow_export(rec, msg, &flow, now_us);
+		cdma_release_context_memory(addr);
+		addr = flow.next;
+	}
+}
+
+/* Exports all the records and releases the instance */
+static void ipfix_flush(struct ipfix_rec *rec, struct ipfix_msg *msg,
+			uint64_t now_us)
+{
+	struct ipfix_flow flow;
+	uint64_t addr, expired;
+	int i;
+
+	tman_delete_timer(rec->timer_handle,
+			  TMAN_TIMER_DELETE_MODE_WO_EXPIRATION);
+	/* The frames that saw the instance valid are done */
+	rcu_synchronize();
+
+	for (i = 0; i < IPFIX_WHEEL_SIZE; i++) {
+		lock_spinlock(&rec->lock);
+		addr = rec->wheel[i];
+		rec->wheel[i] = 0;
+		unlock_spinlock(&rec->lock);
+		expired = 0;
+		while (addr) {
+			cdma_read(&flow, addr, sizeof(flow));
+			table_rule_delete(TABLE_ACCEL_ID_CTLU, rec->table_id,
+					  flow.rule_id, NULL, NULL, NULL);
+			cdma_write(addr + offsetof(struct ipfix_flow, next),
+				   &expired, sizeof(expired));
+			expired = addr;
+			addr = flow.next;
+		}
+		ipfix_flows_release(rec, msg, expired, now_us);
+	}
+	if (msg->len)
+		ipfix_msg_send(rec, msg);
+
+	table_delete(TABLE_ACCEL_ID_CTLU, rec->table_id);
+	slab_find_and_unreserve_bpid((int32_t)rec->max_flows, rec->bpid);
+
+	lock_spinlock(&rec->lock);
+	rec->busy = 0;
+	rec->valid = 0;
+	unlock_spinlock(&rec->lock);
+}
+
+/* Wheel tick: checks the records of the elapsed slots */
+static void ipfix_wheel_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	struct ipfix_rec *rec = &g_ipfix[(uint32_t)arg1];
+	struct ipfix_msg *msg = &rec->msg;
+	uint64_t ts, now_us, addr, expired;
+	uint32_t now_tick, slot;
+	uint8_t valid;
+
+	UNUSED(arg2);
+	/* Confirm that timer callback finished execution */
+	tman_timer_completion_confirmation(LW_SWAP(16,
+						   (uint32_t *)HWC_FD_ADDRESS));
+
+	lock_spinlock(&rec->lock);
+	valid = rec->valid;
+	/* A tick longer than the period: the next one catches up */
+	if (rec->busy || (valid != IPFIX_VALID && valid != IPFIX_DELETING)) {
+		unlock_spinlock(&rec->lock);
+		return;
+	}
+	rec->busy = 1;
+	unlock_spinlock(&rec->lock);
+
+	sl_tman_expiration_task_prolog(rec->spid);
+	msg->len = 0;
+	tman_get_timestamp(&ts);
+	now_us = ipfix_time_us(rec, ts);
+
+	if (valid == IPFIX_DELETING) {
+		ipfix_flush(rec, msg, now_us);
+		return;
+	}
+
+	now_tick = ipfix_tick(now_us);
+	while ((int32_t)(now_tick - rec->tick) > 0) {
+		rec->tick++;
+		slot = rec->tick % IPFIX_WHEEL_SIZE;
+		lock_spinlock(&rec->lock);
+		addr = rec->wheel[slot];
+		rec->wheel[slot] = 0;
+		unlock_spinlock(&rec->lock);
+
+		expired = 0;
+		while (addr)
+			addr = ipfix_flow_check(rec, msg, addr, now_us,
+						&expired);
+		if (expired) {
+			/* The frames that looked up the deleted rules are
+			 * done: the counters are final */
+			rcu_synchronize();
+			ipfix_flows_release(rec, msg, expired, now_us);
+		}
+	}
+	if (msg->len)
+		ipfix_msg_send(rec, msg);
+
+	lock_spinlock(&rec->lock);
+	rec->busy = 0;
+	unlock_spinlock(&rec->lock);
+}
+
+int ipfix_create(const struct ipfix_params *params, ipfix_handle_t *ipfix)
+{
+	struct table_create_params tbl_params;
+	struct ipfix_rec *rec;
+	uint64_t ts;
+	uint16_t active_timeout, idle_timeout;
+	int i, err;
+
+	active_timeout = params->active_timeout ? params->active_timeout :
+		IPFIX_DEFAULT_ACTIVE_TIMEOUT;
+	idle_timeout = params->idle_timeout ? params->idle_timeout :
+		IPFIX_DEFAULT_IDLE_TIMEOUT;
+	if (!params->max_flows || idle_timeout > active_timeout)
+		return -EINVAL;
+
+	err = ipfix_tmi_init();
+	if (err)
+		return err;
+
+	lock_spinlock(&g_ipfix_lock);
+	for (i = 0; i < IPFIX_MAX_INSTANCES; i++)
+		if (!g_ipfix[i].valid)
+			break;
+	if (i == IPFIX_MAX_INSTANCES) {
+		unlock_spinlock(&g_ipfix_lock);
+		return -ENOSPC;
+	}
+	rec = &g_ipfix[i];
+	/* Reserve the entry; it is usable only once valid */
+	rec->valid = IPFIX_RESERVED;
+	unlock_spinlock(&g_ipfix_lock);
+
+	memset(rec, 0, offsetof(struct ipfix_rec, valid));
+	rec->max_flows = params->max_flows;
+	rec->flags = params->flags;
+	rec->sampling_rate = params->sampling_rate;
+	rec->observation_domain_id = params->observation_domain_id;
+	rec->time_base = params->time_base;
+	rec->active_timeout = active_timeout;
+	rec->idle_timeout = idle_timeout;
+	rec->template_refresh = params->template_refresh ?
+		params->template_refresh : IPFIX_DEFAULT_TEMPLATE_REFRESH;
+	rec->ni_id = params->export_params.ni_id;
+	memcpy(rec->dst_mac, params->export_params.dst_mac,
+	       NET_HDR_FLD_ETH_ADDR_SIZE);
+	rec->src_ip = params->export_params.src_ip;
+	rec->dst_ip = params->export_params.dst_ip;
+	rec->dst_port = params->export_params.dst_port;
+	if (!rec->dst_port)
+		rec->dst_port = (params->flags & IPFIX_FLG_NETFLOW_V9) ?
+			IPFIX_NETFLOW_V9_DEFAULT_PORT : IPFIX_DEFAULT_PORT;
+	rec->src_port = params->export_params.src_port ?
+		params->export_params.src_port : rec->dst_port;
+
+	err = dpni_drv_get_spid(rec->ni_id, &rec->spid);
+	if (!err)
+		err = dpni_drv_get_primary_mac_addr(rec->ni_id, rec->src_mac);
+	if (err)
+		goto create_err;
+
+	err = slab_find_and_reserve_bpid(rec->max_flows, IPFIX_FLOW_BUF_SIZE,
+					 IPFIX_MEM_ALIGN, g_mem_pid, NULL,
+					 &rec->bpid);
+	if (err < 0) {
+		pr_err("Not enough IPFIX flow buffers\n");
+		err = -ENOMEM;
+		goto create_err;
+	}
+
+	tbl_params.committed_rules = rec->max_flows;
+	tbl_params.max_rules = rec->max_flows;
+	tbl_params.attributes = TABLE_ATTRIBUTE_TYPE_EM |
+			ipfix_table_location_attr(params->flags) |
+			TABLE_ATTRIBUTE_MR_NO_MISS;
+	tbl_params.timestamp_accuracy = 1;
+	tbl_params.key_size = sizeof(struct ipfix_flow_key);
+	err = table_create(TABLE_ACCEL_ID_CTLU, &tbl_params, &rec->table_id);
+	if (err != TABLE_STATUS_SUCCESS) {
+		pr_err("Cannot create the IPFIX flow table\n");
+		err = -ENOMEM;
+		goto table_err;
+	}
+
+	tman_get_timestamp(&ts);
+	rec->start_ts = ts;
+	rec->valid = IPFIX_VALID;
+	err = tman_create_timer(g_ipfix_tmi_id,
+				TMAN_CREATE_TIMER_MODE_TPRI |
+				TMAN_CREATE_TIMER_MODE_10_MSEC_GRANULARITY,
+				IPFIX_TICK_DURATION, (tman_arg_8B_t)i, 0,
+				ipfix_wheel_cb, &rec->timer_handle);
+	if (err) {
+		pr_err("Cannot create the IPFIX wheel timer\n");
+		rec->valid = IPFIX_RESERVED;
+		table_delete(TABLE_ACCEL_ID_CTLU, rec->table_id);
+		goto table_err;
+	}
+
+	*ipfix = (ipfix_handle_t)i;
+	return 0;
+
+table_err:
+	slab_find_and_unreserve_bpid((int32_t)rec->max_flows, rec->bpid);
+create_err:
+	rec->valid = 0;
+	return err;
+}
+
+void ipfix_delete(ipfix_handle_t ipfix)
+{
+	struct ipfix_rec *rec = &g_ipfix[ipfix];
+
+	ASSERT_COND(ipfix < IPFIX_MAX_INSTANCES &&
+		    rec->valid == IPFIX_VALID);
+	lock_spinlock(&rec->lock);
+	rec->valid = IPFIX_DELETING;
+	unlock_spinlock(&rec->lock);
+}
+
+int ipfix_get_stats(ipfix_handle_t ipfix, struct ipfix_stats *stats)
+{
+	if (ipfix >= IPFIX_MAX_INSTANCES ||
+	    g_ipfix[ipfix].valid != IPFIX_VALID)
+		return -EINVAL;
+	*stats = g_ipfix[ipfix].stats;
+	return 0;
+}
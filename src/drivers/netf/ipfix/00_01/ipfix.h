@@ -0,0 +1,239 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		ipfix.h
+
+@Description	This file contains the AIOP SW internal IPFIX API
+
+*//***************************************************************************/
+
+#ifndef __AIOP_IPFIX_H
+#define __AIOP_IPFIX_H
+
+#include "fsl_types.h"
+#include "fsl_ipfix.h"
+
+/**************************************************************************//**
+@addtogroup	FSL_IPFIX FSL_AIOP_IPFIX
+
+@Description	AIOP IPFIX functions macros and definitions
+
+@{
+*//***************************************************************************/
+
+#define IPFIX_MEM_ALIGN		64
+
+/*
+ * Flow records are DDR context buffers. The CTLU rule of a flow holds the
+ * record address in data0. The frames of the flow update the counters of the
+ * record with the STE, every other field belongs to the wheel task.
+ *
+ * The wheel has IPFIX_WHEEL_SIZE slots of 1 second. A slot is a list of the
+ * records to check at that tick, linked through their 'next' field. A record
+ * is in exactly one list: it is added by the task creating it and then
+ * detached and added back by the wheel task until it expires. Deadlines
+ * beyond the wheel are put in the last slot and rechecked.
+ *
+ * The activity of a flow is seen by the wheel task as a change of its packet
+ * counter, so an idle flow expires between idle_timeout and 2 * idle_timeout
+ * seconds after its last frame.
+ */
+#define IPFIX_WHEEL_SIZE	64
+
+/** Wheel timer: 100 ticks of 10 ms */
+#define IPFIX_TICK_DURATION	100
+
+/** Timers of the module TMI: one per instance */
+#define IPFIX_NUM_TIMERS	(IPFIX_MAX_INSTANCES + 3)
+#define IPFIX_TMI_SIZE		(64 * (IPFIX_NUM_TIMERS + 1))
+
+/** Instance states */
+#define IPFIX_RESERVED		0x01
+#define IPFIX_VALID		0x02
+#define IPFIX_DELETING		0x03
+
+/** TMI states */
+#define IPFIX_TMI_CREATING	0x01
+#define IPFIX_TMI_READY		0x02
+
+/** Mask of the table location bits of ipfix_params.flags */
+#define IPFIX_MODE_TABLE_LOCATION_MASK	0x0C000000
+
+/** Export message */
+#define IPFIX_MSG_SIZE		512
+/** Stack chunk the message is copied through to build the frame */
+#define IPFIX_MSG_CHUNK		128
+#define IPFIX_VERSION		10
+#define IPFIX_NETFLOW_V9_VERSION	9
+#define IPFIX_HDR_SIZE		16
+#define IPFIX_NETFLOW_V9_HDR_SIZE	20
+#define IPFIX_SET_HDR_SIZE	4
+#define IPFIX_TEMPLATE_SET_ID	2
+#define IPFIX_NETFLOW_V9_TEMPLATE_SET_ID	0
+#define IPFIX_TEMPLATE_ID_IPV4	256
+#define IPFIX_TEMPLATE_ID_IPV6	257
+#define IPFIX_IP_TTL		64
+
+/** IP protocol numbers */
+#define IPFIX_IP_PROTO_TCP	6
+#define IPFIX_IP_PROTO_UDP	17
+#define IPFIX_IP_PROTO_SCTP	132
+
+/** Information Elements (IANA IPFIX / NetFlow v9 field types) */
+#define IPFIX_IE_OCTET_DELTA_COUNT	1
+#define IPFIX_IE_PACKET_DELTA_COUNT	2
+#define IPFIX_IE_PROTOCOL		4
+#define IPFIX_IE_SRC_PORT		7
+#define IPFIX_IE_SRC_IPV4		8
+#define IPFIX_IE_INGRESS_INTERFACE	10
+#define IPFIX_IE_DST_PORT		11
+#define IPFIX_IE_DST_IPV4		12
+#define IPFIX_IE_END_SYS_UP_TIME	21
+#define IPFIX_IE_START_SYS_UP_TIME	22
+#define IPFIX_IE_SRC_IPV6		27
+#define IPFIX_IE_DST_IPV6		28
+#define IPFIX_IE_START_MILLISECONDS	152
+#define IPFIX_IE_END_MILLISECONDS	153
+
+#pragma pack(push, 1)
+/**************************************************************************//**
+@Description	Flow key (exact match key of the flow table). IPv4 addresses
+		are in the first word of the address fields.
+*//***************************************************************************/
+struct ipfix_flow_key {
+	uint32_t src_addr[4];
+	uint32_t dst_addr[4];
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint16_t ni_id;
+	uint8_t  protocol;
+	/** 4 or 6 */
+	uint8_t  ip_version;
+};
+
+/**************************************************************************//**
+@Description	Flow record (DDR). The buffer starts 8 bytes after a 64 bytes
+		boundary, so the STE counters are 16 bytes aligned.
+*//***************************************************************************/
+struct ipfix_flow {
+	/** CTLU rule of the flow */
+	uint64_t rule_id;
+	/** STE compound counter: packets, then bytes */
+	uint64_t packets;
+	uint64_t bytes;
+	struct ipfix_flow_key key;
+	/** Counters at the last export */
+	uint64_t exp_packets;
+	uint64_t exp_bytes;
+	/** Packet counter at the last check of the wheel */
+	uint64_t seen_packets;
+	/** Time of the first frame of the record (us since creation of the
+	 * instance) */
+	uint64_t start_us;
+	/** Time of the last activity seen by the wheel (us) */
+	uint64_t last_us;
+	/** Wheel tick of the next check */
+	uint32_t deadline;
+	uint32_t reserved;
+	/** Next record of the wheel slot list */
+	uint64_t next;
+};
+#pragma pack(pop)
+
+/* The CDMA reference count is kept in the 8 bytes before the buffer */
+#define IPFIX_FLOW_BUF_SIZE	(128 - 8)
+
+/* Fields written by the wheel task at each check */
+#define IPFIX_FLOW_STATE_OFFSET	offsetof(struct ipfix_flow, exp_packets)
+#define IPFIX_FLOW_STATE_SIZE	(offsetof(struct ipfix_flow, next) - \
+				 IPFIX_FLOW_STATE_OFFSET)
+
+/**************************************************************************//**
+@Description	Export message under construction (built by the wheel task)
+*//***************************************************************************/
+struct ipfix_msg {
+	uint8_t  buf[IPFIX_MSG_SIZE];
+	/** Length of the message (including the Eth/IP/UDP headers) */
+	uint16_t len;
+	/** Offset of the open set, 0 if none */
+	uint16_t set_offset;
+	/** Template ID of the open data set */
+	uint16_t set_id;
+	/** Data records in the message */
+	uint16_t num_records;
+	/** Template and data records in the message (NetFlow v9) */
+	uint16_t count;
+};
+
+/**************************************************************************//**
+@Description	IPFIX instance (shared RAM)
+*//***************************************************************************/
+struct ipfix_rec {
+	/** Heads of the wheel slot lists */
+	uint64_t wheel[IPFIX_WHEEL_SIZE];
+	struct ipfix_stats stats;
+	/** Export message of the wheel task */
+	struct ipfix_msg msg;
+	/** TMAN time of the creation of the instance (us) */
+	uint64_t start_ts;
+	/** Protects the wheel heads and the state */
+	uint64_t lock;
+	/** Last processed wheel tick */
+	uint32_t tick;
+	uint32_t max_flows;
+	uint32_t sampling_rate;
+	uint32_t observation_domain_id;
+	uint32_t time_base;
+	/** Exported data records (IPFIX) or messages (NetFlow v9) */
+	uint32_t sequence;
+	uint32_t timer_handle;
+	uint32_t flags;
+	uint32_t src_ip;
+	uint32_t dst_ip;
+	uint16_t src_port;
+	uint16_t dst_port;
+	uint16_t table_id;
+	uint16_t bpid;
+	uint16_t ni_id;
+	uint16_t spid;
+	uint16_t active_timeout;
+	uint16_t idle_timeout;
+	uint16_t template_refresh;
+	/** Messages sent since the last templates */
+	uint16_t tmpl_count;
+	uint16_t ip_id;
+	uint8_t  dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	uint8_t  src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	/** The wheel task is running */
+	uint8_t  busy;
+	/** IPFIX_RESERVED / IPFIX_VALID / IPFIX_DELETING. 0: free. */
+	uint8_t  valid;
+};
+
+/** @} */ /* end of group FSL_IPFIX */
+
+#endif /* __AIOP_IPFIX_H */
@@ -58,6 +58,7 @@
 #include "fsl_sl_slab.h"
 #endif
 #include "fsl_mem_mng.h"
+#include "fsl_prof.h"
 #include "fsl_string.h"
 
 #ifndef USE_IPR_SW_TABLE
@@ -69,6 +70,8 @@ extern __TASK struct aiop_default_task_params default_task_params;
 
 static enum memory_partition_id g_mem_pid = MEM_PART_SYSTEM_DDR;
 
+PROF_REGION_DEFINE(ipr_lookup);
+
 #ifdef USE_IPR_SW_TABLE
 static IPR_CODE_PLACEMENT int sw_table_key_delete(uint32_t table_id,
 						  uint32_t line, uint8_t pos,
@@ -858,6 +861,7 @@ IPR_CODE_PLACEMENT int ipr_reassemble(ipr_instance_handle_t instance_handle)
 				    );
 
 	if (fragment_status == NO_ERROR) {
+		PROF_REGION_START(ipr_lookup);
 #ifdef USE_IPR_SW_TABLE
 		sr_status = sw_ipr_lookup_or_insert(&instance_params,
 						    (uint8_t)frame_is_ipv4,
@@ -868,6 +872,7 @@ IPR_CODE_PLACEMENT int ipr_reassemble(ipr_instance_handle_t instance_handle)
 		sr_status = ipr_lookup(frame_is_ipv4, &instance_params,
 					&rfdc_ext_addr);
 #endif
+		PROF_REGION_STOP(ipr_lookup);
 
 		if (sr_status == TABLE_STATUS_SUCCESS) {
 			/* Hit */
@@ -55,6 +55,7 @@
 
 #include "fsl_ipsec.h"
 #include "ipsec.h"
+#include "arw.h"
 
 #include "sec.h"
 #include "rta.h"
@@ -68,10 +69,24 @@
 #include "fsl_icontext.h"
 
 #include "fsl_mem_mng.h"
+#include "fsl_core.h"
+#include "fsl_smp.h"
+#include "fsl_lazy.h"
 
 /* Global parameters */
 uint16_t ipsec_bpid;
 
+/* The IPsec buffer pool is filled on the first instance creation made at
+ * boot, else by ipsec_drv_post_init() */
+static LAZY_MODULE_DEFINE(ipsec_lazy, "IPsec", ipsec_drv_init);
+
+/* Set by ipsec_early_init(): an application uses IPsec */
+static uint8_t ipsec_used;
+
+/* Per core batched lifetime counters */
+struct ipsec_lt_batch g_ipsec_lt_batch[INTG_MAX_NUM_OF_CORES]
+					__attribute__((aligned(8)));
+
 int ipsec_drv_init(void)
 {
 	struct mc_dprc *dprc = sys_get_unique_handle(FSL_MOD_AIOP_RC);
@@ -161,6 +176,40 @@ int ipsec_drv_init(void)
 	return 0;
 }
 
+/**************************************************************************//**
+*	ipsec_drv_early_init
+*//****************************************************************************/
+int ipsec_drv_early_init(void)
+{
+	int err;
+
+	/* The shared descriptor templates are allocated on the first SA */
+	err = ipsec_sd_tmpl_early_init();
+	if (err)
+		return err;
+
+	if (!(g_app_params.app_config_flags & IPSEC_BUFFER_ALLOCATE_ENABLE))
+		return 0;
+
+	return lazy_register(&ipsec_lazy,
+			     (uint64_t)g_app_params.dpni_num_buffs *
+			     g_app_params.dpni_buff_size);
+}
+
+/**************************************************************************//**
+*	ipsec_drv_post_init
+*//****************************************************************************/
+int ipsec_drv_post_init(void)
+{
+	/* Instances and SAs may be created at run time (e.g. by the sNIC),
+	 * when the lazy modules cannot be initialized any more */
+	if (!ipsec_used)
+		return 0;
+
+	ipsec_sd_tmpl_post_init();
+	return lazy_init(&ipsec_lazy);
+}
+
 /**************************************************************************//**
 *	ipsec_early_init
 *//****************************************************************************/
@@ -179,6 +228,7 @@ int ipsec_early_init(
 	uint32_t max_buffs;
 	committed_buffs = total_instance_num + total_committed_sa_num;
 	max_buffs = total_instance_num + total_max_sa_num;
+	ipsec_used = 1;
 
     if (!(fsl_mem_exists(IPSEC_PRIMARY_MEM_PARTITION_ID))) {
     	mem_id = IPSEC_SECONDARY_MEM_PARTITION_ID;
@@ -212,6 +262,11 @@ int ipsec_create_instance (
 
 	int mem_id = IPSEC_PRIMARY_MEM_PARTITION_ID;
 
+	/* Reserve and fill the IPsec buffer pool, if not done yet */
+	return_val = lazy_init(&ipsec_lazy);
+	if (return_val)
+		return return_val;
+
 	if (!(fsl_mem_exists(IPSEC_PRIMARY_MEM_PARTITION_ID))) {
 	    	mem_id = IPSEC_SECONDARY_MEM_PARTITION_ID;
 	}
@@ -473,6 +528,9 @@ int ipsec_generate_encap_sd(
 	int err;
 	struct ipsec_encap_pdb pdb;
 	enum rta_share_type share;
+	uint64_t start_time;
+
+	tman_get_timestamp(&start_time);
 
 	/* For tunnel mode IPv4, calculate the outer header checksum */
 	/* ip_hdr_len = IP header length in bytes.
@@ -653,6 +711,14 @@ int ipsec_generate_encap_sd(
 	pdb.spi = params->encparams.spi;
 	pdb.ip_hdr_len = (uint32_t) params->encparams.ip_hdr_len;
 
+	/* Build the descriptor from the template of its suite, if any */
+	*sd_size = ipsec_sd_tmpl_get(ws_shared_desc, params, &pdb);
+	if (*sd_size) {
+		cdma_write(sd_addr, ws_shared_desc, (uint16_t)((*sd_size)<<2));
+		ipsec_sd_tmpl_account(1, start_time);
+		return IPSEC_SUCCESS;
+	}
+
 	/* Lengths of items to be inlined in descriptor; order is important.
 	 * Note: For now we assume that inl_mask[0] = 1, i.e. that the
 	 * Outer IP Header can be inlined. 
@@ -765,6 +831,10 @@ int ipsec_generate_encap_sd(
 			sd_addr, /* ext_address */
 			ws_shared_desc, /* ws_src */
 			(uint16_t)((*sd_size)<<2)); /* sd_size is in 32-bit words */
+
+	/* Keep it as the template of its suite */
+	ipsec_sd_tmpl_put(sd_addr, ws_shared_desc, *sd_size, params, &pdb);
+	ipsec_sd_tmpl_account(0, start_time);
 	
 	return IPSEC_SUCCESS;
 
@@ -799,6 +869,9 @@ int ipsec_generate_decap_sd(
 
 	struct ipsec_decap_pdb pdb;
 	enum rta_share_type share;
+	uint64_t start_time;
+
+	tman_get_timestamp(&start_time);
 	
 	/* Build PDB fields for the RTA */
 	
@@ -903,6 +976,10 @@ int ipsec_generate_decap_sd(
 		(uint8_t)(((params->decparams.options) & IPSEC_PDB_OPTIONS_MASK));
 	pdb.options |= (((params->decparams.options) & IPSEC_DEC_PDB_HMO_MASK)
 			<<IPSEC_DEC_PDB_HMO_SHIFT);
+
+	/* With the extended anti-replay window, SEC runs without window */
+	if ((params->decparams.options) & IPSEC_DEC_OPTS_ARS_EXT)
+		pdb.options &= ~IPSEC_DECAP_PDB_ARS_MASK;
 	
 	if (params->flags & IPSEC_FLG_TUNNEL_MODE) {
 		pdb.options |= IPSEC_DEC_OPTS_ETU;
@@ -947,6 +1024,14 @@ int ipsec_generate_decap_sd(
 	pdb.anti_replay[2] = 0;
 	pdb.anti_replay[3] = 0;
 
+	/* Build the descriptor from the template of its suite, if any */
+	*sd_size = ipsec_sd_tmpl_get(ws_shared_desc, params, &pdb);
+	if (*sd_size) {
+		cdma_write(sd_addr, ws_shared_desc, (uint16_t)((*sd_size)<<2));
+		ipsec_sd_tmpl_account(1, start_time);
+		return IPSEC_SUCCESS;
+	}
+
 	/*
 	 * Lengths of items to be inlined in descriptor; order is important.
 	 * Job descriptor maximum length is hard-coded to 7 * CAAM_CMD_SZ +
@@ -1049,6 +1134,10 @@ int ipsec_generate_decap_sd(
 			ws_shared_desc, /* ws_src */
 			(uint16_t)((*sd_size)<<2)); /* sd_size is in 32-bit words */
 
+	/* Keep it as the template of its suite */
+	ipsec_sd_tmpl_put(sd_addr, ws_shared_desc, *sd_size, params, &pdb);
+	ipsec_sd_tmpl_account(0, start_time);
+
 	return IPSEC_SUCCESS;
 } /* End of ipsec_generate_decap_sd */
 #pragma pop
@@ -1279,6 +1368,89 @@ void ipsec_create_key_copy(
 } /* End of ipsec_create_key_copy */
 
 
+/**************************************************************************//**
+@Function		ipsec_encap_overhead
+
+@Description	Returns the maximum growth of a frame encrypted with an outbound
+		SA: outer header (tunnel mode) or UDP header (transport mode
+		with NAT-T), ESP header, IV, padding, ESP trailer and ICV.
+*//***************************************************************************/
+static uint16_t ipsec_encap_overhead(struct ipsec_descriptor_params *params)
+{
+	uint16_t overhead;
+	uint16_t iv_len, pad_align, icv_len;
+
+	switch (params->cipherdata.algtype) {
+		case IPSEC_CIPHER_AES_CBC:
+			iv_len = 16;
+			pad_align = 16;
+			break;
+		case IPSEC_CIPHER_DES_IV64:
+		case IPSEC_CIPHER_DES:
+		case IPSEC_CIPHER_3DES:
+			iv_len = 8;
+			pad_align = 8;
+			break;
+		case IPSEC_CIPHER_NULL:
+			iv_len = 0;
+			pad_align = 4;
+			break;
+		default:
+			/* CTR, CCM, GCM and GMAC: 8 bytes IV, 4 bytes alignment */
+			iv_len = 8;
+			pad_align = 4;
+	}
+
+	switch (params->cipherdata.algtype) {
+		case IPSEC_CIPHER_AES_CCM8:
+		case IPSEC_CIPHER_AES_GCM8:
+			icv_len = 8;
+			break;
+		case IPSEC_CIPHER_AES_CCM12:
+		case IPSEC_CIPHER_AES_GCM12:
+			icv_len = 12;
+			break;
+		case IPSEC_CIPHER_AES_CCM16:
+		case IPSEC_CIPHER_AES_GCM16:
+		case IPSEC_CIPHER_AES_NULL_WITH_GMAC:
+			icv_len = 16;
+			break;
+		default:
+			switch (params->authdata.algtype) {
+				case IPSEC_AUTH_HMAC_NULL:
+					icv_len = 0;
+					break;
+				case IPSEC_AUTH_HMAC_MD5_128:
+				case IPSEC_AUTH_HMAC_SHA2_256_128:
+					icv_len = 16;
+					break;
+				case IPSEC_AUTH_HMAC_SHA1_160:
+					icv_len = 20;
+					break;
+				case IPSEC_AUTH_HMAC_SHA2_384_192:
+					icv_len = 24;
+					break;
+				case IPSEC_AUTH_HMAC_SHA2_512_256:
+					icv_len = 32;
+					break;
+				default:
+					/* MD5_96, SHA1_96, AES_XCBC_MAC_96,
+					 * AES_CMAC_96 */
+					icv_len = 12;
+			}
+	}
+
+	/* SPI + Seq Num, IV, padding, pad length + next header, ICV */
+	overhead = (uint16_t)(8 + iv_len + (pad_align - 1) + 2 + icv_len);
+
+	if (params->flags & IPSEC_FLG_TUNNEL_MODE)
+		overhead += params->encparams.ip_hdr_len;
+	else if (params->flags & IPSEC_ENC_OPTS_NAT_EN)
+		overhead += 8; /* UDP header */
+
+	return overhead;
+}
+
 /**************************************************************************//**
 @Function		ipsec_generate_sa_params 
 
@@ -1304,6 +1476,7 @@ int ipsec_generate_sa_params(
 	/* UDP Encap for transport mode */
 	sap.sap1.udp_src_port = 0; /* UDP source for transport mode. */
 	sap.sap1.udp_dst_port = 0; /* UDP destination for transport mode. */
+	sap.sap1.encap_overhead = 0;
 
 	if (params->cipherdata.algtype == IPSEC_CIPHER_NULL)
 		sap.sap1.flags |= IPSEC_FLG_CIPHER_NULL;
@@ -1354,6 +1527,12 @@ int ipsec_generate_sa_params(
 		 * to be used for segment length presentation */
 		sap.sap1.encap_header_length = 
 				params->encparams.ip_hdr_len + 8;
+
+		/* Maximum frame growth, for the MSS of segmented frames */
+		sap.sap1.encap_overhead = ipsec_encap_overhead(params);
+
+		if ((params->encparams.options) & IPSEC_OPTS_ESP_ESN)
+			sap.sap1.flags |= IPSEC_FLG_ESN;
 		
 	} else {
 		/* Inbound (decryption) */
@@ -1365,6 +1544,13 @@ int ipsec_generate_sa_params(
 				sap.sap1.flags |= IPSEC_FLG_IPV6;
 			}
 		}
+
+		/* Extended anti-replay window */
+		if ((params->decparams.options) & IPSEC_DEC_OPTS_ARS_EXT)
+			sap.sap1.flags |= IPSEC_FLG_ARS_EXT;
+
+		if ((params->decparams.options) & IPSEC_OPTS_ESP_ESN)
+			sap.sap1.flags |= IPSEC_FLG_ESN;
 	}
 	
 	//sap.sap1.status = 0; /* 	lifetime expiry, semaphores	*/
@@ -1549,6 +1735,8 @@ void ipsec_init_debug_info(
  * ------------------------------------------------------
  * | Debug/Error information          | 32 bytes        | + 672 
  * ------------------------------------------------------ 
+ * | Extended anti-replay window      | 40 bytes        | + 704
+ * ------------------------------------------------------ 
  * 
  * ipsec_sa_params - Parameters used by the IPsec functional module	128 bytes
  * sec_flow_context	- SEC Flow Context. 64 bytes
@@ -1575,6 +1763,12 @@ int ipsec_add_sa_descriptor(
 		pr_warn("Buffer allocate mode without enabling dedicated IPSec BP\n");
 	}
 
+	/* The extended anti-replay window does not support ESN */
+	if ((params->direction == IPSEC_DIRECTION_INBOUND) &&
+	    (params->decparams.options & IPSEC_DEC_OPTS_ARS_EXT) &&
+	    (params->decparams.options & IPSEC_OPTS_ESP_ESN))
+		return -EINVAL;
+
 	/* Create a shared descriptor */
 	return_val = ipsec_get_buffer(instance_handle,
 			ipsec_handle, &tmi_id);
@@ -1655,12 +1849,193 @@ int ipsec_add_sa_descriptor(
 	
 	/* Initialize the debug area */
 	ipsec_init_debug_info(desc_addr);
+
+	/* Allocate and initialize the extended anti-replay window */
+	if ((params->direction == IPSEC_DIRECTION_INBOUND) &&
+	    (params->decparams.options & IPSEC_DEC_OPTS_ARS_EXT)) {
+		return_val = arw_init(IPSEC_ARW_ADDR(desc_addr),
+				      params->decparams.ar_window_size,
+				      params->decparams.seq_num,
+				      fsl_mem_exists(
+					IPSEC_PRIMARY_MEM_PARTITION_ID) ?
+					IPSEC_PRIMARY_MEM_PARTITION_ID :
+					IPSEC_SECONDARY_MEM_PARTITION_ID);
+		if (return_val) {
+			/* Release the buffer. No check for error here */
+			ipsec_release_buffer(instance_handle, *ipsec_handle);
+			return return_val;
+		}
+	}
 	
 	/* Success, handle returned. */
 	return IPSEC_SUCCESS;
 	
 } /* End of ipsec_add_sa_descriptor */
 
+/**************************************************************************//**
+*	Batched lifetime counters
+*//****************************************************************************/
+
+/* Adds packets and bytes to the lifetime counters of an SA */
+static inline void ipsec_lt_batch_flush(ipsec_handle_t desc_addr,
+					uint32_t packets, uint32_t bytes)
+{
+	if (!packets)
+		return;
+
+	ste_inc_counter(IPSEC_PACKET_COUNTER_ADDR(desc_addr), packets,
+			(STE_MODE_64_BIT_CNTR_SIZE | STE_MODE_SATURATE));
+	ste_inc_counter(IPSEC_BYTES_COUNTER_ADDR(desc_addr), bytes,
+			(STE_MODE_64_BIT_CNTR_SIZE | STE_MODE_SATURATE));
+}
+
+/* Returns 1 if the counts pending on the cores may take the SA counters
+ * (as read from the descriptor) to an enabled soft or hard limit. Once the
+ * soft limit is reached only the hard limit is considered. */
+static inline int ipsec_lt_batch_near_limit(
+		struct ipsec_sa_params_part1 *sap1)
+{
+	uint64_t margin, limit;
+
+	if (sap1->flags & IPSEC_FLG_LIFETIME_KB_CNTR_EN) {
+		margin = (uint64_t)sys_get_num_of_cores() * IPSEC_LT_BATCH_BYTES;
+		limit = (sap1->byte_counter < sap1->soft_byte_limit) ?
+			sap1->soft_byte_limit : sap1->hard_byte_limit;
+		if (sap1->byte_counter + margin >= limit)
+			return 1;
+	}
+
+	if (sap1->flags & IPSEC_FLG_LIFETIME_PKT_CNTR_EN) {
+		margin = (uint64_t)sys_get_num_of_cores() *
+				IPSEC_LT_BATCH_PACKETS;
+		limit = (sap1->packet_counter < sap1->soft_packet_limit) ?
+			sap1->soft_packet_limit : sap1->hard_packet_limit;
+		if (sap1->packet_counter + margin >= limit)
+			return 1;
+	}
+
+	return 0;
+}
+
+/* Returns the packets and bytes of an SA that are pending on all the cores */
+static void ipsec_lt_batch_pending(ipsec_handle_t desc_addr,
+				   uint32_t *packets, uint32_t *bytes)
+{
+	struct ipsec_lt_batch *batch;
+	struct ipsec_lt_batch_entry *entry;
+	uint32_t core;
+
+	*packets = 0;
+	*bytes = 0;
+	for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+		batch = &g_ipsec_lt_batch[core];
+		entry = &batch->entry[IPSEC_LT_BATCH_INDEX(desc_addr)];
+		lock_spinlock(&batch->lock);
+		if (entry->desc_addr == desc_addr) {
+			*packets += entry->packets;
+			*bytes += entry->bytes;
+		}
+		unlock_spinlock(&batch->lock);
+	}
+}
+
+/* Drops the pending counts of a deleted SA */
+static void ipsec_lt_batch_invalidate(ipsec_handle_t desc_addr)
+{
+	struct ipsec_lt_batch *batch;
+	struct ipsec_lt_batch_entry *entry;
+	uint32_t core;
+
+	for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+		batch = &g_ipsec_lt_batch[core];
+		entry = &batch->entry[IPSEC_LT_BATCH_INDEX(desc_addr)];
+		lock_spinlock(&batch->lock);
+		if (entry->desc_addr == desc_addr) {
+			entry->desc_addr = 0;
+			entry->packets = 0;
+			entry->bytes = 0;
+		}
+		unlock_spinlock(&batch->lock);
+	}
+}
+
+/* Lifetime check: near a limit, the counts pending on all the cores are
+ * added to the counters read from the descriptor. The check is then as exact
+ * as without batching: only the STE updates in flight are not seen. */
+static inline void ipsec_lt_batch_check(ipsec_handle_t desc_addr,
+					struct ipsec_sa_params_part1 *sap1)
+{
+	uint32_t packets, bytes;
+
+	if (!(sap1->flags & IPSEC_FLG_LIFETIME_BATCH) ||
+	    !ipsec_lt_batch_near_limit(sap1))
+		return;
+
+	ipsec_lt_batch_pending(desc_addr, &packets, &bytes);
+	sap1->packet_counter += packets;
+	sap1->byte_counter += bytes;
+}
+
+/* Counts processed packets (one packet, or the segments of a burst).
+ * Without batching, or near a limit, the SA counters are updated at once. */
+static inline void ipsec_lt_batch_count(ipsec_handle_t desc_addr,
+					struct ipsec_sa_params_part1 *sap1,
+					uint32_t packet_count,
+					uint32_t byte_count)
+{
+	struct ipsec_lt_batch *batch;
+	struct ipsec_lt_batch_entry *entry;
+	ipsec_handle_t evict_addr = 0;
+	uint32_t evict_packets = 0, evict_bytes = 0;
+	uint32_t packets = 0, bytes = 0;
+	int near_limit;
+
+	if (!(sap1->flags & IPSEC_FLG_LIFETIME_BATCH)) {
+		if (packet_count > 1) {
+			ipsec_lt_batch_flush(desc_addr, packet_count,
+					     byte_count);
+			return;
+		}
+		ste_inc_and_acc_counters(
+			IPSEC_PACKET_COUNTER_ADDR(desc_addr),
+			byte_count,
+			(STE_MODE_COMPOUND_64_BIT_CNTR_SIZE |
+			STE_MODE_COMPOUND_64_BIT_ACC_SIZE |
+			STE_MODE_COMPOUND_CNTR_SATURATE |
+			STE_MODE_COMPOUND_ACC_SATURATE));
+		return;
+	}
+
+	near_limit = ipsec_lt_batch_near_limit(sap1);
+	batch = &g_ipsec_lt_batch[core_get_id()];
+	entry = &batch->entry[IPSEC_LT_BATCH_INDEX(desc_addr)];
+
+	lock_spinlock(&batch->lock);
+	if (entry->desc_addr != desc_addr) {
+		/* The entry is taken by another SA, flush it */
+		evict_addr = entry->desc_addr;
+		evict_packets = entry->packets;
+		evict_bytes = entry->bytes;
+		entry->desc_addr = desc_addr;
+		entry->packets = 0;
+		entry->bytes = 0;
+	}
+	entry->packets += packet_count;
+	entry->bytes += byte_count;
+	if (near_limit || entry->packets >= IPSEC_LT_BATCH_PACKETS ||
+	    entry->bytes >= IPSEC_LT_BATCH_BYTES) {
+		packets = entry->packets;
+		bytes = entry->bytes;
+		entry->packets = 0;
+		entry->bytes = 0;
+	}
+	unlock_spinlock(&batch->lock);
+
+	if (evict_addr)
+		ipsec_lt_batch_flush(evict_addr, evict_packets, evict_bytes);
+	ipsec_lt_batch_flush(desc_addr, packets, bytes);
+}
+
 /**************************************************************************//**
 *	ipsec_del_sa_descriptor
 *//****************************************************************************/
@@ -1671,11 +2046,22 @@ int ipsec_del_sa_descriptor(
 	int return_val;
 	ipsec_instance_handle_t instance_handle;
 	ipsec_handle_t desc_addr;
+	uint32_t params_flags;
 
 	// TODO Delete the timers; take care of callbacks in the middle of operation.
 	
 	desc_addr = IPSEC_DESC_ADDR(ipsec_handle);
 
+	/* Release the extended anti-replay window */
+	cdma_read(&params_flags, IPSEC_FLAGS_ADDR(desc_addr),
+		  (uint16_t)sizeof(params_flags));
+	if (params_flags & IPSEC_FLG_ARS_EXT)
+		arw_free(IPSEC_ARW_ADDR(desc_addr));
+
+	/* Drop the batched lifetime counts, the counters are cleared below */
+	if (params_flags & IPSEC_FLG_LIFETIME_BATCH)
+		ipsec_lt_batch_invalidate(desc_addr);
+
 	/* Flush all the counter updates that are pending in the 
 	 * statistics engine request queue. */
 	ste_barrier();
@@ -1783,11 +2169,16 @@ static inline void buffer_pool_depleted(uint32_t sec_stat, uint32_t *op_stat,
 }
 
 /**************************************************************************//**
-* ipsec_frame_encrypt
+* ipsec_frame_encrypt_seg
+*
+* Encrypts the default frame. For a segment of a burst, the segments already
+* encrypted are added to the lifetime check and the segment is counted in the
+* burst; the SA counters are updated by ipsec_burst_done().
 *//****************************************************************************/
-IPSEC_CODE_PLACEMENT int ipsec_frame_encrypt(
+IPSEC_CODE_PLACEMENT static int ipsec_frame_encrypt_seg(
 		ipsec_handle_t ipsec_handle,
-		uint32_t *enc_status
+		uint32_t *enc_status,
+		struct ipsec_burst *burst
 		)
 {
 	int return_val;
@@ -1877,6 +2268,15 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_encrypt(
 		}
 	}
 	
+	/* Add the counts pending on the cores (batched counters) */
+	ipsec_lt_batch_check(desc_addr, &sap1);
+
+	/* Add the segments of the burst, not counted yet */
+	if (burst) {
+		sap1.packet_counter += burst->packets;
+		sap1.byte_counter += burst->bytes;
+	}
+
 	/* KB lifetime counters */
 	if (sap1.flags & IPSEC_FLG_LIFETIME_KB_CNTR_EN) {
 		if (sap1.byte_counter >= sap1.soft_byte_limit) {
@@ -2496,21 +2896,86 @@ skip_l2_remove:
 		 *		counters
 		 * (STE increment + accumulate). */
 	
-	/* always count */
-	ste_inc_and_acc_counters(
-			IPSEC_PACKET_COUNTER_ADDR(desc_addr), /* uint64_t counter_addr */
-			byte_count,	/* uint32_t acc_value */
-			/* uint32_t flags */
-			(STE_MODE_COMPOUND_64_BIT_CNTR_SIZE |
-			STE_MODE_COMPOUND_64_BIT_ACC_SIZE |
-			STE_MODE_COMPOUND_CNTR_SATURATE |
-			STE_MODE_COMPOUND_ACC_SATURATE));
+	/* always count (per packet or batched per core), once per burst for
+	 * the segments of a burst */
+	if (burst) {
+		burst->packets++;
+		burst->bytes += byte_count;
+	} else {
+		ipsec_lt_batch_count(desc_addr, &sap1, 1, byte_count);
+	}
 	
 	/* 	19.	END */
 	return IPSEC_SUCCESS;
 
+} /* End of ipsec_frame_encrypt_seg */
+
+/**************************************************************************//**
+* ipsec_frame_encrypt
+*//****************************************************************************/
+IPSEC_CODE_PLACEMENT int ipsec_frame_encrypt(
+		ipsec_handle_t ipsec_handle,
+		uint32_t *enc_status
+		)
+{
+	return ipsec_frame_encrypt_seg(ipsec_handle, enc_status, NULL);
 } /* End of ipsec_frame_encrypt */
 
+/**************************************************************************//**
+* ipsec_frame_encrypt_burst
+*//****************************************************************************/
+IPSEC_CODE_PLACEMENT int ipsec_frame_encrypt_burst(
+		struct ipsec_burst *burst,
+		uint32_t *enc_status
+		)
+{
+	return ipsec_frame_encrypt_seg(burst->ipsec_handle, enc_status, burst);
+} /* End of ipsec_frame_encrypt_burst */
+
+/**************************************************************************//**
+* ipsec_burst_done
+*//****************************************************************************/
+IPSEC_CODE_PLACEMENT void ipsec_burst_done(struct ipsec_burst *burst)
+{
+	struct ipsec_sa_params_part1 sap1;
+	ipsec_handle_t desc_addr;
+
+	if (!burst->packets)
+		return;
+
+	desc_addr = IPSEC_DESC_ADDR(burst->ipsec_handle);
+
+	/* The flags and counters select batched or direct counting */
+	fsl_read_external_data(&sap1, desc_addr, (uint16_t)sizeof(sap1),
+			       READ_METHOD);
+	ipsec_lt_batch_count(desc_addr, &sap1, burst->packets, burst->bytes);
+
+	burst->packets = 0;
+	burst->bytes = 0;
+} /* End of ipsec_burst_done */
+
+/**************************************************************************//**
+* ipsec_get_encap_overhead
+*//****************************************************************************/
+int ipsec_get_encap_overhead(
+		ipsec_handle_t ipsec_handle,
+		uint16_t *overhead)
+{
+	struct ipsec_sa_params_part1 sap1;
+	ipsec_handle_t desc_addr;
+
+	desc_addr = IPSEC_DESC_ADDR(ipsec_handle);
+
+	fsl_read_external_data(&sap1, desc_addr, (uint16_t)sizeof(sap1),
+			       READ_METHOD);
+
+	if (!(sap1.flags & IPSEC_FLG_DIR_OUTBOUND))
+		return -EINVAL;
+
+	*overhead = sap1.encap_overhead;
+	return IPSEC_SUCCESS;
+} /* End of ipsec_get_encap_overhead */
+
 /**************************************************************************//**
 * ipsec_frame_decrypt
 *//****************************************************************************/
@@ -2534,6 +2999,7 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_decrypt(
 	uint8_t pad_length;
 	uint16_t end_seg_len;
 	uint32_t sec_status;
+	uint32_t seq_num = 0; /* ESP sequence number (extended AR window) */
 	struct ipsec_sa_params_part1 sap1; /* Parameters to read from ext buffer */
 	struct scope_status_params scope_status;
 
@@ -2576,6 +3042,9 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_decrypt(
 		}
 	}
 	
+	/* Add the counts pending on the cores (batched counters) */
+	ipsec_lt_batch_check(desc_addr, &sap1);
+
 	/* KB lifetime counters */
 	if (sap1.flags & IPSEC_FLG_LIFETIME_KB_CNTR_EN) {
 		if (sap1.byte_counter >= sap1.soft_byte_limit) {
@@ -2597,6 +3066,20 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_decrypt(
 			}
 		}	 
 	}
+
+	/* Extended anti-replay window check. The ESP header starts at the L5
+	 * offset, the sequence number is its second word. The window is
+	 * updated only after SEC has authenticated the packet. */
+	if (sap1.flags & IPSEC_FLG_ARS_EXT) {
+		seq_num = *(uint32_t *)
+				((uint8_t *)PARSER_GET_L5_POINTER_DEFAULT() + 4);
+		return_val = arw_check(IPSEC_ARW_ADDR(desc_addr), seq_num);
+		if (return_val) {
+			*dec_status |= (return_val == ARW_LATE) ?
+				IPSEC_AR_LATE_PACKET : IPSEC_AR_REPLAY_PACKET;
+			return IPSEC_ERROR;
+		}
+	}
 	
 			/*---------------------*/
 			/* ipsec_frame_decrypt */
@@ -2975,6 +3458,18 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_decrypt(
 		return IPSEC_ERROR; /* Exit */
 	}
 
+	/* The packet is authenticated, record it in the extended anti-replay
+	 * window. Another task may have moved the window or received the same
+	 * sequence number since the check. */
+	if (sap1.flags & IPSEC_FLG_ARS_EXT) {
+		return_val = arw_update(IPSEC_ARW_ADDR(desc_addr), seq_num);
+		if (return_val) {
+			*dec_status |= (return_val == ARW_LATE) ?
+				IPSEC_AR_LATE_PACKET : IPSEC_AR_REPLAY_PACKET;
+			return IPSEC_ERROR;
+		}
+	}
+
 	/*---------------------*/
 	/* ipsec_frame_decrypt */
 	/*---------------------*/
@@ -3272,14 +3767,8 @@ IPSEC_CODE_PLACEMENT int ipsec_frame_decrypt(
 	 *		(CDMA write). */
 	/* 20.4.	Update the bytes and/or packets lifetime counters
 	 * (STE increment + accumulate). */
-	/* always count */
-	ste_inc_and_acc_counters(
-			IPSEC_PACKET_COUNTER_ADDR(desc_addr), /* uint64_t counter_addr */
-			byte_count,	/* uint32_t acc_value */
-			(STE_MODE_COMPOUND_64_BIT_CNTR_SIZE |
-			STE_MODE_COMPOUND_64_BIT_ACC_SIZE |
-			STE_MODE_COMPOUND_CNTR_SATURATE |
-			STE_MODE_COMPOUND_ACC_SATURATE)); /* uint32_t flags */
+	/* always count (per packet or batched per core) */
+	ipsec_lt_batch_count(desc_addr, &sap1, 1, byte_count);
 	
 	/* END */
 	return IPSEC_SUCCESS;
@@ -3298,6 +3787,8 @@ int ipsec_get_lifetime_stats(
 	
 	uint64_t current_timestamp;
 	ipsec_handle_t desc_addr;
+	uint32_t params_flags;
+	uint32_t pending_pkts, pending_bytes;
 
 	/* Note: this struct must be equal to the head of ipsec_sa_params_part1 */
 	struct counters_and_timestamp {
@@ -3320,6 +3811,16 @@ int ipsec_get_lifetime_stats(
 	*packets = ctrs.packet_counter;
 	*bytes = ctrs.byte_counter;
 	*dropped_pkts = ctrs.dropped_pkts;
+
+	/* Add the counts that are batched on the cores */
+	cdma_read(&params_flags, IPSEC_FLAGS_ADDR(desc_addr),
+		  (uint16_t)sizeof(params_flags));
+	if (params_flags & IPSEC_FLG_LIFETIME_BATCH) {
+		ipsec_lt_batch_pending(desc_addr, &pending_pkts,
+				       &pending_bytes);
+		*packets += pending_pkts;
+		*bytes += pending_bytes;
+	}
 	
 	/* Get current timestamp from TMAN (in micro-seconds)*/
 	tman_get_timestamp(&current_timestamp);
@@ -3388,6 +3889,7 @@ int ipsec_get_seq_num(
 	ipsec_handle_t desc_addr;
 	uint32_t params_flags;
 	uint8_t pdb_options;
+	uint64_t arw_seq_num;
 
 	union {
 		struct ipsec_encap_pdb encap_pdb;
@@ -3402,6 +3904,15 @@ int ipsec_get_seq_num(
 			IPSEC_FLAGS_ADDR(desc_addr), /* uint64_t ext_address */
 			(uint16_t)sizeof(params_flags) /* uint16_t size */
 	);
+
+	/* Extended anti-replay window, the PDB has no window */
+	if (params_flags & IPSEC_FLG_ARS_EXT) {
+		arw_get_info(IPSEC_ARW_ADDR(desc_addr), &arw_seq_num,
+			     anti_replay_bitmap);
+		*sequence_number = (uint32_t)arw_seq_num;
+		*extended_sequence_number = (uint32_t)(arw_seq_num >> 32);
+		return IPSEC_SUCCESS;
+	}
 	
 	/* Outbound (encapsulation) PDB format */
 	if (params_flags & IPSEC_FLG_DIR_OUTBOUND) {
@@ -3412,9 +3923,13 @@ int ipsec_get_seq_num(
 				       READ_METHOD);
 
 		/* Return swapped values (little to big endian conversion) */
-		/* Always read from PDB, regardless of ESN enabled/disabled */
-		*extended_sequence_number = LW_SWAP(0,&(pdb.encap_pdb.seq_num_ext_hi));
 		*sequence_number = LW_SWAP(0,&(pdb.encap_pdb.seq_num));
+		/* The high order word is maintained by SEC with ESN only */
+		if (params_flags & IPSEC_FLG_ESN)
+			*extended_sequence_number =
+				LW_SWAP(0,&(pdb.encap_pdb.seq_num_ext_hi));
+		else
+			*extended_sequence_number = 0;
 		
 		/* No anti-replay bitmap for encap, so just return zero */
 		anti_replay_bitmap[0] = 0x0;
@@ -3431,9 +3946,13 @@ int ipsec_get_seq_num(
 				       READ_METHOD);
 
 		/* Return swapped values (little to big endian conversion) */
-		/* Always read from PDB, regardless of ESN enabled/disabled */
-		*extended_sequence_number = LW_SWAP(0,&(pdb.decap_pdb.seq_num_ext_hi));
 		*sequence_number = LW_SWAP(0,&(pdb.decap_pdb.seq_num));
+		/* The high order word is maintained by SEC with ESN only */
+		if (params_flags & IPSEC_FLG_ESN)
+			*extended_sequence_number =
+				LW_SWAP(0,&(pdb.decap_pdb.seq_num_ext_hi));
+		else
+			*extended_sequence_number = 0;
 		
 		/* PDB Word 0 is read from the little endian memory, 
 		 * so the Options byte is at the least significant address */
@@ -3485,6 +4004,31 @@ int ipsec_get_seq_num(
 
 } /* End of ipsec_get_seq_num */
 
+/**************************************************************************//**
+	ipsec_get_ar_stats
+*//****************************************************************************/
+int ipsec_get_ar_stats(
+		ipsec_handle_t ipsec_handle,
+		uint64_t *replay_pkts,
+		uint64_t *late_pkts)
+{
+	ipsec_handle_t desc_addr;
+	uint32_t params_flags;
+
+	desc_addr = IPSEC_DESC_ADDR(ipsec_handle);
+
+	cdma_read(&params_flags, IPSEC_FLAGS_ADDR(desc_addr),
+		  (uint16_t)sizeof(params_flags));
+
+	if (!(params_flags & IPSEC_FLG_ARS_EXT))
+		return -EINVAL;
+
+	arw_get_counters(IPSEC_ARW_ADDR(desc_addr), replay_pkts, late_pkts);
+
+	return IPSEC_SUCCESS;
+
+} /* End of ipsec_get_ar_stats */
+
 /**************************************************************************//**
 	ipsec_get_ipv6_nh_offset
 	
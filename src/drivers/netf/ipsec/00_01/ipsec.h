@@ -115,6 +115,10 @@ enum rta_param_type {
 #define IPSEC_FLG_OUTER_HEADER_IPV6 0x20000000
 /* flags[28] : 1 = NULL cipher, 0 = non-NULL cipher */
 #define IPSEC_FLG_CIPHER_NULL 0x10000000
+/* flags[27] : 1 = extended (software) anti-replay window */
+#define IPSEC_FLG_ARS_EXT 0x08000000
+/* flags[26] : 1 = ESN enabled */
+#define IPSEC_FLG_ESN 0x04000000
 
 /** Preserve the ASA (Accelerator Specific Annotation) */
 /* Obsolete, Not supported */
@@ -259,6 +263,8 @@ enum rta_param_type {
  * ------------------------------------------------------
  * | Debug/Error information          | 32 bytes        | + 672
  * ------------------------------------------------------
+ * | Extended anti-replay window      | 40 bytes        | + 704
+ * ------------------------------------------------------
  *
  * ipsec_sa_params - Parameters used by the IPsec functional module	128 bytes
  * sec_flow_context	- SEC Flow Context. 64 bytes
@@ -349,6 +355,11 @@ enum rta_param_type {
 
 #define IPSEC_DEBUG_INFO_ADDR(ADDRESS) ((ADDRESS) + IPSEC_DEBUG_INFO_OFFSET)
 
+/* Extended anti-replay window context (struct arw_context), inbound only */
+#define IPSEC_ARW_OFFSET\
+		IPSEC_DEBUG_INFO_OFFSET + IPSEC_DEBUG_SEGMENT_SIZE
+#define IPSEC_ARW_ADDR(ADDRESS) ((ADDRESS) + IPSEC_ARW_OFFSET)
+
 
 #define IPSEC_GET_SEGMENT_ADDRESS(prc_addr) \
 	((struct presentation_context *)prc_addr)->seg_address
@@ -635,8 +646,11 @@ struct ipsec_sa_params_part1 {
 	uint8_t soft_sec_expired;	/* Soft seconds lifetime expired */
 	uint8_t hard_sec_expired;	/* Hard seconds lifetime expired */
 
+	uint16_t encap_overhead;	/* Outbound maximum frame growth */
+
 	/* Total size = */
-	/* 9*8 (72) + 2*4 (8) + 4*2 (8) + 5*1 (5) = 93 bytes */
+	/* 9*8 (72) + 2*4 (8) + 4*2 (8) + 5*1 (5) + 1 (pad) + 1*2 (2)
+	 * = 96 bytes */
 	/* Aligned size = 96 bytes */
 };
 /* Part 2 */
@@ -671,6 +685,78 @@ struct ipsec_sa_params {
 		struct ipsec_sa_params_part2 sap2;
 };
 
+/* Batched lifetime counters (IPSEC_FLG_LIFETIME_BATCH).
+ * Each core accumulates the packets and bytes of its SAs in a small direct
+ * mapped table and adds them to the SA counters with the STE once a
+ * threshold is reached or the entry is taken by another SA. */
+#define IPSEC_LT_BATCH_ENTRIES	16 /* Entries per core, power of 2 */
+#define IPSEC_LT_BATCH_PACKETS	32 /* Flush threshold, packets */
+#define IPSEC_LT_BATCH_BYTES	0x10000 /* Flush threshold, bytes */
+
+/* The SA descriptors are 64 bytes aligned */
+#define IPSEC_LT_BATCH_INDEX(DESC_ADDR) \
+	((uint32_t)((DESC_ADDR) >> 6) & (IPSEC_LT_BATCH_ENTRIES - 1))
+
+struct ipsec_lt_batch_entry {
+	uint64_t desc_addr;	/* SA descriptor, 0 if the entry is free */
+	uint32_t packets;	/* Packets not yet added to the SA counters */
+	uint32_t bytes;		/* Bytes not yet added to the SA counters */
+};
+
+struct ipsec_lt_batch {
+	uint64_t lock;	/* Taken by the owner core and by
+			ipsec_del_sa_descriptor() */
+	struct ipsec_lt_batch_entry entry[IPSEC_LT_BATCH_ENTRIES];
+};
+
+/* Shared descriptor templates (ipsec_sd_tmpl.c).
+ * The shared descriptors of the SAs of a same algorithm suite and mode
+ * differ only in the PDB (with the tunnel outer header) and in the keys.
+ * A template is the shared descriptor of the first SA of a suite, with these
+ * fields cleared. The descriptor of a next SA is a copy of the template in
+ * which the PDB and the key commands are written with the RTA. */
+#define IPSEC_SD_TMPL_NUM	16 /* Number of templates */
+#define IPSEC_SD_TMPL_STRIDE	256 /* Template size in memory, bytes */
+
+/* Template key mode word */
+#define IPSEC_SD_TMPL_MODE_INBOUND	0x00000001
+#define IPSEC_SD_TMPL_MODE_TUNNEL	0x00000002
+#define IPSEC_SD_TMPL_MODE_HDR_LEN_SHIFT	16 /* Encap PDB ip_hdr_len */
+
+/* Everything the shared descriptor depends on, except the written fields */
+struct ipsec_sd_tmpl_key {
+	uint32_t cipher_alg;
+	uint32_t cipher_keylen;
+	uint32_t cipher_enc_flags;
+	uint32_t auth_alg;
+	uint32_t auth_keylen;
+	uint32_t auth_enc_flags;
+	uint32_t pdb_options;
+	uint32_t mode;
+};
+
+#define IPSEC_SD_TMPL_FREE	0 /* Not used */
+#define IPSEC_SD_TMPL_BUSY	1 /* Being written to memory */
+#define IPSEC_SD_TMPL_VALID	2
+
+struct ipsec_sd_tmpl {
+	struct ipsec_sd_tmpl_key key;
+	uint8_t state;		/* IPSEC_SD_TMPL_FREE/BUSY/VALID */
+	uint8_t readers;	/* Tasks copying the template */
+	uint8_t sd_size;	/* Shared descriptor size, words */
+	uint8_t keys_pc;	/* First word of the key commands */
+	uint8_t auth_key_type;	/* Key types chosen by rta_inline_query() */
+	uint8_t cipher_key_type;
+};
+
+struct ipsec_sd_tmpl_table {
+	uint64_t lock;		/* Protects the table and the statistics */
+	uint64_t tmpl_addr;	/* IPSEC_SD_TMPL_NUM templates in memory */
+	uint32_t next;		/* Next template to replace */
+	struct ipsec_sd_tmpl_stats stats;
+	struct ipsec_sd_tmpl tmpl[IPSEC_SD_TMPL_NUM];
+};
+
 /* DPOVRD for Tunnel Encap mode */
 //struct dpovrd_tunnel_encap {
 //	uint8_t reserved; /* 7-0 Reserved */
@@ -776,6 +862,62 @@ int ipsec_generate_decap_sd(
 		int *sd_size /* Shared descriptor Length */
 );
 
+/**************************************************************************//**
+@Function		ipsec_sd_tmpl_early_init
+
+@Description	Registers the shared descriptor templates memory, allocated
+		on the first SA
+*//***************************************************************************/
+int ipsec_sd_tmpl_early_init(void);
+
+/**************************************************************************//**
+@Function		ipsec_sd_tmpl_post_init
+
+@Description	Allocates the shared descriptor templates memory at boot, if
+		no SA allocated it yet
+*//***************************************************************************/
+void ipsec_sd_tmpl_post_init(void);
+
+/**************************************************************************//**
+@Function		ipsec_sd_tmpl_get
+
+@Description	Builds a shared descriptor from a template, in the workspace.
+		pdb is the struct ipsec_encap_pdb or struct ipsec_decap_pdb
+		of the SA, according to its direction. Sets the key types of
+		the SA algorithms as the full RTA construction would.
+		Returns the shared descriptor size in words, 0 if there is no
+		template for the SA.
+*//***************************************************************************/
+int ipsec_sd_tmpl_get(
+		uint32_t *ws_sd, /* Workspace shared descriptor */
+		struct ipsec_descriptor_params *params,
+		void *pdb
+);
+
+/**************************************************************************//**
+@Function		ipsec_sd_tmpl_put
+
+@Description	Creates a template from a shared descriptor built by the RTA
+		and already written at sd_addr. The workspace descriptor is
+		overwritten. The template is kept only if, once written for the
+		SA, it is identical to the shared descriptor at sd_addr.
+*//***************************************************************************/
+void ipsec_sd_tmpl_put(
+		uint64_t sd_addr, /* Shared Descriptor Address in external memory */
+		uint32_t *ws_sd, /* Workspace shared descriptor */
+		int sd_size, /* Shared descriptor size, words */
+		struct ipsec_descriptor_params *params,
+		void *pdb
+);
+
+/**************************************************************************//**
+@Function		ipsec_sd_tmpl_account
+
+@Description	Accounts the time of a shared descriptor generation, from
+		start_time (TMAN timestamp)
+*//***************************************************************************/
+void ipsec_sd_tmpl_account(int from_tmpl, uint64_t start_time);
+
 /**************************************************************************//**
 @Function		ipsec_generate_sa_params
 
@@ -0,0 +1,445 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		ipsec_sd_tmpl.c
+
+@Description	IPsec SEC shared descriptor templates.
+
+		The shared descriptor of the first SA of an algorithm suite is
+		kept as a template, without its PDB (and tunnel outer header)
+		and key commands. The shared descriptor of a next SA of the
+		suite is a copy of the template in which the PDB and the key
+		commands are written with the same RTA functions as in the
+		full construction (cnstr_shdsc_ipsec_*). The other commands,
+		their offsets and the jumps only depend on the template key.
+*//***************************************************************************/
+
+#include "fsl_types.h"
+#include "fsl_string.h"
+#include "fsl_malloc.h"
+#include "fsl_mem_mng.h"
+#include "fsl_gen.h"
+#include "kernel/fsl_spinlock.h"
+#include "fsl_cdma.h"
+#include "fsl_tman.h"
+#include "fsl_lazy.h"
+#include "system.h"
+#include "fsl_platform.h"
+
+#include "fsl_ipsec.h"
+#include "ipsec.h"
+
+#include "sec.h"
+#include "rta.h"
+#include "desc/ipsec.h"
+
+static int ipsec_sd_tmpl_init(void);
+
+/* The templates memory is allocated on the first SA made at boot, else by
+ * ipsec_drv_post_init() */
+static LAZY_MODULE_DEFINE(ipsec_sd_tmpl_lazy, "IPsec SD templates",
+			  ipsec_sd_tmpl_init);
+
+struct ipsec_sd_tmpl_table g_ipsec_sd_tmpl __attribute__((aligned(8)));
+
+/**************************************************************************//**
+*	Initialization
+*//****************************************************************************/
+static int ipsec_sd_tmpl_init(void)
+{
+	int mem_id = IPSEC_PRIMARY_MEM_PARTITION_ID;
+
+	if (!(fsl_mem_exists(IPSEC_PRIMARY_MEM_PARTITION_ID)))
+		mem_id = IPSEC_SECONDARY_MEM_PARTITION_ID;
+
+	return fsl_get_mem(IPSEC_SD_TMPL_NUM * IPSEC_SD_TMPL_STRIDE, mem_id,
+			   64, &g_ipsec_sd_tmpl.tmpl_addr);
+}
+
+int ipsec_sd_tmpl_early_init(void)
+{
+	if (g_app_params.app_config_flags & IPSEC_SD_TEMPLATES_DISABLE)
+		return 0;
+
+	return lazy_register(&ipsec_sd_tmpl_lazy,
+			     IPSEC_SD_TMPL_NUM * IPSEC_SD_TMPL_STRIDE);
+}
+
+void ipsec_sd_tmpl_post_init(void)
+{
+	if (g_app_params.app_config_flags & IPSEC_SD_TEMPLATES_DISABLE)
+		return;
+
+	/* A failure only leaves the SAs without template */
+	lazy_init(&ipsec_sd_tmpl_lazy);
+}
+
+/**************************************************************************//**
+*	Templates
+*//****************************************************************************/
+static void ipsec_sd_tmpl_set_key(struct ipsec_sd_tmpl_key *key,
+				  struct ipsec_descriptor_params *params,
+				  void *pdb)
+{
+	key->cipher_alg = params->cipherdata.algtype;
+	key->cipher_keylen = params->cipherdata.keylen;
+	key->cipher_enc_flags = params->cipherdata.key_enc_flags;
+	key->auth_alg = params->authdata.algtype;
+	key->auth_keylen = params->authdata.keylen;
+	key->auth_enc_flags = params->authdata.key_enc_flags;
+	key->mode = 0;
+	if (params->flags & IPSEC_FLG_TUNNEL_MODE)
+		key->mode |= IPSEC_SD_TMPL_MODE_TUNNEL;
+	if (params->direction == IPSEC_DIRECTION_INBOUND) {
+		key->pdb_options = ((struct ipsec_decap_pdb *)pdb)->options;
+		key->mode |= IPSEC_SD_TMPL_MODE_INBOUND;
+	} else {
+		key->pdb_options = ((struct ipsec_encap_pdb *)pdb)->options;
+		key->mode |= ((struct ipsec_encap_pdb *)pdb)->ip_hdr_len <<
+				IPSEC_SD_TMPL_MODE_HDR_LEN_SHIFT;
+	}
+}
+
+static inline int ipsec_sd_tmpl_key_equal(struct ipsec_sd_tmpl_key *a,
+					  struct ipsec_sd_tmpl_key *b)
+{
+	return (a->cipher_alg == b->cipher_alg) &&
+		(a->auth_alg == b->auth_alg) &&
+		(a->pdb_options == b->pdb_options) &&
+		(a->mode == b->mode) &&
+		(a->cipher_keylen == b->cipher_keylen) &&
+		(a->auth_keylen == b->auth_keylen) &&
+		(a->cipher_enc_flags == b->cipher_enc_flags) &&
+		(a->auth_enc_flags == b->auth_enc_flags);
+}
+
+static inline void ipsec_sd_tmpl_program(struct program *p, uint32_t *ws_sd)
+{
+	/* As cnstr_shdsc_ipsec_*() called by ipsec_generate_*_sd() */
+	PROGRAM_CNTXT_INIT(p, ws_sd, 0);
+	PROGRAM_SET_BSWAP(p);
+	if (SEC_POINTER_SIZE)
+		PROGRAM_SET_36BIT_ADDR(p);
+}
+
+/* The inline_max_size inline_max_total_size pragmas are here to eliminate
+ * non-inlined build and warnings of the RTA */
+#pragma push
+#pragma inline_max_size (10000)
+#pragma inline_max_total_size(50000)
+
+/* Writes the key commands, as cnstr_shdsc_ipsec_*() */
+static void ipsec_sd_tmpl_write_keys(struct program *p,
+				     struct ipsec_descriptor_params *params)
+{
+	struct alginfo *cipherdata = (struct alginfo *)(&params->cipherdata);
+	struct alginfo *authdata = (struct alginfo *)(&params->authdata);
+
+	if (authdata->keylen) {
+		/* Transport mode uses the legacy descriptors */
+		if (!(params->flags & IPSEC_FLG_TUNNEL_MODE) &&
+		    (rta_sec_era < RTA_SEC_ERA_6))
+			KEY(p, MDHA_SPLIT_KEY, authdata->key_enc_flags,
+			    authdata->key, authdata->keylen,
+			    INLINE_KEY(authdata));
+		else
+			__gen_auth_key(p, authdata);
+	}
+	if (cipherdata->keylen)
+		KEY(p, KEY1, cipherdata->key_enc_flags, cipherdata->key,
+		    cipherdata->keylen, INLINE_KEY(cipherdata));
+}
+
+/* Writes the PDB, after the shared descriptor header, as
+ * cnstr_shdsc_ipsec_*(). Returns the word following the PDB. */
+static unsigned ipsec_sd_tmpl_write_pdb(struct program *p,
+					struct ipsec_descriptor_params *params,
+					void *pdb)
+{
+	struct ipsec_encap_pdb *encap_pdb = (struct ipsec_encap_pdb *)pdb;
+
+	p->current_pc = 1;
+
+	if (params->direction == IPSEC_DIRECTION_INBOUND) {
+		__rta_copy_ipsec_decap_pdb(p, (struct ipsec_decap_pdb *)pdb,
+					   params->cipherdata.algtype);
+		return p->current_pc;
+	}
+
+	__rta_copy_ipsec_encap_pdb(p, encap_pdb, params->cipherdata.algtype);
+	if (!(params->flags & IPSEC_FLG_TUNNEL_MODE)) {
+		COPY_DATA(p, encap_pdb->ip_hdr, encap_pdb->ip_hdr_len);
+		return p->current_pc;
+	}
+
+	switch (encap_pdb->options & PDBOPTS_ESP_OIHI_MASK) {
+	case PDBOPTS_ESP_OIHI_PDB_INL:
+		COPY_DATA(p, (uint8_t *)params->encparams.outer_hdr,
+			  encap_pdb->ip_hdr_len);
+		break;
+	case PDBOPTS_ESP_OIHI_PDB_REF:
+		COPY_DATA(p, (uint8_t *)params->encparams.outer_hdr,
+			  SEC_POINTER_SIZE ? 8 : 4);
+		break;
+	default:
+		break;
+	}
+
+	return p->current_pc;
+}
+
+int ipsec_sd_tmpl_get(
+		uint32_t *ws_sd,
+		struct ipsec_descriptor_params *params,
+		void *pdb)
+{
+	struct ipsec_sd_tmpl_key key;
+	struct ipsec_sd_tmpl *tmpl;
+	struct program prg;
+	uint64_t tmpl_addr;
+	uint8_t sd_size = 0, keys_pc = 0;
+	int i;
+
+	if ((g_app_params.app_config_flags & IPSEC_SD_TEMPLATES_DISABLE) ||
+	    !g_ipsec_sd_tmpl.tmpl_addr)
+		return 0;
+
+	ipsec_sd_tmpl_set_key(&key, params, pdb);
+
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	for (i = 0; i < IPSEC_SD_TMPL_NUM; i++) {
+		tmpl = &g_ipsec_sd_tmpl.tmpl[i];
+		if ((tmpl->state == IPSEC_SD_TMPL_VALID) &&
+		    ipsec_sd_tmpl_key_equal(&tmpl->key, &key)) {
+			/* The template is not replaced while it is read */
+			tmpl->readers++;
+			sd_size = tmpl->sd_size;
+			keys_pc = tmpl->keys_pc;
+			params->authdata.key_type =
+					(enum key_types)tmpl->auth_key_type;
+			params->cipherdata.key_type =
+					(enum key_types)tmpl->cipher_key_type;
+			break;
+		}
+	}
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+
+	if (!sd_size)
+		return 0;
+
+	tmpl_addr = g_ipsec_sd_tmpl.tmpl_addr +
+			(uint64_t)i * IPSEC_SD_TMPL_STRIDE;
+	cdma_read(ws_sd, tmpl_addr, (uint16_t)(sd_size << 2));
+
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	g_ipsec_sd_tmpl.tmpl[i].readers--;
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+
+	params->authdata.algmode = 0;
+	params->cipherdata.algmode = 0;
+
+	ipsec_sd_tmpl_program(&prg, ws_sd);
+	ipsec_sd_tmpl_write_pdb(&prg, params, pdb);
+	prg.current_pc = keys_pc;
+	ipsec_sd_tmpl_write_keys(&prg, params);
+
+	return sd_size;
+}
+
+/* Returns 1 if the workspace shared descriptor is identical to the one in
+ * external memory */
+static int ipsec_sd_tmpl_check(uint64_t sd_addr, uint32_t *ws_sd, int sd_size)
+{
+	uint32_t buf[8];
+	int i, j, n;
+
+	for (i = 0; i < sd_size; i += n) {
+		n = MIN(sd_size - i, 8);
+		cdma_read(buf, sd_addr + ((uint64_t)i << 2), (uint16_t)(n << 2));
+		for (j = 0; j < n; j++)
+			if (buf[j] != ws_sd[i + j])
+				return 0;
+	}
+
+	return 1;
+}
+
+void ipsec_sd_tmpl_put(
+		uint64_t sd_addr,
+		uint32_t *ws_sd,
+		int sd_size,
+		struct ipsec_descriptor_params *params,
+		void *pdb)
+{
+	struct ipsec_sd_tmpl_key key;
+	struct ipsec_sd_tmpl *tmpl = NULL;
+	struct program prg;
+	unsigned pdb_end, keys_len, keys_pc;
+	int i, idx = 0;
+
+	if ((g_app_params.app_config_flags & IPSEC_SD_TEMPLATES_DISABLE) ||
+	    (sd_size <= 0))
+		return;
+
+	/* Any error only leaves the suite without template */
+	if (lazy_init(&ipsec_sd_tmpl_lazy))
+		goto uncached;
+
+	ipsec_sd_tmpl_set_key(&key, params, pdb);
+
+	/* The key commands are just before the final PROTOCOL command */
+	ipsec_sd_tmpl_program(&prg, ws_sd);
+	ipsec_sd_tmpl_write_keys(&prg, params);
+	keys_len = prg.current_pc;
+	if (keys_len + 2 > (unsigned)sd_size)
+		goto uncached;
+	keys_pc = (unsigned)sd_size - 1 - keys_len;
+
+	/* Reserve a template: a free one, else the next valid one that is not
+	 * being read */
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	for (i = 0; i < IPSEC_SD_TMPL_NUM; i++) {
+		tmpl = &g_ipsec_sd_tmpl.tmpl[i];
+		if ((tmpl->state == IPSEC_SD_TMPL_VALID) &&
+		    ipsec_sd_tmpl_key_equal(&tmpl->key, &key)) {
+			/* Created by another task meanwhile */
+			unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+			return;
+		}
+	}
+	tmpl = NULL;
+	for (i = 0; i < IPSEC_SD_TMPL_NUM; i++) {
+		/* A flushed template may still be read */
+		if ((g_ipsec_sd_tmpl.tmpl[i].state == IPSEC_SD_TMPL_FREE) &&
+		    !g_ipsec_sd_tmpl.tmpl[i].readers) {
+			idx = i;
+			tmpl = &g_ipsec_sd_tmpl.tmpl[i];
+			break;
+		}
+	}
+	for (i = 0; !tmpl && (i < IPSEC_SD_TMPL_NUM); i++) {
+		idx = (int)((g_ipsec_sd_tmpl.next + i) % IPSEC_SD_TMPL_NUM);
+		if ((g_ipsec_sd_tmpl.tmpl[idx].state == IPSEC_SD_TMPL_VALID) &&
+		    !g_ipsec_sd_tmpl.tmpl[idx].readers) {
+			tmpl = &g_ipsec_sd_tmpl.tmpl[idx];
+			g_ipsec_sd_tmpl.next = (uint32_t)(idx + 1);
+		}
+	}
+	if (tmpl)
+		tmpl->state = IPSEC_SD_TMPL_BUSY;
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+
+	if (!tmpl)
+		goto uncached;
+
+	/* Template: the shared descriptor without the PDB and the keys */
+	cdma_read(ws_sd, sd_addr, (uint16_t)(sd_size << 2));
+	ipsec_sd_tmpl_program(&prg, ws_sd);
+	pdb_end = ipsec_sd_tmpl_write_pdb(&prg, params, pdb);
+	memset(&ws_sd[1], 0, (pdb_end - 1) << 2);
+	memset(&ws_sd[keys_pc], 0, keys_len << 2);
+	cdma_write(g_ipsec_sd_tmpl.tmpl_addr +
+		   (uint64_t)idx * IPSEC_SD_TMPL_STRIDE,
+		   ws_sd, (uint16_t)(sd_size << 2));
+
+	/* The template is used only if it gives the shared descriptor of this
+	 * SA once written */
+	ipsec_sd_tmpl_write_pdb(&prg, params, pdb);
+	prg.current_pc = keys_pc;
+	ipsec_sd_tmpl_write_keys(&prg, params);
+
+	if ((prg.current_pc != keys_pc + keys_len) ||
+	    !ipsec_sd_tmpl_check(sd_addr, ws_sd, sd_size)) {
+		pr_warn("IPsec: no SD template for cipher 0x%x auth 0x%x\n",
+			params->cipherdata.algtype, params->authdata.algtype);
+		lock_spinlock(&g_ipsec_sd_tmpl.lock);
+		tmpl->state = IPSEC_SD_TMPL_FREE;
+		g_ipsec_sd_tmpl.stats.uncached++;
+		unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+		return;
+	}
+
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	tmpl->key = key;
+	tmpl->sd_size = (uint8_t)sd_size;
+	tmpl->keys_pc = (uint8_t)keys_pc;
+	tmpl->auth_key_type = (uint8_t)params->authdata.key_type;
+	tmpl->cipher_key_type = (uint8_t)params->cipherdata.key_type;
+	tmpl->state = IPSEC_SD_TMPL_VALID;
+	g_ipsec_sd_tmpl.stats.inserts++;
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+	return;
+
+uncached:
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	g_ipsec_sd_tmpl.stats.uncached++;
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+}
+
+#pragma pop
+
+/**************************************************************************//**
+*	Statistics
+*//****************************************************************************/
+void ipsec_sd_tmpl_account(int from_tmpl, uint64_t start_time)
+{
+	uint64_t now;
+
+	tman_get_timestamp(&now);
+
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	if (from_tmpl) {
+		g_ipsec_sd_tmpl.stats.hits++;
+		g_ipsec_sd_tmpl.stats.hit_time += now - start_time;
+	} else {
+		g_ipsec_sd_tmpl.stats.misses++;
+		g_ipsec_sd_tmpl.stats.miss_time += now - start_time;
+	}
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+}
+
+int ipsec_get_sd_tmpl_stats(struct ipsec_sd_tmpl_stats *stats)
+{
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	*stats = g_ipsec_sd_tmpl.stats;
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+
+	return IPSEC_SUCCESS;
+}
+
+void ipsec_flush_sd_tmpl(void)
+{
+	int i;
+
+	lock_spinlock(&g_ipsec_sd_tmpl.lock);
+	/* A template being written or read is replaced only once done */
+	for (i = 0; i < IPSEC_SD_TMPL_NUM; i++)
+		if (g_ipsec_sd_tmpl.tmpl[i].state == IPSEC_SD_TMPL_VALID)
+			g_ipsec_sd_tmpl.tmpl[i].state = IPSEC_SD_TMPL_FREE;
+	memset(&g_ipsec_sd_tmpl.stats, 0, sizeof(g_ipsec_sd_tmpl.stats));
+	unlock_spinlock(&g_ipsec_sd_tmpl.lock);
+}
@@ -0,0 +1,348 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		meter.c
+
+@Description	This file contains the AIOP SW srTCM/trTCM meter
+		implementation.
+
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_ldpaa_aiop.h"
+#include "fsl_cdma.h"
+#include "fsl_ste.h"
+#include "fsl_tman.h"
+#include "fsl_spinlock.h"
+#include "fsl_malloc.h"
+#include "fsl_mem_mng.h"
+#include "fsl_dbg.h"
+#include "meter.h"
+
+static struct meter_table g_meter_tables[METER_MAX_TABLES];
+static uint64_t g_meter_tables_lock __attribute__((aligned(8)));
+
+static inline uint64_t meter_rec_addr(struct meter_table *mt,
+				      uint32_t meter_id)
+{
+	return mt->meters + (uint64_t)meter_id * METER_REC_SIZE;
+}
+
+static inline uint64_t meter_profile_addr(struct meter_table *mt,
+					  uint16_t profile_id)
+{
+	return mt->profiles + (uint64_t)profile_id * METER_PROFILE_REC_SIZE;
+}
+
+static inline uint64_t meter_refill(uint64_t level, uint64_t delta,
+				    uint32_t rate, uint64_t burst)
+{
+	if (delta >= METER_MAX_DELTA)
+		return burst;
+	level += delta * rate;
+	return (level > burst) ? burst : level;
+}
+
+int meter_table_create(struct meter_table_params *params,
+		       meter_table_handle_t *table)
+{
+	struct meter_table *mt;
+	enum memory_partition_id mem_pid;
+	uint8_t rec[METER_REC_SIZE] __attribute__((aligned(16)));
+	uint64_t paddr, size;
+	uint32_t i;
+	int err;
+
+	if (!params->num_meters || params->num_meters > METER_MAX_METERS ||
+	    !params->num_profiles || params->num_profiles > METER_MAX_PROFILES)
+		return -EINVAL;
+
+	if (params->flags & METER_TABLE_LOCATION_PEB)
+		mem_pid = MEM_PART_PEB;
+	else if (fsl_mem_exists(MEM_PART_DP_DDR))
+		mem_pid = MEM_PART_DP_DDR;
+	else
+		mem_pid = MEM_PART_SYSTEM_DDR;
+
+	lock_spinlock(&g_meter_tables_lock);
+	for (i = 0; i < METER_MAX_TABLES; i++)
+		if (!g_meter_tables[i].valid)
+			break;
+	if (i == METER_MAX_TABLES) {
+		unlock_spinlock(&g_meter_tables_lock);
+		return -ENOSPC;
+	}
+	mt = &g_meter_tables[i];
+	/* Reserve the entry; it is usable only once valid */
+	mt->valid = 2;
+	unlock_spinlock(&g_meter_tables_lock);
+
+	size = (uint64_t)params->num_meters * METER_REC_SIZE +
+		(uint64_t)params->num_profiles * METER_PROFILE_REC_SIZE;
+	err = fsl_get_mem(size, mem_pid, METER_REC_SIZE, &paddr);
+	if (err) {
+		mt->valid = 0;
+		return -ENOMEM;
+	}
+	mt->paddr = paddr;
+	mt->meters = paddr;
+	mt->profiles = paddr + (uint64_t)params->num_meters * METER_REC_SIZE;
+	mt->num_meters = params->num_meters;
+	mt->num_profiles = params->num_profiles;
+
+	/* Clear the meters and the profiles */
+	memset(rec, 0, sizeof(rec));
+	for (i = 0; i < params->num_meters; i++)
+		cdma_write(meter_rec_addr(mt, i), rec, METER_REC_SIZE);
+	for (i = 0; i < params->num_profiles; i++)
+		cdma_write(meter_profile_addr(mt, (uint16_t)i), rec,
+			   METER_PROFILE_REC_SIZE);
+
+	mt->valid = 1;
+	*table = (meter_table_handle_t)(mt - g_meter_tables);
+	return 0;
+}
+
+void meter_table_delete(meter_table_handle_t table)
+{
+	struct meter_table *mt = &g_meter_tables[table];
+
+	ASSERT_COND(table < METER_MAX_TABLES && mt->valid == 1);
+	fsl_put_mem(mt->paddr);
+	lock_spinlock(&g_meter_tables_lock);
+	mt->valid = 0;
+	unlock_spinlock(&g_meter_tables_lock);
+}
+
+int meter_profile_set(meter_table_handle_t table, uint16_t profile_id,
+		      struct meter_profile_params *params)
+{
+	struct meter_table *mt = &g_meter_tables[table];
+	struct meter_profile_rec prof __attribute__((aligned(16)));
+
+	if (table >= METER_MAX_TABLES || mt->valid != 1 ||
+	    profile_id >= mt->num_profiles)
+		return -EINVAL;
+	if (params->algorithm != METER_SRTCM &&
+	    params->algorithm != METER_TRTCM)
+		return -EINVAL;
+	if (!params->cir || params->cir > METER_MAX_RATE ||
+	    params->cbs > METER_MAX_BURST || params->ebs > METER_MAX_BURST)
+		return -EINVAL;
+	/* At least one 1/65536 byte per microsecond (PIR >= CIR) */
+	if (!((params->cir << METER_FP_SHIFT) / 1000000))
+		return -EINVAL;
+	if (params->algorithm == METER_SRTCM) {
+		/* RFC 2697: at least one of CBS and EBS is not 0 */
+		if (!params->cbs && !params->ebs)
+			return -EINVAL;
+	} else {
+		/* RFC 2698: PIR >= CIR, PBS and CBS are not 0 */
+		if (params->pir < params->cir ||
+		    params->pir > METER_MAX_RATE ||
+		    !params->cbs || !params->ebs)
+			return -EINVAL;
+	}
+
+	memset(&prof, 0, sizeof(prof));
+	prof.cir = (uint32_t)((params->cir << METER_FP_SHIFT) / 1000000);
+	if (params->algorithm == METER_TRTCM)
+		prof.pir = (uint32_t)((params->pir << METER_FP_SHIFT) /
+				      1000000);
+	prof.cbs = (uint64_t)params->cbs << METER_FP_SHIFT;
+	prof.ebs = (uint64_t)params->ebs << METER_FP_SHIFT;
+	prof.algorithm = (uint8_t)params->algorithm;
+	prof.color_aware =
+		(uint8_t)(params->flags & METER_PROFILE_COLOR_AWARE ? 1 : 0);
+	prof.valid = 1;
+	/* Single write: the meters see the old or the new profile */
+	cdma_write(meter_profile_addr(mt, profile_id), &prof, sizeof(prof));
+	return 0;
+}
+
+int meter_config_range(meter_table_handle_t table, uint32_t first_meter_id,
+		       uint32_t num_meters, uint16_t profile_id)
+{
+	struct meter_table *mt = &g_meter_tables[table];
+	struct meter_profile_rec prof __attribute__((aligned(16)));
+	uint8_t rec[METER_REC_SIZE] __attribute__((aligned(16)));
+	struct meter_state *state = (struct meter_state *)rec;
+	uint64_t addr;
+	uint32_t i;
+
+	if (table >= METER_MAX_TABLES || mt->valid != 1 ||
+	    profile_id >= mt->num_profiles ||
+	    first_meter_id >= mt->num_meters ||
+	    num_meters > mt->num_meters - first_meter_id)
+		return -EINVAL;
+	cdma_read(&prof, meter_profile_addr(mt, profile_id), sizeof(prof));
+	if (!prof.valid)
+		return -EINVAL;
+
+	/* The buckets are full initially */
+	memset(rec, 0, sizeof(rec));
+	tman_get_timestamp(&state->ts);
+	state->tc = prof.cbs;
+	state->te = prof.ebs;
+	state->profile_id = profile_id;
+	state->flags = METER_STATE_VALID;
+	for (i = 0; i < num_meters; i++) {
+		addr = meter_rec_addr(mt, first_meter_id + i);
+		cdma_write_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK |
+				      CDMA_POSTDMA_MUTEX_RM_BIT,
+				      rec, METER_REC_SIZE);
+	}
+	return 0;
+}
+
+int meter_config(meter_table_handle_t table, uint32_t meter_id,
+		 uint16_t profile_id)
+{
+	return meter_config_range(table, meter_id, 1, profile_id);
+}
+
+METER_CODE_PLACEMENT enum meter_color meter_color(meter_table_handle_t table,
+						  uint32_t meter_id,
+						  uint32_t length,
+						  enum meter_color in_color)
+{
+	struct meter_table *mt = &g_meter_tables[table];
+	struct meter_state state __attribute__((aligned(16)));
+	struct meter_profile_rec prof __attribute__((aligned(16)));
+	enum meter_color color;
+	uint64_t addr, now, delta, len;
+
+	ASSERT_COND_LIGHT(table < METER_MAX_TABLES && mt->valid == 1);
+	ASSERT_COND_LIGHT(meter_id < mt->num_meters);
+	addr = meter_rec_addr(mt, meter_id);
+
+	cdma_read_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &state,
+			     sizeof(state));
+	if (!(state.flags & METER_STATE_VALID)) {
+		/* Not configured */
+		cdma_mutex_lock_release(addr);
+		return METER_GREEN;
+	}
+	cdma_read(&prof, meter_profile_addr(mt, state.profile_id),
+		  sizeof(prof));
+	/* Taken under the mutex: monotonic for this meter */
+	tman_get_timestamp(&now);
+	delta = now - state.ts;
+	state.ts = now;
+
+	if (prof.algorithm == METER_SRTCM) {
+		/* RFC 2697: tokens overflowing the C bucket go to the E
+		 * bucket */
+		if (delta >= METER_MAX_DELTA) {
+			state.tc = prof.cbs;
+			state.te = prof.ebs;
+		} else {
+			state.tc += delta * prof.cir;
+			if (state.tc > prof.cbs) {
+				state.te += state.tc - prof.cbs;
+				state.tc = prof.cbs;
+				if (state.te > prof.ebs)
+					state.te = prof.ebs;
+			}
+		}
+	} else {
+		state.tc = meter_refill(state.tc, delta, prof.cir, prof.cbs);
+		state.te = meter_refill(state.te, delta, prof.pir, prof.ebs);
+	}
+
+	if (!prof.color_aware)
+		in_color = METER_GREEN;
+	len = (uint64_t)length << METER_FP_SHIFT;
+	if (prof.algorithm == METER_SRTCM) {
+		if (in_color == METER_GREEN && state.tc >= len) {
+			color = METER_GREEN;
+			state.tc -= len;
+		} else if (in_color != METER_RED && state.te >= len) {
+			color = METER_YELLOW;
+			state.te -= len;
+		} else {
+			color = METER_RED;
+		}
+	} else {
+		/* trTCM: te is the P bucket */
+		if (in_color == METER_RED || state.te < len) {
+			color = METER_RED;
+		} else if (in_color == METER_YELLOW || state.tc < len) {
+			color = METER_YELLOW;
+			state.te -= len;
+		} else {
+			color = METER_GREEN;
+			state.te -= len;
+			state.tc -= len;
+		}
+	}
+
+	cdma_write_with_mutex(addr, CDMA_POSTDMA_MUTEX_RM_BIT, &state,
+			      offsetof(struct meter_state, profile_id));
+	ste_inc_counter(addr + METER_CNT_OFFSET + color * sizeof(uint64_t),
+			1, STE_MODE_64_BIT_CNTR_SIZE);
+	return color;
+}
+
+METER_CODE_PLACEMENT enum meter_color meter_color_ref(uint32_t meter_ref,
+						      uint32_t length,
+						      enum meter_color in_color)
+{
+	return meter_color((meter_table_handle_t)(meter_ref >> 24),
+			   meter_ref & 0x00FFFFFF, length, in_color);
+}
+
+METER_CODE_PLACEMENT enum meter_color meter_color_frame(
+					meter_table_handle_t table,
+					uint32_t meter_id,
+					enum meter_color in_color)
+{
+	return meter_color(table, meter_id,
+			   (uint32_t)LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS),
+			   in_color);
+}
+
+int meter_get_stats(meter_table_handle_t table, uint32_t meter_id,
+		    struct meter_stats *stats, int reset)
+{
+	struct meter_table *mt = &g_meter_tables[table];
+	struct meter_stats zero = {0};
+	uint64_t addr;
+
+	if (table >= METER_MAX_TABLES || mt->valid != 1 ||
+	    meter_id >= mt->num_meters)
+		return -EINVAL;
+	addr = meter_rec_addr(mt, meter_id) + METER_CNT_OFFSET;
+	/* Wait for the pending STE updates of this task */
+	ste_barrier();
+	cdma_read(stats, addr, sizeof(*stats));
+	if (reset)
+		cdma_write(addr, &zero, sizeof(zero));
+	return 0;
+}
@@ -0,0 +1,117 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		meter.h
+
+@Description	This file contains the AIOP SW internal meter API
+
+*//***************************************************************************/
+
+#ifndef __AIOP_METER_H
+#define __AIOP_METER_H
+
+#include "fsl_types.h"
+#include "fsl_meter.h"
+
+/**************************************************************************//**
+@addtogroup	FSL_METER FSL_AIOP_METER
+
+@Description	AIOP METER functions macros and definitions
+
+@{
+*//***************************************************************************/
+
+/*
+ * Bucket levels are kept in 1/65536 byte units and rates in 1/65536 byte per
+ * microsecond (the TMAN timestamp unit), so a refill is one multiplication.
+ * The product fits in 64 bits for rates up to METER_MAX_RATE and elapsed
+ * times below METER_MAX_DELTA (about 18 minutes). A meter idle for longer
+ * gets full buckets, which differs from the RFCs only for profiles that take
+ * longer than that to fill a bucket.
+ */
+#define METER_FP_SHIFT		16
+#define METER_MAX_DELTA		0x40000000ULL
+
+/** Meter record size and alignment (a CDMA cache line) */
+#define METER_REC_SIZE		64
+/** Profile record size */
+#define METER_PROFILE_REC_SIZE	32
+
+/** Offset of the packet counters in a meter record */
+#define METER_CNT_OFFSET	32
+
+/** Meter state flags */
+#define METER_STATE_VALID	0x0001
+
+/** Meter state, at the start of a meter record. Updated under a CDMA mutex
+ * on the record address. */
+struct meter_state {
+	/* TMAN timestamp of the last update (us) */
+	uint64_t ts;
+	/* Committed bucket level */
+	uint64_t tc;
+	/* Excess (srTCM) or peak (trTCM) bucket level */
+	uint64_t te;
+	uint16_t profile_id;
+	uint16_t flags;
+	uint32_t res;
+};
+
+/** Meter profile record. Read with a single CDMA read, so a profile update
+ * is seen entirely or not at all. */
+struct meter_profile_rec {
+	/* Committed rate */
+	uint32_t cir;
+	/* Peak rate (trTCM) */
+	uint32_t pir;
+	/* Committed burst size */
+	uint64_t cbs;
+	/* Excess (srTCM) or peak (trTCM) burst size */
+	uint64_t ebs;
+	uint8_t  valid;
+	uint8_t  algorithm;
+	uint8_t  color_aware;
+	uint8_t  res[5];
+};
+
+/** Meter table descriptor, in the shared SRAM */
+struct meter_table {
+	/* Physical address of the meter records */
+	uint64_t meters;
+	/* Physical address of the profile records */
+	uint64_t profiles;
+	/* Start of the allocated memory */
+	uint64_t paddr;
+	uint32_t num_meters;
+	uint16_t num_profiles;
+	uint8_t  valid;
+	uint8_t  res;
+};
+
+/** @} */ /* end of group FSL_METER */
+
+#endif /* __AIOP_METER_H */
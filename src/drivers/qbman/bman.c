@@ -32,6 +32,35 @@
 #include "fsl_fdma.h"
 #include "fsl_dbg.h"
 #include "fsl_sl_slab.h"
+#include "fsl_smp.h"
+
+/* Buffers released by a core at a time */
+#define BMAN_FILL_CHUNK		1024
+
+/* The buffers of a pool being filled, shared with the other cores */
+struct bman_fill_work {
+	uint64_t addr;
+	uint32_t buff_size;
+	uint16_t icid;
+	uint16_t bpid;
+	uint32_t bdi_flags;
+};
+
+static struct bman_fill_work fill_work;
+
+/*****************************************************************************/
+__COLD_CODE static void bman_fill_range(void *arg, uint32_t first,
+                                        uint32_t count)
+{
+	struct bman_fill_work *fw = (struct bman_fill_work *)arg;
+	uint64_t addr = fw->addr + (uint64_t)fw->buff_size * first;
+	uint32_t i;
+
+	for (i = 0; i < count; i++) {
+		fdma_release_buffer(fw->icid, fw->bdi_flags, fw->bpid, addr);
+		addr += fw->buff_size;
+	}
+}
 
 /*****************************************************************************/
 __COLD_CODE int bman_fill_bpid(uint32_t num_buffs,
@@ -41,9 +70,9 @@ __COLD_CODE int bman_fill_bpid(uint32_t num_buffs,
                      uint16_t bpid,
                      uint16_t alignment_extension)
 {
-	int        i = 0;
 	uint64_t addr  = 0;
 	struct icontext ic;
+	struct bman_fill_work fw;
 	int err;
 
 	/* We allocate a continuous block of memory,
@@ -81,9 +110,19 @@ __COLD_CODE int bman_fill_bpid(uint32_t num_buffs,
 	* otherwise 0 will be added*/
 	addr += alignment_extension;
 
-	for (i = 0; i < num_buffs; i++) {
-		fdma_release_buffer(ic.icid, ic.bdi_flags, bpid, addr);
-		addr += buff_size;
+	fw.addr = addr;
+	fw.buff_size = buff_size;
+	fw.icid = ic.icid;
+	fw.bpid = bpid;
+	fw.bdi_flags = ic.bdi_flags;
+
+	/* During the boot the buffers are released by all the cores */
+	if (sys_boot_work_enabled()) {
+		fill_work = fw;
+		return sys_boot_work_run(bman_fill_range, &fill_work,
+		                         num_buffs, BMAN_FILL_CHUNK);
 	}
+
+	bman_fill_range(&fw, 0, num_buffs);
 	return 0;
 }
@@ -65,6 +65,7 @@
 
 #include "fsl_gso.h"
 #include "fsl_gro.h"
+#include "fsl_prof.h"
 
 
 #define SNIC_CMD_READ(_param, _offset, _width, _type, _arg) \
@@ -181,16 +182,21 @@ static void snic_reset_tcp_gro_ctx(uint16_t id)
 		   sizeof(struct tcp_gro_stats_cntrs));
 }
 
+PROF_REGION_DEFINE(snic_tcp_gro);
+
 __HOT_CODE static inline void snic_tcp_gro(uint16_t snic_id,
 			struct fdma_queueing_destination_params *enqueue_params)
 {
 	uint64_t tcp_gro_ctx = snic_params[snic_id].tcp_gro_ctx;
 	struct tcp_gro_context_params *params = &snic_tcp_gro_param[snic_id];
+	int status;
 
-	int status = tcp_gro_aggregate_seg(tcp_gro_ctx, params,
-					   TCP_GRO_CALCULATE_TCP_CHECKSUM |
-					   TCP_GRO_CALCULATE_IP_CHECKSUM |
-					   TCP_GRO_USE_HWC_SPID);
+	PROF_REGION_START(snic_tcp_gro);
+	status = tcp_gro_aggregate_seg(tcp_gro_ctx, params,
+				       TCP_GRO_CALCULATE_TCP_CHECKSUM |
+				       TCP_GRO_CALCULATE_IP_CHECKSUM |
+				       TCP_GRO_USE_HWC_SPID);
+	PROF_REGION_STOP(snic_tcp_gro);
 	if (status < 0) {
 		fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
 		fdma_terminate_task();
@@ -254,6 +260,7 @@ __HOT_CODE ENTRY_POINT void snic_process_packet(void)
 	struct scope_status_params scope_status;
 #endif
 
+	ACCT_TASK_START(ACCT_EP_SNIC);
 	/* get sNIC ID */
 	snic_id = SNIC_ID_GET;
 	ASSERT_COND(snic_id < MAX_SNIC_NO);
@@ -65,6 +65,8 @@
 
 #include "fsl_gso.h"
 #include "fsl_gro.h"
+#include "fsl_prof.h"
+#include "fsl_fd_batch.h"
 
 
 #define SNIC_CMD_READ(_param, _offset, _width, _type, _arg) \
@@ -182,56 +184,132 @@ static void snic_reset_tcp_gro_ctx(uint16_t id)
 		   sizeof(struct tcp_gro_stats_cntrs));
 }
 
+PROF_REGION_DEFINE(snic_tcp_gro);
+
 __HOT_CODE static inline void snic_tcp_gro(uint16_t snic_id,
 			struct fdma_queueing_destination_params *enqueue_params)
 {
 	uint64_t tcp_gro_ctx = snic_params[snic_id].tcp_gro_ctx;
 	struct tcp_gro_context_params *params = &snic_tcp_gro_param[snic_id];
-
-	int status = tcp_gro_aggregate_seg(tcp_gro_ctx, params,
-					   TCP_GRO_CALCULATE_TCP_CHECKSUM |
-					   TCP_GRO_CALCULATE_IP_CHECKSUM |
-					   TCP_GRO_USE_HWC_SPID);
+	struct fd_batch batch;
+	int status, flush;
+
+	PROF_REGION_START(snic_tcp_gro);
+	status = tcp_gro_aggregate_seg(tcp_gro_ctx, params,
+				       TCP_GRO_CALCULATE_TCP_CHECKSUM |
+				       TCP_GRO_CALCULATE_IP_CHECKSUM |
+				       TCP_GRO_USE_HWC_SPID);
+	PROF_REGION_STOP(snic_tcp_gro);
 	if (status < 0) {
 		fdma_discard_default_frame(FDMA_DIS_FRAME_TC_BIT);
 		fdma_terminate_task();
 	}
 
 	snic_set_enqueue_param(snic_id, enqueue_params);
+	/* The task ends with the enqueue of its last frame */
+	fd_batch_init(&batch, FD_BATCH_TERMINATE);
+	flush = ((status & TCP_GRO_FLUSH_REQUIRED) == TCP_GRO_FLUSH_REQUIRED);
 	if (((status & TCP_GRO_SEG_AGG_DONE) == TCP_GRO_SEG_AGG_DONE) ||
 	    ((status & TCP_GRO_SEG_AGG_DONE_AGG_OPEN) == TCP_GRO_SEG_AGG_DONE_AGG_OPEN))
-		snic_send(enqueue_params, FDMA_DIS_NO_FLAGS);
+		fd_batch_send_default_frame(&batch, enqueue_params,
+					    flush ? FD_BATCH_NO_FLAGS :
+					    FD_BATCH_LAST);
 
-	if ((status & TCP_GRO_FLUSH_REQUIRED) == TCP_GRO_FLUSH_REQUIRED) {
+	if (flush) {
 		status = tcp_gro_flush_aggregation(tcp_gro_ctx);
 		if (status == TCP_GRO_FLUSH_AGG_DONE)
-			snic_send(enqueue_params, FDMA_DIS_NO_FLAGS);
+			fd_batch_send_default_frame(&batch, enqueue_params,
+						    FD_BATCH_LAST);
 	}
 
-	fdma_terminate_task();
+	fd_batch_flush(&batch, FD_BATCH_LAST);
 }
 
 __HOT_CODE static inline void snic_tcp_gso(uint16_t snic_id,
 			struct fdma_queueing_destination_params *enqueue_params)
 {
-#define TCP_MSS 1220
 	uint32_t total_length = (LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
 	tcp_gso_ctx_t tcp_gso_ctx;
+	struct fd_batch batch;
 	int status;
 	int err;
 
-	if (total_length <= TCP_MSS)
+	if (total_length <= SNIC_TCP_MSS)
 		return;
 
 	snic_set_enqueue_param(snic_id, enqueue_params);
-	tcp_gso_context_init(0, TCP_MSS, tcp_gso_ctx);
+	tcp_gso_context_init(0, SNIC_TCP_MSS, tcp_gso_ctx);
+	/* The task ends with the enqueue of the last segment */
+	fd_batch_init(&batch, FD_BATCH_TERMINATE);
 
 	do {
 		status = tcp_gso_generate_seg(tcp_gso_ctx);
 		if (status == TCP_GSO_GEN_SEG_STATUS_SYN_RST_SET)
 			return;
 
-		err = snic_send(enqueue_params, FDMA_DIS_NO_FLAGS);
+		err = fd_batch_send_default_frame(&batch, enqueue_params,
+				(status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS) ?
+				FD_BATCH_NO_FLAGS : FD_BATCH_LAST);
+		if (err)
+		{
+			tcp_gso_discard_frame_remainder(tcp_gso_ctx);
+			break;
+		}
+	} while (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS);
+
+	fd_batch_flush(&batch, FD_BATCH_LAST);
+}
+
+#ifdef ENABLE_SNIC_IPSEC
+/* Segments a super-frame to the MSS left by the ESP overhead of the SA and
+ * encrypts each segment (and adds the VLAN) before sending it. The lifetime
+ * counters of the SA are updated once, after the last segment. */
+__HOT_CODE static inline void snic_tcp_gso_ipsec(uint16_t snic_id,
+			ipsec_handle_t ipsec_handle,
+			struct fdma_queueing_destination_params *enqueue_params)
+{
+	uint32_t total_length = (LDPAA_FD_GET_LENGTH(HWC_FD_ADDRESS));
+	tcp_gso_ctx_t tcp_gso_ctx;
+	struct ipsec_burst burst;
+	struct fd_batch batch;
+	uint32_t enc_status;
+	uint16_t overhead;
+	int status;
+	int err;
+
+	if (ipsec_get_encap_overhead(ipsec_handle, &overhead) ||
+	    (total_length + overhead) <= SNIC_TCP_MSS)
+		return;
+
+	snic_set_enqueue_param(snic_id, enqueue_params);
+	tcp_gso_context_init(0, (uint16_t)(SNIC_TCP_MSS - overhead),
+			     tcp_gso_ctx);
+
+	burst.ipsec_handle = ipsec_handle;
+	burst.packets = 0;
+	burst.bytes = 0;
+	/* The lifetime counters are updated after the last segment, the task
+	 * is not terminated by the batch */
+	fd_batch_init(&batch, FD_BATCH_NO_FLAGS);
+
+	do {
+		status = tcp_gso_generate_seg(tcp_gso_ctx);
+		if (status == TCP_GSO_GEN_SEG_STATUS_SYN_RST_SET)
+			break;
+
+		err = ipsec_frame_encrypt_burst(&burst, &enc_status);
+		if (err) {
+			fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
+		} else {
+#ifdef ENABLE_SNIC_VLAN
+			if (snic_params[snic_id].snic_enable_flags &
+			    SNIC_VLAN_ADD_EN)
+				snic_add_vlan();
+#endif
+			err = fd_batch_send_default_frame(&batch,
+							  enqueue_params,
+							  FD_BATCH_NO_FLAGS);
+		}
 		if (err)
 		{
 			if (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS)
@@ -240,10 +318,15 @@ __HOT_CODE static inline void snic_tcp_gso(uint16_t snic_id,
 		}
 	} while (status == TCP_GSO_GEN_SEG_STATUS_IN_PROCESS);
 
+	ipsec_burst_done(&burst);
+
+	/* The SYN/RST segment is encrypted and sent as a frame */
+	if (status == TCP_GSO_GEN_SEG_STATUS_SYN_RST_SET)
+		return;
+
 	fdma_terminate_task();
-	return;
-#undef TCP_MSS
 }
+#endif	/* ENABLE_SNIC_IPSEC */
 
 __HOT_CODE ENTRY_POINT void snic_process_packet(void)
 {
@@ -251,16 +334,29 @@ __HOT_CODE ENTRY_POINT void snic_process_packet(void)
 	struct fdma_queueing_destination_params enqueue_params;
 	int32_t parse_status;
 	uint16_t snic_id;
+#if defined(ENABLE_SNIC_IPSEC) || defined(ENABLE_SNIC_VLAN) || \
+	defined(ENABLE_SNIC_IPF) || defined(ENABLE_SNIC_IPR)
+	struct snic_params *snic;
+#endif
 #if defined(ENABLE_SNIC_IPSEC) || defined(ENABLE_SNIC_VLAN)
 	uint16_t asa_length;
 #endif
+#ifdef ENABLE_SNIC_IPSEC
+	ipsec_handle_t ipsec_handle;
+	int sa_found;
+#endif
 #ifdef ENABLE_SNIC_OSM
 	struct scope_status_params scope_status;
 #endif
 
+	ACCT_TASK_START(ACCT_EP_SNIC);
 	/* get sNIC ID */
 	snic_id = SNIC_ID_GET;
 	ASSERT_COND(snic_id < MAX_SNIC_NO);
+#if defined(ENABLE_SNIC_IPSEC) || defined(ENABLE_SNIC_VLAN) || \
+	defined(ENABLE_SNIC_IPF) || defined(ENABLE_SNIC_IPR)
+	snic = &snic_params[snic_id];
+#endif
 
 	pr = (struct parse_result *)HWC_PARSE_RES_ADDRESS;
 
@@ -313,8 +409,6 @@ __HOT_CODE ENTRY_POINT void snic_process_packet(void)
 				(HWC_ADC_ADDRESS +
 				ADC_WQID_PRI_OFFSET)) & ADC_WQID_MASK) >> 4);
 
-		snic_tcp_gso(snic_id, &enqueue_params);
-
 #if defined(ENABLE_SNIC_IPSEC) || defined(ENABLE_SNIC_VLAN)
 		/* epid defaults is not present ASA */
 		if ((snic->snic_enable_flags & SNIC_VLAN_ADD_EN) ||
@@ -326,9 +420,20 @@ __HOT_CODE ENTRY_POINT void snic_process_packet(void)
 #endif
 
 #ifdef ENABLE_SNIC_IPSEC
-		/* Check if ipsec transport mode is required */
-		if (snic->snic_enable_flags & SNIC_IPSEC_EN)
-			snic_ipsec_encrypt(snic);
+		/* Check if ipsec transport mode is required. A super-frame is
+		 * segmented and its segments are encrypted and sent. */
+		sa_found = (snic->snic_enable_flags & SNIC_IPSEC_EN) &&
+			!snic_ipsec_sa_lookup(snic, &ipsec_handle);
+		if (sa_found)
+			snic_tcp_gso_ipsec(snic_id, ipsec_handle,
+					   &enqueue_params);
+		else
+#endif
+			snic_tcp_gso(snic_id, &enqueue_params);
+
+#ifdef ENABLE_SNIC_IPSEC
+		if (sa_found)
+			snic_ipsec_encrypt(ipsec_handle);
 #endif
 
 #ifdef ENABLE_SNIC_VLAN
@@ -374,7 +479,7 @@ int snic_ipf(struct snic_params *snic)
 	int32_t ipf_status;
 	int err;
 	struct fdma_queueing_destination_params enqueue_params;
-	struct scope_status_params scope_status;
+	struct fd_batch batch;
 
 	ip_offset = PARSER_GET_OUTER_IP_OFFSET_DEFAULT();
 	ipv4_hdr = (struct ipv4hdr *)
@@ -400,6 +505,9 @@ int snic_ipf(struct snic_params *snic)
 		enqueue_params.qd_priority = default_task_params.qd_priority;
 		ipf_context_init(0, snic->snic_ipf_mtu,
 				ipf_context_addr);
+		/* transition to exclusive just before last fragment enqueue,
+		 * the task ends with it */
+		fd_batch_init(&batch, FD_BATCH_TERMINATE | FD_BATCH_EXCLUSIVE);
 
 		do {
 			/* todo: error cases when IPF FM will support fdma errors*/
@@ -410,37 +518,19 @@ int snic_ipf(struct snic_params *snic)
 				fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
 				break;
 			}
-			/* transition to exclusive just before last fragment enqueue */
-			if (ipf_status == IPF_GEN_FRAG_STATUS_DONE)
-			{
-				/* Get OSM status (ordering scope mode and levels) */
-				osm_get_scope(&scope_status);
-
-				if (scope_status.scope_mode == CONCURRENT) 
-				{
-					/* change to exclusive ordering mode */
-					osm_scope_transition_to_exclusive_with_increment_scope_id();
-				}
-			}
-			err = fdma_store_and_enqueue_default_frame_qd(&enqueue_params,
-					FDMA_ENWF_NO_FLAGS);
+			err = fd_batch_send_default_frame(&batch, &enqueue_params,
+				(ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS) ?
+				FD_BATCH_NO_FLAGS : FD_BATCH_LAST);
 			if (err)
 			{
 				pr_err("HF-NIC[%d]: IPF - fdma store and enqueue error: 0x%x\n", SNIC_ID_GET, err);
-				if (err == -ENOMEM)
-					fdma_discard_default_frame(FDMA_DIS_NO_FLAGS);
-				else /* (err == -EBUSY) */
-					fdma_discard_fd(
-					      (struct ldpaa_fd *)HWC_FD_ADDRESS,
-					      0, FDMA_DIS_AS_BIT);
-				if (ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS)
-					ipf_discard_frame_remainder(ipf_context_addr);
+				ipf_discard_frame_remainder(ipf_context_addr);
 				break;
 			}
 			
 		} while (ipf_status == IPF_GEN_FRAG_STATUS_IN_PROCESS);
 
-		fdma_terminate_task();
+		fd_batch_flush(&batch, FD_BATCH_LAST);
 		return 0;
 	}
 	else
@@ -523,14 +613,13 @@ int snic_ipsec_decrypt(struct snic_params *snic)
 	return 0;
 }
 
-int snic_ipsec_encrypt(struct snic_params *snic)
+int snic_ipsec_sa_lookup(struct snic_params *snic,
+			 ipsec_handle_t *ipsec_handle)
 {
 	uint8_t sa_id;
 	uint32_t asa_seg_addr;	/* ASA Segment Address */
 	int sr_status;
 	struct table_lookup_result lookup_result __attribute__((aligned(16)));
-	ipsec_handle_t ipsec_handle;
-	uint32_t enc_status;
 	union table_lookup_key_desc key_desc  __attribute__((aligned(16)));
 
 	/* Get ASA pointer */
@@ -544,15 +633,20 @@ int snic_ipsec_encrypt(struct snic_params *snic)
 				        1,
 				        &lookup_result);
 
-	if (sr_status == TABLE_STATUS_SUCCESS) 
-	{
-		/* Hit */
-		ipsec_handle = lookup_result.data0;
-		ipsec_frame_encrypt(ipsec_handle,
-				&enc_status);
-		/*todo what happens in case encrypt is not successful*/
-	}
-	
+	if (sr_status != TABLE_STATUS_SUCCESS)
+		return -ENOENT;
+
+	/* Hit */
+	*ipsec_handle = lookup_result.data0;
+	return 0;
+}
+
+int snic_ipsec_encrypt(ipsec_handle_t ipsec_handle)
+{
+	uint32_t enc_status;
+
+	ipsec_frame_encrypt(ipsec_handle, &enc_status);
+	/*todo what happens in case encrypt is not successful*/
 	return 0;
 }
 #endif	/* ENABLE_SNIC_IPSEC */
@@ -78,6 +78,8 @@
 #define MAX_OPEN_IPR_FRAMES     100
 /* Maximum number of IPsec SAs per nic */
 #define MAX_SA_NO               100
+/* TCP MSS of the egress segmentation (GSO), without IPsec overhead */
+#define SNIC_TCP_MSS            1220
 
 /* ipsec_flags */
 #define SNIC_IPSEC_IPV4_ENABLE  0x01
@@ -172,7 +174,9 @@ int snic_create_table_key_id(uint8_t fec_no, uint8_t fec_array[8],
 				uint8_t *key_id,
 				uint16_t *table_id);
 int snic_ipsec_decrypt(struct snic_params *snic);
-int snic_ipsec_encrypt(struct snic_params *snic);
+int snic_ipsec_sa_lookup(struct snic_params *snic,
+			 ipsec_handle_t *ipsec_handle);
+int snic_ipsec_encrypt(ipsec_handle_t ipsec_handle);
 int snic_ipsec_create_instance(struct snic_cmd_data *cmd_data);
 int snic_ipsec_add_sa(struct snic_cmd_data *cmd_data);
 int snic_ipsec_del_sa(struct snic_cmd_data *cmd_data);
@@ -456,4 +456,8 @@ void cdma_refcount_get(
 /** @} */ /* end of ACCEL */
 
 
+#define __FSL_CDMA_H_DONE
+/* Allocation profiling wrappers (ENABLE_ALLOC_PROFILING) */
+#include "fsl_sl_alloc_prof.h"
+
 #endif /* __FSL_CDMA_H */
@@ -518,4 +518,8 @@ uint32_t cdma_get_cache_attributes(void);
 /** @} */ /* end of ACCEL */
 
 
+#define __FSL_CDMA_H_DONE
+/* Allocation profiling wrappers (ENABLE_ALLOC_PROFILING) */
+#include "fsl_sl_alloc_prof.h"
+
 #endif /* __FSL_CDMA_H */
@@ -575,9 +575,15 @@ int keygen_kcr_builder_add_valid_field_fec(uint8_t mask,
 
 @Description	Creates key composition rule. Up to 256 rules are supported.
 
+		The KCR is either built in the workspace with the
+		keygen_kcr_builder() function family or precompiled on the host
+		(misc/tools/kcr_compiler) and placed in constant data. A KCR
+		located outside the workspace is copied to the workspace.
+
 @Param[in]	acc_id - Accelerator ID.
 @Param[in]	kcr - Key composition rule. Must be aligned to 16B boundary.
-		(part of struct kcr_builder (located in the workspace)).
+		(part of struct kcr_builder (located in the workspace) or a
+		precompiled struct kcr_builder).
 @Param[out]	keyid - Key ID (located in the workspace).
 
 @Return		0 on Success, or negative value on error.
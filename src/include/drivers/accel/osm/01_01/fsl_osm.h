@@ -470,9 +470,56 @@ inline void osm_get_scope(struct scope_status_params *scope_status);
 void dump_osm_regs(void);
 #endif	/* SL_DEBUG */
 
+#ifndef LS2085A_REV1
+/*************************************************************************//**
+@Function	osm_prof_reset
+
+@Description	Clear the OSM contention counters of all the cores.
+
+		When ENABLE_OSM_PROFILING is defined in build_flags.h, every
+		OSM function call above is wrapped to sample the core time
+		base, per call site (file and line):
+		- the time waited for exclusivity by the calls which acquire
+		it,
+		- the time the task held exclusivity, from the call which
+		acquired it to the call which left the last exclusive scope
+		(transition to concurrent, relinquish, scope exit or enter
+		relinquishing the parent) or to the task termination.
+		The times are also summed per scope ID class: scope level and
+		scope ID source (incremented or given by the caller).
+
+@Return		None.
+
+@Cautions	Counters updated by tasks running concurrently may be lost.
+*//***************************************************************************/
+void osm_prof_reset(void);
+
+/*************************************************************************//**
+@Function	osm_prof_print
+
+@Description	Print the OSM contention counters, summed over all the cores,
+		to the AIOP console and log: the wait and hold times per scope
+		ID class, then the call sites acquiring the longest exclusive
+		sections, each with the call site which ended its longest
+		section. Exclusivity should be relinquished earlier there.
+
+@Return		None.
+*//***************************************************************************/
+void osm_prof_print(void);
+#endif /* LS2085A_REV1 */
+
 /** @} end of group OSM_Functions */
 /** @} */ /* end of FSL_AIOP_OSM */
 /** @} */ /* end of ACCEL */
 
+#if defined(ENABLE_OSM_PROFILING) && defined(LS2085A_REV1)
+#error "ENABLE_OSM_PROFILING is not supported on LS2085A"
+#endif
+#define __FSL_LIB_OSM_H_DONE
+#if defined(ENABLE_OSM_PROFILING) && defined(__OSM_INLINE_H_DONE)
+/* Wrap the OSM functions once they are declared and defined */
+#include "osm_prof_wrap.h"
+#endif
+
 
 #endif /* __FSL_LIB_OSM_H */
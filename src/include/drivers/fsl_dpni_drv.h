@@ -1070,6 +1070,201 @@ inline int dpni_drv_send(uint16_t ni_id, uint32_t flags);
 *//***************************************************************************/
 int dpni_drv_explicit_send(uint16_t ni_id, struct ldpaa_fd *fd);
 
+#ifndef LS2085A_REV1
+/**************************************************************************//**
+@Group		DPNI_DRV_MULTI_SEND Multi-destination send
+
+@Description	Send the default Working Frame to a set of Network Interfaces,
+		given as a list of NI IDs or as a multicast group.
+
+		Each copy is made by the FDMA (fdma_replicate_frame_qd()) and
+		enqueued by the same command; the cores do not touch the
+		payload. The default Working Frame itself is sent to the last
+		destination, so sending to N NIs costs N-1 replications.
+		DPAA2 buffers are not reference counted, so the copies do not
+		share buffers with the original frame.
+
+		Multicast groups are created and updated by the AIOP
+		application or by the GPP through the
+		\ref DPNI_DRV_MCAST_MODULE_NAME cmdif module. Each group has
+		frames/copies/drops counters updated by the STE.
+
+@{
+*//***************************************************************************/
+/** Maximum number of destinations of a multi-destination send and of a
+ * multicast group */
+#define DPNI_DRV_MAX_MULTI_DEST		8
+/** Number of multicast groups */
+#define DPNI_DRV_MCAST_MAX_GROUPS	32
+/** Name of the cmdif module managing the multicast groups */
+#define DPNI_DRV_MCAST_MODULE_NAME	"NI_MCAST"
+
+/**************************************************************************//**
+@Description	Per destination callback of a multi-destination send.
+
+		Called with the default segment presented, before the copy for
+		ni_id is made. It may rewrite the frame headers (e.g. the
+		destination MAC address or VLAN) using the hm_* functions or
+		fdma_modify_default_segment_data(), so that the FDMA replicates
+		the updated frame. The payload should not be modified.
+
+@Param[in]	ni_id - Destination Network Interface ID.
+@Param[in]	index - Index of the destination in the destination set.
+@Param[in]	arg - User argument given to the send function.
+
+*//***************************************************************************/
+typedef void (dpni_drv_multi_cb)(uint16_t ni_id, uint8_t index, void *arg);
+
+/**************************************************************************//**
+@Description	Counters of a multicast group.
+
+*//***************************************************************************/
+struct dpni_drv_mcast_counters {
+	/** Frames sent on the group */
+	uint64_t frames;
+	/** Frames enqueued on the group NIs (copies and original frames) */
+	uint64_t copies;
+	/** Copies and original frames that failed to be enqueued */
+	uint64_t drops;
+};
+
+/**************************************************************************//**
+@Function	dpni_drv_send_multi
+
+@Description	Send the default Working Frame to several Network Interfaces.
+
+		A copy of the frame is replicated and enqueued for each NI
+		except the last one, which gets the default Working Frame.
+		Copies that fail to be replicated or enqueued are discarded.
+
+@Param[in]	ni_ids - Destination Network Interface IDs.
+@Param[in]	num_nis - Number of destinations, 1 to
+		\ref DPNI_DRV_MAX_MULTI_DEST.
+@Param[in]	flags - Flags for the enqueue of the default Working Frame,
+		see DPNI_DRV_SEND_MODE. With an ordering attribute, the task
+		moves to exclusive mode before the first copy, so the copies
+		are ordered too.
+	Implicit: Queuing Destination Priority (qd_priority) in the TLS.
+@Param[in]	cb - Per destination callback, NULL if the frame is sent
+		unchanged.
+@Param[in]	arg - Argument of the callback.
+
+@Return		Status of the default Working Frame send, as returned by
+		dpni_drv_send().
+@Retval		EINVAL - Invalid number of destinations. Nothing was sent.
+
+@Cautions	The frame to be enqueued must be open (presented) when calling
+		this function.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int dpni_drv_send_multi(const uint16_t *ni_ids, uint8_t num_nis,
+			uint32_t flags, dpni_drv_multi_cb *cb, void *arg);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_group_create
+
+@Description	Create an empty multicast group and clear its counters.
+
+@Param[out]	group_id - ID of the new group.
+
+@Return		0 on success, -ENOSPC if all groups are in use.
+*//***************************************************************************/
+int dpni_drv_mcast_group_create(uint16_t *group_id);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_group_delete
+
+@Description	Delete a multicast group.
+
+@Param[in]	group_id - Group ID.
+
+@Return		0 on success, -EINVAL if the group does not exist.
+*//***************************************************************************/
+int dpni_drv_mcast_group_delete(uint16_t group_id);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_group_add_ni
+
+@Description	Add a Network Interface to a multicast group.
+
+@Param[in]	group_id - Group ID.
+@Param[in]	ni_id - Network Interface ID.
+
+@Return		0 on success, -EINVAL for an invalid group or NI, -EEXIST if
+		the NI is already a member, -ENOSPC if the group has
+		\ref DPNI_DRV_MAX_MULTI_DEST members.
+*//***************************************************************************/
+int dpni_drv_mcast_group_add_ni(uint16_t group_id, uint16_t ni_id);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_group_remove_ni
+
+@Description	Remove a Network Interface from a multicast group.
+
+@Param[in]	group_id - Group ID.
+@Param[in]	ni_id - Network Interface ID.
+
+@Return		0 on success, -EINVAL for an invalid group, -ENAVAIL if the
+		NI is not a member.
+*//***************************************************************************/
+int dpni_drv_mcast_group_remove_ni(uint16_t group_id, uint16_t ni_id);
+
+/**************************************************************************//**
+@Function	dpni_drv_send_mcast_group
+
+@Description	Send the default Working Frame to the members of a multicast
+		group. See dpni_drv_send_multi(). The group counters are
+		updated.
+
+@Param[in]	group_id - Group ID.
+@Param[in]	flags - See dpni_drv_send_multi().
+@Param[in]	cb - See dpni_drv_send_multi().
+@Param[in]	arg - See dpni_drv_send_multi().
+
+@Return		Status of the default Working Frame send, as returned by
+		dpni_drv_send().
+@Retval		EINVAL - Invalid group. Nothing was sent.
+@Retval		ENAVAIL - The group has no member. Nothing was sent.
+
+@Cautions	The frame to be enqueued must be open (presented) when calling
+		this function.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int dpni_drv_send_mcast_group(uint16_t group_id, uint32_t flags,
+			      dpni_drv_multi_cb *cb, void *arg);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_group_get_counters
+
+@Description	Read the counters of a multicast group.
+
+@Param[in]	group_id - Group ID.
+@Param[out]	counters - Group counters.
+@Param[in]	reset - Clear the counters after reading them.
+
+@Return		0 on success, -EINVAL if the group does not exist.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int dpni_drv_mcast_group_get_counters(uint16_t group_id,
+				      struct dpni_drv_mcast_counters *counters,
+				      int reset);
+
+/**************************************************************************//**
+@Function	dpni_drv_mcast_register_cmdif
+
+@Description	Register the \ref DPNI_DRV_MCAST_MODULE_NAME cmdif module, so
+		that the GPP can manage the multicast groups. The commands are
+		defined in fsl_dpni_drv_mcast_cmd.h.
+
+		Must be called from the application initialization.
+
+@Return		0 on success, error code of cmdif_register_module() otherwise.
+*//***************************************************************************/
+int dpni_drv_mcast_register_cmdif(void);
+
+/** @} end of group DPNI_DRV_MULTI_SEND */
+#endif /* LS2085A_REV1 */
+
 /**************************************************************************//**
 @Function	dpni_drv_set_multicast_promisc
 
@@ -1701,6 +1896,127 @@ int dpni_drv_set_initial_presentation_etype(
 	const struct ep_init_presentation * const init_presentation,
 	uint16_t etype);
 
+/**************************************************************************//**
+@Group		DPNI_DRV_PRES_TUNING Adaptive initial presentation
+
+@Description	Tune the presented segment size (SPS) of a Network Interface
+		entry point to the depth of the headers actually received.
+
+		When enabled, sl_prolog() samples one of 2^sample_shift frames
+		of each core and records, per NI, the frame offset where the
+		parser stopped (end of the outer or inner L4 header for
+		tunneled traffic, see PARSER_GET_NEXT_HEADER_OFFSET_DEFAULT()).
+		After 'window' samples the smallest SPS covering 'percentile'
+		percent of the sampled frames, plus 'margin' bytes, is computed
+		and written to the EPID table if it changed. Frames already
+		dispatched keep their presentation.
+
+		A too small SPS shows in the extend_needed counter: sampled
+		frames whose parsed headers did not fit in the presented
+		segment, for which the application calls
+		fdma_extend_default_segment_presentation().
+
+		Only the entry point of the NI is reprogrammed. Frames of the
+		entry points of dpni_drv_enable_etype_fs() are sampled with the
+		other frames of the NI.
+
+@{
+*//***************************************************************************/
+/** Histogram granularity of the parse depth and of the tuned SPS, in bytes */
+#define DPNI_DRV_PRES_TUNING_STEP	16
+
+/**************************************************************************//**
+@Description	Presentation tuning configuration.
+
+*//***************************************************************************/
+struct dpni_drv_pres_tuning_cfg {
+	/** Number of samples between two decisions */
+	uint32_t window;
+	/** Smallest SPS to configure */
+	uint16_t min_sps;
+	/** Largest SPS to configure. The segment must fit in the presentation
+	 * area, see dpni_drv_set_initial_presentation(). 0 - the SPS
+	 * configured when tuning is enabled. */
+	uint16_t max_sps;
+	/** Bytes presented beyond the parsed headers (e.g. for L5 headers
+	 * read by the application) */
+	uint16_t margin;
+	/** Percentage of the sampled frames whose headers must be presented,
+	 * 1 to 100 */
+	uint8_t percentile;
+	/** One frame of 2^sample_shift is sampled on each core, 0 to 15 */
+	uint8_t sample_shift;
+};
+
+/**************************************************************************//**
+@Description	Presentation tuning statistics.
+
+*//***************************************************************************/
+struct dpni_drv_pres_tuning_stats {
+	/** Sampled frames */
+	uint64_t samples;
+	/** Sampled frames whose parsed headers did not fit in the presented
+	 * segment */
+	uint64_t extend_needed;
+	/** SPS decisions (completed windows) */
+	uint32_t decisions;
+	/** Decisions that changed the SPS in the EPID table */
+	uint32_t updates;
+	/** SPS currently configured by the tuning */
+	uint16_t sps;
+};
+
+/**************************************************************************//**
+@Function	dpni_drv_enable_presentation_tuning
+
+@Description	Start tuning the presented segment size of a Network
+		Interface. The statistics are cleared.
+
+@Param[in]	ni_id - The AIOP Network Interface ID.
+@Param[in]	cfg - Tuning configuration.
+
+@Return		0 on success.
+@Retval		EINVAL - Invalid NI or configuration.
+@Retval		ENOTSUP - The entry point presents no data segment or
+		presents it from the end of the frame.
+@Retval		ENOMEM - No memory for the tuning state.
+
+@Cautions	The SPS is changed at run time; the application must not
+		assume a fixed segment length (see PRC_GET_SEGMENT_LENGTH()).
+*//***************************************************************************/
+int dpni_drv_enable_presentation_tuning(
+	uint16_t ni_id,
+	const struct dpni_drv_pres_tuning_cfg *cfg);
+
+/**************************************************************************//**
+@Function	dpni_drv_disable_presentation_tuning
+
+@Description	Stop tuning the presented segment size of a Network Interface
+		and restore the SPS configured when tuning was enabled.
+
+@Param[in]	ni_id - The AIOP Network Interface ID.
+
+@Return		0 on success, -EINVAL if tuning is not enabled on the NI.
+*//***************************************************************************/
+int dpni_drv_disable_presentation_tuning(uint16_t ni_id);
+
+/**************************************************************************//**
+@Function	dpni_drv_get_presentation_tuning_stats
+
+@Description	Read the presentation tuning statistics of a Network
+		Interface. The statistics are kept when tuning is disabled.
+
+@Param[in]	ni_id - The AIOP Network Interface ID.
+@Param[out]	stats - Statistics.
+
+@Return		0 on success, -EINVAL if tuning was never enabled on the NI.
+*//***************************************************************************/
+int dpni_drv_get_presentation_tuning_stats(
+	uint16_t ni_id,
+	struct dpni_drv_pres_tuning_stats *stats);
+
+/** @} end of group DPNI_DRV_PRES_TUNING */
+
 /**************************************************************************//**
 @Function	dpni_drv_set_tx_checksum
 
@@ -0,0 +1,382 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fsl_aqm.h
+
+@Description	This file contains the AIOP SW CoDel/PIE active queue
+		management API
+
+*//***************************************************************************/
+
+#ifndef __FSL_AQM_H
+#define __FSL_AQM_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		NETF NETF (Network Libraries)
+
+ @Description	AIOP Accelerator APIs
+
+ @{
+*//***************************************************************************/
+/**************************************************************************//**
+@Group		FSL_AQM AQM
+
+@Description	AIOP software active queue management on the egress traffic
+		classes of a Network Interface: CoDel (RFC 8289) and PIE
+		(RFC 8033).
+
+		The Tx queues of a DPNI are not visible to the AIOP, so the
+		queueing delay of a frame is estimated when it is sent:
+		- the time spent in the AIOP, from an ingress timestamp stored
+		in the frame pass-through annotation (aqm_stamp_frame()) or
+		kept by the application,
+		- plus the time needed to drain the bytes sent before it on
+		the traffic class, modeled as a queue drained at the traffic
+		class rate.
+
+		With #AQM_FLG_CONG_NOTIF the queue model is kept within the
+		DPNI congestion notification thresholds (see
+		dpni_drv_set_congestion_notification()): the application
+		reports the congestion state changes with
+		aqm_set_congestion_state().
+
+		The drop (or ECN mark) decision is taken before the frame is
+		enqueued. The state of each instance (one per NI and traffic
+		class) is kept in Shared RAM.
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group	AQM_MACROS AQM Macros
+
+@Description	AQM Macros
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	AQM instance handle Type definition
+
+ *//***************************************************************************/
+typedef uint8_t aqm_handle_t;
+
+	/** Maximum number of AQM instances */
+#define AQM_MAX_INSTANCES		32
+	/** Maximum drain rate (bytes/second, 200 Gbps) */
+#define AQM_MAX_RATE			25000000000ULL
+
+#ifndef AQM_PTA_TS_OFFSET
+	/** Offset of the ingress timestamp (8 bytes) in the first 32 bytes
+	 * (PTV1) of the frame PTA */
+#define AQM_PTA_TS_OFFSET		0
+#endif
+
+	/** Default CoDel target delay (microseconds) */
+#define AQM_CODEL_DEFAULT_TARGET	5000
+	/** Default CoDel interval (microseconds) */
+#define AQM_CODEL_DEFAULT_INTERVAL	100000
+	/** Default PIE target delay (microseconds) */
+#define AQM_PIE_DEFAULT_TARGET		15000
+	/** Default PIE drop probability update period (microseconds) */
+#define AQM_PIE_DEFAULT_TUPDATE		15000
+	/** Default PIE maximum burst allowance (microseconds) */
+#define AQM_PIE_DEFAULT_MAX_BURST	150000
+	/** Default PIE alpha (1/256 Hz units: 0.125 Hz) */
+#define AQM_PIE_DEFAULT_ALPHA		32
+	/** Default PIE beta (1/256 Hz units: 1.25 Hz) */
+#define AQM_PIE_DEFAULT_BETA		320
+
+/** @} */ /* end of group AQM_MACROS */
+
+/**************************************************************************//**
+@Group		AQM_STRUCTS AQM Data Structures
+
+@Description	AIOP AQM Data Structures
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	AQM algorithms
+*//***************************************************************************/
+enum aqm_algorithm {
+	/** Controlled Delay (RFC 8289) */
+	AQM_CODEL = 0,
+	/** Proportional Integral controller Enhanced (RFC 8033) */
+	AQM_PIE
+};
+
+/**************************************************************************//**
+@Description	AQM verdicts
+*//***************************************************************************/
+enum aqm_verdict {
+	/** Send the frame */
+	AQM_PASS = 0,
+	/** Send the frame with the ECN field set to CE */
+	AQM_MARK,
+	/** Drop the frame */
+	AQM_DROP
+};
+
+/**************************************************************************//**
+@Description	AQM instance parameters
+*//***************************************************************************/
+struct aqm_params {
+	/** Algorithm */
+	enum aqm_algorithm algorithm;
+	/** \link FSL_AQMFlags AQM flags \endlink */
+	uint32_t flags;
+	/** Rate at which the traffic class is drained (bytes/second), e.g.
+	 * the shaping rate of the traffic class or the link rate */
+	uint64_t rate;
+	/** Target queueing delay (microseconds), 0 for the default */
+	uint32_t target;
+	/** CoDel interval or PIE drop probability update period
+	 * (microseconds), 0 for the default */
+	uint32_t interval;
+	/** PIE maximum burst allowance (microseconds), 0 for the default */
+	uint32_t max_burst;
+	/** PIE alpha (1/256 Hz units), 0 for the default */
+	uint16_t alpha;
+	/** PIE beta (1/256 Hz units), 0 for the default */
+	uint16_t beta;
+	/** Frames finding more than this number of bytes in the queue model
+	 * are dropped; 0 for no limit */
+	uint32_t limit;
+};
+
+/**************************************************************************//**
+@Description	AQM statistics
+*//***************************************************************************/
+struct aqm_stats {
+	/** Frames accepted by the AQM */
+	uint64_t passed;
+	/** Frames accepted with the ECN field set to CE */
+	uint64_t marked;
+	/** Frames dropped */
+	uint64_t dropped;
+	/** Last queueing delay estimate (microseconds) */
+	uint32_t delay;
+	/** Bytes in the queue model */
+	uint32_t backlog;
+	/** PIE drop probability (1/2^32 units) */
+	uint32_t drop_prob;
+};
+
+/** @} */ /* end of group AQM_STRUCTS */
+
+/**************************************************************************//**
+@Group		FSL_AQM_Modes_And_Flags AQM Modes And Flags
+
+@Description	AQM Modes And Flags
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		FSL_AQMFlags AQM Flags
+
+@Description	AQM instance flags
+
+@{
+*//***************************************************************************/
+
+	/** Set the ECN field of ECN capable (ECT) IP frames to CE instead
+	 * of dropping them */
+#define AQM_FLG_ECN			0x00000001
+	/** Keep the queue model within the Tx congestion notification
+	 * thresholds of the traffic class */
+#define AQM_FLG_CONG_NOTIF		0x00000002
+
+/** @} */ /* end of group FSL_AQMFlags */
+
+/**************************************************************************//**
+@Group		FSL_AQMReturnStatus AQM Return Status
+
+@Description	AQM return status
+
+@{
+*//***************************************************************************/
+
+	/** The frame was discarded by the AQM */
+#define AQM_STATUS_DROPPED		1
+
+/** @} */ /* end of group FSL_AQMReturnStatus */
+
+/** @} */ /* end of group FSL_AQM_Modes_And_Flags */
+
+/**************************************************************************//**
+@Group		FSL_AQM_Functions AQM Functions
+
+@Description	AIOP AQM Functions
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Function	aqm_create
+
+@Description	Creates an AQM instance for a traffic class of a Network
+		Interface.
+
+@Param[in]	ni_id - The Network Interface ID.
+@Param[in]	tc - The Tx traffic class.
+@Param[in]	params - The instance parameters.
+@Param[out]	aqm - The instance handle.
+
+@Return		0 on success, -EINVAL for invalid parameters (rate above
+		#AQM_MAX_RATE), -ENOSPC if
+		#AQM_MAX_INSTANCES instances exist, or the error returned by
+		dpni_drv_get_congestion_notification() (#AQM_FLG_CONG_NOTIF).
+*//***************************************************************************/
+int aqm_create(uint16_t ni_id, uint8_t tc, const struct aqm_params *params,
+	       aqm_handle_t *aqm);
+
+/**************************************************************************//**
+@Function	aqm_delete
+
+@Description	Deletes an AQM instance.
+
+@Param[in]	aqm - The instance handle.
+
+@Cautions	The instance must not be in use.
+*//***************************************************************************/
+void aqm_delete(aqm_handle_t aqm);
+
+/**************************************************************************//**
+@Function	aqm_stamp_frame
+
+@Description	Stores the current TMAN timestamp in the pass-through
+		annotation (PTA) of the default frame, at #AQM_PTA_TS_OFFSET.
+		The first 32 bytes of the PTA are added to the frame if it has
+		none.
+
+@Return		0 on success, or the fdma_replace_default_pta_segment_data()
+		error.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int aqm_stamp_frame(void);
+
+/**************************************************************************//**
+@Function	aqm_get_frame_stamp
+
+@Description	Reads the timestamp stored by aqm_stamp_frame() from the
+		PTA of the default frame.
+
+@Param[out]	ts - The ingress timestamp (microseconds).
+
+@Return		0 on success, -ENAVAIL if the frame has no PTA.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int aqm_get_frame_stamp(uint64_t *ts);
+
+/**************************************************************************//**
+@Function	aqm_set_congestion_state
+
+@Description	Reports a change of the Tx congestion state of the traffic
+		class, e.g. on a congestion state change notification.
+		Used with #AQM_FLG_CONG_NOTIF.
+
+@Param[in]	aqm - The instance handle.
+@Param[in]	congested - 1 if the traffic class entered the congestion
+		state, 0 if it exited it.
+*//***************************************************************************/
+void aqm_set_congestion_state(aqm_handle_t aqm, int congested);
+
+/**************************************************************************//**
+@Function	aqm_check
+
+@Description	Estimates the queueing delay of a frame about to be sent on
+		the traffic class and returns the AQM decision. A frame that is
+		not dropped is added to the queue model.
+
+@Param[in]	aqm - The instance handle.
+@Param[in]	ingress_ts - The ingress timestamp of the frame
+		(microseconds), 0 to count the Tx queue delay only.
+@Param[in]	length - The frame length.
+@Param[in]	ect - Non zero if the frame is ECN capable.
+
+@Return		One of \ref aqm_verdict. #AQM_MARK is returned only for
+		ECN capable frames with #AQM_FLG_ECN.
+
+@Cautions	The frame must be sent (or dropped) as decided: a frame not
+		sent after #AQM_PASS or #AQM_MARK remains in the queue model
+		until it is drained.
+*//***************************************************************************/
+enum aqm_verdict aqm_check(aqm_handle_t aqm, uint64_t ingress_ts,
+			   uint32_t length, int ect);
+
+/**************************************************************************//**
+@Function	aqm_send
+
+@Description	Applies the AQM to the default frame and sends it on the
+		traffic class of the instance with dpni_drv_send().
+
+		ECN capable IPv4/IPv6 frames are marked instead of being
+		dropped if the instance was created with #AQM_FLG_ECN.
+		An enqueue rejected by QMan (-EBUSY) sets the congestion state.
+
+@Param[in]	aqm - The instance handle.
+@Param[in]	ingress_ts - The ingress timestamp of the frame
+		(microseconds), 0 to count the Tx queue delay only.
+@Param[in]	send_flags - Flags passed to \ref dpni_drv_send().
+
+@Return		The \ref dpni_drv_send() return value if the frame was sent,
+		or #AQM_STATUS_DROPPED if the frame was discarded.
+
+@Cautions	The default frame must be presented and parsed.
+@Cautions	The Tx traffic class of the task is set to the traffic class
+		of the instance.
+@Cautions	If send_flags terminate the task, the function does not return
+		on a successful send.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int aqm_send(aqm_handle_t aqm, uint64_t ingress_ts, uint32_t send_flags);
+
+/**************************************************************************//**
+@Function	aqm_get_stats
+
+@Description	Returns the statistics of an AQM instance.
+
+@Param[in]	aqm - The instance handle.
+@Param[out]	stats - The statistics.
+@Param[in]	reset - Non zero to clear the counters.
+
+@Return		0 on success, -EINVAL for an invalid handle.
+*//***************************************************************************/
+int aqm_get_stats(aqm_handle_t aqm, struct aqm_stats *stats, int reset);
+
+/** @} */ /* end of group FSL_AQM_Functions */
+/** @} */ /* end of group FSL_AQM */
+/** @} */ /* end of group NETF */
+
+#endif /* __FSL_AQM_H */
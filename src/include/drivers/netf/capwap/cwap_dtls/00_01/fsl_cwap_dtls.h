@@ -101,6 +101,16 @@ typedef uint64_t cwap_dtls_instance_handle_t;
  */
 #define CWAP_DTLS_FLG_BUFFER_REUSE	0x00000002
 
+/**
+ * Extended anti-replay window, checked and updated by software.
+ * Valid for DTLS decapsulation only.
+ * The window size is given by cwap_dtls_sa_descriptor_params.ar_window_size.
+ * The ARS option of the PDB is ignored and SEC runs without anti-replay
+ * window. Use it for SAs receiving far out of order records (e.g. processed
+ * in a concurrent ordering scope).
+ */
+#define CWAP_DTLS_FLG_EXT_ARW		0x00000004
+
 /** @} */ /* end of FSL_CWAP_DTLS_MACROS_SA_FLAGS */
 
 /**************************************************************************//**
@@ -179,6 +189,11 @@ struct cwap_dtls_sa_descriptor_params {
 	struct alginfo authdata;
 	/** Storage Profile ID of the CAPWAP DTLS output frame */
 	uint16_t spid;
+	/**
+	 * Extended anti-replay window size, in records. A power of 2 between
+	 * 1024 and 4096. Valid with CWAP_DTLS_FLG_EXT_ARW only.
+	 */
+	uint16_t ar_window_size;
 };
 
 /** @} */ /* end of FSL_CWAP_DTLS_STRUCTS */
@@ -195,8 +210,10 @@ struct cwap_dtls_sa_descriptor_params {
 @Function	cwap_dtls_drv_init
 
 @Description	Function fills the CWAP/DTLS dedicated BP, if that is requested
-		in the application. It is called from the AIOP initialization
-		task, in the global initialization stage.
+		in the application. It is called once, by the first
+		cwap_dtls_create_instance() made at boot, or at the end of the
+		boot if an application called cwap_dtls_early_init()
+		(see fsl_lazy.h).
 		Note : The application requests the dedicated BP creation by
 		setting the "CWAP_DTLS_BUFFER_ALLOCATE_ENABLE" application
 		configuration flag.
@@ -327,6 +344,9 @@ int cwap_dtls_del_sa_descriptor(cwap_dtls_sa_handle_t sa_handle);
 		* For 1-entry ARS, only the first word is valid
 		* For 2-entry ARS, only the first two words are valid
 		* For 4-entry ARS, all four words are valid
+		* For the extended window (CWAP_DTLS_FLG_EXT_ARW), the 128
+		most recent entries: bit i (word i/32, bit i%32) is set if
+		the sequence number (sequence_number - i) was received
 
 @Cautions	anti_replay_bitmap is relevant for inbound (decapsulation) only,
 		and should be ignored for outbound (encapsulation).
@@ -336,6 +356,24 @@ void cwap_dtls_get_ar_info(cwap_dtls_sa_handle_t sa_handle,
 			   uint64_t *sequence_number,
 			   uint32_t anti_replay_bitmap[4]);
 
+/**************************************************************************//**
+@Function	cwap_dtls_get_ar_stats
+
+@Description	This function returns the anti-replay counters of an inbound
+		SA with an extended anti-replay window (CWAP_DTLS_FLG_EXT_ARW).
+
+@Param[in]	sa_handle - CAPWAP DTLS SA handle
+@Param[out]	replay_pkts - Number of records dropped as replayed
+@Param[out]	late_pkts - Number of records dropped as late (below the
+		window)
+
+@Return		SUCCESS, or -EINVAL if the SA has no extended anti-replay
+		window
+
+*//****************************************************************************/
+int cwap_dtls_get_ar_stats(cwap_dtls_sa_handle_t sa_handle,
+			   uint64_t *replay_pkts, uint64_t *late_pkts);
+
 /**************************************************************************//**
 @Function	cwap_dtls_frame_decrypt
 
@@ -112,7 +112,9 @@ typedef void /*__noreturn*/ (cwapr_timeout_cb_t) (cwapr_timeout_arg_t arg,
 struct cwapr_params {
 	/** \link FSL_CWAPRInsFlags CAPWAP reassembly flags \endlink */
 	uint32_t  flags;
-		/** maximum number of frames which can be reassembled concurrently */
+		/** maximum number of frames which can be reassembled concurrently.
+		 * It's the number of context buffers reserved for the
+		 * instance, in both CTLU and software table modes */
 	uint32_t  max_open_frames;
 		/** maximum reassembled frame size */
 	uint16_t  max_reass_frm_size;	
@@ -132,6 +134,12 @@ struct cwapr_params {
 		/** TMAN instance ID to be used for timers creation.
 		 * This instance may use up to max_open_frames+1 timers */
 	uint8_t	  tmi_id;
+		/** Number of bins of the software table. Must be a power of 2.
+		 * 0 selects \ref CWAPR_SW_TABLE_DEFAULT_BINS.\n
+		 * Valid only if \ref CWAPR_MODE_SW_TABLE is set in flags.
+		 * Each bin holds \ref CWAPR_SW_TABLE_BIN_ENTRIES reassembly
+		 * contexts and takes 64 bytes in the table memory */
+	uint32_t  sw_table_bins;
 
 };
 
@@ -147,7 +155,8 @@ struct cwapr_stats_cntrs {
 	uint32_t	malformed_frags_cntr;
 		/** Counts the number of times the re-assembly process can't
 		     start since the number of open CAPWAP reassembled frames
-		     has exceeded the max_open_frames */
+		     has exceeded the max_open_frames or, in software table
+		     mode, the bin of the frame is full */
 	uint32_t	open_reass_frms_exceed_cntr;
 		/** Counts the number of times that a successful reassembled frame
              length exceeds max_reass_frm_size value*/
@@ -176,9 +185,9 @@ struct cwapr_stats_cntrs {
 @Description CAPWAP reassembly flags.
 
 
-|      0      |      1     |               |      4-5       | 6-31 |
+|      0      |      1     |       2       |      4-5       | 6-31 |
 |-------------|------------|---------------|----------------|------|
-|Extended_stat|TO_type     |               | Table Location |      |
+|Extended_stat|TO_type     |SW_table       | Table Location |      |
 \n
 
 @{
@@ -190,6 +199,12 @@ struct cwapr_stats_cntrs {
 #define CWAPR_MODE_TIMEOUT_TYPE			0x40000000
 /** If set, extended statistics is enabled */
 #define CWAPR_MODE_EXTENDED_STATS_EN		0x80000000
+/** If set, the reassembly contexts are looked up in a software hash table
+ * instead of a CTLU exact match table. The fragments of a new frame don't
+ * create nor delete a CTLU rule. The table has
+ * \ref cwapr_params::sw_table_bins bins and is located in the memory
+ * selected by the Table Location bits */
+#define CWAPR_MODE_SW_TABLE			0x20000000
 
 /** Table is located in Packet Express Buffer memory */
 #define CWAPR_MODE_TABLE_LOCATION_PEB		0x08000000
@@ -207,6 +222,23 @@ struct cwapr_stats_cntrs {
 
 /** @} */ /* end of group FSL_CWAPRInsModeBits */
 
+/**************************************************************************//**
+@Group		FSL_CWAPRSwTable CWAPR software table
+
+@Description	CAPWAP reassembly software table sizing.
+
+@{
+*//***************************************************************************/
+
+/** Default number of bins of the software table */
+#define CWAPR_SW_TABLE_DEFAULT_BINS		1024
+/** Number of reassembly contexts held by a bin of the software table.
+ * A first fragment is counted in open_reass_frms_exceed_cntr if its bin is
+ * full. */
+#define CWAPR_SW_TABLE_BIN_ENTRIES		4
+
+/** @} */ /* end of group FSL_CWAPRSwTable */
+
 /**************************************************************************//**
 @Group		FSL_CWAPRReassReturnStatus CWAPR functions return status
 
@@ -0,0 +1,553 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fsl_fib.h
+
+@Description	This file contains the AIOP SW IPv4/IPv6 Forwarding Information
+		Base (FIB) API
+
+*//***************************************************************************/
+
+#ifndef __FSL_FIB_H
+#define __FSL_FIB_H
+
+#include "fsl_types.h"
+#include "fsl_net.h"
+
+/**************************************************************************//**
+ @Group		NETF NETF (Network Libraries)
+
+ @Description	AIOP Accelerator APIs
+
+ @{
+*//***************************************************************************/
+/**************************************************************************//**
+@Group		FSL_FIB FIB
+
+@Description	AIOP IP forwarding functions macros and definitions.
+
+		A FIB instance owns one CTLU LPM table per address family.
+		Routes of different VRFs share the instance tables: the VRF ID
+		is placed in the exact match part of the LPM key, so every VRF
+		is an independent LPM space.
+
+		A route points either to a next hop or to an ECMP next hop
+		group. Next hops are shared objects: modifying a next hop
+		updates all the routes pointing to it with a single write.
+		Next hops and groups are double buffered and switched under
+		RCU, so the forwarding path never takes a lock.
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group	FIB_MACROS FIB Macros
+
+@Description	FIB Macros
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	FIB handles Type definition
+
+ *//***************************************************************************/
+typedef uint64_t fib_instance_handle_t;
+typedef uint64_t fib_nh_handle_t;
+typedef uint64_t fib_nhg_handle_t;
+
+	/** Maximum number of next hops in an ECMP next hop group */
+#define FIB_NHG_MAX_MEMBERS		8
+
+	/** Maximum VRF ID */
+#define FIB_MAX_VRF_ID			0xFFFF
+
+/** @} */ /* end of group FIB_MACROS */
+
+/**************************************************************************//**
+@Group		FIB_STRUCTS FIB Data Structures
+
+@Description	AIOP FIB Data Structures
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	FIB Parameters
+*//***************************************************************************/
+struct fib_params {
+	/** Maximum number of IPv4 routes (all VRFs). 0 disables IPv4. */
+	uint32_t max_routes_ipv4;
+	/** Maximum number of IPv6 routes (all VRFs). 0 disables IPv6. */
+	uint32_t max_routes_ipv6;
+	/** Maximum number of next hops of this instance */
+	uint32_t max_next_hops;
+	/** Maximum number of ECMP next hop groups of this instance */
+	uint32_t max_nh_groups;
+	/** \link FSL_FIBInsFlags FIB instance flags \endlink */
+	uint32_t flags;
+};
+
+/**************************************************************************//**
+@Description	FIB Next Hop Parameters
+*//***************************************************************************/
+struct fib_nh_params {
+	/** Destination MAC address written in the forwarded frame */
+	uint8_t  dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	/** Source MAC address written in the forwarded frame */
+	uint8_t  src_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	/** Network Interface ID the frame is sent on */
+	uint16_t ni_id;
+	/** VLAN ID set in the outer VLAN tag. Valid only if
+	 * #FIB_NH_FLAG_SET_VLAN_VID is set. */
+	uint16_t vlan_vid;
+	/** \link FSL_FIBNhFlags FIB next hop flags \endlink */
+	uint16_t flags;
+};
+
+/**************************************************************************//**
+@Description	FIB IPv4 prefix
+*//***************************************************************************/
+struct fib_prefix_ipv4 {
+	/** IPv4 address (network order) */
+	uint32_t addr;
+	/** Prefix length (1 - 32). A default route is added as two /1
+	 * routes (0.0.0.0/1 and 128.0.0.0/1). */
+	uint8_t  prefix_length;
+};
+
+/**************************************************************************//**
+@Description	FIB IPv6 prefix
+*//***************************************************************************/
+struct fib_prefix_ipv6 {
+	/** IPv6 address (network order) */
+	uint32_t addr[4];
+	/** Prefix length (1 - 128). A default route is added as two /1
+	 * routes (::/1 and 8000::/1). */
+	uint8_t  prefix_length;
+};
+
+/**************************************************************************//**
+@Description	FIB route target. A route points either to a next hop or to
+		an ECMP next hop group.
+*//***************************************************************************/
+struct fib_route_target {
+	/** Handle of a next hop or of a next hop group */
+	uint64_t handle;
+	/** Non zero if handle is a \ref fib_nhg_handle_t */
+	uint8_t  is_group;
+};
+
+/** @} */ /* end of group FIB_STRUCTS */
+
+/**************************************************************************//**
+@Group		FSL_FIB_Modes_And_Flags FIB Modes And Flags
+
+@Description	AIOP FIB Modes and Flags
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		FSL_FIBInsFlags FIB instance flags
+
+@Description	FIB instance flags.
+
+@{
+*//***************************************************************************/
+
+/** Tables are located in internal memory */
+#define FIB_MODE_TABLE_LOCATION_INT	0x00000000
+/** Tables are located in Packet Express Buffer table */
+#define FIB_MODE_TABLE_LOCATION_PEB	0x08000000
+/** Tables are located in DDR1 (DDR2 on LS1088A) */
+#define FIB_MODE_TABLE_LOCATION_EXT1	0x04000000
+/** Tables are located in DDR2 */
+#define FIB_MODE_TABLE_LOCATION_EXT2	0x0C000000
+
+/** @} */ /* end of group FSL_FIBInsFlags */
+
+/**************************************************************************//**
+@Group		FSL_FIBNhFlags FIB next hop flags
+
+@Description	FIB next hop flags.
+
+@{
+*//***************************************************************************/
+
+/** Replace the VLAN ID of the outer VLAN tag with
+ * \ref fib_nh_params::vlan_vid */
+#define FIB_NH_FLAG_SET_VLAN_VID	0x0001
+/** Frames routed to this next hop are returned to the caller with
+ * #FIB_STATUS_LOCAL (e.g. local delivery or slow path) */
+#define FIB_NH_FLAG_LOCAL		0x0002
+/** Frames routed to this next hop are returned to the caller with
+ * #FIB_STATUS_DROP (black hole route) */
+#define FIB_NH_FLAG_DROP		0x0004
+
+/** @} */ /* end of group FSL_FIBNhFlags */
+
+/**************************************************************************//**
+@Group		FSL_FIBFwdFlags FIB forwarding flags
+
+@Description	Flags of \ref fib_forward().
+
+@{
+*//***************************************************************************/
+
+/** No flags */
+#define FIB_FWD_NO_FLAGS		0x00000000
+/** Do not decrement IPv4 TTL / IPv6 hop limit */
+#define FIB_FWD_NO_TTL_DEC		0x00000001
+
+/** @} */ /* end of group FSL_FIBFwdFlags */
+
+/**************************************************************************//**
+@Group		FSL_FIBReturnStatus FIB functions return status
+
+@Description	AIOP FIB functions return status
+
+@{
+*//***************************************************************************/
+
+/** Base of the FIB status codes */
+#define FIB_STATUS_BASE			0x00001000
+/** No route was found for the destination address */
+#define FIB_STATUS_NO_ROUTE		(FIB_STATUS_BASE + 1)
+/** The route points to a next hop marked with #FIB_NH_FLAG_LOCAL */
+#define FIB_STATUS_LOCAL		(FIB_STATUS_BASE + 2)
+/** The route points to a next hop marked with #FIB_NH_FLAG_DROP */
+#define FIB_STATUS_DROP			(FIB_STATUS_BASE + 3)
+/** IPv4 TTL / IPv6 hop limit expired. The frame was not modified. */
+#define FIB_STATUS_TTL_EXPIRED		(FIB_STATUS_BASE + 4)
+/** The frame is neither IPv4 nor IPv6 or the address family is not
+ * enabled in the instance */
+#define FIB_STATUS_NOT_IP		(FIB_STATUS_BASE + 5)
+
+/** @} */ /* end of group FSL_FIBReturnStatus */
+
+/** @} */ /* end of group FSL_FIB_Modes_And_Flags */
+
+/**************************************************************************//**
+@Group		FSL_FIB_Functions FIB functions
+
+@Description	AIOP FIB functions
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Function	fib_early_init
+
+@Description	Registers the memory needed by the FIB instances.
+		Should be called from the application early initialization.
+
+@Param[in]	nbr_of_instances - Maximum number of FIB instances.
+@Param[in]	nbr_of_next_hops - Total number of next hops of all the
+		instances.
+@Param[in]	nbr_of_nh_groups - Total number of ECMP next hop groups of all
+		the instances.
+
+@Return		0 on success, negative value on error.
+*//***************************************************************************/
+int fib_early_init(uint32_t nbr_of_instances, uint32_t nbr_of_next_hops,
+		   uint32_t nbr_of_nh_groups);
+
+/**************************************************************************//**
+@Function	fib_create_instance
+
+@Description	Creates a FIB instance: the LPM tables, the next hop pools and
+		the ECMP hash key composition rule.
+
+@Param[in]	fib_params_ptr - pointer to the instance parameters.
+@Param[out]	fib_instance_ptr - handle of the created instance.
+
+@Return		0 on success, negative value on error.
+
+@Retval		ENOMEM - not enough memory for the tables or the pools.
+@Retval		ENOSPC - no more key composition rules are available.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fib_create_instance(struct fib_params *fib_params_ptr,
+			fib_instance_handle_t *fib_instance_ptr);
+
+/**************************************************************************//**
+@Function	fib_delete_instance
+
+@Description	Deletes a FIB instance and returns its buffer reservations
+		to the slab. The remaining routes are deleted; the next hops
+		and groups deleted by the user are released with them. All
+		the next hops and groups of the instance must be deleted and
+		no lookup may use the instance when calling this function.
+
+@Param[in]	fib_instance - The FIB instance handle.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+void fib_delete_instance(fib_instance_handle_t fib_instance);
+
+/**************************************************************************//**
+@Function	fib_nh_create
+
+@Description	Creates a next hop.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	nh_params - The next hop parameters.
+@Param[out]	nh - The next hop handle.
+
+@Return		0 on success, negative value on error.
+
+@Retval		ENOSPC - no more next hops are available in the instance.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fib_nh_create(fib_instance_handle_t fib_instance,
+		  struct fib_nh_params *nh_params,
+		  fib_nh_handle_t *nh);
+
+/**************************************************************************//**
+@Function	fib_nh_modify
+
+@Description	Modifies a next hop. All the routes and groups pointing to the
+		next hop use the new parameters when this function returns.
+		The cost does not depend on the number of routes.
+
+@Param[in]	nh - The next hop handle.
+@Param[in]	nh_params - The new next hop parameters.
+
+@Cautions	In this function the task yields.
+@Cautions	This function waits for an RCU grace period.
+*//***************************************************************************/
+void fib_nh_modify(fib_nh_handle_t nh, struct fib_nh_params *nh_params);
+
+/**************************************************************************//**
+@Function	fib_nh_delete
+
+@Description	Releases the creator reference of a next hop. The next hop
+		memory is freed after the last route or group pointing to it
+		is removed.
+
+@Param[in]	nh - The next hop handle.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+void fib_nh_delete(fib_nh_handle_t nh);
+
+/**************************************************************************//**
+@Function	fib_nhg_create
+
+@Description	Creates an ECMP next hop group. The member used for a frame is
+		selected by a hash over the frame 5-tuple, so all the frames of
+		a flow use the same next hop.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	members - Array of next hop handles.
+@Param[in]	num_members - Number of next hops (1 - #FIB_NHG_MAX_MEMBERS).
+@Param[out]	nhg - The next hop group handle.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid number of members.
+@Retval		ENOSPC - no more groups are available in the instance.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fib_nhg_create(fib_instance_handle_t fib_instance,
+		   fib_nh_handle_t *members,
+		   uint8_t num_members,
+		   fib_nhg_handle_t *nhg);
+
+/**************************************************************************//**
+@Function	fib_nhg_modify
+
+@Description	Replaces the members of an ECMP next hop group.
+
+@Param[in]	nhg - The next hop group handle.
+@Param[in]	members - Array of next hop handles.
+@Param[in]	num_members - Number of next hops (1 - #FIB_NHG_MAX_MEMBERS).
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid number of members.
+
+@Cautions	In this function the task yields.
+@Cautions	This function waits for an RCU grace period.
+*//***************************************************************************/
+int fib_nhg_modify(fib_nhg_handle_t nhg, fib_nh_handle_t *members,
+		   uint8_t num_members);
+
+/**************************************************************************//**
+@Function	fib_nhg_delete
+
+@Description	Releases the creator reference of an ECMP next hop group.
+
+@Param[in]	nhg - The next hop group handle.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+void fib_nhg_delete(fib_nhg_handle_t nhg);
+
+/**************************************************************************//**
+@Function	fib_route_add_ipv4
+
+@Description	Adds or replaces an IPv4 route.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[in]	prefix - The route prefix.
+@Param[in]	target - The route next hop or next hop group.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid prefix length or IPv4 is not enabled.
+@Retval		ENOMEM - the table is full.
+
+@Cautions	In this function the task yields.
+@Cautions	If an existing route is replaced this function waits for an RCU
+		grace period.
+*//***************************************************************************/
+int fib_route_add_ipv4(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+		       struct fib_prefix_ipv4 *prefix,
+		       struct fib_route_target *target);
+
+/**************************************************************************//**
+@Function	fib_route_delete_ipv4
+
+@Description	Deletes an IPv4 route.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[in]	prefix - The route prefix.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EIO - the route was not found.
+
+@Cautions	In this function the task yields.
+@Cautions	This function waits for an RCU grace period.
+*//***************************************************************************/
+int fib_route_delete_ipv4(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+			  struct fib_prefix_ipv4 *prefix);
+
+/**************************************************************************//**
+@Function	fib_route_add_ipv6
+
+@Description	Adds or replaces an IPv6 route.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[in]	prefix - The route prefix.
+@Param[in]	target - The route next hop or next hop group.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid prefix length or IPv6 is not enabled.
+@Retval		ENOMEM - the table is full.
+
+@Cautions	In this function the task yields.
+@Cautions	If an existing route is replaced this function waits for an RCU
+		grace period.
+*//***************************************************************************/
+int fib_route_add_ipv6(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+		       struct fib_prefix_ipv6 *prefix,
+		       struct fib_route_target *target);
+
+/**************************************************************************//**
+@Function	fib_route_delete_ipv6
+
+@Description	Deletes an IPv6 route.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[in]	prefix - The route prefix.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EIO - the route was not found.
+
+@Cautions	In this function the task yields.
+@Cautions	This function waits for an RCU grace period.
+*//***************************************************************************/
+int fib_route_delete_ipv6(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+			  struct fib_prefix_ipv6 *prefix);
+
+/**************************************************************************//**
+@Function	fib_lookup
+
+@Description	Looks up the destination address of the default frame and
+		resolves the next hop (including ECMP member selection).
+		The frame is not modified.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[out]	nh_params - The resolved next hop parameters.
+
+@Return		0 on success, one of \ref FSL_FIBReturnStatus, or the
+		\ref FSL_TABLE_STATUS of a failed route lookup.
+
+@Cautions	The default frame must be presented and parsed.
+@Cautions	The task must be an RCU reader (see sl_prolog_with_ref_take()
+		or rcu_read_lock()).
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fib_lookup(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+	       struct fib_nh_params *nh_params);
+
+/**************************************************************************//**
+@Function	fib_forward
+
+@Description	Forwarding fast path: looks up the destination address of the
+		default frame, selects the next hop, decrements the TTL (hop
+		limit), rewrites the L2 header and sends the frame on the next
+		hop Network Interface.
+
+@Param[in]	fib_instance - The FIB instance handle.
+@Param[in]	vrf_id - The VRF ID.
+@Param[in]	flags - \link FSL_FIBFwdFlags FIB forwarding flags \endlink.
+@Param[in]	send_flags - Flags passed to \ref dpni_drv_send().
+
+@Return		The \ref dpni_drv_send() return value if the frame was sent,
+		or one of \ref FSL_FIBReturnStatus or the
+		\ref FSL_TABLE_STATUS of a failed route lookup (the frame is
+		returned to the caller).
+
+@Cautions	The default frame must be presented and parsed.
+@Cautions	The task must be an RCU reader (see sl_prolog_with_ref_take()
+		or rcu_read_lock()).
+@Cautions	If send_flags terminate the task, the function does not return
+		on a successful send.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fib_forward(fib_instance_handle_t fib_instance, uint16_t vrf_id,
+		uint32_t flags, uint32_t send_flags);
+
+/** @} */ /* end of group FSL_FIB_Functions */
+/** @} */ /* end of group FSL_FIB */
+/** @} */ /* end of group NETF */
+
+#endif /* __FSL_FIB_H */
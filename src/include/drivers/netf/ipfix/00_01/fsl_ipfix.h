@@ -0,0 +1,338 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fsl_ipfix.h
+
+@Description	This file contains the AIOP SW IPFIX / NetFlow v9 flow
+		metering and export API
+
+*//***************************************************************************/
+
+#ifndef __FSL_IPFIX_H
+#define __FSL_IPFIX_H
+
+#include "fsl_types.h"
+#include "fsl_net.h"
+
+/**************************************************************************//**
+ @Group		NETF NETF (Network Libraries)
+
+ @Description	AIOP Accelerator APIs
+
+ @{
+*//***************************************************************************/
+/**************************************************************************//**
+@Group		FSL_IPFIX IPFIX
+
+@Description	AIOP flow metering and export functions macros and
+		definitions.
+
+		An IPFIX instance keeps a record for each active flow in a
+		CTLU exact match table. The flow key is the IP source and
+		destination addresses, the protocol, the L4 ports and the
+		input Network Interface. The packet and byte counters of a
+		record are updated by the Statistics Engine.
+
+		A timer wheel with a 1 second tick expires the records:
+		 - a flow without traffic during idle_timeout seconds is
+		 exported and removed from the table,
+		 - a flow active for active_timeout seconds is exported and
+		 continues with a new record (delta counters).
+
+		The expired records are batched in IPFIX (RFC 7011) or NetFlow
+		v9 (RFC 3954) messages sent over UDP/IPv4 to the collector
+		through an AIOP Network Interface.
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group	IPFIX_MACROS IPFIX Macros
+
+@Description	IPFIX Macros
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	IPFIX handle Type definition
+
+ *//***************************************************************************/
+typedef uint8_t ipfix_handle_t;
+
+	/** Maximum number of IPFIX instances */
+#define IPFIX_MAX_INSTANCES		4
+
+	/** Default active timeout (seconds) */
+#define IPFIX_DEFAULT_ACTIVE_TIMEOUT	60
+
+	/** Default idle timeout (seconds) */
+#define IPFIX_DEFAULT_IDLE_TIMEOUT	15
+
+	/** Default template refresh (messages) */
+#define IPFIX_DEFAULT_TEMPLATE_REFRESH	20
+
+	/** Default collector UDP port of IPFIX */
+#define IPFIX_DEFAULT_PORT		4739
+
+	/** Default collector UDP port of NetFlow v9 */
+#define IPFIX_NETFLOW_V9_DEFAULT_PORT	2055
+
+/** @} */ /* end of group IPFIX_MACROS */
+
+/**************************************************************************//**
+@Group		IPFIX_STRUCTS IPFIX Data Structures
+
+@Description	AIOP IPFIX Data Structures
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	IPFIX Exporter Parameters. The messages are sent in UDP/IPv4
+		frames without VLAN tag.
+*//***************************************************************************/
+struct ipfix_export_params {
+	/** Network Interface ID the messages are sent on. The source MAC
+	 * address is the primary MAC address of the NI. */
+	uint16_t ni_id;
+	/** Destination MAC address (collector or next hop) */
+	uint8_t  dst_mac[NET_HDR_FLD_ETH_ADDR_SIZE];
+	/** Source IPv4 address (exporter) */
+	uint32_t src_ip;
+	/** Destination IPv4 address (collector) */
+	uint32_t dst_ip;
+	/** Source UDP port. 0 selects the destination port. */
+	uint16_t src_port;
+	/** Destination UDP port. 0 selects #IPFIX_DEFAULT_PORT or
+	 * #IPFIX_NETFLOW_V9_DEFAULT_PORT. */
+	uint16_t dst_port;
+};
+
+/**************************************************************************//**
+@Description	IPFIX Parameters
+*//***************************************************************************/
+struct ipfix_params {
+	/** Maximum number of flow records of the instance */
+	uint32_t max_flows;
+	/** \link FSL_IPFIXFlags IPFIX instance flags \endlink */
+	uint32_t flags;
+	/** 1-in-N sampling: only one frame (or flow, see
+	 * #IPFIX_FLG_RANDOM_SAMPLING) out of sampling_rate is metered.
+	 * 0 or 1 meters all the frames. */
+	uint32_t sampling_rate;
+	/** Observation Domain ID (IPFIX) / Source ID (NetFlow v9) */
+	uint32_t observation_domain_id;
+	/** UNIX time (seconds) at the creation of the instance. It is the
+	 * base of the export time and of the flow start / end times. The
+	 * AIOP has no time of day clock: 0 exports the time since the
+	 * creation of the instance. */
+	uint32_t time_base;
+	/** Active timeout in seconds. 0 selects
+	 * #IPFIX_DEFAULT_ACTIVE_TIMEOUT. */
+	uint16_t active_timeout;
+	/** Idle timeout in seconds. 0 selects #IPFIX_DEFAULT_IDLE_TIMEOUT.
+	 * Must not be larger than the active timeout. */
+	uint16_t idle_timeout;
+	/** The templates are sent in the first message and then every
+	 * template_refresh messages. 0 selects
+	 * #IPFIX_DEFAULT_TEMPLATE_REFRESH. */
+	uint16_t template_refresh;
+	/** Exporter parameters */
+	struct ipfix_export_params export_params;
+};
+
+/**************************************************************************//**
+@Description	IPFIX Statistics
+*//***************************************************************************/
+struct ipfix_stats {
+	/** Frames metered (selected by the sampling) */
+	uint64_t sampled;
+	/** Non IP frames */
+	uint64_t not_ip;
+	/** Flow records created */
+	uint64_t flows;
+	/** Sampled frames not metered: no flow record available */
+	uint64_t flow_drops;
+	/** Data records exported */
+	uint64_t records;
+	/** Messages sent */
+	uint64_t messages;
+	/** Messages lost: no frame buffer or Tx congestion */
+	uint64_t tx_errors;
+};
+
+/** @} */ /* end of group IPFIX_STRUCTS */
+
+/**************************************************************************//**
+@Group		FSL_IPFIX_Modes_And_Flags IPFIX Modes And Flags
+
+@Description	AIOP IPFIX Modes and Flags
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		FSL_IPFIXFlags IPFIX instance flags
+
+@Description	IPFIX instance flags.
+
+@{
+*//***************************************************************************/
+
+/** Export NetFlow v9 messages instead of IPFIX messages */
+#define IPFIX_FLG_NETFLOW_V9		0x00000001
+/** Random 1-in-N packet sampling. By default the sampling is hash based:
+ * a hash of the flow key selects 1-in-N flows and all the frames of a
+ * selected flow are metered, so its counters are exact. */
+#define IPFIX_FLG_RANDOM_SAMPLING	0x00000002
+/** Table is located in internal memory */
+#define IPFIX_MODE_TABLE_LOCATION_INT	0x00000000
+/** Table is located in Packet Express Buffer table */
+#define IPFIX_MODE_TABLE_LOCATION_PEB	0x08000000
+/** Table is located in DDR1 (DDR2 on LS1088A) */
+#define IPFIX_MODE_TABLE_LOCATION_EXT1	0x04000000
+/** Table is located in DDR2 */
+#define IPFIX_MODE_TABLE_LOCATION_EXT2	0x0C000000
+
+/** @} */ /* end of group FSL_IPFIXFlags */
+
+/**************************************************************************//**
+@Group		FSL_IPFIXReturnStatus IPFIX functions return status
+
+@Description	AIOP IPFIX functions return status
+
+@{
+*//***************************************************************************/
+
+/** Base of the IPFIX status codes */
+#define IPFIX_STATUS_BASE		0x00001000
+/** The frame was not selected by the sampling */
+#define IPFIX_STATUS_NOT_SAMPLED	(IPFIX_STATUS_BASE + 1)
+/** The frame is neither IPv4 nor IPv6 */
+#define IPFIX_STATUS_NOT_IP		(IPFIX_STATUS_BASE + 2)
+
+/** @} */ /* end of group FSL_IPFIXReturnStatus */
+
+/** @} */ /* end of group FSL_IPFIX_Modes_And_Flags */
+
+/**************************************************************************//**
+@Group		FSL_IPFIX_Functions IPFIX functions
+
+@Description	AIOP IPFIX functions
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Function	ipfix_early_init
+
+@Description	Registers the memory needed by the IPFIX instances.
+		Should be called from the application early initialization.
+
+@Param[in]	nbr_of_instances - Maximum number of IPFIX instances.
+@Param[in]	nbr_of_flows - Total number of flow records of all the
+		instances.
+
+@Return		0 on success, negative value on error.
+*//***************************************************************************/
+int ipfix_early_init(uint32_t nbr_of_instances, uint32_t nbr_of_flows);
+
+/**************************************************************************//**
+@Function	ipfix_create
+
+@Description	Creates an IPFIX instance: the flow table, the flow records
+		pool and the timer of the wheel.
+
+@Param[in]	params - The instance parameters.
+@Param[out]	ipfix - The instance handle.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid parameters.
+@Retval		ENOSPC - no more instances are available.
+@Retval		ENOMEM - not enough memory for the table or the records.
+@Retval		EBUSY - another instance is being created.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int ipfix_create(const struct ipfix_params *params, ipfix_handle_t *ipfix);
+
+/**************************************************************************//**
+@Function	ipfix_delete
+
+@Description	Deletes an IPFIX instance. The instance stops metering
+		immediately. The next tick of the wheel (within 1 second)
+		exports the records of all the flows and releases the table
+		and the records. The handle may be reused after that.
+
+@Param[in]	ipfix - The instance handle.
+*//***************************************************************************/
+void ipfix_delete(ipfix_handle_t ipfix);
+
+/**************************************************************************//**
+@Function	ipfix_meter_frame
+
+@Description	Accounts the default frame in the record of its flow. The
+		record is created on the first frame of the flow.
+
+		Implicit input parameters in Task Defaults: frame handle,
+		segment address, parse results and receive NI ID.
+
+		The frame is not modified.
+
+@Param[in]	ipfix - The instance handle.
+
+@Return		0 on success, #IPFIX_STATUS_NOT_SAMPLED,
+		#IPFIX_STATUS_NOT_IP or negative value on error.
+
+@Retval		EINVAL - the instance is not valid (e.g. being deleted).
+@Retval		ENOSPC - the flow has no record and the records pool is
+		empty.
+@Retval		ENOMEM - the flow has no record and the table is full.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int ipfix_meter_frame(ipfix_handle_t ipfix);
+
+/**************************************************************************//**
+@Function	ipfix_get_stats
+
+@Description	Returns the statistics of an IPFIX instance.
+
+@Param[in]	ipfix - The instance handle.
+@Param[out]	stats - The statistics.
+
+@Return		0 on success, -EINVAL if the instance is not valid.
+*//***************************************************************************/
+int ipfix_get_stats(ipfix_handle_t ipfix, struct ipfix_stats *stats);
+
+/** @} */ /* end of group FSL_IPFIX_Functions */
+/** @} */ /* end of group FSL_IPFIX */
+/** @} */ /* end of group NETF */
+
+#endif /* __FSL_IPFIX_H */
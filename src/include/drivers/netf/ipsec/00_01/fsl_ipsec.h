@@ -176,6 +176,15 @@ typedef void (ipsec_lifetime_callback_t) (
 /** Lifetime Seconds counter Enable */
 #define IPSEC_FLG_LIFETIME_SEC_CNTR_EN	0x00000400
 
+/** Batched lifetime counters, for SAs with a high packet rate.
+ * Each core accumulates the packets and bytes of the SA and adds them to the
+ * SA counters once 32 packets or 64 KB are reached, instead of one counter
+ * update per packet. When the counters get close to an enabled kilobyte or
+ * packet limit, the pending counts of all the cores are included in the
+ * lifetime check and the counters are updated per packet again, so the soft
+ * and hard limits are detected as without this flag. */
+#define IPSEC_FLG_LIFETIME_BATCH	0x00000800
+
 /**************************************************************************//**
 @Description	General IPSec ESP encap/decap options
 
@@ -220,6 +229,13 @@ typedef void (ipsec_lifetime_callback_t) (
 #define IPSEC_DEC_OPTS_ARS128	0x0080   /**< 128-entry anti-replay window */
 #define IPSEC_DEC_OPTS_ARS64	0x00c0   /**< 64-entry anti-replay window */
 
+/** Extended anti-replay window, checked and updated by software.
+ * The window size is ipsec_decap_params.ar_window_size; the ARS option is
+ * ignored and SEC runs without anti-replay window. For SAs receiving far
+ * out of order packets (e.g. processed in a concurrent ordering scope).
+ * Not valid together with IPSEC_OPTS_ESP_ESN */
+#define IPSEC_DEC_OPTS_ARS_EXT	0x0800
+
 /** Enable Tunnel ECN according to RFC 6040
  * Valid for Tunnel mode only. Not valid for transport mode */
 #define IPSEC_DEC_OPTS_TECN		0x0020
@@ -421,6 +437,9 @@ struct ipsec_decap_params {
 		struct ipsec_decap_ccm_params ccm;
 		struct ipsec_decap_gcm_params gcm;
 	};
+	uint16_t ar_window_size; /**< Extended anti-replay window size, in
+			packets. A power of 2 between 1024 and 4096.
+			Valid with IPSEC_DEC_OPTS_ARS_EXT only */
 };
 
 /**************************************************************************//**
@@ -480,6 +499,31 @@ struct ipsec_descriptor_params {
 	uint16_t spid; /**< Storage Profile ID of the SEC output frame */
 };
 
+/**************************************************************************//**
+ @Description   Shared descriptor templates statistics
+*//***************************************************************************/
+struct ipsec_sd_tmpl_stats {
+	uint32_t hits;	/**< Shared descriptors built from a template */
+	uint32_t misses; /**< Shared descriptors built by the RTA */
+	uint32_t inserts; /**< Templates created */
+	uint32_t uncached; /**< Misses not kept as a template (no memory,
+			all the templates in use or template check failure) */
+	uint64_t hit_time; /**< Generation time of the hits, micro-seconds */
+	uint64_t miss_time; /**< Generation time of the misses, micro-seconds */
+};
+
+/**************************************************************************//**
+ @Description   Burst of segments encrypted with an SA
+		(e.g. the TCP segments of a super-frame)
+*//***************************************************************************/
+struct ipsec_burst {
+	ipsec_handle_t ipsec_handle; /**< IPsec handle of the outbound SA */
+	uint32_t packets; /**< Segments encrypted, not counted yet. Set to 0
+			before the first segment. */
+	uint32_t bytes; /**< Bytes encrypted, not counted yet. Set to 0
+			before the first segment. */
+};
+
 /** @} */ /* end of FSL_IPSEC_STRUCTS */
 
 /**************************************************************************//**
@@ -532,9 +576,11 @@ int ipsec_early_init(
 @Function	ipsec_drv_init
 
 @Description  Function fills the IPsec dedicated BP, if that is requested in
-		the application. It is called from the AIOP initialization task,
-		in the global initialization stage. Note : The application
-		requests the dedicated BP creation by setting the
+		the application. It is called once, by the first
+		ipsec_create_instance() made at boot, or at the end of the
+		boot if an application called ipsec_early_init()
+		(see fsl_lazy.h). Note : The application requests the
+		dedicated BP creation by setting the
 		"IPSEC_BUFFER_ALLOCATE_ENABLE" application configuration
 		flag.
 
@@ -599,6 +645,10 @@ int ipsec_delete_instance(ipsec_instance_handle_t instance_handle);
 @Description	This function performs add SA for encapsulation:
 		creating the IPsec flow context and the Shared Descriptor.
 
+		The Shared Descriptor is built from a template when an SA of
+		the same algorithms, key lengths, direction, mode and options
+		was added before (see ipsec_get_sd_tmpl_stats()).
+
 		Implicit Input: BPID in the SRAM (internal usage).
 		
 @Param[in]	params - pointer to descriptor parameters
@@ -645,6 +695,9 @@ int ipsec_del_sa_descriptor(ipsec_handle_t ipsec_handle);
 		Note: the counters are always enabled regardless of the 
 			IPSEC_FLG_LIFETIME_KB_CNTR_EN, IPSEC_FLG_LIFETIME_PKT_CNTR_EN
 			and IPSEC_FLG_LIFETIME_SEC_CNTR_EN flags
+
+		With IPSEC_FLG_LIFETIME_BATCH, the bytes and packets include
+		the counts batched on the cores.
 		
 @Param[in]	ipsec_handle - IPsec handle.
 @Param[out]	bytes - number of bytes processed by this SA.
@@ -692,14 +745,24 @@ int ipsec_decr_lifetime_counters(ipsec_handle_t ipsec_handle,
 		- Extended sequence number (if exists).
 		- Anti-replay bitmap (scorecard) (if exists).
 
+		With IPSEC_OPTS_ESP_ESN, the 64 bit sequence number is
+		(extended_sequence_number << 32) | sequence_number, for both
+		encapsulation and decapsulation. It is the last sequence
+		number sent (outbound) or the highest received (inbound).
+
 @Param[in]	ipsec_handle - IPsec handle.
 @Param[out]	sequence_number - Sequence number.
-@Param[out]	extended_sequence_number - Extended sequence number.
+@Param[out]	extended_sequence_number - Extended sequence number
+		(high order 32 bits). Zero if ESN is not enabled.
 @Param[out]	anti_replay_bitmap - Anti-replay bitmap. 4 words.
 		* For 32-entry only the first 32 bit word is valid.
 		* For 64-entry only the first two 32 bit words are valid.
 		* For 128-entry all four words are valid.
 
+		* For the extended window (IPSEC_DEC_OPTS_ARS_EXT), the 128
+		most recent entries: bit i (word i/32, bit i%32) is set if
+		the sequence number (sequence_number - i) was received.
+
 @Cautions	anti_replay_bitmap is relevant for inbound (decapsulation) only,
 			and should be ignored for outbound (encapsulation).
 
@@ -715,6 +778,25 @@ int ipsec_get_seq_num(
 		uint32_t *extended_sequence_number,
 		uint32_t anti_replay_bitmap[4]);
 
+/**************************************************************************//**
+@Function	ipsec_get_ar_stats
+
+@Description	This function returns the anti-replay counters of an inbound
+		SA with an extended anti-replay window (IPSEC_DEC_OPTS_ARS_EXT).
+
+@Param[in]	ipsec_handle - IPsec handle.
+@Param[out]	replay_pkts - number of packets dropped as replayed.
+@Param[out]	late_pkts - number of packets dropped as late (below the
+		window).
+
+@Return		Status. -EINVAL if the SA has no extended anti-replay window.
+
+*//****************************************************************************/
+int ipsec_get_ar_stats(
+		ipsec_handle_t ipsec_handle,
+		uint64_t *replay_pkts,
+		uint64_t *late_pkts);
+
 /**************************************************************************//**
 @Function	ipsec_frame_decrypt
 
@@ -786,6 +868,67 @@ int ipsec_frame_encrypt(
 		uint32_t *enc_status
 		);
 
+/**************************************************************************//**
+@Function	ipsec_frame_encrypt_burst
+
+@Description	This function encrypts a segment of a burst, as
+		ipsec_frame_encrypt() does for a frame, with the SA of the
+		burst. The segments encrypted before are taken into account
+		in the lifetime limits check. The lifetime counters are not
+		updated: the segment is added to the burst counts.
+
+@Param[in,out]	burst - Burst of segments.
+@Param[out]	enc_status - encryption operation return status,
+		including indication of kilobyte/packet lifetime limit crossing
+
+@Return		General status
+
+@Cautions	Same as ipsec_frame_encrypt(). ipsec_burst_done() must be
+		called after the last segment of the burst, also on error.
+*//****************************************************************************/
+int ipsec_frame_encrypt_burst(
+		struct ipsec_burst *burst,
+		uint32_t *enc_status
+		);
+
+/**************************************************************************//**
+@Function	ipsec_burst_done
+
+@Description	This function adds the segments and bytes of a burst to the
+		lifetime counters of its SA, in a single update, and clears
+		the burst counts.
+
+@Param[in,out]	burst - Burst of segments.
+
+@Return		None.
+
+@Cautions	Lifetime limits are checked against the counters of the SA
+		and the segments of the burst itself: the segments of other
+		bursts in progress on the same SA are seen when these bursts
+		are done.
+*//****************************************************************************/
+void ipsec_burst_done(struct ipsec_burst *burst);
+
+/**************************************************************************//**
+@Function	ipsec_get_encap_overhead
+
+@Description	This function returns the maximum growth of a frame encrypted
+		with an outbound SA: outer IP and UDP headers (tunnel mode),
+		UDP header (transport mode with NAT-T), ESP header, IV,
+		padding, ESP trailer and ICV.
+		E.g. the TCP MSS of frames to be segmented (GSO) and encrypted
+		is the MSS of the link minus this overhead.
+
+@Param[in]	ipsec_handle - IPsec handle.
+@Param[out]	overhead - Maximum frame growth, in bytes.
+
+@Return		IPSEC_SUCCESS, -EINVAL for an inbound SA.
+
+*//****************************************************************************/
+int ipsec_get_encap_overhead(
+		ipsec_handle_t ipsec_handle,
+		uint16_t *overhead);
+
 /**************************************************************************//**
 @Function	ipsec_force_seconds_lifetime_expiry
 
@@ -804,6 +947,45 @@ int ipsec_force_seconds_lifetime_expiry(
 		ipsec_handle_t ipsec_handle);
 
 
+/**************************************************************************//**
+@Function	ipsec_get_sd_tmpl_stats
+
+@Description	This function returns the statistics of the shared descriptor
+		templates.
+
+		The SEC shared descriptors of the SAs of a same algorithm suite
+		(algorithms, key lengths, direction, mode and options) differ
+		only in their keys, SPI, sequence numbers, IV/salt and tunnel
+		header. ipsec_add_sa_descriptor() keeps the shared descriptor
+		of the first SA of a suite as a template; the next SAs of the
+		suite get a copy of the template with their fields written in,
+		instead of a full RTA construction. Up to 16 suites are kept.
+
+		The templates are disabled by the IPSEC_SD_TEMPLATES_DISABLE
+		application configuration option.
+
+		The average generation time of the hits and misses gives the
+		shared descriptor part of the SA install rate.
+
+@Param[out]	stats - Statistics.
+
+@Return		IPSEC_SUCCESS
+
+*//****************************************************************************/
+int ipsec_get_sd_tmpl_stats(struct ipsec_sd_tmpl_stats *stats);
+
+/**************************************************************************//**
+@Function	ipsec_flush_sd_tmpl
+
+@Description	This function removes all the shared descriptor templates and
+		clears their statistics. The next SA of each suite is built by
+		the RTA.
+
+@Return		None.
+
+*//****************************************************************************/
+void ipsec_flush_sd_tmpl(void);
+
 /** @} */ /* end of FSL_IPSEC_Functions */
 /** @} */ /* end of FSL_IPSEC */
 /** @} */ /* end of NETF */
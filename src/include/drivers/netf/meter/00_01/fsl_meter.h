@@ -0,0 +1,385 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fsl_meter.h
+
+@Description	This file contains the AIOP SW srTCM/trTCM meter API
+
+*//***************************************************************************/
+
+#ifndef __FSL_METER_H
+#define __FSL_METER_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		NETF NETF (Network Libraries)
+
+ @Description	AIOP Accelerator APIs
+
+ @{
+*//***************************************************************************/
+/**************************************************************************//**
+@Group		FSL_METER METER
+
+@Description	AIOP software meters: single rate (srTCM, RFC 2697) and two
+		rate (trTCM, RFC 2698) three color markers.
+
+		Meters are grouped in meter tables. The state of the meters
+		(bucket levels and time of the last update) and their per
+		color packet counters are kept in DDR or PEB. A meter is
+		updated under a CDMA mutex on its state, with the time taken
+		from the TMAN timestamp.
+
+		The rates and burst sizes are kept in meter profiles, shared by
+		the meters of a table. Changing a profile reconfigures all the
+		meters using it with a single write.
+
+		A classifier selects a meter by storing a meter reference
+		(#METER_REF) in a table rule result, e.g. in the opaque
+		fields, and passing it to meter_color_ref().
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group	METER_MACROS METER Macros
+
+@Description	METER Macros
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	Meter table handle Type definition
+
+ *//***************************************************************************/
+typedef uint8_t meter_table_handle_t;
+
+	/** Maximum number of meter tables */
+#define METER_MAX_TABLES		16
+	/** Maximum number of meters in a table */
+#define METER_MAX_METERS		0x01000000
+	/** Maximum number of profiles in a table */
+#define METER_MAX_PROFILES		1024
+	/** Maximum rate (bytes/second, 200 Gbps) */
+#define METER_MAX_RATE			25000000000ULL
+	/** Maximum burst size (bytes) */
+#define METER_MAX_BURST			0x7FFFFFFF
+
+	/** Meter reference: 32 bit value selecting a meter of a table, to be
+	 * stored in a classification result */
+#define METER_REF(_table, _meter_id) \
+	(((uint32_t)(_table) << 24) | ((uint32_t)(_meter_id) & 0x00FFFFFF))
+
+/** @} */ /* end of group METER_MACROS */
+
+/**************************************************************************//**
+@Group		METER_STRUCTS METER Data Structures
+
+@Description	AIOP METER Data Structures
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	Packet colors
+*//***************************************************************************/
+enum meter_color {
+	/** Green: the packet conforms to the committed rate */
+	METER_GREEN = 0,
+	/** Yellow: the packet exceeds the committed rate but conforms to
+	 * the excess burst (srTCM) or to the peak rate (trTCM) */
+	METER_YELLOW,
+	/** Red: the packet does not conform */
+	METER_RED
+};
+
+/**************************************************************************//**
+@Description	Meter algorithms
+*//***************************************************************************/
+enum meter_algorithm {
+	/** Single rate three color marker (RFC 2697) */
+	METER_SRTCM = 0,
+	/** Two rate three color marker (RFC 2698) */
+	METER_TRTCM
+};
+
+/**************************************************************************//**
+@Description	Meter table parameters
+*//***************************************************************************/
+struct meter_table_params {
+	/** Number of meters, up to #METER_MAX_METERS */
+	uint32_t num_meters;
+	/** Number of profiles, up to #METER_MAX_PROFILES */
+	uint16_t num_profiles;
+	/** \link FSL_METERTableFlags meter table flags \endlink */
+	uint16_t flags;
+};
+
+/**************************************************************************//**
+@Description	Meter profile parameters
+*//***************************************************************************/
+struct meter_profile_params {
+	/** Committed Information Rate (bytes/second), at least 16 */
+	uint64_t cir;
+	/** Peak Information Rate (bytes/second), trTCM only. Must not be
+	 * lower than cir. */
+	uint64_t pir;
+	/** Committed Burst Size (bytes) */
+	uint32_t cbs;
+	/** Excess Burst Size (srTCM) or Peak Burst Size (trTCM) (bytes) */
+	uint32_t ebs;
+	/** Meter algorithm */
+	enum meter_algorithm algorithm;
+	/** \link FSL_METERProfileFlags meter profile flags \endlink */
+	uint32_t flags;
+};
+
+/**************************************************************************//**
+@Description	Meter statistics
+*//***************************************************************************/
+struct meter_stats {
+	/** Packets marked green */
+	uint64_t green;
+	/** Packets marked yellow */
+	uint64_t yellow;
+	/** Packets marked red */
+	uint64_t red;
+};
+
+/** @} */ /* end of group METER_STRUCTS */
+
+/**************************************************************************//**
+@Group		FSL_METER_Modes_And_Flags METER Modes And Flags
+
+@Description	AIOP METER Modes And Flags
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		FSL_METERTableFlags meter table flags
+
+@Description	Meter table flags
+
+@{
+*//***************************************************************************/
+	/** Meters in DP DDR, or in system DDR if there is no DP DDR */
+#define METER_TABLE_LOCATION_DDR	0x0000
+	/** Meters in PEB */
+#define METER_TABLE_LOCATION_PEB	0x0001
+
+/** @} */ /* end of group FSL_METERTableFlags */
+
+/**************************************************************************//**
+@Group		FSL_METERProfileFlags meter profile flags
+
+@Description	Meter profile flags
+
+@{
+*//***************************************************************************/
+	/** Color blind mode: the color of the packet is ignored */
+#define METER_PROFILE_COLOR_BLIND	0x00000000
+	/** Color aware mode: a pre-colored packet can only be marked with its
+	 * color or a worse one */
+#define METER_PROFILE_COLOR_AWARE	0x00000001
+
+/** @} */ /* end of group FSL_METERProfileFlags */
+
+/** @} */ /* end of group FSL_METER_Modes_And_Flags */
+
+/**************************************************************************//**
+@Group		FSL_METER_Functions METER functions
+
+@Description	AIOP METER functions
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Function	meter_table_create
+
+@Description	Creates a meter table. The meters are not configured: they
+		mark all the packets green until meter_config() is called.
+
+@Param[in]	params - Table parameters.
+@Param[out]	table - Handle of the created table.
+
+@Return		0 on success, negative value on error.
+
+@Retval		EINVAL - invalid parameters.
+@Retval		ENOSPC - all the tables are in use.
+@Retval		ENOMEM - not enough memory for the meters.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int meter_table_create(struct meter_table_params *params,
+		       meter_table_handle_t *table);
+
+/**************************************************************************//**
+@Function	meter_table_delete
+
+@Description	Deletes a meter table. The table must not be used by other
+		tasks.
+
+@Param[in]	table - Table handle.
+
+@Return		None.
+*//***************************************************************************/
+void meter_table_delete(meter_table_handle_t table);
+
+/**************************************************************************//**
+@Function	meter_profile_set
+
+@Description	Sets the rates and burst sizes of a profile. All the meters
+		using the profile take the new values on their next packet;
+		the buckets are trimmed to the new burst sizes.
+
+@Param[in]	table - Table handle.
+@Param[in]	profile_id - Profile ID.
+@Param[in]	params - Profile parameters.
+
+@Return		0 on success, -EINVAL on invalid parameters.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int meter_profile_set(meter_table_handle_t table, uint16_t profile_id,
+		      struct meter_profile_params *params);
+
+/**************************************************************************//**
+@Function	meter_config_range
+
+@Description	Attaches a range of meters to a profile. The buckets of the
+		meters are filled and their counters are cleared.
+
+@Param[in]	table - Table handle.
+@Param[in]	first_meter_id - First meter of the range.
+@Param[in]	num_meters - Number of meters.
+@Param[in]	profile_id - Profile ID. The profile must be set.
+
+@Return		0 on success, -EINVAL on invalid parameters.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int meter_config_range(meter_table_handle_t table, uint32_t first_meter_id,
+		       uint32_t num_meters, uint16_t profile_id);
+
+/**************************************************************************//**
+@Function	meter_config
+
+@Description	Attaches a meter to a profile. See meter_config_range().
+
+@Param[in]	table - Table handle.
+@Param[in]	meter_id - Meter ID.
+@Param[in]	profile_id - Profile ID.
+
+@Return		0 on success, -EINVAL on invalid parameters.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int meter_config(meter_table_handle_t table, uint32_t meter_id,
+		 uint16_t profile_id);
+
+/**************************************************************************//**
+@Function	meter_color
+
+@Description	Meters a packet: refills the buckets of the meter for the time
+		elapsed since its last update, then marks the packet and takes
+		its length from the buckets.
+
+@Param[in]	table - Table handle.
+@Param[in]	meter_id - Meter ID.
+@Param[in]	length - Packet length (bytes).
+@Param[in]	in_color - Color of the packet, used in color aware mode.
+		Use METER_GREEN for packets that were not pre-colored.
+
+@Return		Color of the packet (\ref meter_color).
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+enum meter_color meter_color(meter_table_handle_t table, uint32_t meter_id,
+			     uint32_t length, enum meter_color in_color);
+
+/**************************************************************************//**
+@Function	meter_color_ref
+
+@Description	Meters a packet with the meter selected by a meter reference,
+		e.g. found in a classification result. See meter_color().
+
+@Param[in]	meter_ref - Meter reference (#METER_REF).
+@Param[in]	length - Packet length (bytes).
+@Param[in]	in_color - Color of the packet.
+
+@Return		Color of the packet (\ref meter_color).
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+enum meter_color meter_color_ref(uint32_t meter_ref, uint32_t length,
+				 enum meter_color in_color);
+
+/**************************************************************************//**
+@Function	meter_color_frame
+
+@Description	Meters the default frame, with the frame length from the FD.
+		See meter_color().
+
+@Param[in]	table - Table handle.
+@Param[in]	meter_id - Meter ID.
+@Param[in]	in_color - Color of the packet.
+
+@Return		Color of the packet (\ref meter_color).
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+enum meter_color meter_color_frame(meter_table_handle_t table,
+				   uint32_t meter_id,
+				   enum meter_color in_color);
+
+/**************************************************************************//**
+@Function	meter_get_stats
+
+@Description	Reads the per color packet counters of a meter.
+
+@Param[in]	table - Table handle.
+@Param[in]	meter_id - Meter ID.
+@Param[out]	stats - Meter statistics.
+@Param[in]	reset - Clear the counters after reading them. Packets
+		marked by other tasks during the read may be lost.
+
+@Return		0 on success, -EINVAL on invalid parameters.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int meter_get_stats(meter_table_handle_t table, uint32_t meter_id,
+		    struct meter_stats *stats, int reset);
+
+/** @} */ /* end of group FSL_METER_Functions */
+/** @} */ /* end of group FSL_METER */
+/** @} */ /* end of group NETF */
+
+#endif /* __FSL_METER_H */
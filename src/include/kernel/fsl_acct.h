@@ -0,0 +1,157 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @file          fsl_acct.h
+
+ @details       Contains AIOP SL accelerator cycle accounting API.
+ *//***************************************************************************/
+
+#ifndef __FSL_ACCT_H
+#define __FSL_ACCT_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		acct_g Accelerator Cycle Accounting
+
+ @Description	Per entry point and per accelerator time accounting.
+
+		When ENABLE_ACCEL_ACCOUNTING is defined in build_flags.h, the
+		service layer samples the core time base around every
+		accelerator call and at the start and the end of every task.
+		The time is accumulated in per core counters, for the entry
+		point the task was started by:
+		- the number of tasks and their elapsed time,
+		- per accelerator ID, the number of calls and the time the
+		task waited for the accelerator.
+		The difference between the task time and the accelerator time
+		is the time spent on the core, showing whether an entry point
+		is accelerator or core bound.
+
+		The network interface entry points are accounted as
+		ACCT_EP_APP by sl_prolog(). Other entry points must call
+		ACCT_TASK_START() first.
+
+		When ENABLE_ACCEL_ACCOUNTING is not defined, nothing is
+		compiled in the accelerator calls and ACCT_TASK_START()
+		expands to nothing.
+
+ @{
+*//***************************************************************************/
+
+/**************************************************************************//**
+ @Group		ACCT_EP Accounted Entry Points
+ @{
+*//***************************************************************************/
+/** Network interface entry points (sl_prolog()) */
+#define ACCT_EP_APP		0
+/** sNIC entry point */
+#define ACCT_EP_SNIC		1
+/** Command interface server entry point */
+#define ACCT_EP_CMDIF_SRV	2
+/** Free for application entry points (e.g. timer call-backs) */
+#define ACCT_EP_USER		3
+/** Number of accounted entry points */
+#define ACCT_EP_NUM		4
+/** @} */ /* end of ACCT_EP */
+
+/** Number of accelerator IDs (see AIOP_Accelerators_IDS) */
+#define ACCT_ACCEL_NUM		16
+
+/**************************************************************************//**
+@Description	Per core, per entry point counters. Time is in time base
+		ticks.
+*//***************************************************************************/
+struct acct_cntrs {
+	/** Elapsed time of the tasks, from start to termination */
+	uint64_t	task_cycles;
+	/** Number of terminated tasks */
+	uint32_t	tasks;
+	/** Reserved */
+	uint32_t	reserved;
+	/** Time waiting for each accelerator */
+	uint64_t	accel_cycles[ACCT_ACCEL_NUM];
+	/** Number of calls to each accelerator */
+	uint32_t	accel_calls[ACCT_ACCEL_NUM];
+};
+
+#ifdef ENABLE_ACCEL_ACCOUNTING
+#define ACCT_TASK_START_ACCEL(_ep)	acct_task_start(_ep)
+#else
+#define ACCT_TASK_START_ACCEL(_ep)
+#endif /* ENABLE_ACCEL_ACCOUNTING */
+
+/** Account the current task to an entry point (ACCT_EP_USER, ...).
+ * Must be called at the beginning of the entry point function. The network
+ * interface and sNIC entry points are the data path of the allocation
+ * profiler (fsl_alloc_prof.h). */
+#define ACCT_TASK_START(_ep)						\
+	do {								\
+		ACCT_TASK_START_ACCEL(_ep);				\
+		ALLOC_PROF_TASK_START((_ep) == ACCT_EP_APP ||		\
+				      (_ep) == ACCT_EP_SNIC);		\
+	} while (0)
+
+/**************************************************************************//**
+@Function	acct_task_start
+
+@Description	Start accounting the current task to an entry point. Called
+		through ACCT_TASK_START().
+
+@Param[in]	ep - Entry point, one of \ref ACCT_EP.
+
+@Return		None.
+*//***************************************************************************/
+inline void acct_task_start(uint8_t ep);
+
+/**************************************************************************//**
+@Function	acct_reset
+
+@Description	Clear the accounting counters of all the cores.
+
+@Return		None.
+
+@Cautions	Counters updated by tasks running concurrently may be lost.
+*//***************************************************************************/
+void acct_reset(void);
+
+/**************************************************************************//**
+@Function	acct_print
+
+@Description	Print the accounting counters, summed over all the cores, to
+		the AIOP console and log.
+
+@Return		None.
+*//***************************************************************************/
+void acct_print(void);
+
+/** @} */ /* end of acct_g Accelerator Cycle Accounting group */
+
+#include "fsl_sl_acct.h"
+#include "fsl_sl_alloc_prof.h"
+
+#endif /* __FSL_ACCT_H */
@@ -0,0 +1,234 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//**
+ @file          fsl_alloc_prof.h
+
+ @details       Contains AIOP SL allocation profiling API.
+ *//***************************************************************************/
+
+#ifndef __FSL_ALLOC_PROF_H
+#define __FSL_ALLOC_PROF_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		alloc_prof_g Allocation Profiling
+
+ @Description	Per call site memory allocation statistics.
+
+		When ENABLE_ALLOC_PROFILING is defined in build_flags.h, the
+		calls to fsl_malloc()/fsl_free(), fsl_get_mem()/fsl_put_mem(),
+		slab_acquire()/slab_release() and
+		cdma_acquire_context_memory()/cdma_release_context_memory()
+		are wrapped to record their call site (file and line). For
+		each allocation call site the profiler counts:
+		- allocations, failed allocations and releases (a release is
+		accounted to the call site which allocated the memory),
+		- allocated bytes, live bytes and peak live bytes (the size of
+		slab and CDMA context memory buffers is not known at the call
+		site, only the live and peak live buffers are counted),
+		- allocations made by a task started by a data path entry
+		point: network interfaces (sl_prolog()) and the sNIC.
+
+		A call site allocating in the data path with another function
+		than slab_acquire() is flagged with
+		ALLOC_PROF_FLG_DP_NOT_SLAB: the allocation is not served by a
+		slab and should be moved out of the data path.
+
+		The calls are first recorded in a per core buffer. The buffer
+		of a core is aggregated in the call site statistics each time
+		it is full. The buffers of all the cores are aggregated every
+		100 ms by a TMAN timer, and by alloc_prof_aggregate(). A
+		release aggregated before its allocation (made on another
+		core) is matched when the allocation is aggregated.
+
+		The GPP reads the statistics through the
+		\ref ALLOC_PROF_MODULE_NAME cmdif module, see
+		alloc_prof_register_cmdif().
+
+		When ENABLE_ALLOC_PROFILING is not defined, nothing is
+		compiled in the allocation calls.
+
+ @{
+*//***************************************************************************/
+
+/** Name of the cmdif module of the allocation profiler */
+#define ALLOC_PROF_MODULE_NAME	"MEMPROF"
+
+/** Maximum number of profiled call sites. The allocations of the call sites
+ * that do not fit are accounted to the last one, with an empty file name. */
+#define ALLOC_PROF_MAX_SITES	64
+
+/** Length of the file name of a call site (last characters of the path,
+ * including the terminating NULL) */
+#define ALLOC_PROF_FILE_LEN	32
+
+/**************************************************************************//**
+ @Group		ALLOC_PROF_KIND Allocation Functions
+ @{
+*//***************************************************************************/
+/** fsl_malloc() / fsl_free() */
+#define ALLOC_PROF_KIND_MALLOC		0
+/** fsl_get_mem() / fsl_put_mem() */
+#define ALLOC_PROF_KIND_GET_MEM		1
+/** slab_acquire() / slab_release() */
+#define ALLOC_PROF_KIND_SLAB		2
+/** cdma_acquire_context_memory() / cdma_release_context_memory() */
+#define ALLOC_PROF_KIND_CDMA		3
+/** @} */ /* end of ALLOC_PROF_KIND */
+
+/** Call site allocating in the data path, not from a slab */
+#define ALLOC_PROF_FLG_DP_NOT_SLAB	0x01
+
+/**************************************************************************//**
+@Description	Statistics of an allocation call site
+*//***************************************************************************/
+struct alloc_prof_site_info {
+	/** Last characters of the file name */
+	char		file[ALLOC_PROF_FILE_LEN];
+	/** Line of the call */
+	uint32_t	line;
+	/** Allocation function, one of \ref ALLOC_PROF_KIND */
+	uint8_t		kind;
+	/** ALLOC_PROF_FLG_DP_NOT_SLAB */
+	uint8_t		flags;
+	/** Reserved */
+	uint16_t	reserved;
+	/** Successful allocations */
+	uint32_t	allocs;
+	/** Failed allocations */
+	uint32_t	failures;
+	/** Releases of the memory allocated at this call site */
+	uint32_t	frees;
+	/** Allocations made in the data path */
+	uint32_t	dp_allocs;
+	/** Live allocations */
+	uint32_t	live;
+	/** Peak live allocations */
+	uint32_t	peak;
+	/** Allocated bytes */
+	uint64_t	bytes;
+	/** Live bytes */
+	uint64_t	live_bytes;
+	/** Peak live bytes */
+	uint64_t	peak_bytes;
+};
+
+/**************************************************************************//**
+@Description	Global allocation profiling statistics
+*//***************************************************************************/
+struct alloc_prof_summary {
+	/** Number of call sites */
+	uint16_t	num_sites;
+	/** Number of call sites flagged with ALLOC_PROF_FLG_DP_NOT_SLAB */
+	uint16_t	dp_not_slab_sites;
+	/** Releases of memory which allocation was not recorded (allocated
+	 * before a reset, or not tracked). Includes the releases waiting for
+	 * their allocation, recorded on another core and not aggregated
+	 * yet. */
+	uint32_t	unmatched_frees;
+	/** Allocations not tracked for the live counts, the tracking table
+	 * was full */
+	uint32_t	untracked;
+	/** Recorded allocation and release calls */
+	uint32_t	events;
+};
+
+/**************************************************************************//**
+@Function	alloc_prof_aggregate
+
+@Description	Aggregate the calls recorded in the buffers of all the cores
+		in the call site statistics.
+
+@Return		None.
+*//***************************************************************************/
+void alloc_prof_aggregate(void);
+
+/**************************************************************************//**
+@Function	alloc_prof_get_summary
+
+@Description	Aggregate the recorded calls and return the global
+		statistics.
+
+@Param[out]	summary - Global statistics.
+
+@Return		0 on success, -ENAVAIL if the profiling is disabled.
+*//***************************************************************************/
+int alloc_prof_get_summary(struct alloc_prof_summary *summary);
+
+/**************************************************************************//**
+@Function	alloc_prof_get_site
+
+@Description	Return the statistics of a call site, as of the last
+		aggregation.
+
+@Param[in]	index - Call site index, lower than the num_sites of the
+		summary.
+@Param[out]	info - Call site statistics.
+
+@Return		0 on success, -EINVAL for an invalid index, -ENAVAIL if the
+		profiling is disabled.
+*//***************************************************************************/
+int alloc_prof_get_site(uint16_t index, struct alloc_prof_site_info *info);
+
+/**************************************************************************//**
+@Function	alloc_prof_reset
+
+@Description	Clear the recorded calls and the statistics. The memory
+		allocated before is not tracked any more: its releases are
+		counted as unmatched.
+
+@Return		None.
+*//***************************************************************************/
+void alloc_prof_reset(void);
+
+/**************************************************************************//**
+@Function	alloc_prof_print
+
+@Description	Aggregate the recorded calls and print the call site
+		statistics to the AIOP console and log. The call sites flagged
+		with ALLOC_PROF_FLG_DP_NOT_SLAB are printed first.
+
+@Return		None.
+*//***************************************************************************/
+void alloc_prof_print(void);
+
+/**************************************************************************//**
+@Function	alloc_prof_register_cmdif
+
+@Description	Register the \ref ALLOC_PROF_MODULE_NAME cmdif module, so that
+		the GPP can read the statistics. The commands are defined in
+		fsl_alloc_prof_cmd.h.
+
+		Must be called from the application initialization.
+
+@Return		0 on success, error code of cmdif_register_module() otherwise.
+*//***************************************************************************/
+int alloc_prof_register_cmdif(void);
+
+/** @} */ /* end of alloc_prof_g Allocation Profiling group */
+
+#endif /* __FSL_ALLOC_PROF_H */
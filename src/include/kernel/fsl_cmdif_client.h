@@ -55,12 +55,45 @@
 /**< Bit to be used for cmd_id to identify asynchronous commands */
 #define CMDIF_NORESP_CMD	0x1000
 /**< Bit to be used for commands that don't need response */
+#define CMDIF_SG_CMD		0x0800
+/**< Bit to be used for commands which data is a #cmdif_sg_table of
+ * buffers instead of the payload, for large payloads */
 
 /** @} end of group CMDIF_SEND_ATTRIBUTES */
 
 
 #define CMDIF_OPEN_SIZE		64  /**< cmdif_open() default size */
 
+/**************************************************************************//**
+@Description	Data of the #CMDIF_SG_CMD commands.
+
+		The data of the command starts with this header, followed by
+		num_entries #cmdif_sg_entry, in AIOP (big endian) byte order.
+		The payload is the concatenation of the buffers of the entries.
+		The table and the buffers must remain valid until the command
+		is done.
+*//***************************************************************************/
+struct cmdif_sg_table {
+	uint32_t length;
+	/**< Payload length in bytes, at most the sum of the entries
+	 * lengths */
+	uint16_t num_entries;
+	/**< Number of entries following the header */
+	uint16_t reserved;
+};
+
+/**************************************************************************//**
+@Description	Buffer of the payload of a #CMDIF_SG_CMD command.
+*//***************************************************************************/
+struct cmdif_sg_entry {
+	uint64_t addr;
+	/**< Buffer address, accessed with the isolation context of the
+	 * command */
+	uint32_t length;
+	/**< Buffer length in bytes */
+	uint32_t reserved;
+};
+
 /**************************************************************************//**
 @Description   Command interface descriptor.
 *//***************************************************************************/
@@ -166,7 +199,7 @@ int cmdif_close(struct cmdif_desc *cidesc);
 @Param[in]	cidesc     Command interface descriptor which was setup by
 		cmdif_open().
 @Param[in]	cmd_id     Id which represent command on the module that was
-		registered on Server; Application may use bits 11-0.
+		registered on Server; Application may use bits 10-0.
 		See \ref CMDIF_SEND_ATTRIBUTES.
 @Param[in]	size       Size of the data including extra 16 bytes for 
 		\ref cmdif_cb_t in case of \ref CMDIF_ASYNC_CMD.
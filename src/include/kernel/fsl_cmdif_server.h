@@ -33,6 +33,9 @@
 #ifndef __FSL_CMDIF_SERVER_H
 #define __FSL_CMDIF_SERVER_H
 
+#include "fsl_cmdif_client.h"
+#include "fsl_icontext.h"
+
 /**************************************************************************//**
 @Group         cmdif_server_g  Command Interface - Server
 
@@ -44,6 +47,9 @@
 #define CMDIF_SESSION_OPEN_SIZE		64
 /**< cmdif_session_open() default size */
 
+#define CMDIF_SG_BATCH			2
+/**< Number of #cmdif_sg_entry read at once by the #CMDIF_SG_CMD iterator */
+
 struct cmdif_desc;
 
 /**************************************************************************//**
@@ -83,16 +89,49 @@ User provides this function. Driver invokes it for all runtime commands
 @Param[in]	size - Size of the data.
 		On the AIOP side use PRC_GET_SEGMENT_LENGTH() to determine the
 		size of presented data.
+		For #CMDIF_SG_CMD commands, the payload length.
 @Param[in]	data - Data of the command.
 		AIOP server will pass here address to the start of presentation
 		segment - physical address is the same as virtual.
 		On AIOP use fdma_modify_default_segment_data() if needed.
 		On GPP, it should be virtual address that belongs
 		to current SW context.
+		For #CMDIF_SG_CMD commands, AIOP server will pass here a
+		#cmdif_sg_iter over the payload, see cmdif_sg_read().
 @Return		OK on success; error code, otherwise.
  *//***************************************************************************/
 typedef int (ctrl_cb_t)(void *dev, uint16_t cmd, uint32_t size, void *data);
 
+/**************************************************************************//**
+@Description	Iterator over the payload of a #CMDIF_SG_CMD command.
+
+		The payload is read directly from the client buffers, at the
+		pace of the control callback and only when it asks for it; the
+		client gets a single response once the callback returns.
+		Do not modify the content of this structure.
+*//***************************************************************************/
+struct cmdif_sg_iter {
+	struct icontext ic;
+	/**< Isolation context of the client, to be used with
+	 * icontext_dma_read() on the spans returned by cmdif_sg_next() */
+	uint64_t table;
+	/**< Client address of the next entries to read */
+	uint64_t addr;
+	/**< Client address of the rest of the current entry */
+	uint32_t entry_left;
+	/**< Bytes left in the current entry */
+	uint32_t left;
+	/**< Payload bytes not yet returned */
+	uint16_t entries;
+	/**< Entries not yet read */
+	uint16_t cached;
+	/**< Valid entries in cache */
+	uint16_t next;
+	/**< Next entry of cache */
+	struct cmdif_sg_entry cache[CMDIF_SG_BATCH];
+	/**< Entries read from the table */
+};
+
 /**************************************************************************//**
 @Description	Function pointers to be supplied during module registration
  *//***************************************************************************/
@@ -207,6 +246,45 @@ This functionality is relevant only for GPP.
  *//***************************************************************************/
 int cmdif_srv_cb(int pr, void *send_dev);
 
+/**************************************************************************//**
+@Function	cmdif_sg_read
+
+@Description	Copy the next bytes of the payload of a #CMDIF_SG_CMD command
+		into the workspace.
+
+		The data is read with DMA from the client buffers, across
+		entries, without intermediate copies.
+		This functionality is relevant only for AIOP.
+
+@Param[in]	it   - Iterator received by #ctrl_cb_t.
+@Param[out]	dest - Workspace buffer.
+@Param[in]	size - Size of dest in bytes.
+
+@Return		Number of bytes copied, less than size only at the end of the
+		payload (0 once it was all read);
+		-EINVAL - the table holds less than the payload length.
+ *//***************************************************************************/
+int cmdif_sg_read(struct cmdif_sg_iter *it, void *dest, uint16_t size);
+
+/**************************************************************************//**
+@Function	cmdif_sg_next
+
+@Description	Get the next contiguous span of the payload of a
+		#CMDIF_SG_CMD command, without reading it.
+
+		Use it to move the payload from the client buffers to its
+		destination directly, e.g. with icontext_dma_read() and it->ic
+		into the workspace or with CDMA into DDR.
+		This functionality is relevant only for AIOP.
+
+@Param[in]	it   - Iterator received by #ctrl_cb_t.
+@Param[in]	max  - Maximal span size in bytes, not 0.
+@Param[out]	addr - Client address of the span.
+
+@Return		Span size in bytes, at most max (0 at the end of the payload);
+		-EINVAL - the table holds less than the payload length.
+ *//***************************************************************************/
+int cmdif_sg_next(struct cmdif_sg_iter *it, uint32_t max, uint64_t *addr);
 
 /** @} *//* end of cmdif_server_g group */
 
@@ -0,0 +1,155 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @file          fsl_lazy.h
+
+ @details       Contains AIOP SL lazy module initialization API declarations.
+ *//***************************************************************************/
+
+#ifndef __FSL_LAZY_H
+#define __FSL_LAZY_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		lazy_g Lazy Module Initialization
+
+ @Description	Optional modules initialized on their first use.
+
+		A module that is not needed by every application (e.g. the
+		IPsec or CAPWAP/DTLS buffer pools) registers a lazy module at
+		early initialization instead of being initialized in
+		global_init(). It declares the memory that its initialization
+		reserves. The initialization function is called by the first
+		lazy_init() call, typically from the module create_instance
+		function.
+
+		The initialization reserves memory (e.g. PEB) and sends MC
+		commands, so it must run at boot: the first lazy_init() call
+		must be made before the end of the boot (sys.runtime_flag not
+		set). A module which may be used first at run time (e.g.
+		created by GPP commands) is initialized from a post_init
+		function of global_post_init() when an application declared
+		its use at early initialization. At run time lazy_init() only
+		returns the result of the boot initialization.
+
+		lazy_init() is safe under concurrent calls from several tasks:
+		the first caller runs the initialization under a CDMA mutex,
+		the other callers wait for it to complete. Once the module is
+		initialized lazy_init() only reads its state.
+
+		lazy_report() prints which modules were initialized, their
+		initialization time and their memory.
+
+ @{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Description	Lazy module state
+*//***************************************************************************/
+enum lazy_state {
+	/** Not initialized yet (or the initialization failed) */
+	LAZY_NOT_INITIALIZED = 0,
+	/** Initialized */
+	LAZY_INITIALIZED
+};
+
+/**************************************************************************//**
+@Description	Lazy module. Must be in the shared memory, it is defined
+		with LAZY_MODULE_DEFINE().
+*//***************************************************************************/
+struct lazy_module {
+	/** Module name, for the report */
+	const char		*name;
+	/** Initialization function, returns 0 on success */
+	int			(*init)(void);
+	/** Next registered module */
+	struct lazy_module	*next;
+	/** Memory reserved by the initialization (bytes), as declared by
+	 * lazy_register() */
+	uint64_t		mem_size;
+	/** Initialization time (micro-seconds) */
+	uint32_t		init_time;
+	/** Error of the last failed initialization */
+	int			err;
+	/** Number of initialization attempts */
+	uint32_t		attempts;
+	/** enum lazy_state */
+	volatile uint32_t	state;
+};
+
+/** Define a lazy module. Must be used at file scope. */
+#define LAZY_MODULE_DEFINE(_var, _name, _init)				\
+	struct lazy_module _var = {_name, _init}
+
+/**************************************************************************//**
+@Function	lazy_register
+
+@Description	Registers a lazy module and declares its resources. Called
+		at early initialization (e.g. from an early_init function of
+		global_early_init()), on the master core.
+
+@Param[in]	module - Lazy module.
+@Param[in]	mem_size - Memory reserved by the module initialization
+		(bytes), for the report.
+
+@Return		0 on success, -EEXIST if the module is already registered.
+*//***************************************************************************/
+int lazy_register(struct lazy_module *module, uint64_t mem_size);
+
+/**************************************************************************//**
+@Function	lazy_init
+
+@Description	Initializes a lazy module, if not done yet. The module does
+		not need to be registered.
+
+@Param[in]	module - Lazy module.
+
+@Return		0 if the module is initialized, otherwise the error of its
+		initialization function. A failed initialization is tried
+		again by the next call made at boot. At run time, -EACCES if
+		the module was never initialized.
+
+@Cautions	Must not be called from the module initialization function.
+@Cautions	The first call must be made at boot; a first call at run
+		time is asserted.
+*//***************************************************************************/
+int lazy_init(struct lazy_module *module);
+
+/**************************************************************************//**
+@Function	lazy_report
+
+@Description	Prints the registered lazy modules, their state,
+		initialization time and declared memory on the AIOP console.
+
+@Return		None.
+*//***************************************************************************/
+void lazy_report(void);
+
+/** @} */ /* end of lazy_g Lazy Module Initialization group */
+
+#endif /* __FSL_LAZY_H */
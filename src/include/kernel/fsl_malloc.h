@@ -164,4 +164,9 @@ void phys_mem_partition_dump(int partition_id);
 void virt_mem_partition_dump(int partition_id);
 #endif /* SL_DEBUG */
 
+#define __FSL_MALLOC_H_DONE
+
+/* Allocation profiling wrappers (ENABLE_ALLOC_PROFILING) */
+#include "fsl_sl_alloc_prof.h"
+
 #endif /* __FSL_MALLOC_H */
@@ -0,0 +1,185 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @file          fsl_prof.h
+
+ @details       Contains AIOP SL profiling regions API declarations.
+ *//***************************************************************************/
+
+#ifndef __FSL_PROF_H
+#define __FSL_PROF_H
+
+#include "fsl_types.h"
+
+/**************************************************************************//**
+ @Group		prof_g Profiling Regions
+
+ @Description	Named code regions measured with the core time base.
+
+		A region is defined once with PROF_REGION_DEFINE() and its
+		code is delimited by PROF_REGION_START() / PROF_REGION_STOP()
+		in the same function. For every region the service layer
+		counts the calls, the inclusive and exclusive (without nested
+		regions) elapsed time, the maximum elapsed time and a log2
+		histogram of the elapsed time.
+
+		The regions are placed in the ".prof_regions" section of the
+		Shared-RAM. Use misc/tools/prof_regions to decode a memory dump
+		of this section, or prof_regions_print() to print the results
+		on the AIOP console.
+
+		The markers are compiled only when ENABLE_PROF_REGIONS is
+		defined in build_flags.h. Otherwise they expand to nothing.
+
+ @{
+*//***************************************************************************/
+
+/** Number of buckets of the elapsed time histogram. Bucket 0 counts the
+ * calls shorter than 32 time base ticks, bucket n (n > 0) counts the calls
+ * in [2^(n+4), 2^(n+5)) ticks and the last bucket all the longer ones. */
+#define PROF_HIST_BUCKETS	16
+
+/**************************************************************************//**
+@Description	Profiling region. Located in the ".prof_regions" section.
+		The layout is decoded by misc/tools/prof_regions.
+*//***************************************************************************/
+struct prof_region {
+	/** Inclusive elapsed time (time base ticks) */
+	uint64_t	cycles;
+	/** Exclusive elapsed time (time base ticks) */
+	uint64_t	excl_cycles;
+	/** Region name */
+	const char	*name;
+	/** Number of completed calls */
+	uint32_t	calls;
+	/** Maximum elapsed time of one call (best effort) */
+	uint32_t	max_cycles;
+	/** Reserved */
+	uint32_t	reserved;
+	/** Elapsed time histogram */
+	uint32_t	hist[PROF_HIST_BUCKETS];
+};
+
+/**************************************************************************//**
+@Description	Active region of a task. Allocated on the stack by
+		PROF_REGION_START().
+*//***************************************************************************/
+struct prof_frame {
+	/** Region being measured */
+	struct prof_region	*region;
+	/** Enclosing active region of the task */
+	struct prof_frame	*parent;
+	/** Time base at region start */
+	uint32_t		start;
+	/** Time spent in nested regions */
+	uint32_t		child_cycles;
+};
+
+#ifdef ENABLE_PROF_REGIONS
+
+#pragma section RW ".prof_regions" ".prof_regions_bss"
+/** Profiling regions location */
+#define __PROF_REGION __declspec(section ".prof_regions")
+
+/** Define a profiling region. Must be used at file scope. */
+#define PROF_REGION_DEFINE(_name)					\
+	__PROF_REGION struct prof_region prof_region_##_name		\
+			__attribute__((aligned(8))) = {0, 0, #_name}
+
+/** Declare a profiling region defined in another file */
+#define PROF_REGION_EXTERN(_name)					\
+	extern struct prof_region prof_region_##_name
+
+/** Start measuring a region. Declares a local variable, so it must be
+ * placed where a declaration is allowed. */
+#define PROF_REGION_START(_name)					\
+	struct prof_frame prof_frame_##_name;				\
+	prof_region_start(&prof_region_##_name, &prof_frame_##_name)
+
+/** Stop measuring a region. Must be called on every path that leaves the
+ * region, in the function that started it. */
+#define PROF_REGION_STOP(_name)						\
+	prof_region_stop(&prof_frame_##_name)
+
+#else
+
+/* Expand to a valid declaration, the markers are followed by ';' */
+#define PROF_REGION_DEFINE(_name)	struct prof_region
+#define PROF_REGION_EXTERN(_name)	struct prof_region
+#define PROF_REGION_START(_name)
+#define PROF_REGION_STOP(_name)
+
+#endif /* ENABLE_PROF_REGIONS */
+
+/**************************************************************************//**
+@Function	prof_region_start
+
+@Description	Start measuring a region. Called through PROF_REGION_START().
+
+@Param[in]	region - Profiling region.
+@Param[out]	frame - Task frame of the region.
+
+@Return		None.
+*//***************************************************************************/
+void prof_region_start(struct prof_region *region, struct prof_frame *frame);
+
+/**************************************************************************//**
+@Function	prof_region_stop
+
+@Description	Stop measuring a region and account the elapsed time.
+		Called through PROF_REGION_STOP().
+
+@Param[in]	frame - Task frame filled by prof_region_start().
+
+@Return		None.
+*//***************************************************************************/
+void prof_region_stop(struct prof_frame *frame);
+
+/**************************************************************************//**
+@Function	prof_regions_reset
+
+@Description	Clear the counters of all the profiling regions.
+
+@Return		None.
+
+@Cautions	Counters updated by tasks running concurrently may be lost.
+*//***************************************************************************/
+void prof_regions_reset(void);
+
+/**************************************************************************//**
+@Function	prof_regions_print
+
+@Description	Print the counters of all the profiling regions on the AIOP
+		console.
+
+@Return		None.
+*//***************************************************************************/
+void prof_regions_print(void);
+
+/** @} */ /* end of prof_g Profiling Regions group */
+
+#endif /* __FSL_PROF_H */
@@ -0,0 +1,199 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//**
+@File		fsl_fd_batch.h
+
+@Description	Frame batch enqueue API
+*//***************************************************************************/
+
+#ifndef __FSL_FD_BATCH_H
+#define __FSL_FD_BATCH_H
+
+#include "fsl_types.h"
+#include "fsl_ldpaa.h"
+#include "fsl_fdma.h"
+
+/**************************************************************************//**
+@Group		fd_batch_g Frame Batch
+
+@Description	Enqueue of the frames produced by one task (fragments,
+		segments, flushed aggregations, copies).
+
+		A batch lives in the workspace of the task. It sends the
+		frames in the order they are given:
+		- a Working Frame is stored, closed and enqueued by a single
+		FDMA command.
+		- a copy of the Working Frame is made and enqueued by a single
+		FDMA command.
+		- the last frame can be enqueued with the terminate option, so
+		the task ends with its enqueue and not with an extra command.
+		It can also move the task to exclusive ordering mode first.
+
+		Frames that fail to be stored or enqueued are discarded and
+		counted by the batch.
+
+		fd_batch_replicate_default_frame() is available on LS2088A
+		and LS1088A. LS2085A has no conditional terminate: the last
+		frame of a terminate batch is enqueued and the task is then
+		terminated.
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		FD_BATCH_Flags Frame Batch Flags
+
+@Description	Flags of fd_batch_init()
+
+@{
+*//***************************************************************************/
+
+/** No flags */
+#define FD_BATCH_NO_FLAGS		0x00
+/** The task ends with the last frame: the last enqueue terminates the
+ * task. If it fails, the discard of the frame terminates the task. */
+#define FD_BATCH_TERMINATE		0x01
+/** Move the task to exclusive ordering mode (with scope ID increment)
+ * before the last enqueue, if it is in concurrent mode */
+#define FD_BATCH_EXCLUSIVE		0x02
+
+/** @} end of group FD_BATCH_Flags */
+
+/**************************************************************************//**
+@Group		FD_BATCH_Send_Flags Frame Batch Send Flags
+
+@Description	Flags of the send and flush functions
+
+@{
+*//***************************************************************************/
+
+/** The frame is the last frame of the batch */
+#define FD_BATCH_LAST			0x01
+
+/** @} end of group FD_BATCH_Send_Flags */
+
+/**************************************************************************//**
+@Description	Frame batch, in the workspace of the task
+*//***************************************************************************/
+struct fd_batch {
+	/** FD of the last copy of the Working Frame */
+	struct ldpaa_fd fd __attribute__((aligned(sizeof(struct ldpaa_fd))));
+	/** Number of frames given to the batch */
+	uint16_t	frames;
+	/** Number of discarded frames */
+	uint16_t	drops;
+	/** \ref FD_BATCH_Flags */
+	uint8_t		flags;
+};
+
+/**************************************************************************//**
+@Function	fd_batch_init
+
+@Description	Initializes a frame batch.
+
+@Param[in]	batch - Frame batch, in the workspace.
+@Param[in]	flags - \ref FD_BATCH_Flags.
+
+@Return		None.
+*//***************************************************************************/
+void fd_batch_init(struct fd_batch *batch, uint32_t flags);
+
+/**************************************************************************//**
+@Function	fd_batch_send_default_frame
+
+@Description	Stores, closes and enqueues the default Working Frame with a
+		single FDMA command.
+
+		The frame is discarded if it fails to be stored or enqueued.
+
+		Implicit input parameters in Task Defaults: frame handle, spid
+		(storage profile ID).
+
+@Param[in]	batch - Frame batch.
+@Param[in]	qdp - Queueing destination of the frame.
+@Param[in]	flags - \ref FD_BATCH_Send_Flags.
+
+@Return		0 on Success, or negative value on error (the frame was
+		discarded).
+@Retval		EBUSY - Enqueue failed due to congestion in QMAN.
+@Retval		ENOMEM - Failed due to buffer pool depletion.
+
+@Cautions	With \ref FD_BATCH_LAST and \ref FD_BATCH_TERMINATE the
+		function does not return.
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fd_batch_send_default_frame(
+		struct fd_batch *batch,
+		struct fdma_queueing_destination_params *qdp,
+		uint32_t flags);
+
+#ifndef LS2085A_REV1
+/**************************************************************************//**
+@Function	fd_batch_replicate_default_frame
+
+@Description	Enqueues a copy of the default Working Frame. The updates of
+		the Working Frame are stored, the frame is copied and the
+		copy is enqueued by a single FDMA command. The default
+		Working Frame stays open.
+
+		Implicit input parameters in Task Defaults: frame handle, spid
+		(storage profile ID).
+
+@Param[in]	batch - Frame batch.
+@Param[in]	qdp - Queueing destination of the copy.
+
+@Return		0 on Success, or negative value on error (the copy was
+		discarded).
+@Retval		EBUSY - Enqueue failed due to congestion in QMAN.
+@Retval		ENOMEM - Failed due to buffer pool depletion.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int fd_batch_replicate_default_frame(
+		struct fd_batch *batch,
+		struct fdma_queueing_destination_params *qdp);
+#endif /* LS2085A_REV1 */
+
+/**************************************************************************//**
+@Function	fd_batch_flush
+
+@Description	Ends the batch. With \ref FD_BATCH_LAST, a
+		\ref FD_BATCH_TERMINATE batch whose last frame was not sent
+		(the send failed or the frames ended early) terminates the
+		task.
+
+@Param[in]	batch - Frame batch.
+@Param[in]	flags - \ref FD_BATCH_Send_Flags.
+
+@Return		None.
+
+@Cautions	With \ref FD_BATCH_LAST and \ref FD_BATCH_TERMINATE the
+		function does not return.
+*//***************************************************************************/
+void fd_batch_flush(struct fd_batch *batch, uint32_t flags);
+
+/** @} */ /* end of fd_batch_g Frame Batch group */
+#endif /* __FSL_FD_BATCH_H */
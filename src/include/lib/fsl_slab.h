@@ -302,4 +302,9 @@ int slab_register_context_buffer_requirements(uint32_t    committed_buffs,
                                               uint32_t    num_ddr_pools);
 /** @} *//* end of slab_g group */
 
+#define __FSL_SLAB_H_DONE
+
+/* Allocation profiling wrappers (ENABLE_ALLOC_PROFILING) */
+#include "fsl_sl_alloc_prof.h"
+
 #endif /* __FSL_SLAB_H */
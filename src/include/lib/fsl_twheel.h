@@ -0,0 +1,205 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		fsl_twheel.h
+
+@Description	Timer wheel API
+*//***************************************************************************/
+
+#ifndef __FSL_TWHEEL_H
+#define __FSL_TWHEEL_H
+
+#include "fsl_types.h"
+#include "fsl_tman.h"
+
+/**************************************************************************//**
+@Group		twheel_g Timer Wheel
+
+@Description	Software timers multiplexed over a single TMAN instance.
+
+		The timers are kept in hierarchical timer wheels (4 levels of
+		64 slots), one wheel per AIOP core. Each wheel is advanced by
+		one periodic TMAN timer. The expired timers of a tick are
+		processed in a batch by the task of this TMAN timer: no TMAN
+		command is issued and no task is created per software timer.
+
+		A timer is created on the wheel of the calling core and can be
+		deleted or recharged from any core. Creating, deleting and
+		recharging a timer costs 2 CDMA commands, whatever the
+		number of active timers.
+
+		The API mirrors tman_create_timer() / tman_delete_timer() /
+		tman_recharge_timer(), so that a module can move its timers to
+		the timer wheel with few changes. The differences are:
+		- the duration is given in ticks of the timer wheel (see
+		twheel_early_init()), there are no granularity flags.
+		- the callback is called by the tick task and must return. It
+		must not call tman_timer_completion_confirmation() nor
+		fdma_terminate_task().
+		- a deleted timer keeps its memory until the wheel reaches it.
+
+@{
+*//***************************************************************************/
+
+/**************************************************************************//**
+@Group		TWHEEL_MACROS Timer Wheel Macros
+
+@Description	Timer wheel macros
+
+@{
+*//***************************************************************************/
+
+/** Maximum number of timers */
+#define TWHEEL_MAX_TIMERS		0x00FFFFFF
+/** Maximum duration of a timer, in ticks */
+#define TWHEEL_MAX_DURATION		0x00FFFFFF
+/** Default tick, in micro seconds */
+#define TWHEEL_DEFAULT_TICK		10000
+
+/** @} end of group TWHEEL_MACROS */
+
+/**************************************************************************//**
+@Group		TWHEELTimerCreateModeBits Timer wheel create flags
+
+@Description	Timer create flags.
+
+@{
+*//***************************************************************************/
+
+/** If set, the timer is a one-shot timer. Otherwise it is periodic. */
+#define TWHEEL_CREATE_TIMER_ONE_SHOT	TMAN_CREATE_TIMER_ONE_SHOT
+
+/** @} end of group TWHEELTimerCreateModeBits */
+
+/**************************************************************************//**
+@Description	Timer callback function. Same prototype as tman_cb_t.
+
+@Param[in]	arg1 - First argument given to twheel_create_timer().
+@Param[in]	arg2 - Second argument given to twheel_create_timer().
+
+@Cautions	The function is called by the task of the wheel tick, after
+		the timer was released (one-shot timer) or recharged
+		(periodic timer). It must return. It must close the frames and
+		release the resources it used. The other expired timers of
+		the tick wait for its return.
+*//***************************************************************************/
+typedef void (*twheel_cb_t)(tman_arg_8B_t arg1, tman_arg_2B_t arg2);
+
+/**************************************************************************//**
+@Function	twheel_early_init
+
+@Description	Reserves timers on the timer wheel. It may be called several
+		times, by several applications or modules. The timers and the
+		TMAN instance are allocated after all the early
+		initializations; no resource is used if this function is not
+		called.
+
+@Param[in]	nbr_of_timers - Number of timers needed by the caller.
+		All the callers share the sum of these timers.
+@Param[in]	tick - Tick of the wheels, in micro seconds. 0 selects
+		TWHEEL_DEFAULT_TICK. The smallest tick requested is used.
+		It must be a period of a TMAN timer: a multiple of 1 us, 100
+		us, 10 ms or 1 s, in the (10, 65526) range of the TMAN
+		duration.
+
+@Return		0 on success, or negative value on error.
+@Retval		EINVAL - Invalid tick.
+@Retval		ENOSPC - More than TWHEEL_MAX_TIMERS timers.
+
+@Cautions	This function may only be called from the early
+		initialization of an application (app_early_init).
+*//***************************************************************************/
+int twheel_early_init(uint32_t nbr_of_timers, uint32_t tick);
+
+/**************************************************************************//**
+@Function	twheel_create_timer
+
+@Description	Creates a timer on the wheel of the calling core.
+
+@Param[in]	flags - \link TWHEELTimerCreateModeBits Timer create
+		flags \endlink
+@Param[in]	duration - Timer duration, in wheel ticks, in the range
+		[1, TWHEEL_MAX_DURATION]. The timer expires on the
+		duration-th tick after its creation, i.e. after (duration - 1)
+		to duration ticks.
+@Param[in]	opaque_data1 - First argument of the callback function.
+@Param[in]	opaque_data2 - Second argument of the callback function.
+@Param[in]	cb - Callback function called when the timer expires.
+@Param[out]	timer_handle - Handle of the timer for future reference.
+
+@Return		0 on success, or negative value on error.
+@Retval		EINVAL - Invalid duration or callback.
+@Retval		ENOSPC - All the timers are used.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int twheel_create_timer(uint32_t flags, uint32_t duration,
+			tman_arg_8B_t opaque_data1, tman_arg_2B_t opaque_data2,
+			twheel_cb_t cb, uint32_t *timer_handle);
+
+/**************************************************************************//**
+@Function	twheel_delete_timer
+
+@Description	Deletes a timer. The callback of a deleted timer is not
+		called.
+
+@Param[in]	timer_handle - The handle of the timer to be deleted.
+@Param[in]	flags - Reserved, must be 0.
+
+@Return		0 on success, or negative value on error.
+@Retval		ETIMEDOUT - The one-shot timer expired: its callback is
+		running or has run.
+@Retval		ENAVAIL - The timer is not active (already deleted, or
+		expired and reused).
+
+@Cautions	In this function the task yields.
+		The callback of a periodic timer may be running when this
+		function returns.
+*//***************************************************************************/
+int twheel_delete_timer(uint32_t timer_handle, uint32_t flags);
+
+/**************************************************************************//**
+@Function	twheel_recharge_timer
+
+@Description	Restarts a timer with its duration, from the current tick of
+		its wheel. This is the typical operation of an idle timeout:
+		it only updates the timer, which is moved when its wheel
+		reaches it.
+
+@Param[in]	timer_handle - The handle of the timer to be restarted.
+
+@Return		0 on success, or negative value on error.
+@Retval		ETIMEDOUT - The one-shot timer expired: its callback is
+		running or has run.
+@Retval		ENAVAIL - The timer is not active.
+
+@Cautions	In this function the task yields.
+*//***************************************************************************/
+int twheel_recharge_timer(uint32_t timer_handle);
+
+/** @} */ /* end of twheel_g Timer Wheel group */
+#endif /* __FSL_TWHEEL_H */
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @File          acct.c
+
+ @Description   Accelerator cycle accounting implementation.
+ *//***************************************************************************/
+
+#include "fsl_types.h"
+#include "fsl_stdio.h"
+#include "fsl_string.h"
+#include "fsl_acct.h"
+
+#ifdef ENABLE_ACCEL_ACCOUNTING
+
+__TASK uint8_t acct_ep;
+__TASK uint8_t acct_core;
+__TASK uint32_t acct_task_tb;
+__TASK uint32_t acct_accel_tb;
+__TASK uint8_t acct_end_ep;
+__TASK uint32_t acct_end_tb;
+
+/* Per core counters, updated without locking */
+struct acct_cntrs g_acct_cntrs[INTG_MAX_NUM_OF_CORES][ACCT_EP_NUM]
+					__attribute__((aligned(8)));
+
+static const char *acct_ep_names[ACCT_EP_NUM] = {
+	"app", "snic", "cmdif_srv", "user"
+};
+
+/* From AIOP_Accelerators_IDS */
+static const char *acct_accel_names[ACCT_ACCEL_NUM] = {
+	"yield", "tman", "mflu", "sec", "parse/classify", "ctlu", "6", "7",
+	"8", "9", "10", "11", "fpdma", "cdma", "fodma", "15"
+};
+
+__COLD_CODE void acct_reset(void)
+{
+	memset(g_acct_cntrs, 0, sizeof(g_acct_cntrs));
+}
+
+__COLD_CODE void acct_print(void)
+{
+	struct acct_cntrs sum;
+	uint64_t accel_cycles;
+	int core, ep, i;
+
+	fsl_print("Accelerator accounting (time base ticks per task):\n");
+	for (ep = 0; ep < ACCT_EP_NUM; ep++) {
+		memset(&sum, 0, sizeof(sum));
+		for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+			sum.task_cycles += g_acct_cntrs[core][ep].task_cycles;
+			sum.tasks += g_acct_cntrs[core][ep].tasks;
+			for (i = 0; i < ACCT_ACCEL_NUM; i++) {
+				sum.accel_cycles[i] +=
+					g_acct_cntrs[core][ep].accel_cycles[i];
+				sum.accel_calls[i] +=
+					g_acct_cntrs[core][ep].accel_calls[i];
+			}
+		}
+		if (!sum.tasks)
+			continue;
+		accel_cycles = 0;
+		for (i = 0; i < ACCT_ACCEL_NUM; i++)
+			accel_cycles += sum.accel_cycles[i];
+		fsl_print("%s: tasks %d total %d accel %d core %d\n",
+			  acct_ep_names[ep], sum.tasks,
+			  (uint32_t)(sum.task_cycles / sum.tasks),
+			  (uint32_t)(accel_cycles / sum.tasks),
+			  (uint32_t)((sum.task_cycles - accel_cycles) /
+				     sum.tasks));
+		for (i = 0; i < ACCT_ACCEL_NUM; i++) {
+			if (!sum.accel_calls[i])
+				continue;
+			fsl_print("\t%s: calls/task %d.%d ticks/call %d\n",
+				  acct_accel_names[i],
+				  sum.accel_calls[i] / sum.tasks,
+				  (uint32_t)(((uint64_t)sum.accel_calls[i] * 10 /
+					      sum.tasks) % 10),
+				  (uint32_t)(sum.accel_cycles[i] /
+					     sum.accel_calls[i]));
+		}
+	}
+}
+
+#else
+
+__COLD_CODE void acct_reset(void)
+{
+}
+
+__COLD_CODE void acct_print(void)
+{
+	fsl_print("Accelerator accounting is disabled\n");
+}
+
+#endif /* ENABLE_ACCEL_ACCOUNTING */
@@ -625,6 +625,106 @@ __COLD_CODE int session_open(uint16_t *new_auth)
 	}
 }
 
+/** Read the next entries of the S/G table of the client */
+__COLD_CODE static int sg_fetch(struct cmdif_sg_iter *it)
+{
+	uint16_t n = MIN(it->entries, CMDIF_SG_BATCH);
+
+	if (n == 0)
+		return -EINVAL;
+
+	icontext_dma_read(&it->ic,
+	                  (uint16_t)(n * sizeof(struct cmdif_sg_entry)),
+	                  it->table, &it->cache[0]);
+	it->table += n * sizeof(struct cmdif_sg_entry);
+	it->entries -= n;
+	it->cached = n;
+	it->next = 0;
+	return 0;
+}
+
+__COLD_CODE int cmdif_sg_next(struct cmdif_sg_iter *it, uint32_t max,
+                              uint64_t *addr)
+{
+	uint32_t size;
+
+	while (it->entry_left == 0) {
+		if (it->left == 0)
+			return 0;
+		if ((it->next == it->cached) && sg_fetch(it))
+			return -EINVAL;
+		it->addr = it->cache[it->next].addr;
+		it->entry_left = it->cache[it->next].length;
+		it->next++;
+	}
+
+	size = MIN(MIN(it->entry_left, it->left), max);
+	*addr = it->addr;
+	it->addr += size;
+	it->entry_left -= size;
+	it->left -= size;
+	/* The buffers may hold more than the payload */
+	if (it->left == 0)
+		it->entry_left = 0;
+	return (int)size;
+}
+
+__COLD_CODE int cmdif_sg_read(struct cmdif_sg_iter *it, void *dest,
+                              uint16_t size)
+{
+	uint64_t addr;
+	int len;
+	int done = 0;
+
+	while (done < size) {
+		len = cmdif_sg_next(it, (uint32_t)(size - done), &addr);
+		if (len < 0)
+			return len;
+		if (len == 0)
+			break;
+		icontext_dma_read(&it->ic, (uint16_t)len, addr,
+		                  (uint8_t *)dest + done);
+		done += len;
+	}
+	return done;
+}
+
+/** Control callback of #CMDIF_SG_CMD commands, with the payload iterator */
+__COLD_CODE static int sg_ctrl_cb(uint16_t auth_id, uint16_t cmd_id,
+                                  uint16_t gpp_icid, uint32_t gpp_dma)
+{
+	struct cmdif_sg_table *table = cmd_data_get();
+	uint32_t size = cmd_size_get();
+	struct cmdif_sg_iter it;
+	int err;
+
+	/* The table header is presented, the entries are read on demand */
+	if ((PRC_GET_SEGMENT_LENGTH() < sizeof(struct cmdif_sg_table)) ||
+		(size < sizeof(struct cmdif_sg_table)) ||
+		((size - sizeof(struct cmdif_sg_table)) /
+		sizeof(struct cmdif_sg_entry) < table->num_entries)) {
+		no_stack_pr_err("Invalid S/G table for command 0x%x\n", cmd_id);
+		return -EINVAL;
+	}
+
+	/* Client buffers are accessed with the ICID of the command */
+	it.ic.icid = gpp_icid;
+	it.ic.dma_flags = gpp_dma;
+	it.ic.bdi_flags = 0;
+	it.table = LDPAA_FD_GET_ADDR(HWC_FD_ADDRESS) +
+		LDPAA_FD_GET_OFFSET(HWC_FD_ADDRESS) +
+		sizeof(struct cmdif_sg_table);
+	it.addr = 0;
+	it.entry_left = 0;
+	it.left = table->length;
+	it.entries = table->num_entries;
+	it.cached = 0;
+	it.next = 0;
+
+	CTRL_CB(auth_id, cmd_id, it.left, &it);
+	return err;
+}
+
 CMDIF_CODE_PLACEMENT ENTRY_POINT void cmdif_srv_isr(void) __attribute__ ((noreturn))
 {
 	uint16_t gpp_icid;
@@ -633,6 +733,7 @@ CMDIF_CODE_PLACEMENT ENTRY_POINT void cmdif_srv_isr(void) __attribute__ ((noretu
 	uint16_t auth_id;
 	int err;
 
+	ACCT_TASK_START(ACCT_EP_CMDIF_SRV);
 	ASSERT_COND_LIGHT(cmdif_aiop_srv.srv != NULL);
 
 	SET_FRAME_TYPE(PRC_GET_FRAME_HANDLE(), HWC_FD_ADDRESS);
@@ -743,8 +844,12 @@ CMDIF_CODE_PLACEMENT ENTRY_POINT void cmdif_srv_isr(void) __attribute__ ((noretu
 	} else {
 		if (is_valid_auth_id(auth_id)) {
 			/* User can ignore data and use presentation context */
-			CTRL_CB(auth_id, cmd_id, cmd_size_get(), \
-			        cmd_data_get());
+			if (cmd_id & CMDIF_SG_CMD)
+				err = sg_ctrl_cb(auth_id, cmd_id,
+				                 gpp_icid, gpp_dma);
+			else
+				CTRL_CB(auth_id, cmd_id, cmd_size_get(), \
+				        cmd_data_get());
 			if (SYNC_CMD(cmd_id)) {
 				no_stack_pr_debug("PASSED Sync Command\n");
 				CMDIF_STORE_DATA;
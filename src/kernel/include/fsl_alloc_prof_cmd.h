@@ -0,0 +1,88 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//*
+ @File          fsl_alloc_prof_cmd.h
+
+ @Description   Allocation profiling commands between GPP (client) and
+                AIOPSL (server), see alloc_prof_register_cmdif().
+
+ @Cautions      None.
+ *//***************************************************************************/
+
+#ifndef _FSL_ALLOC_PROF_CMD_H
+#define _FSL_ALLOC_PROF_CMD_H
+
+#define ALLOC_PROF_CMD_NUM_OF_PARAMS	11
+
+struct alloc_prof_cmd_data {
+	uint64_t params[ALLOC_PROF_CMD_NUM_OF_PARAMS];
+};
+
+/* alloc_prof_cmds */
+#define ALLOC_PROF_CMD_GET_SUMMARY	0
+#define ALLOC_PROF_CMD_GET_SITE		1
+#define ALLOC_PROF_CMD_RESET		2
+
+/* cmd sizes */
+#define ALLOC_PROF_CMDSZ_GET_SUMMARY	(2*8)
+#define ALLOC_PROF_CMDSZ_GET_SITE	(11*8)
+#define ALLOC_PROF_CMDSZ_RESET		8
+
+/* The file name of a site is returned in params 7 to 10 */
+#define ALLOC_PROF_SITE_FILE_PARAM	7
+
+/*	param, offset, width,	type,			arg_name */
+#define ALLOC_PROF_GET_SUMMARY_RSP(_OP) \
+do { \
+	_OP(0, 0,	16,	uint16_t,		summary.num_sites); \
+	_OP(0, 16,	16,	uint16_t,		summary.dp_not_slab_sites); \
+	_OP(0, 32,	32,	uint32_t,		summary.unmatched_frees); \
+	_OP(1, 0,	32,	uint32_t,		summary.untracked); \
+	_OP(1, 32,	32,	uint32_t,		summary.events); \
+} while (0)
+
+/*	param, offset, width,	type,			arg_name */
+#define ALLOC_PROF_GET_SITE_CMD(_OP) \
+	_OP(0, 0,	16,	uint16_t,		index)
+
+/*	param, offset, width,	type,			arg_name */
+#define ALLOC_PROF_GET_SITE_RSP(_OP) \
+do { \
+	_OP(0, 0,	32,	uint32_t,		info.line); \
+	_OP(0, 32,	8,	uint8_t,		info.kind); \
+	_OP(0, 40,	8,	uint8_t,		info.flags); \
+	_OP(1, 0,	32,	uint32_t,		info.allocs); \
+	_OP(1, 32,	32,	uint32_t,		info.failures); \
+	_OP(2, 0,	32,	uint32_t,		info.frees); \
+	_OP(2, 32,	32,	uint32_t,		info.dp_allocs); \
+	_OP(3, 0,	32,	uint32_t,		info.live); \
+	_OP(3, 32,	32,	uint32_t,		info.peak); \
+	_OP(4, 0,	64,	uint64_t,		info.bytes); \
+	_OP(5, 0,	64,	uint64_t,		info.live_bytes); \
+	_OP(6, 0,	64,	uint64_t,		info.peak_bytes); \
+} while (0)
+
+#endif /* _FSL_ALLOC_PROF_CMD_H */
@@ -0,0 +1,206 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @File          fsl_sl_acct.h
+
+ @Description   SL Internal accelerator cycle accounting API.
+
+*//***************************************************************************/
+
+#ifndef __FSL_SL_ACCT_H
+#define __FSL_SL_ACCT_H
+
+#include "fsl_types.h"
+#include "fsl_soc.h"
+#include "fsl_sl_alloc_prof.h"
+
+#ifdef ENABLE_ACCEL_ACCOUNTING
+
+/* Entry point of a task which is not accounted */
+#define ACCT_EP_NONE		ACCT_EP_NUM
+
+extern __TASK uint8_t acct_ep;
+extern __TASK uint8_t acct_core;
+extern __TASK uint32_t acct_task_tb;
+extern __TASK uint32_t acct_accel_tb;
+extern __TASK uint8_t acct_end_ep;
+extern __TASK uint32_t acct_end_tb;
+extern struct acct_cntrs g_acct_cntrs[INTG_MAX_NUM_OF_CORES][ACCT_EP_NUM];
+
+static inline uint32_t acct_get_time_base(void)
+{
+	register uint32_t tbl;
+
+	asm {mfspr tbl, 284}	/* TBL */
+	return tbl;
+}
+
+inline void acct_task_start(uint8_t ep)
+{
+	register uint32_t pir;
+
+	asm {mfspr pir, 286}	/* PIR */
+	acct_core = (uint8_t)(pir >> 4);
+	acct_ep = ep;
+	acct_task_tb = acct_get_time_base();
+}
+
+inline void acct_task_end(void)
+{
+	struct acct_cntrs *cntrs;
+
+	acct_end_ep = acct_ep;
+	if (acct_ep >= ACCT_EP_NUM || acct_core >= INTG_MAX_NUM_OF_CORES)
+		return;
+	cntrs = &g_acct_cntrs[acct_core][acct_ep];
+	acct_end_tb = acct_get_time_base();
+	cntrs->task_cycles += acct_end_tb - acct_task_tb;
+	cntrs->tasks++;
+	acct_ep = ACCT_EP_NONE;
+}
+
+/* Cancels the last acct_task_end(): the task was not terminated */
+inline void acct_task_resume(void)
+{
+	struct acct_cntrs *cntrs;
+
+	if (acct_end_ep >= ACCT_EP_NUM || acct_core >= INTG_MAX_NUM_OF_CORES)
+		return;
+	cntrs = &g_acct_cntrs[acct_core][acct_end_ep];
+	cntrs->task_cycles -= acct_end_tb - acct_task_tb;
+	cntrs->tasks--;
+	acct_ep = acct_end_ep;
+	acct_end_ep = ACCT_EP_NONE;
+}
+
+inline void acct_accel_start(void)
+{
+	acct_accel_tb = acct_get_time_base();
+}
+
+/* Returns the accelerator status, so it can wrap __e_hwacceli_() */
+inline int acct_accel_stop(uint32_t accel_id, int status)
+{
+	struct acct_cntrs *cntrs;
+	uint32_t cycles = acct_get_time_base() - acct_accel_tb;
+
+	/* The counters are per core and tasks are switched only on
+	 * accelerator calls, so no locking is needed */
+	if (acct_ep < ACCT_EP_NUM && acct_core < INTG_MAX_NUM_OF_CORES) {
+		cntrs = &g_acct_cntrs[acct_core][acct_ep];
+		cntrs->accel_cycles[accel_id & (ACCT_ACCEL_NUM - 1)] += cycles;
+		cntrs->accel_calls[accel_id & (ACCT_ACCEL_NUM - 1)]++;
+	}
+	return status;
+}
+
+/* Accelerator call intrinsics with time accounting */
+#define __e_hwacceli(_id)						\
+	(acct_accel_start(), __e_hwacceli(_id),				\
+	 (void)acct_accel_stop((_id), 0))
+
+#define __e_hwacceli_(_id)						\
+	(acct_accel_start(), acct_accel_stop((_id), __e_hwacceli_(_id)))
+
+#define __e_hwaccel(_id)						\
+	(acct_accel_start(), __e_hwaccel(_id),				\
+	 (void)acct_accel_stop((_id), 0))
+
+#define __e_ordhwacceli_(_id, _osm_op, _osm_id)				\
+	(acct_accel_start(), acct_accel_stop((_id),			\
+		__e_ordhwacceli_((_id), (_osm_op), (_osm_id))))
+
+#define ACCT_TASK_END_ACCEL()	acct_task_end()
+#define ACCT_TASK_RESUME_ACCEL()	acct_task_resume()
+
+#else
+
+#define ACCT_TASK_END_ACCEL()
+#define ACCT_TASK_RESUME_ACCEL()
+
+#endif /* ENABLE_ACCEL_ACCOUNTING */
+
+#ifdef ENABLE_OSM_PROFILING
+/* Ends the exclusive section of the task (osm_prof.c) */
+void osm_prof_task_end(void);
+/* Reopens the exclusive section closed by osm_prof_task_end() */
+void osm_prof_task_resume(void);
+#define ACCT_TASK_END_OSM()	osm_prof_task_end()
+#define ACCT_TASK_RESUME_OSM()	osm_prof_task_resume()
+#else
+#define ACCT_TASK_END_OSM()
+#define ACCT_TASK_RESUME_OSM()
+#endif /* ENABLE_OSM_PROFILING */
+
+#ifdef ENABLE_ALLOC_PROFILING
+/* The next task of the same TLS is not in the data path until it starts */
+#define ACCT_TASK_END_ALLOC()	ALLOC_PROF_TASK_END()
+#define ACCT_TASK_RESUME_ALLOC()	ALLOC_PROF_TASK_RESUME()
+#else
+#define ACCT_TASK_END_ALLOC()
+#define ACCT_TASK_RESUME_ALLOC()
+#endif /* ENABLE_ALLOC_PROFILING */
+
+#if defined(ENABLE_ACCEL_ACCOUNTING) || defined(ENABLE_OSM_PROFILING) || \
+	defined(ENABLE_ALLOC_PROFILING)
+
+/* Called before the task is terminated */
+#define ACCT_TASK_END()							\
+	do {								\
+		ACCT_TASK_END_ACCEL();					\
+		ACCT_TASK_END_OSM();					\
+		ACCT_TASK_END_ALLOC();					\
+	} while (0)
+
+/* Called before a command which terminates the task if _cond is set */
+#define ACCT_TASK_END_IF(_cond)						\
+	do {								\
+		if (_cond)						\
+			ACCT_TASK_END();				\
+	} while (0)
+
+/* Called when a command which terminates the task only on success (conditional
+ * terminate) failed and returned: the end counted by ACCT_TASK_END_IF()
+ * before the command is cancelled, the task is counted when it really ends */
+#define ACCT_TASK_RESUME_IF(_cond)					\
+	do {								\
+		if (_cond) {						\
+			ACCT_TASK_RESUME_ACCEL();			\
+			ACCT_TASK_RESUME_OSM();				\
+			ACCT_TASK_RESUME_ALLOC();			\
+		}							\
+	} while (0)
+
+#else
+
+#define ACCT_TASK_END()
+#define ACCT_TASK_END_IF(_cond)
+#define ACCT_TASK_RESUME_IF(_cond)
+
+#endif
+
+#endif /* __FSL_SL_ACCT_H */
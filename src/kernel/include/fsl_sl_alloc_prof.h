@@ -0,0 +1,126 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//**
+ @File          fsl_sl_alloc_prof.h
+
+ @Description   SL Internal allocation profiling API and wrappers of the
+                profiled allocation functions (fsl_alloc_prof.h).
+
+ @note          Included at the end of fsl_malloc.h, fsl_slab.h, fsl_cdma.h
+                and cdma_inline.h: each function is wrapped once it is
+                declared (and defined, for the CDMA inline functions).
+                Files defining the profiled functions set
+                ALLOC_PROF_NO_WRAP.
+*//***************************************************************************/
+
+#ifndef __FSL_SL_ALLOC_PROF_H
+#define __FSL_SL_ALLOC_PROF_H
+
+#include "fsl_types.h"
+
+#ifdef ENABLE_ALLOC_PROFILING
+
+struct slab;
+
+/* 1 if the task was started by a data path entry point */
+extern __TASK uint8_t alloc_prof_dp;
+/* alloc_prof_dp before the last ALLOC_PROF_TASK_END() */
+extern __TASK uint8_t alloc_prof_end_dp;
+
+/* Called by ACCT_TASK_START(), ACCT_TASK_END() and
+ * ACCT_TASK_RESUME_ALLOC() */
+#define ALLOC_PROF_TASK_START(_dp)	(alloc_prof_dp = (uint8_t)(_dp))
+#define ALLOC_PROF_TASK_END()						\
+	(alloc_prof_end_dp = alloc_prof_dp, alloc_prof_dp = 0)
+#define ALLOC_PROF_TASK_RESUME()	(alloc_prof_dp = alloc_prof_end_dp)
+
+/* Profiled allocation functions (alloc_prof.c), called by the wrappers
+ * with the call site */
+void *alloc_prof_fsl_malloc(size_t size, uint32_t alignment,
+			    const char *file, uint32_t line);
+void alloc_prof_fsl_free(void *mem, const char *file, uint32_t line);
+int alloc_prof_fsl_get_mem(uint64_t size, int mem_partition_id,
+			   uint64_t alignment, uint64_t *paddr,
+			   const char *file, uint32_t line);
+void alloc_prof_fsl_put_mem(uint64_t paddr, const char *file, uint32_t line);
+int alloc_prof_slab_acquire(struct slab *slab, uint64_t *buff,
+			    const char *file, uint32_t line);
+int alloc_prof_slab_release(struct slab *slab, uint64_t buff,
+			    const char *file, uint32_t line);
+int alloc_prof_cdma_acquire_context_memory(uint16_t pool_id,
+					   uint64_t *context_memory,
+					   const char *file, uint32_t line);
+void alloc_prof_cdma_release_context_memory(uint64_t context_address,
+					    const char *file, uint32_t line);
+
+#else
+
+#define ALLOC_PROF_TASK_START(_dp)
+#define ALLOC_PROF_TASK_END()
+#define ALLOC_PROF_TASK_RESUME()
+
+#endif /* ENABLE_ALLOC_PROFILING */
+
+#endif /* __FSL_SL_ALLOC_PROF_H */
+
+/* The wrappers are outside of the include guard: this file is included again
+ * once the next allocation header is processed */
+#if defined(ENABLE_ALLOC_PROFILING) && !defined(ALLOC_PROF_NO_WRAP)
+
+#if defined(__FSL_MALLOC_H_DONE) && !defined(ALLOC_PROF_MALLOC_WRAPPED)
+#define ALLOC_PROF_MALLOC_WRAPPED
+#define fsl_malloc(_size, _alignment)					\
+	alloc_prof_fsl_malloc((_size), (_alignment), __FILE__, __LINE__)
+#define fsl_free(_mem)							\
+	alloc_prof_fsl_free((_mem), __FILE__, __LINE__)
+#define fsl_get_mem(_size, _mem_partition_id, _alignment, _paddr)	\
+	alloc_prof_fsl_get_mem((_size), (_mem_partition_id), (_alignment), \
+			       (_paddr), __FILE__, __LINE__)
+#define fsl_put_mem(_paddr)						\
+	alloc_prof_fsl_put_mem((_paddr), __FILE__, __LINE__)
+#endif
+
+#if defined(__FSL_SLAB_H_DONE) && !defined(ALLOC_PROF_SLAB_WRAPPED)
+#define ALLOC_PROF_SLAB_WRAPPED
+#define slab_acquire(_slab, _buff)					\
+	alloc_prof_slab_acquire((_slab), (_buff), __FILE__, __LINE__)
+#define slab_release(_slab, _buff)					\
+	alloc_prof_slab_release((_slab), (_buff), __FILE__, __LINE__)
+#endif
+
+#if defined(__FSL_CDMA_H_DONE) && defined(__CDMA_INLINE_H_DONE) && \
+	!defined(ALLOC_PROF_CDMA_WRAPPED)
+#define ALLOC_PROF_CDMA_WRAPPED
+#define cdma_acquire_context_memory(_pool_id, _context_memory)		\
+	alloc_prof_cdma_acquire_context_memory((_pool_id),		\
+					       (_context_memory),	\
+					       __FILE__, __LINE__)
+#define cdma_release_context_memory(_context_address)			\
+	alloc_prof_cdma_release_context_memory((_context_address),	\
+					       __FILE__, __LINE__)
+#endif
+
+#endif /* ENABLE_ALLOC_PROFILING */
@@ -154,6 +154,91 @@ uint32_t sys_get_max_num_of_cores(void);
 *//***************************************************************************/
 void sys_barrier(void);
 
+/* @} */ /* end of barrier collection */
+
+/**************************************************************************//**
+ @Collection    Boot Work Application Programming Interface
+
+ @Description   Definitions and functions for executing initialization work
+                on all the cores.
+
+                During the initialization the master core runs the modules
+                initialization while the other cores wait in
+                sys_boot_worker(). Work that consists of independent items
+                (e.g. releasing buffers to a pool) is given to
+                sys_boot_work_run(); the items are split in chunks that are
+                executed by all the cores. Boot work is run by the master
+                core only.
+
+ @{
+*//***************************************************************************/
+
+/**************************************************************************//**
+ @Description   Boot work function.
+
+ @Param[in]     arg   - Argument given to sys_boot_work_run(). It must be in
+                        the shared memory.
+ @Param[in]     first - Index of the first item to execute.
+ @Param[in]     count - Number of items to execute.
+*//***************************************************************************/
+typedef void (sys_boot_work_t)(void *arg, uint32_t first, uint32_t count);
+
+/**************************************************************************//**
+ @Function      sys_boot_work_run
+
+ @Description   Executes 'count' items of work on all the cores waiting in
+                sys_boot_worker() and on the calling core. Returns when all
+                the items were executed.
+
+                After sys_boot_workers_release() the calling core executes
+                all the items.
+
+ @Param[in]     work  - Work function.
+ @Param[in]     arg   - Argument of the work function.
+ @Param[in]     count - Number of items.
+ @Param[in]     chunk - Number of items given to a core at a time
+                        (0 for all the items).
+
+ @Return        0 on success, -EBUSY if called while another work is
+                running (only one core may run boot work at a time).
+*//***************************************************************************/
+int sys_boot_work_run(sys_boot_work_t *work, void *arg, uint32_t count,
+                      uint32_t chunk);
+
+/**************************************************************************//**
+ @Function      sys_boot_work_enabled
+
+ @Description   Returns 1 while the other cores wait in sys_boot_worker(),
+                i.e. until sys_boot_workers_release() is called.
+*//***************************************************************************/
+int sys_boot_work_enabled(void);
+
+/**************************************************************************//**
+ @Function      sys_boot_worker
+
+ @Description   Executes the boot work given to sys_boot_work_run() until
+                sys_boot_workers_release() is called. Called by the cores
+                which are not the master core during the initialization.
+*//***************************************************************************/
+void sys_boot_worker(void);
+
+/**************************************************************************//**
+ @Function      sys_boot_workers_release
+
+ @Description   Ends sys_boot_worker() on all the cores.
+*//***************************************************************************/
+void sys_boot_workers_release(void);
+
+/**************************************************************************//**
+ @Function      sys_boot_work_report
+
+ @Description   Prints the number of boot work runs and the number of items
+                executed by each core.
+*//***************************************************************************/
+void sys_boot_work_report(void);
+
+/* @} */ /* end of boot work collection */
+
 /** @} */ /* end of sys_mp_grp */
 /** @} */ /* end of sys_g */
 
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @File          lazy.c
+
+ @Description   Lazy module initialization implementation.
+ *//***************************************************************************/
+
+#include "fsl_types.h"
+#include "fsl_errors.h"
+#include "fsl_dbg.h"
+#include "fsl_cdma.h"
+#include "fsl_tman.h"
+#include "fsl_system.h"
+#include "fsl_lazy.h"
+
+/* Registered modules, added on the master core at early initialization */
+static struct lazy_module *lazy_modules;
+
+/*****************************************************************************/
+__COLD_CODE int lazy_register(struct lazy_module *module, uint64_t mem_size)
+{
+	struct lazy_module **m;
+
+	for (m = &lazy_modules; *m; m = &(*m)->next)
+		if (*m == module)
+			return -EEXIST;
+
+	module->mem_size = mem_size;
+	module->next = NULL;
+	*m = module;
+	return 0;
+}
+
+/*****************************************************************************/
+int lazy_init(struct lazy_module *module)
+{
+	uint64_t start, end;
+	int err;
+
+	if (module->state == LAZY_INITIALIZED)
+		return 0;
+
+	/* The initialization reserves memory and sends MC commands: boot
+	 * time only. At run time the error of the boot attempt is kept. */
+	if (sys.runtime_flag) {
+		ASSERT_COND(module->attempts);
+		return module->attempts ? module->err : -EACCES;
+	}
+
+	/* The first caller initializes the module, the other ones wait */
+	cdma_mutex_lock_take((uint64_t)module, CDMA_MUTEX_WRITE_LOCK);
+	if (module->state != LAZY_INITIALIZED) {
+		tman_get_timestamp(&start);
+		err = module->init();
+		tman_get_timestamp(&end);
+
+		module->attempts++;
+		module->init_time += (uint32_t)(end - start);
+		module->err = err;
+		if (!err) {
+			module->state = LAZY_INITIALIZED;
+			pr_info("%s initialized in %d us\n", module->name,
+				module->init_time);
+		} else {
+			pr_err("%s initialization failed (%d)\n", module->name,
+			       err);
+		}
+	}
+	err = (module->state == LAZY_INITIALIZED) ? 0 : module->err;
+	cdma_mutex_lock_release((uint64_t)module);
+
+	return err;
+}
+
+/*****************************************************************************/
+__COLD_CODE void lazy_report(void)
+{
+	struct lazy_module *m;
+
+	pr_info("Lazy modules:\n");
+	for (m = lazy_modules; m; m = m->next) {
+		if (m->state == LAZY_INITIALIZED)
+			pr_info("  %s: initialized in %d us, %d KB\n", m->name,
+				m->init_time, (uint32_t)(m->mem_size >> 10));
+		else if (m->attempts)
+			pr_info("  %s: failed %d times (%d), %d KB declared\n",
+				m->name, m->attempts, m->err,
+				(uint32_t)(m->mem_size >> 10));
+		else
+			pr_info("  %s: not initialized, %d KB declared\n",
+				m->name, (uint32_t)(m->mem_size >> 10));
+	}
+}
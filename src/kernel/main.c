@@ -30,6 +30,8 @@
 #include "fsl_dbg.h"
 #include "fsl_cmgw.h"
 #include "fsl_rcu.h"
+#include "fsl_tman.h"
+#include "fsl_lazy.h"
 
 extern int sys_init(void);
 extern void sys_free(void);
@@ -42,6 +44,52 @@ extern int apps_early_init(void);
 extern int apps_init(void);
 extern void core_ready_for_tasks(void);
 
+/* Boot stages of the master core, for the boot time report */
+enum boot_stage {
+	BOOT_SYS_INIT,
+	BOOT_TILE_INIT,
+	BOOT_GLOBAL_EARLY_INIT,
+	BOOT_APPS_EARLY_INIT,
+	BOOT_GLOBAL_INIT,
+	BOOT_APPS_INIT,
+	BOOT_GLOBAL_POST_INIT,
+	BOOT_NUM_STAGES
+};
+
+static const char *boot_stage_names[BOOT_NUM_STAGES] = {
+	"sys_init", "tile_init", "global_early_init", "apps_early_init",
+	"global_init", "apps_init", "global_post_init"
+};
+
+/* Duration of each stage, in micro-seconds */
+static uint32_t boot_stage_time[BOOT_NUM_STAGES];
+
+/* Records the duration of a stage started at '*start' and starts the next */
+__COLD_CODE static void boot_stage_done(enum boot_stage stage,
+					uint64_t *start)
+{
+	uint64_t now;
+
+	tman_get_timestamp(&now);
+	boot_stage_time[stage] = (uint32_t)(now - *start);
+	*start = now;
+}
+
+__COLD_CODE static void boot_time_report(void)
+{
+	uint32_t total = 0;
+	int i;
+
+	pr_info("Boot time breakdown (micro-seconds):\n");
+	for (i = 0; i < BOOT_NUM_STAGES; i++) {
+		pr_info("  %s: %d\n", boot_stage_names[i], boot_stage_time[i]);
+		total += boot_stage_time[i];
+	}
+	pr_info("  total: %d\n", total);
+	sys_boot_work_report();
+	lazy_report();
+}
+
 
 #if (STACK_OVERFLOW_DETECTION == 1)
 extern char _stack_addr[]; /* Starting address for stack */
@@ -82,6 +130,7 @@ int main(int argc, char *argv[])
 {
 	int err = 0;
 	int is_master_core;
+	uint64_t stage_start;
 	UNUSED(argc);UNUSED(argv);
 
 	/* Initiate small data area pointers at task initialization */
@@ -98,6 +147,8 @@ int main(int argc, char *argv[])
 	}
 #endif
 
+	tman_get_timestamp(&stage_start);
+
 	/* Initialize system */
 	err = sys_init();
 	if (err) {
@@ -109,6 +160,7 @@ int main(int argc, char *argv[])
 	is_master_core = sys_is_master_core();
 
 	if(is_master_core) {
+		boot_stage_done(BOOT_SYS_INIT, &stage_start);
 		if(cmgw_get_ntasks() > 2 /*4-tasks*/) {
 			pr_warn("More then 4 AIOP tasks/core.\n");
 		}
@@ -124,31 +176,42 @@ int main(int argc, char *argv[])
 		}
 	}
 
+	/* The other cores execute the boot work of the master core (e.g.
+	 * filling the buffer pools) until its initialization is done */
+	if(!is_master_core)
+		sys_boot_worker();
+
 	if(is_master_core)
 	{
+		tman_get_timestamp(&stage_start);
+
 		err = tile_init();
 		if(err) {
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_TILE_INIT, &stage_start);
 
 		err = global_early_init();
 		if(err) {
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_GLOBAL_EARLY_INIT, &stage_start);
 
 		err = apps_early_init();
 		if(err) {
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_APPS_EARLY_INIT, &stage_start);
 
 		err = global_init();
 		if(err) {
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_GLOBAL_INIT, &stage_start);
 	}
 
 	if(is_master_core)
@@ -160,12 +223,18 @@ int main(int argc, char *argv[])
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_APPS_INIT, &stage_start);
 
 		err = global_post_init();
 		if(err) {
 			cmgw_report_boot_failure();
 			return err;
 		}
+		boot_stage_done(BOOT_GLOBAL_POST_INIT, &stage_start);
+
+		sys_boot_workers_release();
+		boot_time_report();
+
 		/* Avoid applications hang on rcu_synchronize() or
 		 * cdma_ephemeral_reference_sync() call if an unnecessary lock
 		 * was taken by applications in the call-back functions called
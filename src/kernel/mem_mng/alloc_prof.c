@@ -0,0 +1,774 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//**
+ @File          alloc_prof.c
+
+ @Description   Allocation profiling implementation.
+ *//***************************************************************************/
+
+/* The allocation calls of this file are not profiled */
+#define ALLOC_PROF_NO_WRAP
+
+#include "general.h"
+#include "fsl_types.h"
+#include "fsl_errors.h"
+#include "fsl_stdio.h"
+#include "fsl_string.h"
+#include "fsl_dbg.h"
+#include "fsl_core.h"
+#include "fsl_spinlock.h"
+#include "fsl_malloc.h"
+#include "fsl_slab.h"
+#include "fsl_cdma.h"
+#include "fsl_fdma.h"
+#include "fsl_tman.h"
+#include "fsl_cmdif_server.h"
+#include "fsl_mc_sys.h"
+#include "fsl_mc_cmd.h"
+#include "fsl_alloc_prof.h"
+#include "fsl_alloc_prof_cmd.h"
+#include "fsl_sl_alloc_prof.h"
+
+#ifdef ENABLE_ALLOC_PROFILING
+
+/* Calls recorded per core before they are aggregated */
+#define ALLOC_PROF_RING_SIZE	32
+/* Tracked live allocations, a power of 2 */
+#define ALLOC_PROF_MAX_LIVE	512
+#define ALLOC_PROF_OTHER_SITE	(ALLOC_PROF_MAX_SITES - 1)
+/* Site of a live entry recording a release processed before its
+ * allocation */
+#define ALLOC_PROF_PENDING_FREE	0xFF
+/* Period of the aggregation of all the cores (10 ms units) */
+#define ALLOC_PROF_DRAIN_PERIOD	10
+/* One periodic timer, plus the timers required by tman_create_tmi() */
+#define ALLOC_PROF_TMI_TIMERS	4
+
+/* Event flags */
+#define ALLOC_PROF_EV_FREE	0x01	/* Release */
+#define ALLOC_PROF_EV_FAIL	0x02	/* Failed allocation */
+#define ALLOC_PROF_EV_DP	0x04	/* Call made in the data path */
+
+/* Recorded allocation or release call */
+struct alloc_prof_event {
+	uint64_t	addr;
+	const char	*file;
+	uint32_t	size;
+	uint16_t	line;
+	uint8_t		kind;
+	uint8_t		flags;
+};
+
+struct alloc_prof_core {
+	/* Taken by the core and by the aggregation of all the cores */
+	uint64_t		lock;
+	uint32_t		num;
+	uint32_t		res;
+	struct alloc_prof_event	events[ALLOC_PROF_RING_SIZE];
+};
+
+struct alloc_prof_site {
+	const char	*file;
+	uint32_t	line;
+	uint8_t		kind;
+	uint8_t		res[3];
+	uint32_t	allocs;
+	uint32_t	failures;
+	uint32_t	frees;
+	uint32_t	dp_allocs;
+	uint32_t	live;
+	uint32_t	peak;
+	uint64_t	bytes;
+	uint64_t	live_bytes;
+	uint64_t	peak_bytes;
+};
+
+/* Live allocation, addr 0 is a free entry */
+struct alloc_prof_live {
+	uint64_t	addr;
+	uint32_t	size;
+	uint8_t		site;
+	uint8_t		kind;
+	/* Aggregation round of a pending release */
+	uint16_t	round;
+};
+
+__TASK uint8_t alloc_prof_dp;
+__TASK uint8_t alloc_prof_end_dp;
+
+/* Per core buffers */
+struct alloc_prof_core g_alloc_prof_core[INTG_MAX_NUM_OF_CORES]
+					__attribute__((aligned(8)));
+
+/* Aggregated statistics, protected by alloc_prof_lock */
+static uint64_t alloc_prof_lock __attribute__((aligned(8)));
+static struct alloc_prof_site alloc_prof_sites[ALLOC_PROF_MAX_SITES];
+static struct alloc_prof_live alloc_prof_live[ALLOC_PROF_MAX_LIVE];
+static uint32_t alloc_prof_num_sites;
+static uint32_t alloc_prof_unmatched_frees;
+static uint32_t alloc_prof_untracked;
+static uint32_t alloc_prof_events;
+static uint32_t alloc_prof_pending;
+static uint16_t alloc_prof_round;
+
+static uint8_t alloc_prof_tmi_id = 0xFF;
+static uint32_t alloc_prof_timer;
+
+static const char alloc_prof_other_file[] = "";
+
+static const char *alloc_prof_kind_names[] = {
+	"fsl_malloc", "fsl_get_mem", "slab_acquire",
+	"cdma_acquire_context_memory"
+};
+
+#define ALLOC_PROF_CMD_READ(_param, _offset, _width, _type, _arg) \
+	_arg = (_type)mc_dec(cmd_data->params[_param], _offset, _width);
+
+#define ALLOC_PROF_RSP_PREP(_param, _offset, _width, _type, _arg) \
+	cmd_data->params[_param] |= mc_enc(_offset, _width, _arg);
+
+static uint8_t alloc_prof_get_site_idx(const char *file, uint16_t line,
+				       uint8_t kind)
+{
+	struct alloc_prof_site *site;
+	uint32_t i;
+
+	for (i = 0; i < alloc_prof_num_sites; i++) {
+		site = &alloc_prof_sites[i];
+		if (site->line == line && site->file == file &&
+		    site->kind == kind)
+			return (uint8_t)i;
+	}
+	if (alloc_prof_num_sites == ALLOC_PROF_OTHER_SITE) {
+		alloc_prof_sites[ALLOC_PROF_OTHER_SITE].file =
+						alloc_prof_other_file;
+		alloc_prof_sites[ALLOC_PROF_OTHER_SITE].kind = kind;
+		return ALLOC_PROF_OTHER_SITE;
+	}
+	site = &alloc_prof_sites[i];
+	site->file = file;
+	site->line = line;
+	site->kind = kind;
+	alloc_prof_num_sites++;
+	return (uint8_t)i;
+}
+
+static inline uint32_t alloc_prof_hash(uint64_t addr)
+{
+	return (uint32_t)(((uint32_t)(addr >> 3) ^ (uint32_t)(addr >> 32)) *
+			  2654435761u) >> 23;	/* log2(ALLOC_PROF_MAX_LIVE) */
+}
+
+static struct alloc_prof_live *alloc_prof_live_find(uint64_t addr,
+						    uint8_t kind)
+{
+	struct alloc_prof_live *e;
+	uint32_t i, n;
+
+	i = alloc_prof_hash(addr);
+	for (n = 0; n < ALLOC_PROF_MAX_LIVE; n++) {
+		e = &alloc_prof_live[i];
+		if (!e->addr)
+			return NULL;
+		if (e->addr == addr && e->kind == kind)
+			return e;
+		i = (i + 1) & (ALLOC_PROF_MAX_LIVE - 1);
+	}
+	return NULL;
+}
+
+/* Linear probing deletion: the next entries of the cluster that would not be
+ * found any more are moved back */
+static void alloc_prof_live_remove(struct alloc_prof_live *e)
+{
+	uint32_t i, j, h;
+
+	i = (uint32_t)(e - alloc_prof_live);
+	j = i;
+	for (;;) {
+		j = (j + 1) & (ALLOC_PROF_MAX_LIVE - 1);
+		if (!alloc_prof_live[j].addr)
+			break;
+		h = alloc_prof_hash(alloc_prof_live[j].addr);
+		/* Entry j stays if its home slot h is cyclically in (i, j] */
+		if (i <= j ? (i < h && h <= j) : (i < h || h <= j))
+			continue;
+		alloc_prof_live[i] = alloc_prof_live[j];
+		i = j;
+	}
+	alloc_prof_live[i].addr = 0;
+}
+
+static struct alloc_prof_live *alloc_prof_live_add(uint64_t addr,
+						   uint8_t kind)
+{
+	struct alloc_prof_live *e;
+	uint32_t i, n;
+
+	i = alloc_prof_hash(addr);
+	for (n = 0; n < ALLOC_PROF_MAX_LIVE; n++) {
+		e = &alloc_prof_live[i];
+		if (!e->addr) {
+			e->addr = addr;
+			e->kind = kind;
+			return e;
+		}
+		i = (i + 1) & (ALLOC_PROF_MAX_LIVE - 1);
+	}
+	return NULL;
+}
+
+static void alloc_prof_release(struct alloc_prof_live *e)
+{
+	struct alloc_prof_site *site = &alloc_prof_sites[e->site];
+
+	site->frees++;
+	site->live--;
+	site->live_bytes -= e->size;
+	alloc_prof_live_remove(e);
+}
+
+/* The events of the cores are not processed in the order they were
+ * recorded: the release of a buffer allocated on another core can be
+ * processed first. Such a release is kept pending in the live table, the
+ * allocation processed later cancels it. */
+static void alloc_prof_process(struct alloc_prof_event *ev)
+{
+	struct alloc_prof_site *site;
+	struct alloc_prof_live *e;
+	uint8_t idx;
+
+	alloc_prof_events++;
+	if (ev->flags & ALLOC_PROF_EV_FREE) {
+		e = alloc_prof_live_find(ev->addr, ev->kind);
+		if (e && e->site != ALLOC_PROF_PENDING_FREE) {
+			alloc_prof_release(e);
+			return;
+		}
+		alloc_prof_unmatched_frees++;
+		if (e)
+			return;
+		e = alloc_prof_live_add(ev->addr, ev->kind);
+		if (e) {
+			e->size = 0;
+			e->site = ALLOC_PROF_PENDING_FREE;
+			e->round = alloc_prof_round;
+			alloc_prof_pending++;
+		}
+		return;
+	}
+
+	idx = alloc_prof_get_site_idx(ev->file, ev->line, ev->kind);
+	site = &alloc_prof_sites[idx];
+	if (ev->flags & ALLOC_PROF_EV_FAIL) {
+		site->failures++;
+		return;
+	}
+	site->allocs++;
+	site->bytes += ev->size;
+	if (ev->flags & ALLOC_PROF_EV_DP)
+		site->dp_allocs++;
+
+	e = alloc_prof_live_find(ev->addr, ev->kind);
+	if (e && e->site == ALLOC_PROF_PENDING_FREE) {
+		/* Already released */
+		site->frees++;
+		alloc_prof_unmatched_frees--;
+		alloc_prof_pending--;
+		alloc_prof_live_remove(e);
+		return;
+	}
+	/* A release that was not recorded (e.g. made by the hardware) */
+	if (e)
+		alloc_prof_release(e);
+
+	e = alloc_prof_live_add(ev->addr, ev->kind);
+	if (!e) {
+		alloc_prof_untracked++;
+		return;
+	}
+	e->size = ev->size;
+	e->site = idx;
+	site->live++;
+	site->live_bytes += ev->size;
+	if (site->live > site->peak)
+		site->peak = site->live;
+	if (site->live_bytes > site->peak_bytes)
+		site->peak_bytes = site->live_bytes;
+}
+
+/* Called with the lock of the core buffer taken */
+static void alloc_prof_drain(struct alloc_prof_core *pc)
+{
+	uint32_t i;
+
+	lock_spinlock(&alloc_prof_lock);
+	for (i = 0; i < pc->num; i++)
+		alloc_prof_process(&pc->events[i]);
+	unlock_spinlock(&alloc_prof_lock);
+	pc->num = 0;
+}
+
+static void alloc_prof_record(uint8_t kind, uint8_t flags, uint64_t addr,
+			      uint32_t size, const char *file, uint32_t line)
+{
+	struct alloc_prof_core *pc;
+	struct alloc_prof_event *ev;
+
+	pc = &g_alloc_prof_core[core_get_id() & (INTG_MAX_NUM_OF_CORES - 1)];
+	if (alloc_prof_dp)
+		flags |= ALLOC_PROF_EV_DP;
+
+	/* No accelerator call while the lock is taken, the task is not
+	 * switched */
+	lock_spinlock(&pc->lock);
+	ev = &pc->events[pc->num];
+	ev->addr = addr;
+	ev->file = file;
+	ev->size = size;
+	ev->line = (uint16_t)line;
+	ev->kind = kind;
+	ev->flags = flags;
+	if (++pc->num == ALLOC_PROF_RING_SIZE)
+		alloc_prof_drain(pc);
+	unlock_spinlock(&pc->lock);
+}
+
+void *alloc_prof_fsl_malloc(size_t size, uint32_t alignment,
+			    const char *file, uint32_t line)
+{
+	void *mem = fsl_malloc(size, alignment);
+
+	alloc_prof_record(ALLOC_PROF_KIND_MALLOC,
+			  mem ? 0 : ALLOC_PROF_EV_FAIL, (uint64_t)(uint32_t)mem,
+			  (uint32_t)size, file, line);
+	return mem;
+}
+
+void alloc_prof_fsl_free(void *mem, const char *file, uint32_t line)
+{
+	/* Recorded before the memory can be allocated again */
+	if (mem)
+		alloc_prof_record(ALLOC_PROF_KIND_MALLOC, ALLOC_PROF_EV_FREE,
+				  (uint64_t)(uint32_t)mem, 0, file, line);
+	fsl_free(mem);
+}
+
+int alloc_prof_fsl_get_mem(uint64_t size, int mem_partition_id,
+			   uint64_t alignment, uint64_t *paddr,
+			   const char *file, uint32_t line)
+{
+	int err = fsl_get_mem(size, mem_partition_id, alignment, paddr);
+
+	alloc_prof_record(ALLOC_PROF_KIND_GET_MEM, err ? ALLOC_PROF_EV_FAIL : 0,
+			  err ? 0 : *paddr, (uint32_t)size, file, line);
+	return err;
+}
+
+void alloc_prof_fsl_put_mem(uint64_t paddr, const char *file, uint32_t line)
+{
+	alloc_prof_record(ALLOC_PROF_KIND_GET_MEM, ALLOC_PROF_EV_FREE, paddr, 0,
+			  file, line);
+	fsl_put_mem(paddr);
+}
+
+int alloc_prof_slab_acquire(struct slab *slab, uint64_t *buff,
+			    const char *file, uint32_t line)
+{
+	int err = slab_acquire(slab, buff);
+
+	alloc_prof_record(ALLOC_PROF_KIND_SLAB, err ? ALLOC_PROF_EV_FAIL : 0,
+			  err ? 0 : *buff, 0, file, line);
+	return err;
+}
+
+int alloc_prof_slab_release(struct slab *slab, uint64_t buff,
+			    const char *file, uint32_t line)
+{
+	alloc_prof_record(ALLOC_PROF_KIND_SLAB, ALLOC_PROF_EV_FREE, buff, 0,
+			  file, line);
+	return slab_release(slab, buff);
+}
+
+int alloc_prof_cdma_acquire_context_memory(uint16_t pool_id,
+					   uint64_t *context_memory,
+					   const char *file, uint32_t line)
+{
+	int err = cdma_acquire_context_memory(pool_id, context_memory);
+
+	alloc_prof_record(ALLOC_PROF_KIND_CDMA, err ? ALLOC_PROF_EV_FAIL : 0,
+			  err ? 0 : *context_memory, 0, file, line);
+	return err;
+}
+
+void alloc_prof_cdma_release_context_memory(uint64_t context_address,
+					    const char *file, uint32_t line)
+{
+	alloc_prof_record(ALLOC_PROF_KIND_CDMA, ALLOC_PROF_EV_FREE,
+			  context_address, 0, file, line);
+	cdma_release_context_memory(context_address);
+}
+
+/* Removes the pending releases processed before the aggregation round: their
+ * allocation, recorded before them, was processed by this round. They stay
+ * counted as unmatched. */
+static void alloc_prof_expire(uint16_t round)
+{
+	struct alloc_prof_live *e;
+	uint32_t i = 0;
+
+	while (alloc_prof_pending && i < ALLOC_PROF_MAX_LIVE) {
+		e = &alloc_prof_live[i];
+		if (e->addr && e->site == ALLOC_PROF_PENDING_FREE &&
+		    (int16_t)(e->round - round) < 0) {
+			alloc_prof_pending--;
+			/* The next entry of the cluster may move to i */
+			alloc_prof_live_remove(e);
+			continue;
+		}
+		i++;
+	}
+}
+
+__COLD_CODE void alloc_prof_aggregate(void)
+{
+	struct alloc_prof_core *pc;
+	uint16_t round;
+	int core;
+
+	lock_spinlock(&alloc_prof_lock);
+	round = ++alloc_prof_round;
+	unlock_spinlock(&alloc_prof_lock);
+
+	for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+		pc = &g_alloc_prof_core[core];
+		lock_spinlock(&pc->lock);
+		if (pc->num)
+			alloc_prof_drain(pc);
+		unlock_spinlock(&pc->lock);
+	}
+
+	lock_spinlock(&alloc_prof_lock);
+	alloc_prof_expire(round);
+	unlock_spinlock(&alloc_prof_lock);
+}
+
+/* Periodic aggregation: the calls of a core are processed even if its buffer
+ * is not full */
+static void alloc_prof_timer_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	UNUSED(arg1);
+	UNUSED(arg2);
+	tman_timer_completion_confirmation(
+			TMAN_GET_TIMER_HANDLE(HWC_FD_ADDRESS));
+	alloc_prof_aggregate();
+	fdma_terminate_task();
+}
+
+static void alloc_prof_delete_tmi_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	UNUSED(arg1);
+	UNUSED(arg2);
+	tman_timer_completion_confirmation(
+			TMAN_GET_TIMER_HANDLE(HWC_FD_ADDRESS));
+	fdma_terminate_task();
+}
+
+__COLD_CODE int alloc_prof_init(void)
+{
+	enum memory_partition_id mem_pid = MEM_PART_SYSTEM_DDR;
+	uint64_t tmi_addr = 0;
+	int err;
+
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		mem_pid = MEM_PART_DP_DDR;
+	err = fsl_get_mem((ALLOC_PROF_TMI_TIMERS + 1) * 64, mem_pid, 64,
+			  &tmi_addr);
+	if (!err)
+		err = tman_create_tmi(tmi_addr, ALLOC_PROF_TMI_TIMERS,
+				      &alloc_prof_tmi_id);
+	if (err) {
+		pr_err("Cannot create the allocation profiling TMI\n");
+		return err;
+	}
+	err = tman_create_timer(alloc_prof_tmi_id,
+				TMAN_CREATE_TIMER_MODE_TPRI |
+				TMAN_CREATE_TIMER_MODE_10_MSEC_GRANULARITY,
+				ALLOC_PROF_DRAIN_PERIOD, 0, 0,
+				alloc_prof_timer_cb, &alloc_prof_timer);
+	if (err)
+		pr_err("Cannot create the allocation profiling timer\n");
+	return err;
+}
+
+__COLD_CODE void alloc_prof_free(void)
+{
+	if (alloc_prof_tmi_id != 0xFF) {
+		tman_delete_tmi(alloc_prof_delete_tmi_cb,
+				TMAN_INS_DELETE_MODE_FORCE_EXP,
+				alloc_prof_tmi_id, 0, 0);
+		alloc_prof_tmi_id = 0xFF;
+	}
+}
+
+static int alloc_prof_dp_not_slab(const struct alloc_prof_site *site)
+{
+	return site->dp_allocs && site->kind != ALLOC_PROF_KIND_SLAB;
+}
+
+__COLD_CODE int alloc_prof_get_summary(struct alloc_prof_summary *summary)
+{
+	uint32_t i;
+
+	alloc_prof_aggregate();
+	lock_spinlock(&alloc_prof_lock);
+	summary->num_sites = (uint16_t)alloc_prof_num_sites;
+	if (alloc_prof_sites[ALLOC_PROF_OTHER_SITE].file)
+		summary->num_sites = ALLOC_PROF_MAX_SITES;
+	summary->dp_not_slab_sites = 0;
+	for (i = 0; i < summary->num_sites; i++)
+		if (alloc_prof_dp_not_slab(&alloc_prof_sites[i]))
+			summary->dp_not_slab_sites++;
+	summary->unmatched_frees = alloc_prof_unmatched_frees;
+	summary->untracked = alloc_prof_untracked;
+	summary->events = alloc_prof_events;
+	unlock_spinlock(&alloc_prof_lock);
+	return 0;
+}
+
+__COLD_CODE int alloc_prof_get_site(uint16_t index,
+				    struct alloc_prof_site_info *info)
+{
+	struct alloc_prof_site *site;
+	uint32_t len;
+
+	if (index >= ALLOC_PROF_MAX_SITES)
+		return -EINVAL;
+	lock_spinlock(&alloc_prof_lock);
+	site = &alloc_prof_sites[index];
+	if (!site->file) {
+		unlock_spinlock(&alloc_prof_lock);
+		return -EINVAL;
+	}
+	/* Keep the end of the path, it names the file */
+	len = strlen(site->file);
+	if (len >= ALLOC_PROF_FILE_LEN)
+		strcpy(info->file, site->file + len - ALLOC_PROF_FILE_LEN + 1);
+	else
+		strcpy(info->file, site->file);
+	info->line = site->line;
+	info->kind = site->kind;
+	info->flags = (uint8_t)(alloc_prof_dp_not_slab(site) ?
+				ALLOC_PROF_FLG_DP_NOT_SLAB : 0);
+	info->reserved = 0;
+	info->allocs = site->allocs;
+	info->failures = site->failures;
+	info->frees = site->frees;
+	info->dp_allocs = site->dp_allocs;
+	info->live = site->live;
+	info->peak = site->peak;
+	info->bytes = site->bytes;
+	info->live_bytes = site->live_bytes;
+	info->peak_bytes = site->peak_bytes;
+	unlock_spinlock(&alloc_prof_lock);
+	return 0;
+}
+
+__COLD_CODE void alloc_prof_reset(void)
+{
+	struct alloc_prof_core *pc;
+	int core;
+
+	for (core = 0; core < INTG_MAX_NUM_OF_CORES; core++) {
+		pc = &g_alloc_prof_core[core];
+		lock_spinlock(&pc->lock);
+		pc->num = 0;
+		unlock_spinlock(&pc->lock);
+	}
+	lock_spinlock(&alloc_prof_lock);
+	memset(alloc_prof_sites, 0, sizeof(alloc_prof_sites));
+	memset(alloc_prof_live, 0, sizeof(alloc_prof_live));
+	alloc_prof_num_sites = 0;
+	alloc_prof_unmatched_frees = 0;
+	alloc_prof_untracked = 0;
+	alloc_prof_events = 0;
+	alloc_prof_pending = 0;
+	unlock_spinlock(&alloc_prof_lock);
+}
+
+static void alloc_prof_print_site(uint16_t index)
+{
+	struct alloc_prof_site_info info;
+
+	if (alloc_prof_get_site(index, &info))
+		return;
+	fsl_print("\t%s:%d %s%s\n", info.file[0] ? info.file : "(other)",
+		  info.line, alloc_prof_kind_names[info.kind],
+		  (info.flags & ALLOC_PROF_FLG_DP_NOT_SLAB) ?
+		  " - DATA PATH, NOT SLAB" : "");
+	fsl_print("\t\tallocs %d failed %d frees %d data path %d\n",
+		  info.allocs, info.failures, info.frees, info.dp_allocs);
+	fsl_print("\t\tlive %d peak %d bytes %d live %d peak %d\n",
+		  info.live, info.peak, (uint32_t)info.bytes,
+		  (uint32_t)info.live_bytes, (uint32_t)info.peak_bytes);
+}
+
+__COLD_CODE void alloc_prof_print(void)
+{
+	struct alloc_prof_summary summary;
+	uint16_t i;
+
+	alloc_prof_get_summary(&summary);
+	fsl_print("Allocation profiling: %d calls, %d call sites\n",
+		  summary.events, summary.num_sites);
+	fsl_print("Unmatched releases %d, untracked allocations %d\n",
+		  summary.unmatched_frees, summary.untracked);
+	if (summary.dp_not_slab_sites) {
+		fsl_print("Data path allocations not from a slab:\n");
+		for (i = 0; i < summary.num_sites; i++)
+			if (alloc_prof_dp_not_slab(&alloc_prof_sites[i]))
+				alloc_prof_print_site(i);
+	}
+	fsl_print("Call sites:\n");
+	for (i = 0; i < summary.num_sites; i++)
+		if (!alloc_prof_dp_not_slab(&alloc_prof_sites[i]))
+			alloc_prof_print_site(i);
+}
+
+#else
+
+__COLD_CODE void alloc_prof_aggregate(void)
+{
+}
+
+__COLD_CODE int alloc_prof_init(void)
+{
+	return 0;
+}
+
+__COLD_CODE void alloc_prof_free(void)
+{
+}
+
+__COLD_CODE int alloc_prof_get_summary(struct alloc_prof_summary *summary)
+{
+	UNUSED(summary);
+	return -ENAVAIL;
+}
+
+__COLD_CODE int alloc_prof_get_site(uint16_t index,
+				    struct alloc_prof_site_info *info)
+{
+	UNUSED(index);
+	UNUSED(info);
+	return -ENAVAIL;
+}
+
+__COLD_CODE void alloc_prof_reset(void)
+{
+}
+
+__COLD_CODE void alloc_prof_print(void)
+{
+	fsl_print("Allocation profiling is disabled\n");
+}
+
+#endif /* ENABLE_ALLOC_PROFILING */
+
+static int alloc_prof_open_cb(uint8_t instance_id, void **dev)
+{
+	UNUSED(instance_id);
+	UNUSED(dev);
+	return 0;
+}
+
+static int alloc_prof_close_cb(void *dev)
+{
+	UNUSED(dev);
+	return 0;
+}
+
+__COLD_CODE static int alloc_prof_ctrl_cb(void *dev, uint16_t cmd,
+					  uint32_t size, void *data)
+{
+	struct alloc_prof_cmd_data *cmd_data =
+					(struct alloc_prof_cmd_data *)data;
+	struct alloc_prof_summary summary;
+	struct alloc_prof_site_info info;
+	uint16_t index;
+	int i, err;
+
+	UNUSED(dev);
+
+	switch (cmd) {
+	case ALLOC_PROF_CMD_GET_SUMMARY:
+		if (size < ALLOC_PROF_CMDSZ_GET_SUMMARY)
+			return -EINVAL;
+		err = alloc_prof_get_summary(&summary);
+		if (err)
+			return err;
+		cmd_data->params[0] = 0;
+		cmd_data->params[1] = 0;
+		ALLOC_PROF_GET_SUMMARY_RSP(ALLOC_PROF_RSP_PREP);
+		fdma_modify_default_segment_data(0,
+						 ALLOC_PROF_CMDSZ_GET_SUMMARY);
+		return 0;
+	case ALLOC_PROF_CMD_GET_SITE:
+		if (size < ALLOC_PROF_CMDSZ_GET_SITE)
+			return -EINVAL;
+		ALLOC_PROF_GET_SITE_CMD(ALLOC_PROF_CMD_READ);
+		err = alloc_prof_get_site(index, &info);
+		if (err)
+			return err;
+		for (i = 0; i < ALLOC_PROF_SITE_FILE_PARAM; i++)
+			cmd_data->params[i] = 0;
+		ALLOC_PROF_GET_SITE_RSP(ALLOC_PROF_RSP_PREP);
+		memcpy(&cmd_data->params[ALLOC_PROF_SITE_FILE_PARAM],
+		       info.file, ALLOC_PROF_FILE_LEN);
+		fdma_modify_default_segment_data(0, ALLOC_PROF_CMDSZ_GET_SITE);
+		return 0;
+	case ALLOC_PROF_CMD_RESET:
+		alloc_prof_reset();
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+__COLD_CODE int alloc_prof_register_cmdif(void)
+{
+	struct cmdif_module_ops ops;
+	int err;
+
+	ops.open_cb = (open_cb_t *)alloc_prof_open_cb;
+	ops.close_cb = (close_cb_t *)alloc_prof_close_cb;
+	ops.ctrl_cb = (ctrl_cb_t *)alloc_prof_ctrl_cb;
+	err = cmdif_register_module(ALLOC_PROF_MODULE_NAME, &ops);
+	if (err)
+		pr_err("Failed to register %s cmdif module\n",
+		       ALLOC_PROF_MODULE_NAME);
+	return err;
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+ @File          prof.c
+
+ @Description   Profiling regions implementation.
+ *//***************************************************************************/
+
+#include "fsl_types.h"
+#include "fsl_stdio.h"
+#include "fsl_string.h"
+#include "fsl_spinlock.h"
+#include "fsl_core_booke_regs.h"
+#include "fsl_prof.h"
+
+/* Bounds of the ".prof_regions" section, defined in the linker file */
+extern struct prof_region _prof_regions_start[];
+extern struct prof_region _prof_regions_end[];
+
+/* Innermost active region of the task */
+__TASK struct prof_frame *prof_cur_frame;
+
+static inline uint32_t prof_get_time_base(void)
+{
+	register uint32_t tbl;
+
+	asm {mfspr tbl, TBL}
+	return tbl;
+}
+
+static inline uint32_t prof_hist_bucket(register uint32_t cycles)
+{
+	register uint32_t lz;
+	int32_t bucket;
+
+	asm {cntlzw lz, cycles}
+	/* Bucket n counts [2^(n+4), 2^(n+5)) */
+	bucket = 27 - (int32_t)lz;
+	if (bucket < 0)
+		return 0;
+	if (bucket >= PROF_HIST_BUCKETS)
+		return PROF_HIST_BUCKETS - 1;
+	return (uint32_t)bucket;
+}
+
+__HOT_CODE void prof_region_start(struct prof_region *region,
+				  struct prof_frame *frame)
+{
+	frame->region = region;
+	frame->parent = prof_cur_frame;
+	frame->child_cycles = 0;
+	prof_cur_frame = frame;
+	frame->start = prof_get_time_base();
+}
+
+__HOT_CODE void prof_region_stop(struct prof_frame *frame)
+{
+	struct prof_region *region = frame->region;
+	uint32_t cycles, excl_cycles;
+
+	/* Time base wrap around is handled by the unsigned subtraction */
+	cycles = prof_get_time_base() - frame->start;
+	excl_cycles = cycles - frame->child_cycles;
+
+	prof_cur_frame = frame->parent;
+	if (prof_cur_frame)
+		prof_cur_frame->child_cycles += cycles;
+
+	atomic_incr64((int64_t *)&region->cycles, (int64_t)cycles);
+	atomic_incr64((int64_t *)&region->excl_cycles, (int64_t)excl_cycles);
+	atomic_incr32((int32_t *)&region->calls, 1);
+	atomic_incr32((int32_t *)&region->hist[prof_hist_bucket(cycles)], 1);
+	/* Not atomic, a concurrent larger value may be lost */
+	if (cycles > region->max_cycles)
+		region->max_cycles = cycles;
+}
+
+__COLD_CODE void prof_regions_reset(void)
+{
+	struct prof_region *region;
+
+	for (region = _prof_regions_start; region < _prof_regions_end;
+	     region++) {
+		region->cycles = 0;
+		region->excl_cycles = 0;
+		region->calls = 0;
+		region->max_cycles = 0;
+		memset(region->hist, 0, sizeof(region->hist));
+	}
+}
+
+__COLD_CODE void prof_regions_print(void)
+{
+	struct prof_region *region;
+	uint32_t avg, excl_avg;
+	int i;
+
+	fsl_print("Profiling regions (time base ticks):\n");
+	for (region = _prof_regions_start; region < _prof_regions_end;
+	     region++) {
+		avg = 0;
+		excl_avg = 0;
+		if (region->calls) {
+			avg = (uint32_t)(region->cycles / region->calls);
+			excl_avg = (uint32_t)(region->excl_cycles /
+					      region->calls);
+		}
+		fsl_print("%s: calls %d avg %d excl %d max %d\n",
+			  region->name, region->calls, avg, excl_avg,
+			  region->max_cycles);
+		fsl_print("\thist:");
+		for (i = 0; i < PROF_HIST_BUCKETS; i++)
+			fsl_print(" %d", region->hist[i]);
+		fsl_print("\n");
+	}
+}
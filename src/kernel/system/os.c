@@ -24,6 +24,9 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/* Defines the profiled allocation functions (fsl_sl_alloc_prof.h) */
+#define ALLOC_PROF_NO_WRAP
+
 #include "fsl_malloc.h"
 #include "common/fsl_stdarg.h"
 #include "kernel/fsl_spinlock.h"
@@ -27,19 +27,42 @@
 
 #include "fsl_types.h"
 #include "fsl_errors.h"
+#include "common/fsl_string.h"
 #include "kernel/fsl_spinlock.h"
 #include "fsl_smp.h"
 #include "fsl_system.h"
+#include "fsl_dbg.h"
 
 int sys_init_multi_processing(void);
 void sys_free_multi_processing(void);
 
+/* Boot work shared by the cores during the initialization */
+struct sys_boot_work {
+    /* The lock must be aligned to a double word boundary */
+    uint64_t                    lock;
+    sys_boot_work_t * volatile  work;
+    void                        *arg;
+    uint32_t                    count;
+    uint32_t                    chunk;
+    uint32_t                    next;
+    volatile uint32_t           done;
+    volatile uint32_t           release;
+    /* Statistics for the boot report */
+    uint32_t                    num_runs;
+    uint32_t                    items[INTG_MAX_NUM_OF_CORES];
+};
+
+static struct sys_boot_work boot_work __attribute__((aligned(8)));
+
 /*****************************************************************************/
 int sys_init_multi_processing(void)
 {
     /* Initialize the central program barrier */
     sys.barrier_lock = 0;
     sys.barrier_mask = sys.active_cores_mask;
+
+    /* Initialize the boot work, before the other cores start polling it */
+    memset(&boot_work, 0, sizeof(boot_work));
  
     return 0;
 }
@@ -110,3 +133,105 @@ uint32_t sys_get_max_num_of_cores(void)
 {
     return INTG_ACTUAL_MAX_NUM_OF_CORES;
 }
+
+/*****************************************************************************/
+/* Executes chunks of the current boot work until all of them are taken */
+static void sys_boot_work_exec(void)
+{
+    sys_boot_work_t *work;
+    void *arg;
+    uint32_t first, count;
+
+    for (;;)
+    {
+        lock_spinlock(&(boot_work.lock));
+        work = boot_work.work;
+        if (!work || (boot_work.next >= boot_work.count))
+        {
+            unlock_spinlock(&(boot_work.lock));
+            return;
+        }
+        arg = boot_work.arg;
+        first = boot_work.next;
+        count = MIN(boot_work.chunk, boot_work.count - first);
+        boot_work.next += count;
+        unlock_spinlock(&(boot_work.lock));
+
+        work(arg, first, count);
+
+        lock_spinlock(&(boot_work.lock));
+        boot_work.done += count;
+        boot_work.items[core_get_id()] += count;
+        unlock_spinlock(&(boot_work.lock));
+    }
+}
+
+/*****************************************************************************/
+int sys_boot_work_run(sys_boot_work_t *work, void *arg, uint32_t count,
+                      uint32_t chunk)
+{
+    if (!work)
+        return -EINVAL;
+    if (!count)
+        return 0;
+
+    lock_spinlock(&(boot_work.lock));
+    if (boot_work.work)
+    {
+        unlock_spinlock(&(boot_work.lock));
+        return -EBUSY;
+    }
+    boot_work.arg = arg;
+    boot_work.count = count;
+    boot_work.chunk = chunk ? chunk : count;
+    boot_work.next = 0;
+    boot_work.done = 0;
+    boot_work.num_runs++;
+    /* Published last, the other cores poll it */
+    boot_work.work = work;
+    unlock_spinlock(&(boot_work.lock));
+
+    /* The caller takes its share, then waits for the other cores */
+    sys_boot_work_exec();
+    while (boot_work.done < count) {}
+
+    lock_spinlock(&(boot_work.lock));
+    boot_work.work = NULL;
+    unlock_spinlock(&(boot_work.lock));
+
+    return 0;
+}
+
+/*****************************************************************************/
+int sys_boot_work_enabled(void)
+{
+    return boot_work.release ? 0 : 1;
+}
+
+/*****************************************************************************/
+void sys_boot_worker(void)
+{
+    while (!boot_work.release)
+    {
+        if (boot_work.work)
+            sys_boot_work_exec();
+    }
+}
+
+/*****************************************************************************/
+void sys_boot_workers_release(void)
+{
+    boot_work.release = 1;
+}
+
+/*****************************************************************************/
+void sys_boot_work_report(void)
+{
+    uint32_t i;
+
+    pr_info("Boot work: %d runs\n", boot_work.num_runs);
+    for (i = 0; i < INTG_MAX_NUM_OF_CORES; i++)
+        if (boot_work.items[i])
+            pr_info("Boot work: core %d executed %d items\n", i,
+                    boot_work.items[i]);
+}
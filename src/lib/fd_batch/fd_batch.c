@@ -0,0 +1,141 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+/**************************************************************************//**
+@File		fd_batch.c
+
+@Description	Frame batch enqueue
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_errors.h"
+#include "fsl_fdma.h"
+#include "osm_inline.h"
+#include "fsl_fd_batch.h"
+
+/* fdma_discard_fd() API is different for rev1 and rev2 */
+#ifdef LS2085A_REV1
+#define FD_BATCH_DISCARD_FD(_fd, _flags)	fdma_discard_fd((_fd), (_flags))
+#else
+#define FD_BATCH_DISCARD_FD(_fd, _flags)				\
+	fdma_discard_fd((_fd), 0, FDMA_DIS_AS_BIT | (_flags))
+#endif
+
+/* Records the status of a frame of the batch */
+static inline int fd_batch_set_status(struct fd_batch *batch, int err)
+{
+	if (err)
+		batch->drops++;
+	return err;
+}
+
+/* Enqueue terminate control of a frame. The last frame of a terminate batch
+ * ends the task: with its enqueue, or with its discard if the enqueue
+ * fails. LS2085A has no conditional terminate: the task is terminated after
+ * the enqueue returns. */
+static inline uint32_t fd_batch_tc(struct fd_batch *batch, uint32_t flags,
+				   uint32_t *dis_flags)
+{
+	struct scope_status_params scope_status;
+
+	*dis_flags = FDMA_DIS_NO_FLAGS;
+	if (!(flags & FD_BATCH_LAST))
+		return FDMA_EN_TC_RET_BITS;
+	if (batch->flags & FD_BATCH_EXCLUSIVE) {
+		batch->flags &= ~FD_BATCH_EXCLUSIVE;
+		osm_get_scope(&scope_status);
+		if (scope_status.scope_mode == CONCURRENT)
+			osm_scope_transition_to_exclusive_with_increment_scope_id();
+	}
+#ifdef LS2085A_REV1
+	return FDMA_EN_TC_RET_BITS;
+#else
+	if (!(batch->flags & FD_BATCH_TERMINATE))
+		return FDMA_EN_TC_RET_BITS;
+	*dis_flags = FDMA_DIS_FRAME_TC_BIT;
+	return FDMA_EN_TC_CONDTERM_BITS;
+#endif
+}
+
+FD_BATCH_CODE_PLACEMENT void fd_batch_init(struct fd_batch *batch,
+					   uint32_t flags)
+{
+	batch->frames = 0;
+	batch->drops = 0;
+	batch->flags = (uint8_t)flags;
+}
+
+FD_BATCH_CODE_PLACEMENT int fd_batch_send_default_frame(
+		struct fd_batch *batch,
+		struct fdma_queueing_destination_params *qdp,
+		uint32_t flags)
+{
+	uint32_t tc, dis_flags;
+	int err;
+
+	batch->frames++;
+	tc = fd_batch_tc(batch, flags, &dis_flags);
+	err = fdma_store_and_enqueue_default_frame_qd(qdp, tc);
+	if (err) {
+		/* The frame is still open if it was not stored or if the
+		 * conditional terminate enqueue failed */
+		if (err == -ENOMEM || tc != FDMA_EN_TC_RET_BITS)
+			fdma_discard_default_frame(dis_flags);
+		else /* (err == -EBUSY) */
+			FD_BATCH_DISCARD_FD((struct ldpaa_fd *)HWC_FD_ADDRESS,
+					    dis_flags);
+	}
+	err = fd_batch_set_status(batch, err);
+#ifdef LS2085A_REV1
+	fd_batch_flush(batch, flags);
+#endif
+	return err;
+}
+
+#ifndef LS2085A_REV1
+FD_BATCH_CODE_PLACEMENT int fd_batch_replicate_default_frame(
+		struct fd_batch *batch,
+		struct fdma_queueing_destination_params *qdp)
+{
+	uint8_t replic_handle;
+	int err;
+
+	batch->frames++;
+	err = fdma_replicate_frame_qd((uint8_t)PRC_GET_FRAME_HANDLE(),
+				      *((uint8_t *)HWC_SPID_ADDRESS), qdp,
+				      &batch->fd, FDMA_REPLIC_ENQ_BIT,
+				      &replic_handle);
+	if (err == -EBUSY)
+		FD_BATCH_DISCARD_FD(&batch->fd, FDMA_DIS_NO_FLAGS);
+	return fd_batch_set_status(batch, err);
+}
+#endif /* LS2085A_REV1 */
+
+FD_BATCH_CODE_PLACEMENT void fd_batch_flush(struct fd_batch *batch,
+					    uint32_t flags)
+{
+	if ((flags & FD_BATCH_LAST) && (batch->flags & FD_BATCH_TERMINATE))
+		fdma_terminate_task();
+}
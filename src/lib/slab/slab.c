@@ -24,6 +24,10 @@
  * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+/* Defines the profiled slab functions, its buffer pool calls are part of them
+ * (fsl_sl_alloc_prof.h) */
+#define ALLOC_PROF_NO_WRAP
+
 #include "fsl_types.h"
 #include "fsl_errors.h"
 #include "common/fsl_string.h"
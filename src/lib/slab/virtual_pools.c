@@ -31,6 +31,10 @@
 				Operations implementation.
 *//***************************************************************************/
 
+/* The buffer pool calls of the slab pools are not profiled
+ * (fsl_sl_alloc_prof.h) */
+#define ALLOC_PROF_NO_WRAP
+
 #include "virtual_pools.h"
 #include "kernel/fsl_spinlock.h"
 #include "fsl_cdma.h"
@@ -0,0 +1,467 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		twheel.c
+
+@Description	Hierarchical timer wheels multiplexed over a TMAN instance
+*//***************************************************************************/
+
+#include "general.h"
+#include "fsl_errors.h"
+#include "fsl_string.h"
+#include "fsl_malloc.h"
+#include "fsl_spinlock.h"
+#include "fsl_cdma.h"
+#include "fsl_tman.h"
+#include "fsl_fdma.h"
+#include "fsl_core.h"
+#include "fsl_smp.h"
+#include "fsl_sl_dbg.h"
+#include "twheel.h"
+
+static struct twheel_cfg g_twheel = {
+	.free_head = TWHEEL_NIL,
+	.mem_pid = MEM_PART_SYSTEM_DDR,
+	.tmi_id = 0xFF
+};
+
+/* TMAN timer granularities, finest first */
+static const struct {
+	uint32_t	usec;
+	uint32_t	flags;
+} twheel_granularity[] = {
+	{1, TMAN_CREATE_TIMER_MODE_USEC_GRANULARITY},
+	{100, TMAN_CREATE_TIMER_MODE_100_USEC_GRANULARITY},
+	{10000, TMAN_CREATE_TIMER_MODE_10_MSEC_GRANULARITY},
+	{1000000, TMAN_CREATE_TIMER_MODE_SEC_GRANULARITY}
+};
+
+/* Flags and duration of the TMAN timer of a tick */
+static int twheel_tman_period(uint32_t tick, uint32_t *flags,
+			      uint16_t *duration)
+{
+	uint32_t i, d;
+
+	for (i = 0; i < sizeof(twheel_granularity) /
+			sizeof(twheel_granularity[0]); i++) {
+		if (tick % twheel_granularity[i].usec)
+			break;
+		d = tick / twheel_granularity[i].usec;
+		if (d > 10 && d < 65526) {
+			*flags = twheel_granularity[i].flags;
+			*duration = (uint16_t)d;
+			return 0;
+		}
+	}
+	return -EINVAL;
+}
+
+static inline uint64_t twheel_timer_addr(uint32_t idx)
+{
+	return g_twheel.timers_addr + idx * sizeof(struct twheel_timer);
+}
+
+/* Links a timer in the slot of its expiration tick. The caller holds the
+ * mutex of the timer and writes the 'next' field before releasing it: a
+ * tick task following the slot reads the timer only after its link. */
+static void twheel_link(struct twheel *w, uint32_t idx,
+			struct twheel_timer *tmr)
+{
+	uint32_t expiry, delta, level, slot;
+
+	lock_spinlock(&w->lock);
+	expiry = tmr->expiry;
+	delta = expiry - w->now;
+	if ((int32_t)delta <= 0) {
+		/* Late, on the next tick */
+		expiry = w->now + 1;
+		delta = 1;
+	}
+	for (level = 0; level < TWHEEL_LEVELS - 1; level++)
+		if (delta < (1 << (TWHEEL_SLOT_BITS * (level + 1))))
+			break;
+	slot = (expiry >> (TWHEEL_SLOT_BITS * level)) & TWHEEL_SLOT_MASK;
+	tmr->next = w->slots[level][slot];
+	w->slots[level][slot] = idx;
+	unlock_spinlock(&w->lock);
+}
+
+/* Returns a timer to the free list. The caller holds the mutex of the timer
+ * and writes its first 8 bytes before releasing it. */
+static void twheel_release(uint32_t idx, struct twheel_timer *tmr)
+{
+	tmr->state = TWHEEL_TIMER_FREE;
+	lock_spinlock(&g_twheel.lock);
+	tmr->next = g_twheel.free_head;
+	g_twheel.free_head = idx;
+	unlock_spinlock(&g_twheel.lock);
+}
+
+/* Gets a free timer, with its mutex taken. A timer can't leave the free list
+ * while its mutex is held, so it is still the head of the list if the head
+ * index didn't change. */
+static int twheel_alloc(uint32_t *idx, struct twheel_timer *tmr)
+{
+	uint64_t addr;
+	uint32_t i;
+
+	for (;;) {
+		i = g_twheel.free_head;
+		if (i == TWHEEL_NIL)
+			break;
+		addr = twheel_timer_addr(i);
+		cdma_read_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, tmr,
+				     8);
+		lock_spinlock(&g_twheel.lock);
+		if (g_twheel.free_head == i) {
+			g_twheel.free_head = tmr->next;
+			unlock_spinlock(&g_twheel.lock);
+			*idx = i;
+			return 0;
+		}
+		unlock_spinlock(&g_twheel.lock);
+		cdma_mutex_lock_release(addr);
+	}
+
+	/* Timers never used */
+	lock_spinlock(&g_twheel.lock);
+	i = g_twheel.unused;
+	if (i < g_twheel.nbr_of_timers)
+		g_twheel.unused++;
+	unlock_spinlock(&g_twheel.lock);
+	if (i >= g_twheel.nbr_of_timers)
+		return -ENOSPC;
+	cdma_mutex_lock_take(twheel_timer_addr(i), CDMA_MUTEX_WRITE_LOCK);
+	tmr->gen = 0;
+	*idx = i;
+	return 0;
+}
+
+static inline int twheel_check(struct twheel_timer *tmr, uint32_t handle)
+{
+	if (tmr->gen != (uint8_t)(handle >> TWHEEL_GEN_SHIFT))
+		return -ENAVAIL;
+	if (tmr->state == TWHEEL_TIMER_ARMED)
+		return 0;
+	return (tmr->state == TWHEEL_TIMER_FREE) ? -ETIMEDOUT : -ENAVAIL;
+}
+
+/* Processes the timers of a list detached from a slot: expires the due
+ * timers, moves the others to the slot of their expiration tick and releases
+ * the deleted ones. */
+static void twheel_process(struct twheel *w, uint32_t idx, uint32_t now)
+{
+	struct twheel_timer tmr;
+	uint64_t addr;
+	uint32_t next;
+
+	while (idx != TWHEEL_NIL) {
+		addr = twheel_timer_addr(idx);
+		cdma_read_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &tmr,
+				     sizeof(tmr));
+		next = tmr.next;
+		if (tmr.state != TWHEEL_TIMER_ARMED) {
+			twheel_release(idx, &tmr);
+			cdma_write_with_mutex(addr, CDMA_POSTDMA_MUTEX_RM_BIT,
+					      &tmr, 8);
+		} else if ((int32_t)(tmr.expiry - now) > 0) {
+			/* Cascaded or recharged */
+			twheel_link(w, idx, &tmr);
+			cdma_write_with_mutex(addr, CDMA_POSTDMA_MUTEX_RM_BIT,
+					      &tmr, 8);
+		} else {
+			if (tmr.one_shot) {
+				twheel_release(idx, &tmr);
+				cdma_write_with_mutex(addr,
+						      CDMA_POSTDMA_MUTEX_RM_BIT,
+						      &tmr, 8);
+			} else {
+				tmr.expiry = now + tmr.duration;
+				twheel_link(w, idx, &tmr);
+				cdma_write_with_mutex(addr,
+						      CDMA_POSTDMA_MUTEX_RM_BIT,
+						      &tmr, 12);
+			}
+			tmr.cb(tmr.opaque_data1, tmr.opaque_data2);
+		}
+		idx = next;
+	}
+}
+
+/* Moves a wheel to its next tick. The slots of the tick are detached under
+ * the lock, then processed: the cascaded levels first, their timers may
+ * expire on this tick. */
+static void twheel_advance(struct twheel *w)
+{
+	uint32_t lists[TWHEEL_LEVELS];
+	uint32_t now, level, slot;
+
+	for (level = 1; level < TWHEEL_LEVELS; level++)
+		lists[level] = TWHEEL_NIL;
+
+	lock_spinlock(&w->lock);
+	now = w->now + 1;
+	w->now = now;
+	slot = now & TWHEEL_SLOT_MASK;
+	lists[0] = w->slots[0][slot];
+	w->slots[0][slot] = TWHEEL_NIL;
+	for (level = 1; level < TWHEEL_LEVELS; level++) {
+		if (now & ((1 << (TWHEEL_SLOT_BITS * level)) - 1))
+			break;
+		slot = (now >> (TWHEEL_SLOT_BITS * level)) & TWHEEL_SLOT_MASK;
+		lists[level] = w->slots[level][slot];
+		w->slots[level][slot] = TWHEEL_NIL;
+	}
+	unlock_spinlock(&w->lock);
+
+	for (level = TWHEEL_LEVELS; level-- > 0; )
+		twheel_process(w, lists[level], now);
+}
+
+/* Task of the TMAN timer of a wheel. The wheel catches up with the TMAN
+ * timestamp, so the ticks of a skipped or late task are not lost. */
+static void twheel_tick_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	struct twheel	*w = &g_twheel.wheels[(uint32_t)arg1];
+	uint64_t	ts;
+	uint32_t	target;
+	uint8_t		busy;
+
+	UNUSED(arg2);
+	tman_timer_completion_confirmation(
+			TMAN_GET_TIMER_HANDLE(HWC_FD_ADDRESS));
+
+	lock_spinlock(&w->lock);
+	busy = w->busy;
+	w->busy = 1;
+	unlock_spinlock(&w->lock);
+
+	if (!busy) {
+		tman_get_timestamp(&ts);
+		target = (uint32_t)((ts - g_twheel.start) / g_twheel.tick);
+		while ((int32_t)(target - w->now) > 0)
+			twheel_advance(w);
+
+		lock_spinlock(&w->lock);
+		w->busy = 0;
+		unlock_spinlock(&w->lock);
+	}
+	fdma_terminate_task();
+}
+
+TWHEEL_CODE_PLACEMENT int twheel_create_timer(uint32_t flags,
+					      uint32_t duration,
+					      tman_arg_8B_t opaque_data1,
+					      tman_arg_2B_t opaque_data2,
+					      twheel_cb_t cb,
+					      uint32_t *timer_handle)
+{
+	struct twheel_timer	tmr;
+	struct twheel		*w;
+	uint32_t		idx, wheel;
+	int			err;
+
+	if (!duration || duration > TWHEEL_MAX_DURATION || !cb)
+		return -EINVAL;
+	err = twheel_alloc(&idx, &tmr);
+	if (err)
+		return err;
+
+	wheel = core_get_id() % g_twheel.num_wheels;
+	w = &g_twheel.wheels[wheel];
+	tmr.state = TWHEEL_TIMER_ARMED;
+	tmr.gen++;
+	tmr.wheel = (uint8_t)wheel;
+	tmr.one_shot = (flags & TWHEEL_CREATE_TIMER_ONE_SHOT) ? 1 : 0;
+	tmr.expiry = w->now + duration;
+	tmr.duration = duration;
+	tmr.opaque_data1 = opaque_data1;
+	tmr.cb = cb;
+	tmr.opaque_data2 = opaque_data2;
+	tmr.reserved = 0;
+	twheel_link(w, idx, &tmr);
+	cdma_write_with_mutex(twheel_timer_addr(idx), CDMA_POSTDMA_MUTEX_RM_BIT,
+			      &tmr, sizeof(tmr));
+	*timer_handle = TWHEEL_HANDLE(idx, tmr.gen);
+	return 0;
+}
+
+TWHEEL_CODE_PLACEMENT int twheel_delete_timer(uint32_t timer_handle,
+					      uint32_t flags)
+{
+	struct twheel_timer	tmr;
+	uint64_t		addr;
+	uint32_t		idx = timer_handle & TWHEEL_IDX_MASK;
+	int			err;
+
+	UNUSED(flags);
+	if (idx >= g_twheel.nbr_of_timers)
+		return -ENAVAIL;
+	addr = twheel_timer_addr(idx);
+	cdma_read_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &tmr, 8);
+	err = twheel_check(&tmr, timer_handle);
+	if (err) {
+		cdma_mutex_lock_release(addr);
+		return err;
+	}
+	/* Released when its wheel reaches it */
+	tmr.state = TWHEEL_TIMER_DELETED;
+	cdma_write_with_mutex(addr, CDMA_POSTDMA_MUTEX_RM_BIT, &tmr, 4);
+	return 0;
+}
+
+TWHEEL_CODE_PLACEMENT int twheel_recharge_timer(uint32_t timer_handle)
+{
+	struct twheel_timer	tmr;
+	uint64_t		addr;
+	uint32_t		idx = timer_handle & TWHEEL_IDX_MASK;
+	int			err;
+
+	if (idx >= g_twheel.nbr_of_timers)
+		return -ENAVAIL;
+	addr = twheel_timer_addr(idx);
+	cdma_read_with_mutex(addr, CDMA_PREDMA_MUTEX_WRITE_LOCK, &tmr, 16);
+	err = twheel_check(&tmr, timer_handle);
+	if (err) {
+		cdma_mutex_lock_release(addr);
+		return err;
+	}
+	/* The timer stays in its slot and is moved when the wheel reaches
+	 * it */
+	tmr.expiry = g_twheel.wheels[tmr.wheel].now + tmr.duration;
+	cdma_write_with_mutex(addr, CDMA_POSTDMA_MUTEX_RM_BIT, &tmr, 12);
+	return 0;
+}
+
+__COLD_CODE int twheel_early_init(uint32_t nbr_of_timers, uint32_t tick)
+{
+	uint32_t flags;
+	uint16_t duration;
+
+	if (!tick)
+		tick = TWHEEL_DEFAULT_TICK;
+	if (twheel_tman_period(tick, &flags, &duration)) {
+		pr_err("Invalid timer wheel tick %d us\n", tick);
+		return -EINVAL;
+	}
+	if (nbr_of_timers > TWHEEL_MAX_TIMERS - g_twheel.nbr_of_timers) {
+		pr_err("Too many timer wheel timers\n");
+		return -ENOSPC;
+	}
+	g_twheel.nbr_of_timers += nbr_of_timers;
+	if (!g_twheel.tick || tick < g_twheel.tick)
+		g_twheel.tick = tick;
+	return 0;
+}
+
+__COLD_CODE int twheel_init(void)
+{
+	struct twheel	*w;
+	uint64_t	tmi_addr = 0;
+	uint32_t	i, flags, tmi_timers;
+	uint16_t	duration;
+	int		err;
+
+	/* Not used */
+	if (!g_twheel.nbr_of_timers)
+		return 0;
+
+	if (fsl_mem_exists(MEM_PART_DP_DDR))
+		g_twheel.mem_pid = MEM_PART_DP_DDR;
+	g_twheel.num_wheels = sys_get_num_of_cores();
+	if (g_twheel.num_wheels > TWHEEL_MAX_WHEELS)
+		g_twheel.num_wheels = TWHEEL_MAX_WHEELS;
+
+	err = fsl_get_mem((uint64_t)g_twheel.nbr_of_timers *
+			  sizeof(struct twheel_timer), g_twheel.mem_pid,
+			  TWHEEL_MEM_ALIGN, &g_twheel.timers_addr);
+	if (err) {
+		pr_err("Cannot allocate %d timer wheel timers\n",
+		       g_twheel.nbr_of_timers);
+		return err;
+	}
+	g_twheel.wheels = (struct twheel *)
+		fsl_malloc(g_twheel.num_wheels * sizeof(struct twheel),
+			   TWHEEL_MEM_ALIGN);
+	if (!g_twheel.wheels) {
+		pr_err("Cannot allocate the timer wheels\n");
+		return -ENOMEM;
+	}
+	for (i = 0; i < g_twheel.num_wheels; i++) {
+		w = &g_twheel.wheels[i];
+		memset(w, 0, sizeof(*w));
+		memset(w->slots, 0xFF, sizeof(w->slots));
+	}
+
+	/* One periodic timer per wheel, plus the timers required by
+	 * tman_create_tmi() */
+	tmi_timers = g_twheel.num_wheels + 4;
+	err = fsl_get_mem((tmi_timers + 1) * 64, g_twheel.mem_pid, 64,
+			  &tmi_addr);
+	if (!err)
+		err = tman_create_tmi(tmi_addr, tmi_timers, &g_twheel.tmi_id);
+	if (err) {
+		pr_err("Cannot create the timer wheel TMI\n");
+		return err;
+	}
+
+	twheel_tman_period(g_twheel.tick, &flags, &duration);
+	tman_get_timestamp(&g_twheel.start);
+	for (i = 0; i < g_twheel.num_wheels; i++) {
+		err = tman_create_timer(g_twheel.tmi_id,
+					flags | TMAN_CREATE_TIMER_MODE_TPRI,
+					duration, i, 0, twheel_tick_cb,
+					&g_twheel.wheels[i].tman_handle);
+		if (err) {
+			pr_err("Cannot create the tick of timer wheel %d\n", i);
+			return err;
+		}
+	}
+
+	pr_info("Timer wheel: %d timers, %d wheels, tick %d us\n",
+		g_twheel.nbr_of_timers, g_twheel.num_wheels, g_twheel.tick);
+	return 0;
+}
+
+static void twheel_delete_tmi_cb(tman_arg_8B_t arg1, tman_arg_2B_t arg2)
+{
+	UNUSED(arg1);
+	UNUSED(arg2);
+	tman_timer_completion_confirmation(
+			TMAN_GET_TIMER_HANDLE(HWC_FD_ADDRESS));
+	fdma_terminate_task();
+}
+
+__COLD_CODE void twheel_free(void)
+{
+	if (g_twheel.tmi_id != 0xFF) {
+		tman_delete_tmi(twheel_delete_tmi_cb,
+				TMAN_INS_DELETE_MODE_FORCE_EXP,
+				g_twheel.tmi_id, 0, 0);
+		g_twheel.tmi_id = 0xFF;
+	}
+}
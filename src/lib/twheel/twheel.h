@@ -0,0 +1,119 @@
+/*
+ * Copyright 2016 Freescale Semiconductor, Inc.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *   * Neither the name of Freescale Semiconductor nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY Freescale Semiconductor ``AS IS'' AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL Freescale Semiconductor BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**************************************************************************//**
+@File		twheel.h
+
+@Description	Timer wheel internal definitions
+*//***************************************************************************/
+
+#ifndef __TWHEEL_H
+#define __TWHEEL_H
+
+#include "fsl_twheel.h"
+
+/* Wheel geometry: 4 levels of 64 slots cover TWHEEL_MAX_DURATION ticks */
+#define TWHEEL_LEVELS		4
+#define TWHEEL_SLOT_BITS	6
+#define TWHEEL_SLOTS		(1 << TWHEEL_SLOT_BITS)
+#define TWHEEL_SLOT_MASK	(TWHEEL_SLOTS - 1)
+
+/* End of a list */
+#define TWHEEL_NIL		0xFFFFFFFF
+
+/* Timer handle: generation in the MSB, timer index in the other bits */
+#define TWHEEL_IDX_MASK		0x00FFFFFF
+#define TWHEEL_GEN_SHIFT	24
+#define TWHEEL_HANDLE(_idx, _gen)					\
+	(((uint32_t)(_gen) << TWHEEL_GEN_SHIFT) | (_idx))
+
+/* Wheel index is stored on 8 bits */
+#define TWHEEL_MAX_WHEELS	255
+
+#define TWHEEL_MEM_ALIGN	64
+
+/* Timer states */
+#define TWHEEL_TIMER_FREE	0
+#define TWHEEL_TIMER_ARMED	1
+/* Deleted, still linked in a slot */
+#define TWHEEL_TIMER_DELETED	2
+
+/* Timer, in DDR. It is always read and written with its CDMA mutex. The
+ * first 8 bytes are written alone (state change, relink), the first 12
+ * bytes on recharge. */
+struct twheel_timer {
+	uint8_t		state;
+	/* Incremented on each creation, part of the handle */
+	uint8_t		gen;
+	uint8_t		wheel;
+	uint8_t		one_shot;
+	/* Next timer of the slot, or of the free list */
+	uint32_t	next;
+	/* Expiration tick */
+	uint32_t	expiry;
+	uint32_t	duration;
+	uint64_t	opaque_data1;
+	twheel_cb_t	cb;
+	uint16_t	opaque_data2;
+	uint16_t	reserved;
+};
+
+/* Wheel of a core, in Shared RAM */
+struct twheel {
+	/* Protects the slots and the current tick */
+	uint64_t	lock;
+	uint32_t	slots[TWHEEL_LEVELS][TWHEEL_SLOTS];
+	/* Current tick: the timers of this tick were processed, or are being
+	 * processed */
+	volatile uint32_t now;
+	uint32_t	tman_handle;
+	/* A tick task is processing the wheel */
+	uint8_t		busy;
+};
+
+struct twheel_cfg {
+	/* Protects the free list */
+	uint64_t	lock;
+	/* Timers array */
+	uint64_t	timers_addr;
+	/* TMAN timestamp of tick 0 */
+	uint64_t	start;
+	struct twheel	*wheels;
+	/* Released timers */
+	uint32_t	free_head;
+	/* Timers never used, from this index */
+	uint32_t	unused;
+	uint32_t	nbr_of_timers;
+	uint32_t	tick;
+	uint32_t	num_wheels;
+	int		mem_pid;
+	uint8_t		tmi_id;
+};
+
+int twheel_init(void);
+void twheel_free(void);
+
+#endif /* __TWHEEL_H */
@@ -337,6 +337,33 @@ static void check_counters()
 	ASSERT_COND(dpci_down_ev_count >= (dpci_rm_count * 2));
 }
 
+static int sg_cmd_test(struct cmdif_sg_iter *it, uint32_t size)
+{
+	uint8_t  buf[64];
+	uint32_t total = 0;
+	int      len;
+	int      i;
+
+	do {
+		len = cmdif_sg_read(it, &buf[0], sizeof(buf));
+		if (len < 0) {
+			pr_err("S/G payload read failed %d\n", len);
+			return len;
+		}
+		for (i = 0; i < len; i++) {
+			if (buf[i] != (uint8_t)(total + i)) {
+				pr_err("S/G payload mismatch at %d\n",
+				       total + i);
+				return -EIO;
+			}
+		}
+		total += len;
+	} while (len == sizeof(buf));
+
+	pr_debug("S/G payload of %d bytes\n", total);
+	return (total == size) ? 0 : -EIO;
+}
+
 static int close_cb(void *dev)
 {
 	UNUSED(dev);
@@ -410,6 +437,9 @@ static int ctrl_cb0(void *dev, uint16_t cmd, uint32_t size,
 	case RCU_SYNC_CHECK:
 		err = rcu_test_check();
 		break;
+	case SG_CMD_TEST:
+		err = sg_cmd_test(data, size);
+		break;
 	case DPCI_ADD:
 		err = dpci_dynamic_add_test();
 		/* Done indication for MC*/
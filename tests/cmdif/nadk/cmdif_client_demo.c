@@ -79,6 +79,13 @@
 /* Command ID for testing shared pool where GPP is allocation master */
 #define SHBP_TEST_GPP	0x110
 
+/* Command ID for testing S/G payloads, payload byte i is (uint8_t)i */
+#define SG_CMD_TEST	(0x116 | CMDIF_SG_CMD)
+
+/* Buffers of the S/G payload, the table takes one more buffer */
+#define SG_NUM_ENTRIES	4
+#define SG_BUF_SIZE	128
+
 /*
  * Structure for testing shared pool
  */
@@ -120,6 +127,7 @@ int async_count2;
 void *aiop_open_cmd_mem_pool;
 void *aiop_data_mem_pool;
 void *aiop_shbp_mem_pool;
+void *aiop_sg_mem_pool;
 
 /* The IO worker function, required by main() for thread-creation */
 static void *app_io_thread(void *__worker);
@@ -405,6 +413,24 @@ int create_global_mempools(void)
 				"memory pool");
 		return NADK_FAILURE;
 	}
+
+	memset(&mpcfg, 0, sizeof(struct nadk_mpool_cfg));
+	/* Fill all the params for the pool to be passed in cfg */
+	mpcfg.name = "aiop_sg_mem_pool";
+	mpcfg.block_size = SG_BUF_SIZE;
+	mpcfg.num_global_blocks = SG_NUM_ENTRIES + 1;
+	mpcfg.num_max_blocks = SG_NUM_ENTRIES + 1;
+
+	/* Create the memory pool of the dma'ble memory */
+	aiop_sg_mem_pool = nadk_mpool_create(&mpcfg, NULL, NULL);
+	if (!aiop_sg_mem_pool) {
+		NADK_ERR(APP1, "Unable to allocate the aiop S/G "
+			"memory pool");
+		nadk_mpool_delete(aiop_shbp_mem_pool);
+		nadk_mpool_delete(aiop_open_cmd_mem_pool);
+		nadk_mpool_delete(aiop_data_mem_pool);
+		return NADK_FAILURE;
+	}
 	
 	return NADK_SUCCESS;
 }
@@ -414,6 +440,7 @@ int destroy_global_mempools(void)
 	/* The below API is currently not implemented */
 	nadk_mpool_delete(aiop_open_cmd_mem_pool);
 	nadk_mpool_delete(aiop_data_mem_pool);
+	nadk_mpool_delete(aiop_sg_mem_pool);
 
 	return NADK_SUCCESS;
 }
@@ -706,6 +733,99 @@ shbp_err0:
 	return ret;	
 }
 
+/*
+ * Sends SG_CMD_TEST with a table of num_entries buffers. Only sent_entries
+ * entries follow the header in the command data.
+ */
+static int sg_cmd_send(uint8_t *table, uint8_t **bufs, uint16_t num_entries,
+		       uint16_t sent_entries, uint32_t length)
+{
+	struct cmdif_sg_table *hdr = (struct cmdif_sg_table *)table;
+	struct cmdif_sg_entry *entry = (struct cmdif_sg_entry *)(hdr + 1);
+	int i;
+
+	/* AIOP reads the table in big endian */
+	hdr->length = nadk_bswap32(length);
+	hdr->num_entries = nadk_bswap16(num_entries);
+	hdr->reserved = 0;
+	for (i = 0; i < num_entries; i++) {
+		entry[i].addr = nadk_bswap64((uint64_t)bufs[i]);
+		entry[i].length = nadk_bswap32(SG_BUF_SIZE);
+		entry[i].reserved = 0;
+	}
+
+	return cmdif_send(&cidesc[0], SG_CMD_TEST,
+			  sizeof(*hdr) + sent_entries * sizeof(*entry),
+			  CMDIF_PRI_LOW, (uint64_t)table);
+}
+
+static int sg_test()
+{
+	uint8_t *bufs[SG_NUM_ENTRIES];
+	uint8_t *table;
+	int err;
+	int ret = -1;
+	int i, j;
+
+	NADK_NOTE(APP1, "Testing S/G commands");
+
+	table = nadk_mpool_getblock(aiop_sg_mem_pool, NULL);
+	if (!table) {
+		NADK_ERR(APP1, "Unable to get the memory");
+		return NADK_FAILURE;
+	}
+	for (i = 0; i < SG_NUM_ENTRIES; i++) {
+		bufs[i] = nadk_mpool_getblock(aiop_sg_mem_pool, NULL);
+		if (!bufs[i]) {
+			NADK_ERR(APP1, "Unable to get the memory");
+			goto sg_err;
+		}
+		for (j = 0; j < SG_BUF_SIZE; j++)
+			bufs[i][j] = (uint8_t)(i * SG_BUF_SIZE + j);
+	}
+
+	/* The payload ends inside the last buffer */
+	err = sg_cmd_send(table, bufs, SG_NUM_ENTRIES, SG_NUM_ENTRIES,
+			  SG_NUM_ENTRIES * SG_BUF_SIZE - 5);
+	if (err) {
+		NADK_ERR(APP1, "FAILED SG_CMD_TEST multi-entry err = %d", err);
+		goto sg_err;
+	}
+
+	/* The command data ends before the last entry of the table */
+	err = sg_cmd_send(table, bufs, SG_NUM_ENTRIES, SG_NUM_ENTRIES - 1,
+			  SG_NUM_ENTRIES * SG_BUF_SIZE);
+	if (err != -EINVAL) {
+		NADK_ERR(APP1, "FAILED SG_CMD_TEST truncated table err = %d",
+			 err);
+		goto sg_err;
+	}
+
+	/* The buffers hold less than the payload length */
+	err = sg_cmd_send(table, bufs, SG_NUM_ENTRIES, SG_NUM_ENTRIES,
+			  SG_NUM_ENTRIES * SG_BUF_SIZE + 1);
+	if (err != -EINVAL) {
+		NADK_ERR(APP1, "FAILED SG_CMD_TEST short buffers err = %d",
+			 err);
+		goto sg_err;
+	}
+
+	NADK_NOTE(APP1, "PASSED Finished S/G test");
+	ret = 0;
+
+sg_err:
+	while (i--) {
+		err = nadk_mpool_relblock(aiop_sg_mem_pool, bufs[i]);
+		if (err != NADK_SUCCESS)
+			NADK_ERR(APP1, "Error in releasing memory");
+	}
+	err = nadk_mpool_relblock(aiop_sg_mem_pool, table);
+	if (err != NADK_SUCCESS)
+		NADK_ERR(APP1, "Error in releasing memory");
+
+	return ret;
+}
+
 /* This is the worker IO thread function. */
 static void *app_io_thread(void *__worker)
 {
@@ -766,6 +886,12 @@ static void *app_io_thread(void *__worker)
 		NADK_NOTE(APP1, "PASSED SHBP tests %d", i);
 	else
 		NADK_NOTE(APP1, "FAILED SHBP tests %d", i);
+
+	ret = sg_test();
+	if (ret == 0)
+		NADK_NOTE(APP1, "PASSED S/G tests");
+	else
+		NADK_NOTE(APP1, "FAILED S/G tests");
 	
 	/* Get a memory block */
 	/* NOTE: Here we are using the same memory and same block of the